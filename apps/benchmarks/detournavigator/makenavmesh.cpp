@@ -0,0 +1,40 @@
+#include "world.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <components/detournavigator/makenavmesh.hpp>
+#include <components/detournavigator/preparednavmeshdata.hpp>
+#include <components/detournavigator/recastglobalallocator.hpp>
+
+#include <cstddef>
+#include <random>
+
+namespace
+{
+    using namespace DetourNavigator;
+    using namespace DetourNavigator::Benchmarks;
+
+    void prepareNavMeshTileData(benchmark::State& state)
+    {
+        RecastGlobalAllocator::init();
+        RecastGlobalAllocator::setArenaMaxSize(static_cast<std::size_t>(state.range(1)) * 1024 * 1024);
+        const Settings settings = makeSettings();
+        const AgentBounds agentBounds = makeAgentBounds(1);
+        const TilePosition tilePosition(minTilePosition, minTilePosition);
+        std::minstd_rand random;
+        const World world = generateWorld(settings.mRecast, static_cast<std::size_t>(state.range(0)), random);
+        const auto recastMesh = makeRecastMesh(world, settings.mRecast, tilePosition);
+
+        for (auto _ : state)
+        {
+            auto result
+                = DetourNavigator::prepareNavMeshTileData(*recastMesh, tilePosition, agentBounds, settings.mRecast);
+            benchmark::DoNotOptimize(result);
+        }
+    }
+}
+
+// Arguments are number of boxes per tile and arena max size in MiB, 0 disables the arena
+BENCHMARK(prepareNavMeshTileData)->ArgsProduct({ { 0, 100, 1000 }, { 0, 64 } })->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,205 @@
+#include "world.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <components/detournavigator/findsmoothpath.hpp>
+#include <components/detournavigator/makenavmesh.hpp>
+#include <components/detournavigator/preparednavmeshdata.hpp>
+#include <components/detournavigator/raycast.hpp>
+#include <components/detournavigator/recastglobalallocator.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    using namespace DetourNavigator;
+    using namespace DetourNavigator::Benchmarks;
+
+    constexpr std::size_t queriesCount = 1000;
+
+    const Settings& getSettings()
+    {
+        static const Settings value = makeSettings();
+        return value;
+    }
+
+    // Worlds and navmeshes are shared between benchmark threads and reused for the same arguments
+    const World& getWorld(std::size_t boxesPerTile)
+    {
+        static std::mutex mutex;
+        static std::map<std::size_t, World> worlds;
+        const std::lock_guard lock(mutex);
+        auto it = worlds.find(boxesPerTile);
+        if (it == worlds.end())
+        {
+            std::minstd_rand random;
+            it = worlds.emplace(boxesPerTile, generateWorld(getSettings().mRecast, boxesPerTile, random)).first;
+        }
+        return it->second;
+    }
+
+    const dtNavMesh& getNavMesh(std::size_t boxesPerTile, int agentBoundsIndex)
+    {
+        static std::mutex mutex;
+        static std::map<std::pair<std::size_t, int>, NavMeshPtr> navMeshes;
+        const World& world = getWorld(boxesPerTile);
+        const std::lock_guard lock(mutex);
+        NavMeshPtr& navMesh = navMeshes[{ boxesPerTile, agentBoundsIndex }];
+        if (navMesh == nullptr)
+            navMesh = makeNavMesh(world, getSettings(), makeAgentBounds(agentBoundsIndex));
+        return *navMesh;
+    }
+
+    // Returns pairs of points in navmesh coordinates uniformly distributed over the generated tiles
+    std::vector<std::pair<osg::Vec3f, osg::Vec3f>> generateQueries(const World& world, int threadIndex)
+    {
+        const RecastSettings& settings = getSettings().mRecast;
+        const float tileSize = getRealTileSize(settings);
+        std::minstd_rand random(threadIndex + 1);
+        std::uniform_real_distribution<float> distribution(
+            minTilePosition * tileSize, (maxTilePosition + 1) * tileSize);
+        const auto generatePoint = [&] {
+            return toNavMeshCoordinates(
+                settings, osg::Vec3f(distribution(random), distribution(random), world.mMaxHeight / 2));
+        };
+        std::vector<std::pair<osg::Vec3f, osg::Vec3f>> result;
+        result.reserve(queriesCount);
+        for (std::size_t i = 0; i < queriesCount; ++i)
+        {
+            const osg::Vec3f start = generatePoint();
+            result.emplace_back(start, generatePoint());
+        }
+        return result;
+    }
+
+    void buildRecastMesh(benchmark::State& state)
+    {
+        const World& world = getWorld(static_cast<std::size_t>(state.range(0)));
+        const TilePosition tilePosition(minTilePosition, minTilePosition);
+
+        for (auto _ : state)
+        {
+            auto recastMesh = makeRecastMesh(world, getSettings().mRecast, tilePosition);
+            benchmark::DoNotOptimize(recastMesh);
+        }
+    }
+
+    void makeNavMeshTileData(benchmark::State& state)
+    {
+        const Settings& settings = getSettings();
+        const World& world = getWorld(static_cast<std::size_t>(state.range(0)));
+        const AgentBounds agentBounds = makeAgentBounds(static_cast<int>(state.range(1)));
+        const TilePosition tilePosition(minTilePosition, minTilePosition);
+        const auto recastMesh = makeRecastMesh(world, settings.mRecast, tilePosition);
+        const auto prepared = prepareNavMeshTileData(*recastMesh, tilePosition, agentBounds, settings.mRecast);
+        if (prepared == nullptr)
+        {
+            state.SkipWithError("Failed to prepare navmesh tile data");
+            return;
+        }
+
+        for (auto _ : state)
+        {
+            auto data
+                = DetourNavigator::makeNavMeshTileData(*prepared, {}, agentBounds, tilePosition, settings.mRecast);
+            benchmark::DoNotOptimize(data);
+        }
+    }
+
+    // Full tile generation from recast mesh as it's done by AsyncNavMeshUpdater, each thread generates own tile
+    void generateNavMeshTile(benchmark::State& state)
+    {
+        RecastGlobalAllocator::init();
+        const Settings& settings = getSettings();
+        const World& world = getWorld(static_cast<std::size_t>(state.range(0)));
+        const AgentBounds agentBounds = makeAgentBounds(static_cast<int>(state.range(1)));
+        const int tiles = maxTilePosition - minTilePosition + 1;
+        const TilePosition tilePosition(
+            minTilePosition + state.thread_index() % tiles, minTilePosition + state.thread_index() / tiles % tiles);
+        const auto recastMesh = makeRecastMesh(world, settings.mRecast, tilePosition);
+
+        for (auto _ : state)
+        {
+            const auto prepared = prepareNavMeshTileData(*recastMesh, tilePosition, agentBounds, settings.mRecast);
+            if (prepared == nullptr)
+                continue;
+            auto data
+                = DetourNavigator::makeNavMeshTileData(*prepared, {}, agentBounds, tilePosition, settings.mRecast);
+            benchmark::DoNotOptimize(data);
+        }
+    }
+
+    void findSmoothPath(benchmark::State& state)
+    {
+        const Settings& settings = getSettings();
+        const std::size_t boxesPerTile = static_cast<std::size_t>(state.range(0));
+        const int agentBoundsIndex = static_cast<int>(state.range(1));
+        const dtNavMesh& navMesh = getNavMesh(boxesPerTile, agentBoundsIndex);
+        const AgentBounds agentBounds = makeAgentBounds(agentBoundsIndex);
+        const osg::Vec3f halfExtents = toNavMeshCoordinates(settings.mRecast, agentBounds.mHalfExtents);
+        const float stepSize = toNavMeshCoordinates(settings.mRecast, 2 * agentBounds.mHalfExtents.x());
+        const auto queries = generateQueries(getWorld(boxesPerTile), state.thread_index());
+        std::vector<osg::Vec3f> path;
+        std::size_t n = 0;
+
+        for (auto _ : state)
+        {
+            const auto& [start, end] = queries[n++ % queries.size()];
+            path.clear();
+            const Status status = DetourNavigator::findSmoothPath(navMesh, halfExtents, stepSize, start, end,
+                Flag_walk, AreaCosts{}, settings, 0, std::back_inserter(path));
+            benchmark::DoNotOptimize(status);
+        }
+    }
+
+    void raycast(benchmark::State& state)
+    {
+        const Settings& settings = getSettings();
+        const std::size_t boxesPerTile = static_cast<std::size_t>(state.range(0));
+        const int agentBoundsIndex = static_cast<int>(state.range(1));
+        const dtNavMesh& navMesh = getNavMesh(boxesPerTile, agentBoundsIndex);
+        const osg::Vec3f halfExtents
+            = toNavMeshCoordinates(settings.mRecast, makeAgentBounds(agentBoundsIndex).mHalfExtents);
+        const auto queries = generateQueries(getWorld(boxesPerTile), state.thread_index());
+        std::size_t n = 0;
+
+        for (auto _ : state)
+        {
+            const auto& [start, end] = queries[n++ % queries.size()];
+            const auto result
+                = DetourNavigator::raycast(navMesh, halfExtents, start, end, Flag_walk, settings.mDetour);
+            benchmark::DoNotOptimize(result);
+        }
+    }
+}
+
+// Arguments are number of boxes per tile and agent bounds index: 0 - small, 1 - medium, 2 - large
+BENCHMARK(buildRecastMesh)->Arg(0)->Arg(100)->Arg(1000);
+
+BENCHMARK(makeNavMeshTileData)->ArgsProduct({ { 0, 100, 1000 }, { 0, 1, 2 } });
+
+BENCHMARK(generateNavMeshTile)
+    ->ArgsProduct({ { 0, 100, 1000 }, { 0, 1, 2 } })
+    ->Unit(benchmark::kMillisecond)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+
+BENCHMARK(findSmoothPath)
+    ->ArgsProduct({ { 0, 100, 1000 }, { 0, 1, 2 } })
+    ->Unit(benchmark::kMicrosecond)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+
+BENCHMARK(raycast)
+    ->ArgsProduct({ { 0, 100, 1000 }, { 0, 1, 2 } })
+    ->Unit(benchmark::kMicrosecond)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,156 @@
+#ifndef OPENMW_BENCHMARKS_DETOURNAVIGATOR_WORLD_H
+#define OPENMW_BENCHMARKS_DETOURNAVIGATOR_WORLD_H
+
+#include <components/detournavigator/agentbounds.hpp>
+#include <components/detournavigator/makenavmesh.hpp>
+#include <components/detournavigator/navmeshdata.hpp>
+#include <components/detournavigator/preparednavmeshdata.hpp>
+#include <components/detournavigator/recastmeshbuilder.hpp>
+#include <components/detournavigator/settings.hpp>
+#include <components/detournavigator/settingsutils.hpp>
+#include <components/detournavigator/sharednavmesh.hpp>
+#include <components/detournavigator/tileposition.hpp>
+#include <components/esm3/loadland.hpp>
+
+#include <BulletCollision/CollisionShapes/btBoxShape.h>
+#include <DetourNavMesh.h>
+
+#include <osg/Math>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace DetourNavigator
+{
+    namespace Benchmarks
+    {
+        // Tiles are within a single cell with position (0, 0) covering about 9x9 tiles
+        constexpr int minTilePosition = 1;
+        constexpr int maxTilePosition = 4;
+
+        inline Settings makeSettings()
+        {
+            Settings result;
+            result.mRecast.mBorderSize = 16;
+            result.mRecast.mCellHeight = 0.2f;
+            result.mRecast.mCellSize = 0.2f;
+            result.mRecast.mDetailSampleDist = 6;
+            result.mRecast.mDetailSampleMaxError = 1;
+            result.mRecast.mMaxClimb = 34;
+            result.mRecast.mMaxSimplificationError = 1.3f;
+            result.mRecast.mMaxSlope = 49;
+            result.mRecast.mRecastScaleFactor = 0.029411764705882353f;
+            result.mRecast.mSwimHeightScale = 0.9f;
+            result.mRecast.mMaxEdgeLen = 12;
+            result.mRecast.mMaxVertsPerPoly = 6;
+            result.mRecast.mRegionMergeArea = 400;
+            result.mRecast.mRegionMinArea = 64;
+            result.mRecast.mTileSize = 128;
+            result.mDetour.mMaxNavMeshQueryNodes = 2048;
+            result.mDetour.mMaxPolys = 4096;
+            result.mDetour.mMaxPolygonPathSize = 1024;
+            result.mDetour.mMaxSmoothPathSize = 1024;
+            result.mDetour.mMaxLocalPathTiles = 4;
+            result.mMaxTilesNumber = 512;
+            return result;
+        }
+
+        inline AgentBounds makeAgentBounds(int index)
+        {
+            switch (index)
+            {
+                case 0:
+                    return AgentBounds{ CollisionShapeType::Aabb, osg::Vec3f(12, 12, 30) };
+                case 1:
+                    return AgentBounds{ CollisionShapeType::Aabb, osg::Vec3f(29, 29, 66) };
+                case 2:
+                    return AgentBounds{ CollisionShapeType::Cylinder, osg::Vec3f(64, 64, 128) };
+            }
+            throw std::invalid_argument("Invalid agent bounds index");
+        }
+
+        struct Box
+        {
+            btVector3 mHalfExtents;
+            btTransform mTransform;
+        };
+
+        struct World
+        {
+            std::vector<float> mHeights;
+            float mMaxHeight = 100;
+            std::vector<Box> mBoxes;
+        };
+
+        template <class Random>
+        World generateWorld(const RecastSettings& settings, std::size_t boxesPerTile, Random& random)
+        {
+            World result;
+            std::uniform_real_distribution<float> heightDistribution(0, result.mMaxHeight);
+            result.mHeights.resize(ESM::Land::LAND_NUM_VERTS);
+            for (float& height : result.mHeights)
+                height = heightDistribution(random);
+
+            const int tiles = maxTilePosition - minTilePosition + 1;
+            const float tileSize = getRealTileSize(settings);
+            std::uniform_real_distribution<float> positionDistribution(
+                minTilePosition * tileSize, (maxTilePosition + 1) * tileSize);
+            std::uniform_real_distribution<float> sizeDistribution(10, 100);
+            std::uniform_real_distribution<float> angleDistribution(0, osg::PI);
+            result.mBoxes.reserve(boxesPerTile * tiles * tiles);
+            std::generate_n(std::back_inserter(result.mBoxes), boxesPerTile * tiles * tiles, [&] {
+                return Box{
+                    btVector3(sizeDistribution(random), sizeDistribution(random), sizeDistribution(random)),
+                    btTransform(btQuaternion(btVector3(0, 0, 1), angleDistribution(random)),
+                        btVector3(positionDistribution(random), positionDistribution(random),
+                            heightDistribution(random))),
+                };
+            });
+            return result;
+        }
+
+        inline std::shared_ptr<RecastMesh> makeRecastMesh(
+            const World& world, const RecastSettings& settings, const TilePosition& tilePosition)
+        {
+            const TileBounds bounds = makeRealTileBoundsWithBorder(settings, tilePosition);
+            RecastMeshBuilder builder(bounds);
+            builder.addHeightfield(osg::Vec2i(0, 0), ESM::Land::REAL_SIZE, world.mHeights.data(), ESM::Land::LAND_SIZE,
+                0, world.mMaxHeight);
+            for (const Box& box : world.mBoxes)
+                builder.addObject(btBoxShape(box.mHalfExtents), box.mTransform, AreaType_ground);
+            return std::move(builder).create(Version{ .mGeneration = 0, .mRevision = 0 });
+        }
+
+        // Generates tiles in range [minTilePosition, maxTilePosition] by both coordinates
+        inline NavMeshPtr makeNavMesh(const World& world, const Settings& settings, const AgentBounds& agentBounds)
+        {
+            NavMeshPtr result = makeEmptyNavMesh(settings);
+            for (int x = minTilePosition; x <= maxTilePosition; ++x)
+            {
+                for (int y = minTilePosition; y <= maxTilePosition; ++y)
+                {
+                    const TilePosition tilePosition(x, y);
+                    const auto recastMesh = makeRecastMesh(world, settings.mRecast, tilePosition);
+                    const auto prepared
+                        = prepareNavMeshTileData(*recastMesh, tilePosition, agentBounds, settings.mRecast);
+                    if (prepared == nullptr)
+                        continue;
+                    NavMeshData data
+                        = makeNavMeshTileData(*prepared, {}, agentBounds, tilePosition, settings.mRecast);
+                    if (data.mValue == nullptr)
+                        continue;
+                    if (dtStatusSucceed(result->addTile(data.mValue.get(), data.mSize, DT_TILE_FREE_DATA, 0, nullptr)))
+                        static_cast<void>(data.mValue.release());
+                }
+            }
+            return result;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,138 @@
+#include <benchmark/benchmark.h>
+
+#include <components/esm3terrain/storage.hpp>
+
+#include <osg/Array>
+
+#include <cstdint>
+#include <map>
+#include <random>
+#include <utility>
+
+namespace
+{
+    constexpr int worldSize = 4;
+
+    // Synthetic landscape of worldSize x worldSize cells with random heights, normals and colours.
+    class TestStorage final : public ESMTerrain::Storage
+    {
+    public:
+        TestStorage()
+            : ESMTerrain::Storage(nullptr)
+        {
+            std::minstd_rand random;
+            std::uniform_int_distribution<int> heightDistribution(-1000, 1000);
+            std::uniform_int_distribution<int> normalDistribution(-30, 30);
+            std::uniform_int_distribution<int> colourDistribution(0, 255);
+            for (int x = 0; x < worldSize; ++x)
+            {
+                for (int y = 0; y < worldSize; ++y)
+                {
+                    ESM::Land& land = mLands[std::make_pair(x, y)];
+                    land.blank();
+                    ESM::Land::LandData& data = *land.getLandData();
+                    for (int i = 0; i < ESM::Land::LAND_NUM_VERTS; ++i)
+                    {
+                        data.mHeights[i] = static_cast<float>(heightDistribution(random));
+                        data.mNormals[i * 3] = static_cast<ESM::Land::VNML>(normalDistribution(random));
+                        data.mNormals[i * 3 + 1] = static_cast<ESM::Land::VNML>(normalDistribution(random));
+                        data.mNormals[i * 3 + 2] = 100;
+                        for (int j = 0; j < 3; ++j)
+                            data.mColours[i * 3 + j] = static_cast<unsigned char>(colourDistribution(random));
+                    }
+                }
+            }
+        }
+
+        osg::ref_ptr<const ESMTerrain::LandObject> getLand(int cellX, int cellY) override
+        {
+            const auto it = mLands.find(std::make_pair(cellX, cellY));
+            if (it == mLands.end())
+                return nullptr;
+            return new ESMTerrain::LandObject(&it->second,
+                ESM::Land::DATA_VHGT | ESM::Land::DATA_VNML | ESM::Land::DATA_VCLR | ESM::Land::DATA_VTEX);
+        }
+
+        const ESM::LandTexture* getLandTexture(int index, short plugin) override { return nullptr; }
+
+        void getBounds(float& minX, float& maxX, float& minY, float& maxY) override
+        {
+            minX = 0;
+            maxX = worldSize;
+            minY = 0;
+            maxY = worldSize;
+        }
+
+    private:
+        std::map<std::pair<int, int>, ESM::Land> mLands;
+    };
+
+    // Fills vertex buffers for every chunk of the given size covering the whole landscape
+    template <int lodLevel, int chunkSizeNumerator, int chunkSizeDenominator>
+    void fillVertexBuffers(benchmark::State& state)
+    {
+        TestStorage storage;
+        const float size = static_cast<float>(chunkSizeNumerator) / chunkSizeDenominator;
+        osg::ref_ptr<osg::Vec3Array> positions(new osg::Vec3Array);
+        osg::ref_ptr<osg::Vec3Array> normals(new osg::Vec3Array);
+        osg::ref_ptr<osg::Vec4ubArray> colours(new osg::Vec4ubArray);
+        std::size_t vertices = 0;
+
+        while (state.KeepRunning())
+        {
+            for (float x = 0; x < worldSize; x += size)
+            {
+                for (float y = 0; y < worldSize; y += size)
+                {
+                    const osg::Vec2f center(x + size / 2, y + size / 2);
+                    storage.fillVertexBuffers(lodLevel, size, center, positions, normals, colours);
+                    benchmark::DoNotOptimize(positions->data());
+                    benchmark::DoNotOptimize(normals->data());
+                    benchmark::DoNotOptimize(colours->data());
+                    vertices += positions->size();
+                }
+            }
+        }
+
+        state.SetItemsProcessed(static_cast<std::int64_t>(vertices));
+    }
+
+    void fillVertexBuffersLod0Chunk1(benchmark::State& state)
+    {
+        fillVertexBuffers<0, 1, 1>(state);
+    }
+
+    void fillVertexBuffersLod0Chunk1of4(benchmark::State& state)
+    {
+        fillVertexBuffers<0, 1, 4>(state);
+    }
+
+    void fillVertexBuffersLod1Chunk1(benchmark::State& state)
+    {
+        fillVertexBuffers<1, 1, 1>(state);
+    }
+
+    void fillVertexBuffersLod2Chunk2(benchmark::State& state)
+    {
+        fillVertexBuffers<2, 2, 1>(state);
+    }
+
+    void fillVertexBuffersLod3Chunk4(benchmark::State& state)
+    {
+        fillVertexBuffers<3, 4, 1>(state);
+    }
+
+    void fillVertexBuffersLod5Chunk4(benchmark::State& state)
+    {
+        fillVertexBuffers<5, 4, 1>(state);
+    }
+}
+
+BENCHMARK(fillVertexBuffersLod0Chunk1);
+BENCHMARK(fillVertexBuffersLod0Chunk1of4);
+BENCHMARK(fillVertexBuffersLod1Chunk1);
+BENCHMARK(fillVertexBuffersLod2Chunk2);
+BENCHMARK(fillVertexBuffersLod3Chunk4);
+BENCHMARK(fillVertexBuffersLod5Chunk4);
+
+BENCHMARK_MAIN();
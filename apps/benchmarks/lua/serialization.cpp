@@ -0,0 +1,131 @@
+#include <benchmark/benchmark.h>
+
+#include <components/lua/serialization.hpp>
+
+#include <osg/Vec3f>
+
+#include <string>
+
+namespace
+{
+    // Typical event payload: a list of records with the same set of keys.
+    sol::table makeEventData(sol::state& lua, int itemsCount)
+    {
+        sol::table result(lua, sol::create);
+        for (int i = 1; i <= itemsCount; ++i)
+        {
+            sol::table item(lua, sol::create);
+            item["recordId"] = "record_" + std::to_string(i);
+            item["position"] = osg::Vec3f(i, 2 * i, 3 * i);
+            item["count"] = i;
+            item["enabled"] = i % 2 == 0;
+            result[i] = item;
+        }
+        return result;
+    }
+
+    template <int itemsCount>
+    void serializeEvent(benchmark::State& state)
+    {
+        sol::state lua;
+        const sol::object data = makeEventData(lua, itemsCount);
+
+        while (state.KeepRunning())
+        {
+            const LuaUtil::BinaryData result = LuaUtil::serialize(data);
+            benchmark::DoNotOptimize(result);
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    template <int itemsCount>
+    void serializeEventToPooledBuffer(benchmark::State& state)
+    {
+        sol::state lua;
+        const sol::object data = makeEventData(lua, itemsCount);
+        LuaUtil::BinaryDataPool pool;
+
+        while (state.KeepRunning())
+        {
+            LuaUtil::BinaryData result = pool.acquire();
+            LuaUtil::serialize(result, data);
+            benchmark::DoNotOptimize(result);
+            pool.release(std::move(result));
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    template <int itemsCount>
+    void deserializeEvent(benchmark::State& state)
+    {
+        sol::state lua;
+        const LuaUtil::BinaryData data = LuaUtil::serialize(makeEventData(lua, itemsCount));
+
+        while (state.KeepRunning())
+        {
+            const sol::object result = LuaUtil::deserialize(lua, data);
+            benchmark::DoNotOptimize(result);
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void serializeEvent_1(benchmark::State& state)
+    {
+        serializeEvent<1>(state);
+    }
+
+    void serializeEvent_16(benchmark::State& state)
+    {
+        serializeEvent<16>(state);
+    }
+
+    void serializeEvent_256(benchmark::State& state)
+    {
+        serializeEvent<256>(state);
+    }
+
+    void serializeEventToPooledBuffer_1(benchmark::State& state)
+    {
+        serializeEventToPooledBuffer<1>(state);
+    }
+
+    void serializeEventToPooledBuffer_16(benchmark::State& state)
+    {
+        serializeEventToPooledBuffer<16>(state);
+    }
+
+    void serializeEventToPooledBuffer_256(benchmark::State& state)
+    {
+        serializeEventToPooledBuffer<256>(state);
+    }
+
+    void deserializeEvent_1(benchmark::State& state)
+    {
+        deserializeEvent<1>(state);
+    }
+
+    void deserializeEvent_16(benchmark::State& state)
+    {
+        deserializeEvent<16>(state);
+    }
+
+    void deserializeEvent_256(benchmark::State& state)
+    {
+        deserializeEvent<256>(state);
+    }
+} // namespace
+
+BENCHMARK(serializeEvent_1);
+BENCHMARK(serializeEvent_16);
+BENCHMARK(serializeEvent_256);
+BENCHMARK(serializeEventToPooledBuffer_1);
+BENCHMARK(serializeEventToPooledBuffer_16);
+BENCHMARK(serializeEventToPooledBuffer_256);
+BENCHMARK(deserializeEvent_1);
+BENCHMARK(deserializeEvent_16);
+BENCHMARK(deserializeEvent_256);
+
+BENCHMARK_MAIN();
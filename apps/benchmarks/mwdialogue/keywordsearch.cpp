@@ -0,0 +1,110 @@
+#include <benchmark/benchmark.h>
+
+#include "apps/openmw/mwdialogue/keywordsearch.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using KeywordSearch = MWDialogue::KeywordSearch<std::string, int>;
+
+    std::string generateWord(std::minstd_rand& random)
+    {
+        static const std::vector<std::string> syllables = { "ald", "bal", "mor", "ven", "dra", "ith", "sey", "ul",
+            "gar", "ra", "thi", "mo", "vel", "nir", "ka", "dun", "an", "ro" };
+        std::uniform_int_distribution<std::size_t> syllableDistribution(0, syllables.size() - 1);
+        std::uniform_int_distribution<int> lengthDistribution(1, 4);
+        std::string result;
+        for (int i = lengthDistribution(random); i > 0; --i)
+            result += syllables[syllableDistribution(random)];
+        return result;
+    }
+
+    // Topics of one to three words like "latest rumors" or "mages guild"
+    std::vector<std::string> generateTopics(std::size_t count, std::minstd_rand& random)
+    {
+        std::uniform_int_distribution<int> wordsDistribution(1, 3);
+        std::set<std::string> result;
+        while (result.size() < count)
+        {
+            std::string topic = generateWord(random);
+            for (int i = wordsDistribution(random); i > 1; --i)
+                topic += " " + generateWord(random);
+            result.insert(std::move(topic));
+        }
+        return std::vector<std::string>(result.begin(), result.end());
+    }
+
+    // Dialogue response sized text with a topic every few words
+    std::string generateText(const std::vector<std::string>& topics, std::minstd_rand& random)
+    {
+        std::uniform_int_distribution<std::size_t> topicDistribution(0, topics.size() - 1);
+        std::uniform_int_distribution<int> kindDistribution(0, 7);
+        std::string result;
+        while (result.size() < 1024)
+        {
+            if (!result.empty())
+                result += kindDistribution(random) == 0 ? ". " : " ";
+            if (kindDistribution(random) == 0)
+                result += topics[topicDistribution(random)];
+            else
+                result += generateWord(random);
+        }
+        return result;
+    }
+
+    void highlightKeywords(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        const std::vector<std::string> topics = generateTopics(static_cast<std::size_t>(state.range(0)), random);
+        std::vector<std::string> texts;
+        for (int i = 0; i < 16; ++i)
+            texts.push_back(generateText(topics, random));
+
+        KeywordSearch search;
+        for (const std::string& topic : topics)
+            search.seed(topic, 0);
+
+        std::vector<KeywordSearch::Match> matches;
+        std::size_t bytes = 0;
+        std::size_t index = 0;
+        for (auto _ : state)
+        {
+            const std::string& text = texts[index++ % texts.size()];
+            matches.clear();
+            search.highlightKeywords(text.begin(), text.end(), matches);
+            benchmark::DoNotOptimize(matches.data());
+            bytes += text.size();
+        }
+
+        state.SetBytesProcessed(static_cast<std::int64_t>(bytes));
+    }
+
+    void seedKeywords(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        const std::vector<std::string> topics = generateTopics(static_cast<std::size_t>(state.range(0)), random);
+        const std::string text = generateText(topics, random);
+        std::vector<KeywordSearch::Match> matches;
+
+        for (auto _ : state)
+        {
+            KeywordSearch search;
+            for (const std::string& topic : topics)
+                search.seed(topic, 0);
+            matches.clear();
+            search.highlightKeywords(text.begin(), text.end(), matches);
+            benchmark::DoNotOptimize(matches.data());
+        }
+    }
+}
+
+BENCHMARK(highlightKeywords)->Arg(100)->Arg(1000)->Arg(10000)->Arg(50000);
+BENCHMARK(seedKeywords)->Arg(1000)->Arg(10000);
+
+BENCHMARK_MAIN();
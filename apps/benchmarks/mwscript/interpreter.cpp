@@ -0,0 +1,203 @@
+#include <benchmark/benchmark.h>
+
+#include <components/compiler/context.hpp>
+#include <components/compiler/fileparser.hpp>
+#include <components/compiler/scanner.hpp>
+#include <components/compiler/streamerrorhandler.hpp>
+#include <components/interpreter/context.hpp>
+#include <components/interpreter/installopcodes.hpp>
+#include <components/interpreter/interpreter.hpp>
+#include <components/interpreter/program.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Typical local scripts: timers with state machines, loops, arithmetic and DoOnce blocks
+    const std::vector<std::string> scripts = {
+        R"mwscript(Begin bench_timer
+float timer
+short state
+set timer to ( timer + 0.016 )
+if ( timer > 5 )
+    set timer to 0
+    if ( state == 0 )
+        set state to 1
+    elseif ( state == 1 )
+        set state to 2
+    else
+        set state to 0
+    endif
+endif
+End)mwscript",
+        R"mwscript(Begin bench_loop
+short i
+long sum
+set i to 0
+set sum to 0
+while ( i < 20 )
+    set sum to ( sum + i * i )
+    set i to ( i + 1 )
+endwhile
+End)mwscript",
+        R"mwscript(Begin bench_math
+short a
+short b
+short c
+float d
+set a to ( a + 1 )
+set b to ( a * 3 - 7 )
+set c to ( ( a + b ) / 2 )
+set d to ( a * 0.5 + b * 0.25 - c )
+if ( a > 1000 )
+    set a to 0
+endif
+End)mwscript",
+        R"mwscript(Begin bench_doonce
+short done
+if ( done == 1 )
+    return
+endif
+set done to 1
+End)mwscript",
+    };
+
+    class CompilerContext final : public Compiler::Context
+    {
+    public:
+        bool canDeclareLocals() const override { return true; }
+        char getGlobalType(const std::string& /*name*/) const override { return ' '; }
+        std::pair<char, bool> getMemberType(const std::string& /*name*/, const std::string& /*id*/) const override
+        {
+            return { ' ', false };
+        }
+        bool isId(const std::string& /*name*/) const override { return false; }
+    };
+
+    class InterpreterContext final : public Interpreter::Context
+    {
+    public:
+        std::vector<int> mShorts = std::vector<int>(8);
+        std::vector<int> mLongs = std::vector<int>(8);
+        std::vector<float> mFloats = std::vector<float>(8);
+
+        std::string_view getTarget() const override { return {}; }
+        int getLocalShort(int index) const override { return mShorts[index]; }
+        int getLocalLong(int index) const override { return mLongs[index]; }
+        float getLocalFloat(int index) const override { return mFloats[index]; }
+        void setLocalShort(int index, int value) override { mShorts[index] = value; }
+        void setLocalLong(int index, int value) override { mLongs[index] = value; }
+        void setLocalFloat(int index, float value) override { mFloats[index] = value; }
+        void messageBox(std::string_view /*message*/, const std::vector<std::string>& /*buttons*/) override {}
+        void report(const std::string& /*message*/) override {}
+        int getGlobalShort(std::string_view /*name*/) const override { return {}; }
+        int getGlobalLong(std::string_view /*name*/) const override { return {}; }
+        float getGlobalFloat(std::string_view /*name*/) const override { return {}; }
+        void setGlobalShort(std::string_view /*name*/, int /*value*/) override {}
+        void setGlobalLong(std::string_view /*name*/, int /*value*/) override {}
+        void setGlobalFloat(std::string_view /*name*/, float /*value*/) override {}
+        std::vector<std::string> getGlobals() const override { return {}; }
+        char getGlobalType(std::string_view /*name*/) const override { return ' '; }
+        std::string getActionBinding(std::string_view /*action*/) const override { return {}; }
+        std::string_view getActorName() const override { return {}; }
+        std::string_view getNPCRace() const override { return {}; }
+        std::string_view getNPCClass() const override { return {}; }
+        std::string_view getNPCFaction() const override { return {}; }
+        std::string_view getNPCRank() const override { return {}; }
+        std::string_view getPCName() const override { return {}; }
+        std::string_view getPCRace() const override { return {}; }
+        std::string_view getPCClass() const override { return {}; }
+        std::string_view getPCRank() const override { return {}; }
+        std::string_view getPCNextRank() const override { return {}; }
+        int getPCBounty() const override { return {}; }
+        std::string_view getCurrentCellName() const override { return {}; }
+        int getMemberShort(std::string_view /*id*/, std::string_view /*name*/, bool /*global*/) const override
+        {
+            return {};
+        }
+        int getMemberLong(std::string_view /*id*/, std::string_view /*name*/, bool /*global*/) const override
+        {
+            return {};
+        }
+        float getMemberFloat(std::string_view /*id*/, std::string_view /*name*/, bool /*global*/) const override
+        {
+            return {};
+        }
+        void setMemberShort(std::string_view /*id*/, std::string_view /*name*/, int /*value*/, bool /*global*/) override
+        {
+        }
+        void setMemberLong(std::string_view /*id*/, std::string_view /*name*/, int /*value*/, bool /*global*/) override
+        {
+        }
+        void setMemberFloat(
+            std::string_view /*id*/, std::string_view /*name*/, float /*value*/, bool /*global*/) override
+        {
+        }
+    };
+
+    std::vector<std::vector<Interpreter::Type_Code>> compileScripts()
+    {
+        Compiler::StreamErrorHandler errorHandler;
+        CompilerContext context;
+        Compiler::FileParser parser(errorHandler, context);
+        std::vector<std::vector<Interpreter::Type_Code>> result;
+        for (const std::string& script : scripts)
+        {
+            parser.reset();
+            errorHandler.reset();
+            std::istringstream input(script);
+            Compiler::Scanner scanner(errorHandler, input, context.getExtensions());
+            scanner.scan(parser);
+            if (!errorHandler.isGood())
+                throw std::runtime_error("Failed to compile benchmark script");
+            parser.getCode(result.emplace_back());
+        }
+        return result;
+    }
+
+    // Runs every script of the corpus for state.range(0) actors each with its own locals. Byte code is interpreted
+    // directly when state.range(1) is 0 and decoded once before the loop otherwise.
+    void runScripts(benchmark::State& state)
+    {
+        const std::size_t actorsCount = static_cast<std::size_t>(state.range(0));
+        const bool decoded = state.range(1) != 0;
+
+        Interpreter::Interpreter interpreter;
+        Interpreter::installOpcodes(interpreter);
+
+        const std::vector<std::vector<Interpreter::Type_Code>> code = compileScripts();
+        std::vector<Interpreter::Program> programs;
+        for (const std::vector<Interpreter::Type_Code>& v : code)
+            programs.push_back(interpreter.decode(v.data(), static_cast<int>(v.size())));
+
+        std::vector<InterpreterContext> contexts(actorsCount * code.size());
+
+        for (auto _ : state)
+        {
+            for (std::size_t i = 0; i < actorsCount; ++i)
+            {
+                for (std::size_t j = 0; j < code.size(); ++j)
+                {
+                    InterpreterContext& context = contexts[i * code.size() + j];
+                    const int codeSize = static_cast<int>(code[j].size());
+                    if (decoded)
+                        interpreter.run(programs[j], code[j].data(), codeSize, context);
+                    else
+                        interpreter.run(code[j].data(), codeSize, context);
+                }
+            }
+            benchmark::DoNotOptimize(contexts.front().mShorts.front());
+        }
+
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * contexts.size()));
+    }
+}
+
+BENCHMARK(runScripts)->ArgsProduct({ { 100, 1000 }, { 0, 1 } });
+
+BENCHMARK_MAIN();
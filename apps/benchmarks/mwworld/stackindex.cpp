@@ -0,0 +1,146 @@
+#include <benchmark/benchmark.h>
+
+#include "apps/openmw/mwworld/stackindex.hpp"
+
+#include <components/misc/strings/algorithm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <list>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    // Simplified container item: stacks when ids match case insensitively and the condition is the same
+    struct Item
+    {
+        std::string mId;
+        int mCondition;
+        int mCount;
+    };
+
+    using Items = std::list<Item>;
+
+    bool stacks(const Item& left, const Item& right)
+    {
+        return Misc::StringUtils::ciEqual(left.mId, right.mId) && left.mCondition == right.mCondition;
+    }
+
+    // Merchant like inventory: many distinct ids, some of them with several differently worn stacks
+    std::vector<Item> generateItems(std::size_t count)
+    {
+        std::minstd_rand random;
+        std::uniform_int_distribution<std::size_t> idDistribution(0, count / 4);
+        std::uniform_int_distribution<int> conditionDistribution(0, 3);
+        std::vector<Item> result;
+        result.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            std::string id = "item_" + std::to_string(idDistribution(random));
+            result.push_back(Item{ std::move(id), conditionDistribution(random), 1 });
+        }
+        return result;
+    }
+
+    // Same search as ContainerStore did: visit every item in the container
+    struct LinearContainer
+    {
+        Items mItems;
+
+        void add(const Item& item)
+        {
+            for (Item& v : mItems)
+            {
+                if (v.mCount != 0 && stacks(v, item))
+                {
+                    v.mCount += item.mCount;
+                    return;
+                }
+            }
+            mItems.push_back(item);
+        }
+
+        void remove(const Item& item)
+        {
+            for (Item& v : mItems)
+            {
+                if (v.mCount != 0 && stacks(v, item))
+                {
+                    --v.mCount;
+                    return;
+                }
+            }
+        }
+    };
+
+    // Visit only stacks with the same id
+    struct IndexedContainer
+    {
+        Items mItems;
+        MWWorld::StackIndex<Items::iterator> mIndex;
+
+        void add(const Item& item)
+        {
+            for (const Items::iterator& v : mIndex.get(item.mId))
+            {
+                if (v->mCount != 0 && stacks(*v, item))
+                {
+                    v->mCount += item.mCount;
+                    return;
+                }
+            }
+            mItems.push_back(item);
+            mIndex.add(item.mId, std::prev(mItems.end()));
+        }
+
+        void remove(const Item& item)
+        {
+            for (const Items::iterator& v : mIndex.get(item.mId))
+            {
+                if (v->mCount != 0 && stacks(*v, item))
+                {
+                    --v->mCount;
+                    return;
+                }
+            }
+        }
+    };
+
+    // Adds state.range(0) items one by one and then removes them all
+    template <class Container>
+    void addAndRemoveItems(benchmark::State& state)
+    {
+        const std::vector<Item> items = generateItems(static_cast<std::size_t>(state.range(0)));
+
+        for (auto _ : state)
+        {
+            Container container;
+            for (const Item& item : items)
+                container.add(item);
+            for (const Item& item : items)
+                container.remove(item);
+            benchmark::DoNotOptimize(container.mItems.size());
+        }
+
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * items.size() * 2));
+    }
+
+    void addAndRemoveItemsLinear(benchmark::State& state)
+    {
+        addAndRemoveItems<LinearContainer>(state);
+    }
+
+    void addAndRemoveItemsIndexed(benchmark::State& state)
+    {
+        addAndRemoveItems<IndexedContainer>(state);
+    }
+}
+
+BENCHMARK(addAndRemoveItemsLinear)->Arg(1000)->Arg(10000);
+BENCHMARK(addAndRemoveItemsIndexed)->Arg(1000)->Arg(10000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,131 @@
+#include <benchmark/benchmark.h>
+
+#include <components/nif/controller.hpp>
+#include <components/nif/data.hpp>
+#include <components/nifosg/controller.hpp>
+#include <components/nifosg/matrixtransform.hpp>
+#include <components/sceneutil/controller.hpp>
+
+#include <osg/NodeVisitor>
+#include <osg/ref_ptr>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+    // Typical animation group has tens of keys per bone, full animation file has hundreds
+    constexpr float keysPerSecond = 15;
+
+    class TimeSource final : public SceneUtil::ControllerSource
+    {
+    public:
+        float mTime = 0;
+
+        float getValue(osg::NodeVisitor* /*nv*/) override { return mTime; }
+    };
+
+    Nif::NiKeyframeData makeKeyframeData(std::size_t keysCount)
+    {
+        std::minstd_rand random;
+        std::uniform_real_distribution<float> distribution(-1, 1);
+        Nif::NiKeyframeData result;
+        result.mRotations = std::make_shared<Nif::QuaternionKeyMap>();
+        result.mRotations->mInterpolationType = Nif::InterpolationType_Linear;
+        result.mTranslations = std::make_shared<Nif::Vector3KeyMap>();
+        result.mTranslations->mInterpolationType = Nif::InterpolationType_Linear;
+        result.mScales = std::make_shared<Nif::FloatKeyMap>();
+        result.mScales->mInterpolationType = Nif::InterpolationType_Linear;
+        for (std::size_t i = 0; i < keysCount; ++i)
+        {
+            const float time = static_cast<float>(i) / keysPerSecond;
+            osg::Quat rotation(distribution(random), distribution(random), distribution(random), 1);
+            rotation /= rotation.length();
+            result.mRotations->mTimes.push_back(time);
+            result.mRotations->mKeys.push_back(Nif::QuaternionKey{ rotation, {}, {} });
+            const osg::Vec3f translation(distribution(random), distribution(random), distribution(random));
+            result.mTranslations->mTimes.push_back(time);
+            result.mTranslations->mKeys.push_back(Nif::Vector3Key{ translation, {}, {} });
+            result.mScales->mTimes.push_back(time);
+            result.mScales->mKeys.push_back(Nif::FloatKey{ 1 + distribution(random) / 10, 0, 0 });
+        }
+        return result;
+    }
+
+    struct Actor
+    {
+        osg::ref_ptr<NifOsg::KeyframeController> mController;
+        osg::ref_ptr<NifOsg::MatrixTransform> mNode;
+        std::shared_ptr<TimeSource> mSource;
+    };
+
+    // Evaluates keyframe controllers of a crowd: state.range(0) actors with state.range(1) bones each sharing tracks
+    // of state.range(2) keys. Time moves forward each frame when state.range(3) is 0 and jumps randomly otherwise.
+    void evaluateKeyframeControllers(benchmark::State& state)
+    {
+        const std::size_t actorsCount = static_cast<std::size_t>(state.range(0));
+        const std::size_t bonesCount = static_cast<std::size_t>(state.range(1));
+        const std::size_t keysCount = static_cast<std::size_t>(state.range(2));
+        const bool randomTime = state.range(3) != 0;
+        const float duration = static_cast<float>(keysCount) / keysPerSecond;
+
+        std::vector<Nif::NiKeyframeData> data;
+        std::vector<Nif::NiKeyframeController> records(bonesCount);
+        std::vector<osg::ref_ptr<NifOsg::KeyframeController>> prototypes;
+        data.reserve(bonesCount);
+        for (std::size_t i = 0; i < bonesCount; ++i)
+        {
+            data.push_back(makeKeyframeData(keysCount));
+            records[i].mInterpolator = Nif::NiInterpolatorPtr(nullptr);
+            records[i].mData = Nif::NiKeyframeDataPtr(&data[i]);
+            prototypes.push_back(new NifOsg::KeyframeController(&records[i]));
+        }
+
+        std::minstd_rand random;
+        std::uniform_real_distribution<float> timeDistribution(0, duration);
+        std::vector<Actor> actors;
+        actors.reserve(actorsCount * bonesCount);
+        for (std::size_t i = 0; i < actorsCount; ++i)
+        {
+            const auto source = std::make_shared<TimeSource>();
+            source->mTime = timeDistribution(random);
+            // Each actor has its own copy of controllers like an instanced animation does
+            for (const osg::ref_ptr<NifOsg::KeyframeController>& prototype : prototypes)
+            {
+                Actor& actor = actors.emplace_back();
+                actor.mController = new NifOsg::KeyframeController(*prototype, osg::CopyOp::SHALLOW_COPY);
+                actor.mController->setSource(source);
+                actor.mNode = new NifOsg::MatrixTransform;
+                actor.mSource = source;
+            }
+        }
+
+        osg::NodeVisitor visitor(osg::NodeVisitor::TRAVERSE_NONE);
+        constexpr float frameDuration = 1.0f / 60;
+
+        for (auto _ : state)
+        {
+            for (std::size_t i = 0; i < actors.size(); i += bonesCount)
+            {
+                TimeSource& source = *actors[i].mSource;
+                if (randomTime)
+                    source.mTime = timeDistribution(random);
+                else
+                    source.mTime = std::fmod(source.mTime + frameDuration, duration);
+            }
+            for (Actor& actor : actors)
+                (*actor.mController)(actor.mNode.get(), &visitor);
+            benchmark::DoNotOptimize(actors.front().mNode->getMatrix());
+        }
+
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * actors.size()));
+    }
+}
+
+BENCHMARK(evaluateKeyframeControllers)->ArgsProduct({ { 100, 500 }, { 30 }, { 16, 128, 1024 }, { 0, 1 } });
+
+BENCHMARK_MAIN();
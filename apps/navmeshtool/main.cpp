@@ -122,6 +122,9 @@ namespace NavMeshTool
             addOption("remove-unused-tiles", bpo::value<bool>()->implicit_value(true)->default_value(false),
                 "remove tiles from cache that will not be used with current content profile");
 
+            addOption("incremental", bpo::value<bool>()->implicit_value(true)->default_value(false),
+                "skip generation of tiles which input is not changed since the previous run");
+
             addOption("write-binary-log", bpo::value<bool>()->implicit_value(true)->default_value(false),
                 "write progress in binary messages to be consumed by the launcher");
 
@@ -184,6 +187,7 @@ namespace NavMeshTool
 
             const bool processInteriorCells = variables["process-interior-cells"].as<bool>();
             const bool removeUnusedTiles = variables["remove-unused-tiles"].as<bool>();
+            const bool incremental = variables["incremental"].as<bool>();
             const bool writeBinaryLog = variables["write-binary-log"].as<bool>();
 
 #ifdef WIN32
@@ -235,7 +239,7 @@ namespace NavMeshTool
                 navigatorSettings, readers, vfs, bulletShapeManager, esmData, processInteriorCells, writeBinaryLog);
 
             const Status status = generateAllNavMeshTiles(agentBounds, navigatorSettings, threadsNumber,
-                removeUnusedTiles, writeBinaryLog, cellsData, std::move(db));
+                removeUnusedTiles, incremental, writeBinaryLog, cellsData, std::move(db));
 
             switch (status)
             {
@@ -8,6 +8,7 @@
 #include <components/detournavigator/gettilespositions.hpp>
 #include <components/detournavigator/navmeshdb.hpp>
 #include <components/detournavigator/navmeshdbutils.hpp>
+#include <components/detournavigator/navmeshdbwriter.hpp>
 #include <components/detournavigator/preparednavmeshdata.hpp>
 #include <components/detournavigator/recastmesh.hpp>
 #include <components/detournavigator/recastmeshprovider.hpp>
@@ -17,15 +18,24 @@
 #include <components/misc/progressreporter.hpp>
 #include <components/navmeshtool/protocol.hpp>
 #include <components/sceneutil/workqueue.hpp>
-#include <components/sqlite3/transaction.hpp>
+#include <components/sqlite3/types.hpp>
 
 #include <osg/Vec3f>
 
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <random>
+#include <set>
+#include <string>
 #include <string_view>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -37,16 +47,28 @@ namespace NavMeshTool
         using DetourNavigator::GenerateNavMeshTile;
         using DetourNavigator::MeshSource;
         using DetourNavigator::NavMeshDb;
+        using DetourNavigator::NavMeshDbReader;
+        using DetourNavigator::NavMeshDbWriter;
         using DetourNavigator::NavMeshTileInfo;
         using DetourNavigator::PreparedNavMeshData;
         using DetourNavigator::RecastMeshProvider;
         using DetourNavigator::Settings;
         using DetourNavigator::ShapeId;
+        using DetourNavigator::ShapeType;
         using DetourNavigator::TileId;
+        using DetourNavigator::TileInputDigest;
         using DetourNavigator::TilePosition;
         using DetourNavigator::TilesPositionsRange;
         using DetourNavigator::TileVersion;
-        using Sqlite3::Transaction;
+
+        using TileInputDigests = std::map<TilePosition, std::int64_t>;
+        using WorldspaceTileInputDigests = std::map<std::string, TileInputDigests, std::less<>>;
+
+        // Tiles are written by large transactions to reduce the number of fsyncs
+        constexpr std::size_t dbWriteBatchSize = 1000;
+        constexpr std::chrono::seconds dbWriteBatchDelay(1);
+        // Checkpoint less often than by default (1000 pages) to move writes to the database file in bigger chunks
+        constexpr int walAutoCheckpointPages = 16384;
 
         void logGeneratedTiles(std::size_t provided, std::size_t expected)
         {
@@ -78,13 +100,16 @@ namespace NavMeshTool
         public:
             std::atomic_size_t mExpected{ 0 };
 
-            explicit NavMeshTileConsumer(NavMeshDb&& db, bool removeUnusedTiles, bool writeBinaryLog)
-                : mDb(std::move(db))
-                , mRemoveUnusedTiles(removeUnusedTiles)
+            explicit NavMeshTileConsumer(NavMeshDb&& db, bool removeUnusedTiles, bool writeBinaryLog,
+                WorldspaceTileInputDigests&& tileInputDigests)
+                : mRemoveUnusedTiles(removeUnusedTiles)
                 , mWriteBinaryLog(writeBinaryLog)
-                , mTransaction(mDb.startTransaction(Sqlite3::TransactionMode::Immediate))
-                , mNextTileId(mDb.getMaxTileId() + 1)
-                , mNextShapeId(mDb.getMaxShapeId() + 1)
+                , mTileInputDigests(std::move(tileInputDigests))
+                , mDbPath(db.getPath())
+                , mNextTileId(db.getMaxTileId() + 1)
+                , mNextShapeId(db.getMaxShapeId() + 1)
+                , mWriter(std::move(db), dbWriteBatchSize, dbWriteBatchDelay,
+                      [this](const std::exception& e) { cancel(e.what()); })
             {
             }
 
@@ -94,24 +119,51 @@ namespace NavMeshTool
 
             std::size_t getUpdated() const { return mUpdated.load(); }
 
-            std::size_t getDeleted() const
-            {
-                const std::lock_guard lock(mMutex);
-                return mDeleted;
-            }
+            std::size_t getDeleted() const { return mDeleted.load(); }
+
+            std::size_t getReused() const { return mReused.load(); }
+
+            std::size_t getTransactionsCount() const { return mWriter.getTransactionsCount(); }
 
             std::int64_t resolveMeshSource(const MeshSource& source) override
             {
-                const std::lock_guard lock(mMutex);
-                return DetourNavigator::resolveMeshSource(mDb, source, mNextShapeId);
+                const std::optional<ShapeType> type = DetourNavigator::getShapeType(source.mAreaType);
+                if (!type.has_value())
+                {
+                    Log(Debug::Warning) << "Trying to resolve recast mesh source with unsupported area type: "
+                                        << source.mAreaType;
+                    return 0;
+                }
+                const std::lock_guard lock(mShapesMutex);
+                auto key = std::make_tuple(source.mShape->mFileName, *type, source.mShape->mFileHash);
+                if (const auto it = mShapeIds.find(key); it != mShapeIds.end())
+                    return static_cast<std::int64_t>(it->second);
+                const std::string& hash = std::get<2>(key);
+                const Sqlite3::ConstBlob hashData{ hash.data(), static_cast<int>(hash.size()) };
+                std::optional<ShapeId> shapeId = withReader(
+                    [&](NavMeshDbReader& reader) { return reader.findShapeId(std::get<0>(key), *type, hashData); });
+                if (!shapeId.has_value())
+                {
+                    shapeId = mNextShapeId;
+                    ++mNextShapeId;
+                    mWriter.enqueue([newShapeId = *shapeId, key](NavMeshDb& db) {
+                        const auto& [name, shapeType, shapeHash] = key;
+                        const Sqlite3::ConstBlob data{ shapeHash.data(), static_cast<int>(shapeHash.size()) };
+                        db.insertShape(newShapeId, name, shapeType, data);
+                    });
+                }
+                mShapeIds.emplace(std::move(key), *shapeId);
+                return static_cast<std::int64_t>(*shapeId);
             }
 
             std::optional<NavMeshTileInfo> find(std::string_view worldspace, const TilePosition& tilePosition,
                 const std::vector<std::byte>& input) override
             {
+                // Each tile is processed once so uncommitted changes don't affect the result
                 std::optional<NavMeshTileInfo> result;
-                std::lock_guard lock(mMutex);
-                if (const auto tile = mDb.findTile(worldspace, tilePosition, input))
+                const auto tile = withReader(
+                    [&](NavMeshDbReader& reader) { return reader.findTile(worldspace, tilePosition, input); });
+                if (tile.has_value())
                 {
                     NavMeshTileInfo info;
                     info.mTileId = tile->mTileId;
@@ -123,37 +175,44 @@ namespace NavMeshTool
 
             void ignore(std::string_view worldspace, const TilePosition& tilePosition) override
             {
-                if (mRemoveUnusedTiles)
-                {
-                    std::lock_guard lock(mMutex);
-                    mDeleted += static_cast<std::size_t>(mDb.deleteTilesAt(worldspace, tilePosition));
-                }
+                mWriter.enqueue([this, worldspace = std::string(worldspace), tilePosition](NavMeshDb& db) {
+                    if (mRemoveUnusedTiles)
+                        mDeleted += static_cast<std::size_t>(db.deleteTilesAt(worldspace, tilePosition));
+                    writeTileInputDigest(db, worldspace, tilePosition);
+                });
                 report();
             }
 
             void identity(std::string_view worldspace, const TilePosition& tilePosition, std::int64_t tileId) override
             {
-                if (mRemoveUnusedTiles)
-                {
-                    std::lock_guard lock(mMutex);
-                    mDeleted += static_cast<std::size_t>(
-                        mDb.deleteTilesAtExcept(worldspace, tilePosition, TileId{ tileId }));
-                }
+                mWriter.enqueue([this, worldspace = std::string(worldspace), tilePosition, tileId](NavMeshDb& db) {
+                    if (mRemoveUnusedTiles)
+                        mDeleted += static_cast<std::size_t>(
+                            db.deleteTilesAtExcept(worldspace, tilePosition, TileId{ tileId }));
+                    writeTileInputDigest(db, worldspace, tilePosition);
+                });
+                report();
+            }
+
+            // Tile generated by previous run from the same input is left as is
+            void reuse()
+            {
+                ++mReused;
                 report();
             }
 
             void insert(std::string_view worldspace, const TilePosition& tilePosition, std::int64_t version,
                 const std::vector<std::byte>& input, PreparedNavMeshData& data) override
             {
-                {
-                    std::lock_guard lock(mMutex);
+                const TileId tileId{ mNextTileId.fetch_add(1) };
+                data.mUserId = static_cast<unsigned>(tileId);
+                mWriter.enqueue([this, tileId, worldspace = std::string(worldspace), tilePosition, version, input,
+                                    serialized = serialize(data)](NavMeshDb& db) {
                     if (mRemoveUnusedTiles)
-                        mDeleted += static_cast<std::size_t>(mDb.deleteTilesAt(worldspace, tilePosition));
-                    data.mUserId = static_cast<unsigned>(mNextTileId);
-                    mDb.insertTile(
-                        mNextTileId, worldspace, tilePosition, TileVersion{ version }, input, serialize(data));
-                    ++mNextTileId;
-                }
+                        mDeleted += static_cast<std::size_t>(db.deleteTilesAt(worldspace, tilePosition));
+                    db.insertTile(tileId, worldspace, tilePosition, TileVersion{ version }, input, serialized);
+                    writeTileInputDigest(db, worldspace, tilePosition);
+                });
                 ++mInserted;
                 report();
             }
@@ -162,13 +221,14 @@ namespace NavMeshTool
                 std::int64_t version, PreparedNavMeshData& data) override
             {
                 data.mUserId = static_cast<unsigned>(tileId);
-                {
-                    std::lock_guard lock(mMutex);
+                mWriter.enqueue([this, worldspace = std::string(worldspace), tilePosition, tileId, version,
+                                    serialized = serialize(data)](NavMeshDb& db) {
                     if (mRemoveUnusedTiles)
                         mDeleted += static_cast<std::size_t>(
-                            mDb.deleteTilesAtExcept(worldspace, tilePosition, TileId{ tileId }));
-                    mDb.updateTile(TileId{ tileId }, TileVersion{ version }, serialize(data));
-                }
+                            db.deleteTilesAtExcept(worldspace, tilePosition, TileId{ tileId }));
+                    db.updateTile(TileId{ tileId }, TileVersion{ version }, serialized);
+                    writeTileInputDigest(db, worldspace, tilePosition);
+                });
                 ++mUpdated;
                 report();
             }
@@ -185,67 +245,124 @@ namespace NavMeshTool
 
             Status wait()
             {
-                constexpr std::chrono::seconds transactionInterval(1);
                 std::unique_lock lock(mMutex);
-                auto start = std::chrono::steady_clock::now();
-                while (mProvided < mExpected && mStatus == Status::Ok)
-                {
-                    mHasTile.wait(lock);
-                    const auto now = std::chrono::steady_clock::now();
-                    if (now - start > transactionInterval)
-                    {
-                        mTransaction.commit();
-                        mTransaction = mDb.startTransaction(Sqlite3::TransactionMode::Immediate);
-                        start = now;
-                    }
-                }
+                mHasTile.wait(lock, [&] { return mProvided >= mExpected || mStatus != Status::Ok; });
                 logGeneratedTiles(mProvided, mExpected);
                 if (mWriteBinaryLog)
                     logGeneratedTilesMessage(mProvided);
                 return mStatus;
             }
 
-            void commit()
+            void commit() { mWriter.flush(); }
+
+            void discard() { mWriter.discard(); }
+
+            // Commits all changes, closes readers and switches the database back to a single file.
+            void finish(bool vacuum)
             {
-                const std::lock_guard lock(mMutex);
-                mTransaction.commit();
+                mWriter.stop();
+                {
+                    const std::lock_guard lock(mReadersMutex);
+                    mReaders.clear();
+                }
+                NavMeshDb& db = mWriter.getDb();
+                if (vacuum)
+                {
+                    Log(Debug::Info) << "Vacuuming the database...";
+                    db.vacuum();
+                }
+                try
+                {
+                    db.disableWriteAheadLog();
+                }
+                catch (const std::exception& e)
+                {
+                    Log(Debug::Warning) << "Failed to disable write-ahead log for navmeshdb: " << e.what();
+                }
             }
 
-            void vacuum()
+            void removeTilesOutsideRange(std::string_view worldspace, const TilesPositionsRange& range)
             {
-                const std::lock_guard lock(mMutex);
-                mDb.vacuum();
+                mWriter.enqueue([this, worldspace = std::string(worldspace), range](NavMeshDb& db) {
+                    Log(Debug::Info) << "Removing tiles outside processed range for worldspace \"" << worldspace
+                                     << "\"...";
+                    mDeleted += static_cast<std::size_t>(db.deleteTilesOutsideRange(worldspace, range));
+                    db.deleteTileInputDigestsOutsideRange(worldspace, range);
+                });
             }
 
-            void removeTilesOutsideRange(std::string_view worldspace, const TilesPositionsRange& range)
+            std::optional<std::int64_t> findTileInputDigest(
+                std::string_view worldspace, const TilePosition& tilePosition) const
             {
-                const std::lock_guard lock(mMutex);
-                mTransaction.commit();
-                Log(Debug::Info) << "Removing tiles outside processed range for worldspace \"" << worldspace << "\"...";
-                mDeleted += static_cast<std::size_t>(mDb.deleteTilesOutsideRange(worldspace, range));
-                mTransaction = mDb.startTransaction(Sqlite3::TransactionMode::Immediate);
+                const auto worldspaceIt = mTileInputDigests.find(worldspace);
+                if (worldspaceIt == mTileInputDigests.end())
+                    return std::nullopt;
+                const auto it = worldspaceIt->second.find(tilePosition);
+                if (it == worldspaceIt->second.end())
+                    return std::nullopt;
+                return it->second;
             }
 
         private:
+            using ShapeKey = std::tuple<std::string, ShapeType, std::string>;
+
             std::atomic_size_t mProvided{ 0 };
             std::atomic_size_t mInserted{ 0 };
             std::atomic_size_t mUpdated{ 0 };
-            std::size_t mDeleted = 0;
+            std::atomic_size_t mDeleted{ 0 };
+            std::atomic_size_t mReused{ 0 };
             Status mStatus = Status::Ok;
             mutable std::mutex mMutex;
-            NavMeshDb mDb;
             const bool mRemoveUnusedTiles;
             const bool mWriteBinaryLog;
-            Transaction mTransaction;
-            TileId mNextTileId;
+            const WorldspaceTileInputDigests mTileInputDigests;
+            const std::string mDbPath;
+            std::atomic<std::int64_t> mNextTileId;
             std::condition_variable mHasTile;
             Misc::ProgressReporter<LogGeneratedTiles> mReporter;
+            std::mutex mShapesMutex;
             ShapeId mNextShapeId;
-            std::mutex mReportMutex;
+            std::map<ShapeKey, ShapeId> mShapeIds;
+            std::mutex mReadersMutex;
+            std::vector<std::unique_ptr<NavMeshDbReader>> mReaders;
+            NavMeshDbWriter mWriter;
+
+            // Each thread uses own read-only connection so lookups don't wait for each other and for the writer
+            template <class Function>
+            auto withReader(Function&& function)
+            {
+                std::unique_ptr<NavMeshDbReader> reader;
+                {
+                    const std::lock_guard lock(mReadersMutex);
+                    if (!mReaders.empty())
+                    {
+                        reader = std::move(mReaders.back());
+                        mReaders.pop_back();
+                    }
+                }
+                if (reader == nullptr)
+                    reader = std::make_unique<NavMeshDbReader>(mDbPath);
+                auto result = function(*reader);
+                const std::lock_guard lock(mReadersMutex);
+                mReaders.push_back(std::move(reader));
+                return result;
+            }
+
+            // Digest is written in the same transaction as the tile so it never refers to a tile that isn't stored
+            void writeTileInputDigest(NavMeshDb& db, std::string_view worldspace, const TilePosition& tilePosition)
+            {
+                if (const std::optional<std::int64_t> digest = findTileInputDigest(worldspace, tilePosition))
+                    db.setTileInputDigest(worldspace, tilePosition, *digest);
+            }
 
             void report()
             {
-                const std::size_t provided = mProvided.fetch_add(1, std::memory_order_relaxed) + 1;
+                std::size_t provided = 0;
+                {
+                    // Update under the lock to avoid missed wakeup of the waiting thread
+                    const std::lock_guard lock(mMutex);
+                    provided = ++mProvided;
+                }
                 mReporter(provided, mExpected);
                 mHasTile.notify_one();
                 if (mWriteBinaryLog)
@@ -255,21 +372,45 @@ namespace NavMeshTool
     }
 
     Status generateAllNavMeshTiles(const AgentBounds& agentBounds, const Settings& settings, std::size_t threadsNumber,
-        bool removeUnusedTiles, bool writeBinaryLog, WorldspaceData& data, NavMeshDb&& db)
+        bool removeUnusedTiles, bool incremental, bool writeBinaryLog, WorldspaceData& data, NavMeshDb&& db)
     {
         Log(Debug::Info) << "Generating navmesh tiles by " << threadsNumber << " parallel workers...";
 
-        SceneUtil::WorkQueue workQueue(threadsNumber);
-        auto navMeshTileConsumer
-            = std::make_shared<NavMeshTileConsumer>(std::move(db), removeUnusedTiles, writeBinaryLog);
-        std::size_t tiles = 0;
-        std::mt19937_64 random;
+        std::vector<TilesPositionsRange> ranges;
+        WorldspaceTileInputDigests tileInputDigests;
+        std::vector<std::set<TilePosition>> unchangedTiles;
 
         for (const std::unique_ptr<WorldspaceNavMeshInput>& input : data.mNavMeshInputs)
         {
             const auto range = DetourNavigator::makeTilesPositionsRange(Misc::Convert::toOsgXY(input->mAabb.m_min),
                 Misc::Convert::toOsgXY(input->mAabb.m_max), settings.mRecast);
 
+            ranges.push_back(range);
+            TileInputDigests current = makeTileInputDigests(*input, range, settings.mRecast, agentBounds);
+
+            TileInputDigests stored;
+            if (incremental)
+                for (const TileInputDigest& digest : db.getTileInputDigests(input->mWorldspace))
+                    stored.emplace(digest.mTilePosition, digest.mValue);
+
+            unchangedTiles.push_back(findUnchangedTiles(stored, current));
+            tileInputDigests.emplace(input->mWorldspace, std::move(current));
+        }
+
+        db.enableWriteAheadLog(walAutoCheckpointPages);
+
+        SceneUtil::WorkQueue workQueue(threadsNumber);
+        auto navMeshTileConsumer = std::make_shared<NavMeshTileConsumer>(
+            std::move(db), removeUnusedTiles, writeBinaryLog, std::move(tileInputDigests));
+        std::size_t tiles = 0;
+        std::mt19937_64 random;
+
+        for (std::size_t i = 0; i < data.mNavMeshInputs.size(); ++i)
+        {
+            const std::unique_ptr<WorldspaceNavMeshInput>& input = data.mNavMeshInputs[i];
+            const TilesPositionsRange& range = ranges[i];
+            const std::set<TilePosition>& worldspaceUnchangedTiles = unchangedTiles[i];
+
             if (removeUnusedTiles)
                 navMeshTileConsumer->removeTilesOutsideRange(input->mWorldspace, range);
 
@@ -288,27 +429,38 @@ namespace NavMeshTool
             std::shuffle(worldspaceTiles.begin(), worldspaceTiles.end(), random);
 
             for (const TilePosition& tilePosition : worldspaceTiles)
+            {
+                if (worldspaceUnchangedTiles.count(tilePosition) > 0)
+                {
+                    navMeshTileConsumer->reuse();
+                    continue;
+                }
                 workQueue.addWorkItem(new GenerateNavMeshTile(input->mWorldspace, tilePosition,
                     RecastMeshProvider(input->mTileCachedRecastMeshManager), agentBounds, settings,
                     navMeshTileConsumer));
+            }
         }
 
         const Status status = navMeshTileConsumer->wait();
         if (status == Status::Ok)
             navMeshTileConsumer->commit();
+        else
+            navMeshTileConsumer->discard();
 
+        const auto provided = navMeshTileConsumer->getProvided();
         const auto inserted = navMeshTileConsumer->getInserted();
         const auto updated = navMeshTileConsumer->getUpdated();
         const auto deleted = navMeshTileConsumer->getDeleted();
+        const auto reused = navMeshTileConsumer->getReused();
 
-        Log(Debug::Info) << "Generated navmesh for " << navMeshTileConsumer->getProvided() << " tiles, " << inserted
-                         << " are inserted, " << updated << " updated and " << deleted << " deleted";
+        Log(Debug::Info) << "Generated navmesh for " << provided << " tiles, " << inserted << " are inserted, "
+                         << updated << " updated and " << deleted << " deleted in "
+                         << navMeshTileConsumer->getTransactionsCount() << " transactions";
 
-        if (inserted + updated + deleted > 0)
-        {
-            Log(Debug::Info) << "Vacuuming the database...";
-            navMeshTileConsumer->vacuum();
-        }
+        Log(Debug::Info) << "Reused " << reused << " tiles with unchanged input and rebuilt " << (provided - reused)
+                         << " tiles";
+
+        navMeshTileConsumer->finish(inserted + updated + deleted > 0);
 
         return status;
     }
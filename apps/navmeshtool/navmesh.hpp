@@ -22,7 +22,7 @@ namespace NavMeshTool
     };
 
     Status generateAllNavMeshTiles(const DetourNavigator::AgentBounds& agentBounds,
-        const DetourNavigator::Settings& settings, std::size_t threadsNumber, bool removeUnusedTiles,
+        const DetourNavigator::Settings& settings, std::size_t threadsNumber, bool removeUnusedTiles, bool incremental,
         bool writeBinaryLog, WorldspaceData& cellsData, DetourNavigator::NavMeshDb&& db);
 }
 
@@ -3,9 +3,11 @@
 #include <components/bullethelpers/aabb.hpp>
 #include <components/debug/debugging.hpp>
 #include <components/debug/debuglog.hpp>
+#include <components/detournavigator/agentbounds.hpp>
 #include <components/detournavigator/gettilespositions.hpp>
 #include <components/detournavigator/objectid.hpp>
 #include <components/detournavigator/recastmesh.hpp>
+#include <components/detournavigator/serialization.hpp>
 #include <components/detournavigator/settings.hpp>
 #include <components/detournavigator/tilecachedrecastmeshmanager.hpp>
 #include <components/esm3/cellref.hpp>
@@ -23,18 +25,23 @@
 #include <components/settings/settings.hpp>
 #include <components/vfs/manager.hpp>
 
+#include <extern/smhasher/MurmurHash3.h>
+
 #include <LinearMath/btVector3.h>
 
 #include <osg/Vec2i>
 #include <osg/ref_ptr>
 
 #include <algorithm>
+#include <array>
 #include <memory>
 #include <stdexcept>
 #include <string>
 #include <string_view>
 #include <tuple>
+#include <type_traits>
 #include <utility>
+#include <variant>
 #include <vector>
 
 namespace NavMeshTool
@@ -47,6 +54,80 @@ namespace NavMeshTool
         using DetourNavigator::HeightfieldSurface;
         using DetourNavigator::ObjectId;
         using DetourNavigator::ObjectTransform;
+        using DetourNavigator::TilePosition;
+        using DetourNavigator::TilesPositionsRange;
+
+        // Change when the digest stops covering all the input of the recast mesh
+        constexpr std::uint32_t tileInputDigestVersion = 1;
+
+        class Digest
+        {
+        public:
+            template <class T>
+            void add(const T& value)
+            {
+                static_assert(std::is_trivially_copyable_v<T>);
+                addBytes(&value, sizeof(value));
+            }
+
+            void addString(std::string_view value)
+            {
+                add(value.size());
+                addBytes(value.data(), value.size());
+            }
+
+            void addBytes(const void* data, std::size_t size)
+            {
+                const char* const begin = static_cast<const char*>(data);
+                mData.insert(mData.end(), begin, begin + size);
+            }
+
+            std::uint64_t getValue() const
+            {
+                std::array<std::uint64_t, 2> seed{ 0, 0 };
+                std::array<std::uint64_t, 2> result{ 0, 0 };
+                MurmurHash3_x64_128(mData.data(), static_cast<int>(mData.size()), seed.data(), result.data());
+                return result[0];
+            }
+
+        private:
+            std::string mData;
+        };
+
+        void addToDigest(const HeightfieldPlane& value, Digest& digest)
+        {
+            digest.add(value.mHeight);
+        }
+
+        void addToDigest(const HeightfieldSurface& value, Digest& digest)
+        {
+            digest.add(value.mSize);
+            digest.add(value.mMinHeight);
+            digest.add(value.mMaxHeight);
+            digest.addBytes(value.mHeights, value.mSize * value.mSize * sizeof(float));
+        }
+
+        void addToDigest(const BulletObject& object, bool hasAvoidShape, Digest& digest)
+        {
+            digest.addString(object.getShapeInstance()->mFileName);
+            digest.addString(object.getShapeInstance()->mFileHash);
+            digest.add(object.getObjectTransform().mPosition);
+            digest.add(object.getObjectTransform().mScale);
+            digest.add(hasAvoidShape);
+        }
+
+        void merge(const TilesPositionsRange& range, std::optional<TilesPositionsRange>& target)
+        {
+            if (!target.has_value())
+            {
+                target = range;
+                return;
+            }
+            target->mBegin.x() = std::min(target->mBegin.x(), range.mBegin.x());
+            target->mBegin.y() = std::min(target->mBegin.y(), range.mBegin.y());
+            target->mEnd.x() = std::max(target->mEnd.x(), range.mEnd.x());
+            target->mEnd.y() = std::max(target->mEnd.y(), range.mEnd.y());
+        }
 
         struct CellRef
         {
@@ -280,6 +361,13 @@ namespace NavMeshTool
 
             const TileCachedRecastMeshManager::UpdateGuard guard(navMeshInput.mTileCachedRecastMeshManager);
 
+            Digest cellDigest;
+            std::optional<TilesPositionsRange> cellTilesRange;
+            bool affectsAllTiles = false;
+
+            cellDigest.add(exterior);
+            cellDigest.add(cellPosition);
+
             if (exterior)
             {
                 const auto it
@@ -288,19 +376,34 @@ namespace NavMeshTool
                     = makeHeightfieldShape(it == esmData.mLands.end() ? std::optional<ESM::Land>() : *it, cellPosition,
                         data.mHeightfields, data.mLandData);
 
-                mergeOrAssign(
-                    getAabb(cellPosition, minHeight, maxHeight), navMeshInput.mAabb, navMeshInput.mAabbInitialized);
+                const btAABB cellAabb = getAabb(cellPosition, minHeight, maxHeight);
+
+                mergeOrAssign(cellAabb, navMeshInput.mAabb, navMeshInput.mAabbInitialized);
 
                 navMeshInput.mTileCachedRecastMeshManager.addHeightfield(
                     cellPosition, ESM::Land::REAL_SIZE, heightfieldShape, &guard);
 
                 navMeshInput.mTileCachedRecastMeshManager.addWater(cellPosition, ESM::Land::REAL_SIZE, -1, &guard);
+
+                std::visit([&](const auto& v) { addToDigest(v, cellDigest); }, heightfieldShape);
+                merge(DetourNavigator::makeTilesPositionsRange(Misc::Convert::toOsgXY(cellAabb.m_min),
+                          Misc::Convert::toOsgXY(cellAabb.m_max), settings.mRecast),
+                    cellTilesRange);
             }
             else
             {
-                if ((cell.mData.mFlags & ESM::Cell::HasWater) != 0)
+                const bool hasWater = (cell.mData.mFlags & ESM::Cell::HasWater) != 0;
+
+                if (hasWater)
                     navMeshInput.mTileCachedRecastMeshManager.addWater(
                         cellPosition, std::numeric_limits<int>::max(), cell.mWater, &guard);
+
+                cellDigest.add(hasWater);
+                if (hasWater)
+                {
+                    cellDigest.add(cell.mWater);
+                    affectsAllTiles = true;
+                }
             }
 
             forEachObject(cell, esmData, vfs, bulletShapeManager, readers, [&](BulletObject object) {
@@ -320,16 +423,30 @@ namespace NavMeshTool
                 navMeshInput.mTileCachedRecastMeshManager.addObject(
                     objectId, shape, transform, DetourNavigator::AreaType_ground, &guard);
 
-                if (const btCollisionShape* avoid = object.getShapeInstance()->mAvoidCollisionShape.get())
+                merge(DetourNavigator::makeTilesPositionsRange(shape.getShape(), transform, settings.mRecast),
+                    cellTilesRange);
+
+                const btCollisionShape* const avoid = object.getShapeInstance()->mAvoidCollisionShape.get();
+
+                if (avoid != nullptr)
                 {
                     const CollisionShape avoidShape(object.getShapeInstance(), *avoid, object.getObjectTransform());
                     navMeshInput.mTileCachedRecastMeshManager.addObject(
                         objectId, avoidShape, transform, DetourNavigator::AreaType_null, &guard);
+                    merge(DetourNavigator::makeTilesPositionsRange(*avoid, transform, settings.mRecast),
+                        cellTilesRange);
                 }
 
+                addToDigest(object, avoid != nullptr, cellDigest);
+
                 data.mObjects.emplace_back(std::move(object));
             });
 
+            if (affectsAllTiles)
+                navMeshInput.mCellInputDigests.push_back(CellInputDigest{ std::nullopt, cellDigest.getValue() });
+            else if (cellTilesRange.has_value())
+                navMeshInput.mCellInputDigests.push_back(CellInputDigest{ cellTilesRange, cellDigest.getValue() });
+
             const auto cellDescription = cell.getDescription();
 
             if (writeBinaryLog)
@@ -349,4 +466,69 @@ namespace NavMeshTool
 
         return data;
     }
+
+    std::map<TilePosition, std::int64_t> makeTileInputDigests(const WorldspaceNavMeshInput& input,
+        const TilesPositionsRange& range, const DetourNavigator::RecastSettings& settings,
+        const DetourNavigator::AgentBounds& agentBounds)
+    {
+        Digest settingsDigest;
+        settingsDigest.add(tileInputDigestVersion);
+        settingsDigest.add(DetourNavigator::recastMeshVersion);
+        settingsDigest.add(DetourNavigator::navMeshFormatVersion);
+        settingsDigest.add(agentBounds.mShapeType);
+        settingsDigest.add(agentBounds.mHalfExtents);
+        settingsDigest.add(settings.mCellHeight);
+        settingsDigest.add(settings.mCellSize);
+        settingsDigest.add(settings.mDetailSampleDist);
+        settingsDigest.add(settings.mDetailSampleMaxError);
+        settingsDigest.add(settings.mMaxClimb);
+        settingsDigest.add(settings.mMaxSimplificationError);
+        settingsDigest.add(settings.mMaxSlope);
+        settingsDigest.add(settings.mRecastScaleFactor);
+        settingsDigest.add(settings.mSwimHeightScale);
+        settingsDigest.add(settings.mBorderSize);
+        settingsDigest.add(settings.mMaxEdgeLen);
+        settingsDigest.add(settings.mMaxVertsPerPoly);
+        settingsDigest.add(settings.mRegionMergeArea);
+        settingsDigest.add(settings.mRegionMinArea);
+        settingsDigest.add(settings.mTileSize);
+
+        std::vector<std::uint64_t> commonDigests{ settingsDigest.getValue() };
+        std::map<TilePosition, std::vector<std::uint64_t>> tileCellDigests;
+
+        for (const CellInputDigest& cellDigest : input.mCellInputDigests)
+        {
+            if (!cellDigest.mTilesRange.has_value())
+            {
+                commonDigests.push_back(cellDigest.mValue);
+                continue;
+            }
+            DetourNavigator::getTilesPositions(DetourNavigator::getIntersection(*cellDigest.mTilesRange, range),
+                [&](const TilePosition& tilePosition) { tileCellDigests[tilePosition].push_back(cellDigest.mValue); });
+        }
+
+        std::map<TilePosition, std::int64_t> result;
+
+        DetourNavigator::getTilesPositions(range, [&](const TilePosition& tilePosition) {
+            std::vector<std::uint64_t> digests = commonDigests;
+            if (const auto it = tileCellDigests.find(tilePosition); it != tileCellDigests.end())
+                digests.insert(digests.end(), it->second.begin(), it->second.end());
+            // Cells order depends on the content files order which doesn't affect the recast mesh
+            std::sort(digests.begin() + 1, digests.end());
+            Digest digest;
+            digest.addBytes(digests.data(), digests.size() * sizeof(std::uint64_t));
+            result.emplace_hint(result.end(), tilePosition, static_cast<std::int64_t>(digest.getValue()));
+        });
+
+        return result;
+    }
+    std::set<TilePosition> findUnchangedTiles(
+        const std::map<TilePosition, std::int64_t>& stored, const std::map<TilePosition, std::int64_t>& current)
+    {
+        std::set<TilePosition> result;
+        for (const auto& [tilePosition, digest] : current)
+            if (const auto it = stored.find(tilePosition); it != stored.end() && it->second == digest)
+                result.emplace_hint(result.end(), tilePosition);
+        return result;
+    }
 }
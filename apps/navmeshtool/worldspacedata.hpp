@@ -3,6 +3,8 @@
 
 #include <components/bullethelpers/collisionobject.hpp>
 #include <components/detournavigator/tilecachedrecastmeshmanager.hpp>
+#include <components/detournavigator/tileposition.hpp>
+#include <components/detournavigator/tilespositionsrange.hpp>
 #include <components/esm3/loadland.hpp>
 #include <components/misc/convert.hpp>
 #include <components/resource/bulletshape.hpp>
@@ -11,7 +13,11 @@
 #include <BulletCollision/Gimpact/btBoxCollision.h>
 #include <LinearMath/btVector3.h>
 
+#include <cstdint>
+#include <map>
 #include <memory>
+#include <optional>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -38,6 +44,8 @@ namespace EsmLoader
 
 namespace DetourNavigator
 {
+    struct AgentBounds;
+    struct RecastSettings;
     struct Settings;
 }
 
@@ -46,12 +54,21 @@ namespace NavMeshTool
     using DetourNavigator::ObjectTransform;
     using DetourNavigator::TileCachedRecastMeshManager;
 
+    // Digest of heightfield, water and objects added from a single cell. Empty tiles range means the cell affects
+    // all tiles of the worldspace.
+    struct CellInputDigest
+    {
+        std::optional<DetourNavigator::TilesPositionsRange> mTilesRange;
+        std::uint64_t mValue;
+    };
+
     struct WorldspaceNavMeshInput
     {
         std::string mWorldspace;
         TileCachedRecastMeshManager mTileCachedRecastMeshManager;
         btAABB mAabb;
         bool mAabbInitialized = false;
+        std::vector<CellInputDigest> mCellInputDigests;
 
         explicit WorldspaceNavMeshInput(std::string worldspace, const DetourNavigator::RecastSettings& settings);
     };
@@ -91,6 +108,17 @@ namespace NavMeshTool
     WorldspaceData gatherWorldspaceData(const DetourNavigator::Settings& settings, ESM::ReadersCache& readers,
         const VFS::Manager& vfs, Resource::BulletShapeManager& bulletShapeManager, const EsmLoader::EsmData& esmData,
         bool processInteriorCells, bool writeBinaryLog);
+
+    // Combines digests of all cells affecting each tile in the range with the settings used to generate the tile.
+    // Equal digests mean equal recast mesh and therefore equal navmesh tile.
+    std::map<DetourNavigator::TilePosition, std::int64_t> makeTileInputDigests(const WorldspaceNavMeshInput& input,
+        const DetourNavigator::TilesPositionsRange& range, const DetourNavigator::RecastSettings& settings,
+        const DetourNavigator::AgentBounds& agentBounds);
+
+    // Returns tiles with the current input digest equal to the stored one. These tiles can be kept as is.
+    std::set<DetourNavigator::TilePosition> findUnchangedTiles(
+        const std::map<DetourNavigator::TilePosition, std::int64_t>& stored,
+        const std::map<DetourNavigator::TilePosition, std::int64_t>& current);
 }
 
 #endif
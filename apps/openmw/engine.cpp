@@ -31,6 +31,7 @@
 #include <components/sceneutil/workqueue.hpp>
 
 #include <components/files/configurationmanager.hpp>
+#include <components/files/conversion.hpp>
 
 #include <components/version/version.hpp>
 
@@ -116,6 +117,20 @@ namespace
         void operator()(std::string) const {}
     };
 
+    // Records used by scripts may change without renaming the content file
+    std::string getContentFileStamp(const Files::Collections& fileCollections, const std::string& contentFile)
+    {
+        const auto extension = Files::pathToUnicodeString(Files::pathFromUnicodeString(contentFile).extension());
+        const Files::MultiDirCollection& collection = fileCollections.getCollection(extension);
+        if (!collection.doesExist(contentFile))
+            return {};
+        const std::filesystem::path path = collection.getPath(contentFile);
+        std::error_code ec;
+        const std::uintmax_t size = std::filesystem::file_size(path, ec);
+        const auto writeTime = std::filesystem::last_write_time(path, ec).time_since_epoch().count();
+        return std::to_string(size) + " " + std::to_string(writeTime);
+    }
+
     class IdentifyOpenGLOperation : public osg::GraphicsOperation
     {
     public:
@@ -321,6 +336,7 @@ bool OMW::Engine::frame(float frametime)
         mMechanicsManager->reportStats(frameNumber, *stats);
         mWorld->reportStats(frameNumber, *stats);
         mLuaManager->reportStats(frameNumber, *stats);
+        mWindowManager->reportStats(frameNumber, *stats);
     }
 
     mViewer->eventTraversal();
@@ -689,7 +705,7 @@ void OMW::Engine::prepareEngine()
     mL10nManager->setPreferredLocales(Settings::Manager::getStringArray("preferred locales", "General"));
     mEnvironment.setL10nManager(*mL10nManager);
 
-    mLuaManager = std::make_unique<MWLua::LuaManager>(mVFS.get(), mResDir / "lua_libs");
+    mLuaManager = std::make_unique<MWLua::LuaManager>(mVFS.get(), mResDir / "lua_libs", mCfgMgr.getUserDataPath());
     mEnvironment.setLuaManager(*mLuaManager);
 
     // starts a separate lua thread if "lua num threads" > 0
@@ -755,7 +771,7 @@ void OMW::Engine::prepareEngine()
     mEnvironment.setInputManager(*mInputManager);
 
     // Create sound system
-    mSoundManager = std::make_unique<MWSound::SoundManager>(mVFS.get(), mUseSound);
+    mSoundManager = std::make_unique<MWSound::SoundManager>(mVFS.get(), mUseSound, mWorkQueue.get());
     mEnvironment.setSoundManager(*mSoundManager);
 
     if (!mSkipMenu)
@@ -812,6 +828,19 @@ void OMW::Engine::prepareEngine()
             Log(Debug::Info) << "compiled " << result.second << " of " << result.first << " scripts ("
                              << 100 * static_cast<double>(result.second) / result.first << "%)";
     }
+    else if (Settings::Manager::getBool("precompile scripts", "Game"))
+    {
+        // Byte code depends on the engine version and loaded content
+        std::string cacheKey = Version::getOpenmwVersionDescription(mResDir);
+        for (const std::string& contentFile : mContentFiles)
+            cacheKey += "\n" + contentFile + " " + getContentFileStamp(mFileCollections, contentFile);
+
+        const int threads = std::max(0, Settings::Manager::getInt("script compile threads", "Game"));
+        std::pair<int, int> result = mScriptManager->precompileAll(
+            static_cast<std::size_t>(threads), mCfgMgr.getUserDataPath() / "scripts.cache", cacheKey);
+        if (result.first)
+            Log(Debug::Info) << "precompiled " << result.second << " of " << result.first << " scripts";
+    }
     if (mCompileAllDialogue)
     {
         std::pair<int, int> result = MWDialogue::ScriptTest::compileAll(&mExtensions, mWarningsMode);
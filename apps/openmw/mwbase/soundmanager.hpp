@@ -5,6 +5,7 @@
 #include <set>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include "../mwsound/type.hpp"
 #include "../mwworld/ptr.hpp"
@@ -193,6 +194,9 @@ namespace MWBase
         virtual void resumeSounds(MWSound::BlockerType blocker) = 0;
         ///< Resumes all previously paused sounds.
 
+        virtual void preloadSounds(const std::vector<std::string>& soundIds) = 0;
+        ///< Decode the given sounds in background, so they are ready when first played.
+
         virtual void pausePlayback() = 0;
         virtual void resumePlayback() = 0;
 
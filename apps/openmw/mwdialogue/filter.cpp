@@ -689,6 +689,29 @@ const ESM::DialInfo* MWDialogue::Filter::search(const ESM::Dialogue& dialogue, c
         return suitableInfos[0];
 }
 
+std::vector<const ESM::DialInfo*> MWDialogue::Filter::getCandidates(const ESM::Dialogue& dialogue) const
+{
+    const InfoIndex* index
+        = MWBase::Environment::get().getWorld()->getStore().get<ESM::Dialogue>().getInfoIndex(dialogue);
+
+    if (index == nullptr)
+    {
+        std::vector<const ESM::DialInfo*> result;
+        result.reserve(dialogue.mInfo.size());
+        for (const ESM::DialInfo& info : dialogue.mInfo)
+            result.push_back(&info);
+        return result;
+    }
+
+    const std::string_view actorId = mActor.getCellRef().getRefId();
+
+    if (mActor.getType() != ESM::NPC::sRecordId)
+        return index->getCandidates(actorId, false, {}, {}, {});
+
+    const ESM::NPC& npc = *mActor.get<ESM::NPC>()->mBase;
+    return index->getCandidates(actorId, true, npc.mRace, npc.mClass, mActor.getClass().getPrimaryFaction(mActor));
+}
+
 bool MWDialogue::Filter::couldPotentiallyMatch(const ESM::DialInfo& info) const
 {
     return testActor(info) && matchesStaticFilters(info, mActor);
@@ -702,14 +725,13 @@ std::vector<const ESM::DialInfo*> MWDialogue::Filter::list(
     bool infoRefusal = false;
 
     // Iterate over topic responses to find a matching one
-    for (ESM::Dialogue::InfoContainer::const_iterator iter = dialogue.mInfo.begin(); iter != dialogue.mInfo.end();
-         ++iter)
+    for (const ESM::DialInfo* info : getCandidates(dialogue))
     {
-        if (testActor(*iter) && testPlayer(*iter) && testSelectStructs(*iter))
+        if (testActor(*info) && testPlayer(*info) && testSelectStructs(*info))
         {
-            if (testDisposition(*iter, invertDisposition))
+            if (testDisposition(*info, invertDisposition))
             {
-                infos.push_back(&*iter);
+                infos.push_back(info);
                 if (!searchAll)
                     break;
             }
@@ -728,12 +750,11 @@ std::vector<const ESM::DialInfo*> MWDialogue::Filter::list(
 
         const ESM::Dialogue& infoRefusalDialogue = *dialogues.find("Info Refusal");
 
-        for (ESM::Dialogue::InfoContainer::const_iterator iter = infoRefusalDialogue.mInfo.begin();
-             iter != infoRefusalDialogue.mInfo.end(); ++iter)
-            if (testActor(*iter) && testPlayer(*iter) && testSelectStructs(*iter)
-                && testDisposition(*iter, invertDisposition))
+        for (const ESM::DialInfo* info : getCandidates(infoRefusalDialogue))
+            if (testActor(*info) && testPlayer(*info) && testSelectStructs(*info)
+                && testDisposition(*info, invertDisposition))
             {
-                infos.push_back(&*iter);
+                infos.push_back(info);
                 if (!searchAll)
                     break;
             }
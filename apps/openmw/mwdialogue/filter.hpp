@@ -50,6 +50,10 @@ namespace MWDialogue
         bool hasFactionRankReputationRequirements(
             const MWWorld::Ptr& actor, std::string_view factionId, int rank) const;
 
+        std::vector<const ESM::DialInfo*> getCandidates(const ESM::Dialogue& dialogue) const;
+        ///< Infos of \a dialogue in their order, skipping those which can't pass testActor by actor id, race, class
+        /// or faction.
+
     public:
         Filter(const MWWorld::Ptr& actor, int choice, bool talkedToPlayer);
 
@@ -0,0 +1,66 @@
+#include "infoindex.hpp"
+
+#include <algorithm>
+
+#include <components/esm3/loaddial.hpp>
+#include <components/esm3/loadinfo.hpp>
+
+namespace MWDialogue
+{
+    namespace
+    {
+        template <class Buckets>
+        void addBucket(const Buckets& buckets, std::string_view key, std::vector<std::size_t>& out)
+        {
+            if (key.empty())
+                return;
+            const auto it = buckets.find(key);
+            if (it != buckets.end())
+                out.insert(out.end(), it->second.begin(), it->second.end());
+        }
+    }
+
+    InfoIndex::InfoIndex(const ESM::Dialogue& dialogue)
+    {
+        for (const ESM::DialInfo& info : dialogue.mInfo)
+        {
+            const std::size_t position = mInfos.size();
+            mInfos.push_back(&info);
+
+            // Should be consistent with Filter::testActor
+            if (!info.mActor.empty())
+                mByActor[info.mActor].push_back(position);
+            else if (!info.mRace.empty())
+                mByRace[info.mRace].push_back(position);
+            else if (!info.mClass.empty())
+                mByClass[info.mClass].push_back(position);
+            else if (!info.mFactionLess && !info.mFaction.empty())
+                mByFaction[info.mFaction].push_back(position);
+            else
+                mOther.push_back(position);
+        }
+    }
+
+    std::vector<const ESM::DialInfo*> InfoIndex::getCandidates(std::string_view actorId, bool isNpc,
+        std::string_view race, std::string_view actorClass, std::string_view faction) const
+    {
+        Bucket positions;
+
+        addBucket(mByActor, actorId, positions);
+
+        if (isNpc)
+        {
+            addBucket(mByRace, race, positions);
+            addBucket(mByClass, actorClass, positions);
+            addBucket(mByFaction, faction, positions);
+            positions.insert(positions.end(), mOther.begin(), mOther.end());
+            std::sort(positions.begin(), positions.end());
+        }
+
+        std::vector<const ESM::DialInfo*> result;
+        result.reserve(positions.size());
+        for (const std::size_t position : positions)
+            result.push_back(mInfos[position]);
+        return result;
+    }
+}
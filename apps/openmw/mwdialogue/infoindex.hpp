@@ -0,0 +1,50 @@
+#ifndef GAME_MWDIALOGUE_INFOINDEX_H
+#define GAME_MWDIALOGUE_INFOINDEX_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <components/misc/strings/algorithm.hpp>
+
+namespace ESM
+{
+    struct DialInfo;
+    struct Dialogue;
+}
+
+namespace MWDialogue
+{
+    /// \brief Infos of a dialogue grouped by the actor condition which is the cheapest to reject
+    ///
+    /// Each info is put into the bucket of the first non-empty condition out of actor id, race, class and faction.
+    /// An info from a bucket can only be said by an actor with the same value of the corresponding property, so
+    /// only the matching buckets need to be tested.
+    class InfoIndex
+    {
+    public:
+        explicit InfoIndex(const ESM::Dialogue& dialogue);
+
+        /// Return infos in the dialogue order which could pass actor id, race, class and faction conditions. The
+        /// result is a superset of the infos passing these conditions. Race, class and faction are ignored for
+        /// creatures because only infos specific to the creature id are suitable for them.
+        std::vector<const ESM::DialInfo*> getCandidates(std::string_view actorId, bool isNpc, std::string_view race,
+            std::string_view actorClass, std::string_view faction) const;
+
+    private:
+        // Positions of infos in mInfos
+        using Bucket = std::vector<std::size_t>;
+        using Buckets = std::unordered_map<std::string, Bucket, Misc::StringUtils::CiHash, Misc::StringUtils::CiEqual>;
+
+        std::vector<const ESM::DialInfo*> mInfos;
+        Buckets mByActor;
+        Buckets mByRace;
+        Buckets mByClass;
+        Buckets mByFaction;
+        Bucket mOther;
+    };
+}
+
+#endif
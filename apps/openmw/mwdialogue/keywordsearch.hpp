@@ -1,18 +1,25 @@
 #ifndef GAME_MWDIALOGUE_KEYWORDSEARCH_H
 #define GAME_MWDIALOGUE_KEYWORDSEARCH_H
 
-#include <algorithm> // std::reverse
-#include <cctype>
-#include <map>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <stdexcept>
+#include <string>
+#include <utility>
 #include <vector>
 
-#include <components/misc/strings/algorithm.hpp>
 #include <components/misc/strings/lower.hpp>
 
 namespace MWDialogue
 {
 
+    /// \brief Finds seeded keywords in a text ignoring the case of ASCII letters
+    ///
+    /// Keywords are stored in a trie which is compiled into an Aho-Corasick automaton by the first search after
+    /// seeding. A search is a single pass over the text whatever the number of keywords is.
     template <typename string_t, typename value_t>
     class KeywordSearch
     {
@@ -30,165 +37,89 @@ namespace MWDialogue
         {
             if (keyword.empty())
                 return;
-            seed_impl(std::move(keyword), std::move(value), 0, mRoot);
+
+            std::uint32_t node = 0;
+            for (const char ch : keyword)
+                node = addChild(node, Misc::StringUtils::toLower(ch));
+
+            if (mNodes[node].mKeyword != sNone)
+            {
+                if (mKeywords[mNodes[node].mKeyword].mText == keyword)
+                    throw std::runtime_error("duplicate keyword inserted");
+                // Keywords different only by case are the same keyword, keep the first one
+                return;
+            }
+
+            mNodes[node].mKeyword = static_cast<std::uint32_t>(mKeywords.size());
+            mKeywords.push_back(Keyword{ std::move(keyword), std::move(value) });
+            mCompiled = false;
         }
 
         void clear()
         {
-            mRoot.mChildren.clear();
-            mRoot.mKeyword.clear();
+            mKeywords.clear();
+            mNodes.assign(1, Node{});
+            mCompiled = false;
         }
 
-        bool containsKeyword(const string_t& keyword, value_t& value)
+        bool containsKeyword(const string_t& keyword, value_t& value) const
         {
-            typename Entry::childen_t::iterator current;
-            typename Entry::childen_t::iterator next;
-
-            current = mRoot.mChildren.find(Misc::StringUtils::toLower(*keyword.begin()));
-            if (current == mRoot.mChildren.end())
-                return false;
-            else if (current->second.mKeyword.size() && Misc::StringUtils::ciEqual(current->second.mKeyword, keyword))
-            {
-                value = current->second.mValue;
-                return true;
-            }
-
-            for (Point i = ++keyword.begin(); i != keyword.end(); ++i)
+            std::uint32_t node = 0;
+            for (const char ch : keyword)
             {
-                next = current->second.mChildren.find(Misc::StringUtils::toLower(*i));
-                if (next == current->second.mChildren.end())
+                node = findChild(node, Misc::StringUtils::toLower(ch));
+                if (node == sNone)
                     return false;
-                if (Misc::StringUtils::ciEqual(next->second.mKeyword, keyword))
-                {
-                    value = next->second.mValue;
-                    return true;
-                }
-                current = next;
             }
-            return false;
+
+            if (mNodes[node].mKeyword == sNone)
+                return false;
+
+            value = mKeywords[mNodes[node].mKeyword].mValue;
+            return true;
         }
 
         static bool sortMatches(const Match& left, const Match& right) { return left.mBeg < right.mBeg; }
 
+        /// Append to \a out the found keywords in the order of their position. The longest keyword starting at each
+        /// position is a candidate. Of overlapping candidates the longest one is chosen, so "foo bar" and "lock switch"
+        /// are found in "foo bar lock switch" for keywords "foo bar", "bar lock" and "lock switch".
+        /// \note Not thread safe, the automaton is compiled on demand.
         void highlightKeywords(Point beg, Point end, std::vector<Match>& out) const
         {
-            std::vector<Match> matches;
-            for (Point i = beg; i != end; ++i)
-            {
-                // check first character
-                typename Entry::childen_t::const_iterator candidate
-                    = mRoot.mChildren.find(Misc::StringUtils::toLower(*i));
-
-                // no match, on to next character
-                if (candidate == mRoot.mChildren.end())
-                    continue;
+            if (!mCompiled)
+                compile();
 
-                // see how far the match goes
-                Point j = i;
-
-                // some keywords might be longer variations of other keywords, so we definitely need a list of
-                // candidates the first element in the pair is length of the match, i.e. depth from the first character
-                // on
-                std::vector<typename std::pair<int, typename Entry::childen_t::const_iterator>> candidates;
-
-                while ((j + 1) != end)
-                {
-                    typename Entry::childen_t::const_iterator next
-                        = candidate->second.mChildren.find(Misc::StringUtils::toLower(*++j));
-
-                    if (next == candidate->second.mChildren.end())
-                    {
-                        if (candidate->second.mKeyword.size() > 0)
-                            candidates.push_back(std::make_pair((j - i), candidate));
-                        break;
-                    }
-
-                    candidate = next;
-
-                    if (candidate->second.mKeyword.size() > 0)
-                        candidates.push_back(std::make_pair((j - i), candidate));
-                }
-
-                if (candidates.empty())
-                    continue; // didn't match enough to disambiguate, on to next character
-
-                // shorter candidates will be added to the vector first. however, we want to check against longer
-                // candidates first
-                std::reverse(candidates.begin(), candidates.end());
-
-                for (typename std::vector<std::pair<int, typename Entry::childen_t::const_iterator>>::iterator it
-                     = candidates.begin();
-                     it != candidates.end(); ++it)
-                {
-                    candidate = it->second;
-                    // try to match the rest of the keyword
-                    Point k = i + it->first;
-                    typename string_t::const_iterator t = candidate->second.mKeyword.begin() + (k - i);
-
-                    while (k != end && t != candidate->second.mKeyword.end())
-                    {
-                        if (Misc::StringUtils::toLower(*k) != Misc::StringUtils::toLower(*t))
-                            break;
+            if (mKeywords.empty())
+                return;
 
-                        ++k, ++t;
-                    }
+            // Candidates are found at their ends but have to be produced in the order of their beginnings. The longest
+            // keyword state for each of the last mLongestByBeginning.size() positions is kept in the ring buffer until
+            // there is no longer keyword which could start at the position.
+            const std::size_t maxLength = mLongestByBeginning.size();
+            std::fill(mLongestByBeginning.begin(), mLongestByBeginning.end(), sNone);
 
-                    // didn't match full keyword, try the next candidate
-                    if (t != candidate->second.mKeyword.end())
-                        continue;
-
-                    // found a keyword, but there might still be longer keywords that start somewhere _within_ this
-                    // keyword we will resolve these overlapping keywords later, choosing the longest one in case of
-                    // conflict
-                    Match match;
-                    match.mValue = candidate->second.mValue;
-                    match.mBeg = i;
-                    match.mEnd = k;
-                    matches.push_back(match);
-                    break;
-                }
-            }
-
-            // resolve overlapping keywords
-            while (!matches.empty())
+            Candidates candidates(beg, out);
+            std::uint32_t state = 0;
+            std::size_t position = 0;
+            for (Point i = beg; i != end; ++i)
             {
-                int longestKeywordSize = 0;
-                typename std::vector<Match>::iterator longestKeyword = matches.begin();
-                for (typename std::vector<Match>::iterator it = matches.begin(); it != matches.end(); ++it)
-                {
-                    int size = it->mEnd - it->mBeg;
-                    if (size > longestKeywordSize)
-                    {
-                        longestKeywordSize = size;
-                        longestKeyword = it;
-                    }
-
-                    typename std::vector<Match>::iterator next = it;
-                    ++next;
+                state = getNextState(state, Misc::StringUtils::toLower(*i));
+                ++position;
 
-                    if (next == matches.end())
-                        break;
+                // Outputs are ordered from the longest to the shortest keyword ending here
+                for (std::uint32_t output = mStates[state].mOutput; output != sNone;
+                     output = mStates[mStates[output].mFailure].mOutput)
+                    mLongestByBeginning[(position - mStates[output].mLength) % maxLength] = output;
 
-                    if (it->mEnd <= next->mBeg)
-                    {
-                        break; // no overlap
-                    }
-                }
-
-                Match keyword = *longestKeyword;
-                matches.erase(longestKeyword);
-                out.push_back(keyword);
-                // erase anything that overlaps with the keyword we just added to the output
-                for (typename std::vector<Match>::iterator it = matches.begin(); it != matches.end();)
-                {
-                    if (it->mBeg < keyword.mEnd && it->mEnd > keyword.mBeg)
-                        it = matches.erase(it);
-                    else
-                        ++it;
-                }
+                if (position >= maxLength)
+                    addCandidate(position - maxLength, candidates);
             }
 
-            std::sort(out.begin(), out.end(), sortMatches);
+            for (std::size_t i = position < maxLength ? 0 : position - maxLength + 1; i < position; ++i)
+                addCandidate(i, candidates);
+
+            candidates.finish();
         }
 
         static bool removeUnusedPostfix(std::string& text, std::vector<Match>& matches)
@@ -205,20 +136,25 @@ namespace MWDialogue
             {
                 it++;
                 size_t n = 0;
-                std::set<std::string> kws;
+                // Matches before the postfix are the first ones
+                std::size_t textMatches = 0;
+                const auto isInText = [&](const Match& match) {
+                    return std::any_of(matches.begin(), matches.begin() + textMatches,
+                        [&](const Match& v) { return std::equal(v.mBeg, v.mEnd, match.mBeg, match.mEnd); });
+                };
                 for (auto i = matches.begin(); i != matches.end();)
                 {
                     auto& match = *i;
                     match.mBeg -= n;
                     match.mEnd -= n;
                     if (match.mEnd <= it)
-                        kws.insert(std::string(match.mBeg, match.mEnd));
+                        ++textMatches;
                     else
                     {
                         if (match.mBeg < it || match.mEnd >= text.cend()
                             || *(match.mBeg - 1) != ',' && *(match.mBeg - 1) != '{'
                             || *match.mEnd != ',' && *match.mEnd != '}'
-                            || kws.contains(std::string(match.mBeg, match.mEnd)))
+                            || isInText(match))
                         {
                             i = matches.erase(i);
                             continue;
@@ -246,53 +182,205 @@ namespace MWDialogue
         }
 
     private:
-        struct Entry
-        {
-            typedef std::map<wchar_t, Entry> childen_t;
+        static constexpr std::uint32_t sNone = std::numeric_limits<std::uint32_t>::max();
 
-            string_t mKeyword;
+        struct Keyword
+        {
+            string_t mText;
             value_t mValue;
-            childen_t mChildren;
         };
 
-        void seed_impl(string_t keyword, value_t value, size_t depth, Entry& entry)
+        struct Node
         {
-            int ch = Misc::StringUtils::toLower(keyword.at(depth));
+            std::vector<std::pair<char, std::uint32_t>> mChildren; // sorted by character
+            std::uint32_t mKeyword = sNone;
+        };
 
-            typename Entry::childen_t::iterator j = entry.mChildren.find(ch);
+        struct Edge
+        {
+            char mChar;
+            std::uint32_t mTarget;
+        };
 
-            if (j == entry.mChildren.end())
+        struct State
+        {
+            std::uint32_t mEdgesBegin = 0;
+            std::uint32_t mEdgesEnd = 0;
+            std::uint32_t mFailure = 0; ///< state for the longest proper suffix of this state present in the trie
+            std::uint32_t mOutput = sNone; ///< this or the closest state on the failure chain ending a keyword
+            std::uint32_t mLength = 0;
+            std::uint32_t mKeyword = sNone;
+        };
+
+        // Matches added to the output and not yet resolved. Candidates overlapping each other form a group which is
+        // resolved once a candidate beginning after all of them is added.
+        struct Candidates
+        {
+            Point mText;
+            std::vector<Match>& mOut;
+            std::size_t mGroupBegin;
+            Point mGroupEnd;
+
+            Candidates(Point text, std::vector<Match>& out)
+                : mText(text)
+                , mOut(out)
+                , mGroupBegin(out.size())
+                , mGroupEnd(text)
             {
-                entry.mChildren[ch].mValue = std::move(value);
-                entry.mChildren[ch].mKeyword = std::move(keyword);
             }
-            else
+
+            void add(Match&& match)
             {
-                if (j->second.mKeyword.size() > 0)
+                if (mOut.size() > mGroupBegin && mGroupEnd <= match.mBeg)
                 {
-                    if (keyword == j->second.mKeyword)
-                        throw std::runtime_error("duplicate keyword inserted");
+                    resolveOverlaps(mOut, mGroupBegin);
+                    mGroupBegin = mOut.size();
+                }
+                if (mOut.size() == mGroupBegin || mGroupEnd < match.mEnd)
+                    mGroupEnd = match.mEnd;
+                mOut.push_back(std::move(match));
+            }
 
-                    value_t pushValue = j->second.mValue;
-                    string_t pushKeyword = j->second.mKeyword;
+            void finish() { resolveOverlaps(mOut, mGroupBegin); }
+        };
 
-                    if (depth >= pushKeyword.size())
-                        throw std::runtime_error("unexpected");
+        std::uint32_t addChild(std::uint32_t node, char ch)
+        {
+            auto& children = mNodes[node].mChildren;
+            const auto it = std::lower_bound(children.begin(), children.end(), ch,
+                [](const std::pair<char, std::uint32_t>& child, char value) { return child.first < value; });
+            if (it != children.end() && it->first == ch)
+                return it->second;
+
+            const std::uint32_t child = static_cast<std::uint32_t>(mNodes.size());
+            children.insert(it, { ch, child });
+            mNodes.emplace_back();
+            return child;
+        }
 
-                    if (depth + 1 < pushKeyword.size())
-                    {
-                        seed_impl(std::move(pushKeyword), std::move(pushValue), depth + 1, j->second);
-                        j->second.mKeyword.clear();
-                    }
+        std::uint32_t findChild(std::uint32_t node, char ch) const
+        {
+            const auto& children = mNodes[node].mChildren;
+            const auto it = std::lower_bound(children.begin(), children.end(), ch,
+                [](const std::pair<char, std::uint32_t>& child, char value) { return child.first < value; });
+            if (it == children.end() || it->first != ch)
+                return sNone;
+            return it->second;
+        }
+
+        std::uint32_t findEdge(std::uint32_t state, char ch) const
+        {
+            const auto begin = mEdges.begin() + mStates[state].mEdgesBegin;
+            const auto end = mEdges.begin() + mStates[state].mEdgesEnd;
+            const auto it
+                = std::lower_bound(begin, end, ch, [](const Edge& edge, char value) { return edge.mChar < value; });
+            if (it == end || it->mChar != ch)
+                return sNone;
+            return it->mTarget;
+        }
+
+        std::uint32_t getNextState(std::uint32_t state, char ch) const
+        {
+            for (; state != 0; state = mStates[state].mFailure)
+            {
+                const std::uint32_t next = findEdge(state, ch);
+                if (next != sNone)
+                    return next;
+            }
+            return mRootTransitions[static_cast<unsigned char>(ch)];
+        }
+
+        void compile() const
+        {
+            mStates.assign(mNodes.size(), State{});
+            mEdges.clear();
+            mEdges.reserve(mNodes.size() - 1);
+            mRootTransitions.fill(0);
+            std::uint32_t maxLength = 0;
+
+            // Breadth-first order makes failure links and outputs of shorter states available
+            std::vector<std::uint32_t> queue;
+            queue.reserve(mNodes.size());
+            queue.push_back(0);
+            for (std::size_t i = 0; i < queue.size(); ++i)
+            {
+                const std::uint32_t index = queue[i];
+                const Node& node = mNodes[index];
+                State& state = mStates[index];
+
+                state.mKeyword = node.mKeyword;
+                if (node.mKeyword != sNone)
+                {
+                    state.mOutput = index;
+                    maxLength = std::max(maxLength, state.mLength);
                 }
-                if (depth + 1 == keyword.size())
-                    j->second.mKeyword = value;
-                else // depth+1 < keyword.size()
-                    seed_impl(std::move(keyword), std::move(value), depth + 1, j->second);
+                else if (index != 0)
+                    state.mOutput = mStates[state.mFailure].mOutput;
+
+                state.mEdgesBegin = static_cast<std::uint32_t>(mEdges.size());
+                for (const auto& [ch, child] : node.mChildren)
+                {
+                    mEdges.push_back(Edge{ ch, child });
+                    queue.push_back(child);
+                    mStates[child].mLength = state.mLength + 1;
+                    if (index == 0)
+                        mRootTransitions[static_cast<unsigned char>(ch)] = child;
+                    else
+                        mStates[child].mFailure = getNextState(state.mFailure, ch);
+                }
+                state.mEdgesEnd = static_cast<std::uint32_t>(mEdges.size());
+            }
+
+            mLongestByBeginning.assign(maxLength, sNone);
+            mCompiled = true;
+        }
+
+        void addCandidate(std::size_t beginning, Candidates& candidates) const
+        {
+            std::uint32_t& longest = mLongestByBeginning[beginning % mLongestByBeginning.size()];
+            if (longest == sNone)
+                return;
+            const State& state = mStates[longest];
+            const Point beg = candidates.mText + static_cast<std::ptrdiff_t>(beginning);
+            candidates.add(Match{ beg, beg + state.mLength, mKeywords[state.mKeyword].mValue });
+            longest = sNone;
+        }
+
+        // Choose the longest match from the chain of overlapping matches beginning with the first one, drop the
+        // matches it overlaps and repeat for the remaining ones. out[first..] is sorted by beginning.
+        static void resolveOverlaps(std::vector<Match>& out, std::size_t first)
+        {
+            std::size_t resolved = first;
+            std::size_t size = out.size();
+            while (resolved < size)
+            {
+                std::size_t longest = resolved;
+                for (std::size_t i = resolved; i + 1 < size && out[i].mEnd > out[i + 1].mBeg; ++i)
+                    if (out[i + 1].mEnd - out[i + 1].mBeg > out[longest].mEnd - out[longest].mBeg)
+                        longest = i + 1;
+
+                const Match chosen = out[longest];
+                const auto remaining = std::remove_if(out.begin() + resolved, out.begin() + size,
+                    [&](const Match& match) { return match.mBeg < chosen.mEnd && match.mEnd > chosen.mBeg; });
+                // Chosen match overlaps itself so there is room to keep it before the remaining ones
+                std::move_backward(out.begin() + resolved, remaining, remaining + 1);
+                out[resolved] = chosen;
+                size = static_cast<std::size_t>(remaining - out.begin()) + 1;
+                ++resolved;
             }
+            out.erase(out.begin() + size, out.end());
+            std::sort(out.begin() + first, out.end(), sortMatches);
         }
 
-        Entry mRoot;
+        std::vector<Keyword> mKeywords;
+        std::vector<Node> mNodes = std::vector<Node>(1);
+
+        // Automaton compiled from mNodes by the first search after seeding. States have the same indices as nodes.
+        mutable bool mCompiled = false;
+        mutable std::vector<State> mStates;
+        mutable std::vector<Edge> mEdges;
+        mutable std::array<std::uint32_t, 256> mRootTransitions{};
+        mutable std::vector<std::uint32_t> mLongestByBeginning;
     };
 
 }
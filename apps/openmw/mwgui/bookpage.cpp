@@ -1,6 +1,13 @@
 #include "bookpage.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <limits>
+#include <list>
 #include <optional>
+#include <string_view>
+#include <unordered_map>
 
 #include "MyGUI_FactoryManager.h"
 #include "MyGUI_FontManager.h"
@@ -8,6 +15,7 @@
 #include "MyGUI_RenderManager.h"
 #include "MyGUI_TextureUtility.h"
 
+#include <components/misc/hash.hpp>
 #include <components/misc/utf8stream.hpp>
 #include <components/sceneutil/depth.hpp>
 
@@ -22,6 +30,30 @@ namespace MWGui
     static bool ucsCarriageReturn(int codePoint);
     static bool ucsBreakingSpace(int codePoint);
 
+    static std::chrono::steady_clock::duration sLastLayoutDuration{};
+
+    namespace
+    {
+        // Identifies a typeset book by its input and by everything the layout depends on
+        struct LayoutKey
+        {
+            std::size_t mInputHash;
+            int mPageWidth;
+            int mPageHeight;
+            int mFontHeight;
+
+            bool operator==(const LayoutKey& other) const = default;
+        };
+
+        typedef std::list<std::pair<LayoutKey, std::shared_ptr<TypesetBookImpl>>> LayoutCache;
+
+        constexpr std::size_t sLayoutCacheSize = 16;
+
+        // Most recently used first. Reopening the journal or a topic typesets the same input again, so the
+        // book laid out the previous time is returned instead.
+        LayoutCache sLayoutCache;
+    }
+
     struct BookTypesetter::Style
     {
         virtual ~Style() {}
@@ -41,6 +73,7 @@ namespace MWGui
             MyGUI::Colour mActiveColour;
             MyGUI::Colour mNormalColour;
             InteractiveId mInteractiveId;
+            std::size_t mIndex; // position in the book's styles, identifies the style in the input hash
 
             bool match(MyGUI::IFont* tstFont, const MyGUI::Colour& tstHotColour, const MyGUI::Colour& tstActiveColour,
                 const MyGUI::Colour& tstNormalColour, intptr_t tstInteractiveId)
@@ -98,13 +131,18 @@ namespace MWGui
 
         typedef std::vector<Page> Pages;
 
+        struct Layout;
+
         Pages mPages;
         Sections mSections;
         Contents mContents;
         Styles mStyles;
         MyGUI::IntRect mRect;
 
-        virtual ~TypesetBookImpl() {}
+        // The input which is not laid out yet. Sections and pages are laid out on demand, up to the requested page.
+        mutable std::unique_ptr<Layout> mLayout;
+
+        virtual ~TypesetBookImpl();
 
         Range addContent(const BookTypesetter::Utf8Span& text)
         {
@@ -116,26 +154,42 @@ namespace MWGui
             return Range(i->data(), i->data() + i->size());
         }
 
-        size_t pageCount() const override { return mPages.size(); }
+        size_t pageCount() const override
+        {
+            layoutPage(std::numeric_limits<std::size_t>::max());
+            return mPages.size();
+        }
 
         std::pair<unsigned int, unsigned int> getSize() const override
         {
+            layoutPage(std::numeric_limits<std::size_t>::max());
             return std::make_pair(mRect.width(), mRect.height());
         }
 
+        /// Returns the page or nullptr if the document has fewer pages.
+        /// Only the input up to the end of the page is laid out.
+        const Page* getPage(std::size_t page) const
+        {
+            layoutPage(page);
+            return page < mPages.size() ? &mPages[page] : nullptr;
+        }
+
+        void layoutPage(std::size_t page) const;
+
         template <typename Visitor>
         void visitRuns(int top, int bottom, MyGUI::IFont* Font, Visitor const& visitor) const
         {
-            for (Sections::const_iterator i = mSections.begin(); i != mSections.end(); ++i)
+            // Sections and lines are laid out from top to bottom, so the first visible ones are found by bisection
+            Sections::const_iterator i = std::partition_point(
+                mSections.begin(), mSections.end(), [&](const Section& v) { return v.mRect.bottom <= top; });
+
+            for (; i != mSections.end() && i->mRect.top < bottom; ++i)
             {
-                if (top >= mRect.bottom || bottom <= i->mRect.top)
-                    continue;
+                Lines::const_iterator j = std::partition_point(
+                    i->mLines.begin(), i->mLines.end(), [&](const Line& v) { return v.mRect.bottom <= top; });
 
-                for (Lines::const_iterator j = i->mLines.begin(); j != i->mLines.end(); ++j)
+                for (; j != i->mLines.end() && j->mRect.top < bottom; ++j)
                 {
-                    if (top >= j->mRect.bottom || bottom <= j->mRect.top)
-                        continue;
-
                     for (Runs::const_iterator k = j->mRuns.begin(); k != j->mRuns.end(); ++k)
                         if (!Font || k->mStyle->mFont == Font)
                             visitor(*i, *j, *k);
@@ -217,8 +271,32 @@ namespace MWGui
         struct Typesetter;
     };
 
-    struct TypesetBookImpl::Typesetter : BookTypesetter
+    // Lays out the input recorded by the typesetter. The input is replayed only as far as the requested page, so
+    // opening a long document measures the text of its first pages only.
+    struct TypesetBookImpl::Layout
     {
+        typedef BookTypesetter::Alignment Alignment;
+
+        struct Operation
+        {
+            enum Type
+            {
+                Write,
+                Flush, // ends the pending word, as adding or selecting content does
+                LineBreak,
+                SectionBreak,
+                SetSectionAlignment
+            };
+
+            Type mType;
+            StyleImpl* mStyle;
+            Utf8Point mBegin;
+            Utf8Point mEnd;
+            int mValue;
+        };
+
+        typedef std::vector<Operation> Operations;
+
         struct PartialText
         {
             StyleImpl* mStyle;
@@ -236,13 +314,15 @@ namespace MWGui
         };
 
         typedef TypesetBookImpl Book;
-        typedef std::shared_ptr<Book> BookPtr;
         typedef std::vector<PartialText>::const_iterator PartialTextConstIterator;
 
+        Book& mBook;
         int mPageWidth;
         int mPageHeight;
 
-        BookPtr mBook;
+        Operations mOperations;
+        std::size_t mNextOperation;
+
         Section* mSection;
         Line* mLine;
         Run* mRun;
@@ -251,137 +331,101 @@ namespace MWGui
         std::vector<PartialText> mPartialWhitespace;
         std::vector<PartialText> mPartialWord;
 
-        Book::Content const* mCurrentContent;
         Alignment mCurrentAlignment;
 
-        Typesetter(size_t width, size_t height)
-            : mPageWidth(width)
-            , mPageHeight(height)
+        std::size_t mPaginatedSections;
+        int mCurPageStart;
+        int mCurPageStop;
+
+        std::chrono::steady_clock::duration mLayoutDuration{};
+
+        Layout(Book& book, int pageWidth, int pageHeight, Operations&& operations)
+            : mBook(book)
+            , mPageWidth(pageWidth)
+            , mPageHeight(pageHeight)
+            , mOperations(std::move(operations))
+            , mNextOperation(0)
             , mSection(nullptr)
             , mLine(nullptr)
             , mRun(nullptr)
-            , mCurrentContent(nullptr)
-            , mCurrentAlignment(AlignLeft)
-        {
-            mBook = std::make_shared<Book>();
-        }
-
-        virtual ~Typesetter() {}
-
-        Style* createStyle(const std::string& fontName, const Colour& fontColour, bool useBookFont) override
-        {
-            std::string fullFontName;
-            if (fontName.empty())
-                fullFontName = MyGUI::FontManager::getInstance().getDefaultFont();
-            else
-                fullFontName = fontName;
-
-            if (useBookFont)
-                fullFontName = "Journalbook " + fullFontName;
-
-            for (Styles::iterator i = mBook->mStyles.begin(); i != mBook->mStyles.end(); ++i)
-                if (i->match(fullFontName.c_str(), fontColour, fontColour, fontColour, 0))
-                    return &*i;
-
-            MyGUI::IFont* font = MyGUI::FontManager::getInstance().getByName(fullFontName);
-            if (!font)
-                throw std::runtime_error(std::string("can't find font ") + fullFontName);
-
-            StyleImpl& style = *mBook->mStyles.insert(mBook->mStyles.end(), StyleImpl());
-            style.mFont = font;
-            style.mHotColour = fontColour;
-            style.mActiveColour = fontColour;
-            style.mNormalColour = fontColour;
-            style.mInteractiveId = 0;
-
-            return &style;
-        }
-
-        Style* createHotStyle(Style* baseStyle, const Colour& normalColour, const Colour& hoverColour,
-            const Colour& activeColour, InteractiveId id, bool unique) override
+            , mCurrentAlignment(BookTypesetter::AlignLeft)
+            , mPaginatedSections(0)
+            , mCurPageStart(0)
+            , mCurPageStop(0)
         {
-            StyleImpl* BaseStyle = static_cast<StyleImpl*>(baseStyle);
-
-            if (!unique)
-                for (Styles::iterator i = mBook->mStyles.begin(); i != mBook->mStyles.end(); ++i)
-                    if (i->match(BaseStyle->mFont, hoverColour, activeColour, normalColour, id))
-                        return &*i;
-
-            StyleImpl& style = *mBook->mStyles.insert(mBook->mStyles.end(), StyleImpl());
-
-            style.mFont = BaseStyle->mFont;
-            style.mHotColour = hoverColour;
-            style.mActiveColour = activeColour;
-            style.mNormalColour = normalColour;
-            style.mInteractiveId = id;
-
-            return &style;
         }
 
-        void write(Style* style, Utf8Span text) override
+        /// Lays out the input until the page is complete or the input is exhausted.
+        /// Returns true once the whole document is laid out.
+        bool layoutPage(std::size_t page)
         {
-            Range range = mBook->addContent(text);
-
-            writeImpl(static_cast<StyleImpl*>(style), range.first, range.second);
-        }
-
-        intptr_t addContent(Utf8Span text, bool select) override
-        {
-            add_partial_text();
+            const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
 
-            Contents::iterator i = mBook->mContents.insert(mBook->mContents.end(), Content(text.first, text.second));
-
-            if (select)
-                mCurrentContent = &(*i);
+            while (mBook.mPages.size() <= page && mNextOperation < mOperations.size())
+            {
+                apply(mOperations[mNextOperation++]);
 
-            return reinterpret_cast<intptr_t>(&(*i));
-        }
+                // The current section may still grow, so only the sections before it can be paginated
+                paginate(mSection != nullptr ? mBook.mSections.size() - 1 : mBook.mSections.size());
+            }
 
-        void selectContent(intptr_t contentHandle) override
-        {
-            add_partial_text();
+            const bool complete = mBook.mPages.size() <= page;
 
-            mCurrentContent = reinterpret_cast<Content const*>(contentHandle);
-        }
+            if (complete)
+            {
+                add_partial_text();
+                paginate(mBook.mSections.size());
 
-        void write(Style* style, size_t begin, size_t end) override
-        {
-            assert(mCurrentContent != nullptr);
-            assert(end <= mCurrentContent->size());
-            assert(begin <= mCurrentContent->size());
+                if (mCurPageStart != mCurPageStop)
+                    mBook.mPages.push_back(Page(mCurPageStart, mCurPageStop));
+            }
 
-            Utf8Point begin_ = mCurrentContent->data() + begin;
-            Utf8Point end_ = mCurrentContent->data() + end;
+            mLayoutDuration += std::chrono::steady_clock::now() - start;
+            sLastLayoutDuration = mLayoutDuration;
 
-            writeImpl(static_cast<StyleImpl*>(style), begin_, end_);
+            return complete;
         }
 
-        void lineBreak(float margin) override
+        void apply(const Operation& operation)
         {
-            assert(margin == 0); // TODO: figure out proper behavior here...
-
-            add_partial_text();
-
-            mRun = nullptr;
-            mLine = nullptr;
+            switch (operation.mType)
+            {
+                case Operation::Write:
+                    writeImpl(operation.mStyle, operation.mBegin, operation.mEnd);
+                    break;
+                case Operation::Flush:
+                    add_partial_text();
+                    break;
+                case Operation::LineBreak:
+                    add_partial_text();
+                    mRun = nullptr;
+                    mLine = nullptr;
+                    break;
+                case Operation::SectionBreak:
+                    sectionBreak(operation.mValue);
+                    break;
+                case Operation::SetSectionAlignment:
+                    setSectionAlignment(static_cast<Alignment>(operation.mValue));
+                    break;
+            }
         }
 
-        void sectionBreak(int margin) override
+        void sectionBreak(int margin)
         {
             add_partial_text();
 
-            if (mBook->mSections.size() > 0)
+            if (mBook.mSections.size() > 0)
             {
                 mRun = nullptr;
                 mLine = nullptr;
                 mSection = nullptr;
 
-                if (mBook->mRect.bottom < (mBook->mSections.back().mRect.bottom + margin))
-                    mBook->mRect.bottom = (mBook->mSections.back().mRect.bottom + margin);
+                if (mBook.mRect.bottom < (mBook.mSections.back().mRect.bottom + margin))
+                    mBook.mRect.bottom = (mBook.mSections.back().mRect.bottom + margin);
             }
         }
 
-        void setSectionAlignment(Alignment sectionAlignment) override
+        void setSectionAlignment(Alignment sectionAlignment)
         {
             add_partial_text();
 
@@ -390,32 +434,30 @@ namespace MWGui
             mCurrentAlignment = sectionAlignment;
         }
 
-        TypesetBook::Ptr complete() override
+        /// Aligns the lines of the sections up to sectionCount and breaks them into pages. A page is added once the
+        /// next section doesn't fit on it, the last page is added when the whole document is laid out.
+        void paginate(std::size_t sectionCount)
         {
-            int curPageStart = 0;
-            int curPageStop = 0;
-
-            add_partial_text();
-
-            std::vector<Alignment>::iterator sa = mSectionAlignment.begin();
-            for (Sections::iterator i = mBook->mSections.begin(); i != mBook->mSections.end(); ++i, ++sa)
+            for (; mPaginatedSections < sectionCount; ++mPaginatedSections)
             {
+                Sections::iterator i = mBook.mSections.begin() + mPaginatedSections;
+
                 // apply alignment to individual lines...
                 for (Lines::iterator j = i->mLines.begin(); j != i->mLines.end(); ++j)
                 {
                     int width = j->mRect.width();
                     int excess = mPageWidth - width;
 
-                    switch (*sa)
+                    switch (mSectionAlignment[mPaginatedSections])
                     {
                         default:
-                        case AlignLeft:
+                        case BookTypesetter::AlignLeft:
                             j->mRect.left = 0;
                             break;
-                        case AlignCenter:
+                        case BookTypesetter::AlignCenter:
                             j->mRect.left = excess / 2;
                             break;
-                        case AlignRight:
+                        case BookTypesetter::AlignRight:
                             j->mRect.left = excess;
                             break;
                     }
@@ -423,18 +465,18 @@ namespace MWGui
                     j->mRect.right = j->mRect.left + width;
                 }
 
-                if (curPageStop == curPageStart)
+                if (mCurPageStop == mCurPageStart)
                 {
-                    curPageStart = i->mRect.top;
-                    curPageStop = i->mRect.top;
+                    mCurPageStart = i->mRect.top;
+                    mCurPageStop = i->mRect.top;
                 }
 
-                int spaceLeft = mPageHeight - (curPageStop - curPageStart);
+                int spaceLeft = mPageHeight - (mCurPageStop - mCurPageStart);
                 int sectionHeight = i->mRect.height();
 
                 // This is NOT equal to i->mRect.height(), which doesn't account for section breaks.
-                int spaceRequired = (i->mRect.bottom - curPageStop);
-                if (curPageStart == curPageStop) // If this is a new page, the section break is not needed
+                int spaceRequired = (i->mRect.bottom - mCurPageStop);
+                if (mCurPageStart == mCurPageStop) // If this is a new page, the section break is not needed
                     spaceRequired = i->mRect.height();
 
                 if (spaceRequired <= mPageHeight)
@@ -443,54 +485,49 @@ namespace MWGui
                     {
                         // The section won't completely fit on the current page. Finish the current page and start a new
                         // one.
-                        assert(curPageStart != curPageStop);
+                        assert(mCurPageStart != mCurPageStop);
 
-                        mBook->mPages.push_back(Page(curPageStart, curPageStop));
+                        mBook.mPages.push_back(Page(mCurPageStart, mCurPageStop));
 
-                        curPageStart = i->mRect.top;
-                        curPageStop = i->mRect.bottom;
+                        mCurPageStart = i->mRect.top;
+                        mCurPageStop = i->mRect.bottom;
                     }
                     else
-                        curPageStop = i->mRect.bottom;
+                        mCurPageStop = i->mRect.bottom;
                 }
                 else
                 {
                     // The section won't completely fit on the current page. Finish the current page and start a new
                     // one.
-                    mBook->mPages.push_back(Page(curPageStart, curPageStop));
+                    mBook.mPages.push_back(Page(mCurPageStart, mCurPageStop));
 
-                    curPageStart = i->mRect.top;
-                    curPageStop = i->mRect.bottom;
+                    mCurPageStart = i->mRect.top;
+                    mCurPageStop = i->mRect.bottom;
 
                     // split section
                     int sectionHeightLeft = sectionHeight;
                     while (sectionHeightLeft >= mPageHeight)
                     {
                         // Adjust to the top of the first line that does not fit on the current page anymore
-                        int splitPos = curPageStop;
+                        int splitPos = mCurPageStop;
                         for (Lines::iterator j = i->mLines.begin(); j != i->mLines.end(); ++j)
                         {
-                            if (j->mRect.bottom > curPageStart + mPageHeight)
+                            if (j->mRect.bottom > mCurPageStart + mPageHeight)
                             {
                                 splitPos = j->mRect.top;
                                 break;
                             }
                         }
 
-                        mBook->mPages.push_back(Page(curPageStart, splitPos));
-                        curPageStart = splitPos;
-                        curPageStop = splitPos;
+                        mBook.mPages.push_back(Page(mCurPageStart, splitPos));
+                        mCurPageStart = splitPos;
+                        mCurPageStop = splitPos;
 
                         sectionHeightLeft = (i->mRect.bottom - splitPos);
                     }
-                    curPageStop = i->mRect.bottom;
+                    mCurPageStop = i->mRect.bottom;
                 }
             }
-
-            if (curPageStart != curPageStop)
-                mBook->mPages.push_back(Page(curPageStart, curPageStop));
-
-            return mBook;
         }
 
         void writeImpl(StyleImpl* style, Utf8Stream::Point _begin, Utf8Stream::Point _end)
@@ -575,7 +612,7 @@ namespace MWGui
             {
                 for (PartialTextConstIterator i = mPartialWhitespace.begin(); i != mPartialWhitespace.end(); ++i)
                 {
-                    int top = mLine ? mLine->mRect.top : mBook->mRect.bottom;
+                    int top = mLine ? mLine->mRect.top : mBook.mRect.bottom;
 
                     append_run(i->mStyle, i->mBegin, i->mEnd, 0, left + i->mWidth, top + fontHeight);
 
@@ -585,7 +622,7 @@ namespace MWGui
 
             for (PartialTextConstIterator i = mPartialWord.begin(); i != mPartialWord.end(); ++i)
             {
-                int top = mLine ? mLine->mRect.top : mBook->mRect.bottom;
+                int top = mLine ? mLine->mRect.top : mBook.mRect.bottom;
 
                 append_run(i->mStyle, i->mBegin, i->mEnd, i->mEnd - i->mBegin, left + i->mWidth, top + fontHeight);
 
@@ -600,9 +637,9 @@ namespace MWGui
         {
             if (mSection == nullptr)
             {
-                mBook->mSections.push_back(Section());
-                mSection = &mBook->mSections.back();
-                mSection->mRect = MyGUI::IntRect(0, mBook->mRect.bottom, 0, mBook->mRect.bottom);
+                mBook.mSections.push_back(Section());
+                mSection = &mBook.mSections.back();
+                mSection->mRect = MyGUI::IntRect(0, mBook.mRect.bottom, 0, mBook.mRect.bottom);
                 mSectionAlignment.push_back(mCurrentAlignment);
             }
 
@@ -610,14 +647,14 @@ namespace MWGui
             {
                 mSection->mLines.push_back(Line());
                 mLine = &mSection->mLines.back();
-                mLine->mRect = MyGUI::IntRect(0, mSection->mRect.bottom, 0, mBook->mRect.bottom);
+                mLine->mRect = MyGUI::IntRect(0, mSection->mRect.bottom, 0, mBook.mRect.bottom);
             }
 
-            if (mBook->mRect.right < right)
-                mBook->mRect.right = right;
+            if (mBook.mRect.right < right)
+                mBook.mRect.right = right;
 
-            if (mBook->mRect.bottom < bottom)
-                mBook->mRect.bottom = bottom;
+            if (mBook.mRect.bottom < bottom)
+                mBook.mRect.bottom = bottom;
 
             if (mSection->mRect.right < right)
                 mSection->mRect.right = right;
@@ -654,11 +691,259 @@ namespace MWGui
         }
     };
 
+    TypesetBookImpl::~TypesetBookImpl() {}
+
+    void TypesetBookImpl::layoutPage(std::size_t page) const
+    {
+        if (mLayout != nullptr && mLayout->layoutPage(page))
+            mLayout.reset();
+    }
+
+    // Records the input and hashes it as it streams in. complete() returns the cached book for the same input and
+    // page size, otherwise the input is laid out lazily by the returned book.
+    struct TypesetBookImpl::Typesetter : BookTypesetter
+    {
+        typedef TypesetBookImpl Book;
+        typedef std::shared_ptr<Book> BookPtr;
+        typedef Layout::Operation Operation;
+
+        enum class Input
+        {
+            Style,
+            HotStyle,
+            Write,
+            AddContent,
+            SelectContent,
+            WriteContent,
+            LineBreak,
+            SectionBreak,
+            SectionAlignment
+        };
+
+        int mPageWidth;
+        int mPageHeight;
+
+        BookPtr mBook;
+        Layout::Operations mOperations;
+
+        Book::Content const* mCurrentContent;
+        std::unordered_map<Book::Content const*, std::size_t> mContentIndices;
+
+        std::size_t mInputHash;
+
+        Typesetter(size_t width, size_t height)
+            : mPageWidth(width)
+            , mPageHeight(height)
+            , mCurrentContent(nullptr)
+            , mInputHash(0)
+        {
+            mBook = std::make_shared<Book>();
+        }
+
+        virtual ~Typesetter() {}
+
+        void hashInput(Input input) { Misc::hashCombine(mInputHash, input); }
+
+        void hashText(Utf8Span text)
+        {
+            const std::string_view view(
+                reinterpret_cast<const char*>(text.first), static_cast<std::size_t>(text.second - text.first));
+            Misc::hashCombine(mInputHash, view);
+        }
+
+        void hashColour(const Colour& colour)
+        {
+            Misc::hashCombine(mInputHash, colour.red);
+            Misc::hashCombine(mInputHash, colour.green);
+            Misc::hashCombine(mInputHash, colour.blue);
+            Misc::hashCombine(mInputHash, colour.alpha);
+        }
+
+        void hashStyle(const StyleImpl* style) { Misc::hashCombine(mInputHash, style->mIndex); }
+
+        Style* createStyle(const std::string& fontName, const Colour& fontColour, bool useBookFont) override
+        {
+            std::string fullFontName;
+            if (fontName.empty())
+                fullFontName = MyGUI::FontManager::getInstance().getDefaultFont();
+            else
+                fullFontName = fontName;
+
+            if (useBookFont)
+                fullFontName = "Journalbook " + fullFontName;
+
+            for (Styles::iterator i = mBook->mStyles.begin(); i != mBook->mStyles.end(); ++i)
+                if (i->match(fullFontName.c_str(), fontColour, fontColour, fontColour, 0))
+                    return &*i;
+
+            MyGUI::IFont* font = MyGUI::FontManager::getInstance().getByName(fullFontName);
+            if (!font)
+                throw std::runtime_error(std::string("can't find font ") + fullFontName);
+
+            StyleImpl& style = *mBook->mStyles.insert(mBook->mStyles.end(), StyleImpl());
+            style.mFont = font;
+            style.mHotColour = fontColour;
+            style.mActiveColour = fontColour;
+            style.mNormalColour = fontColour;
+            style.mInteractiveId = 0;
+            style.mIndex = mBook->mStyles.size() - 1;
+
+            hashInput(Input::Style);
+            Misc::hashCombine(mInputHash, fullFontName);
+            hashColour(fontColour);
+
+            return &style;
+        }
+
+        Style* createHotStyle(Style* baseStyle, const Colour& normalColour, const Colour& hoverColour,
+            const Colour& activeColour, InteractiveId id, bool unique) override
+        {
+            StyleImpl* BaseStyle = static_cast<StyleImpl*>(baseStyle);
+
+            if (!unique)
+                for (Styles::iterator i = mBook->mStyles.begin(); i != mBook->mStyles.end(); ++i)
+                    if (i->match(BaseStyle->mFont, hoverColour, activeColour, normalColour, id))
+                        return &*i;
+
+            StyleImpl& style = *mBook->mStyles.insert(mBook->mStyles.end(), StyleImpl());
+
+            style.mFont = BaseStyle->mFont;
+            style.mHotColour = hoverColour;
+            style.mActiveColour = activeColour;
+            style.mNormalColour = normalColour;
+            style.mInteractiveId = id;
+            style.mIndex = mBook->mStyles.size() - 1;
+
+            hashInput(Input::HotStyle);
+            hashStyle(BaseStyle);
+            hashColour(normalColour);
+            hashColour(hoverColour);
+            hashColour(activeColour);
+            Misc::hashCombine(mInputHash, id);
+
+            return &style;
+        }
+
+        void write(Style* style, Utf8Span text) override
+        {
+            StyleImpl* styleImpl = static_cast<StyleImpl*>(style);
+            Range range = mBook->addContent(text);
+
+            hashInput(Input::Write);
+            hashStyle(styleImpl);
+            hashText(text);
+
+            mOperations.push_back({ Operation::Write, styleImpl, range.first, range.second, 0 });
+        }
+
+        intptr_t addContent(Utf8Span text, bool select) override
+        {
+            mOperations.push_back({ Operation::Flush, nullptr, nullptr, nullptr, 0 });
+
+            Contents::iterator i = mBook->mContents.insert(mBook->mContents.end(), Content(text.first, text.second));
+            mContentIndices.emplace(&(*i), mContentIndices.size());
+
+            hashInput(Input::AddContent);
+            hashText(text);
+            Misc::hashCombine(mInputHash, select);
+
+            if (select)
+                mCurrentContent = &(*i);
+
+            return reinterpret_cast<intptr_t>(&(*i));
+        }
+
+        void selectContent(intptr_t contentHandle) override
+        {
+            mOperations.push_back({ Operation::Flush, nullptr, nullptr, nullptr, 0 });
+
+            mCurrentContent = reinterpret_cast<Content const*>(contentHandle);
+
+            hashInput(Input::SelectContent);
+            Misc::hashCombine(mInputHash, mContentIndices.at(mCurrentContent));
+        }
+
+        void write(Style* style, size_t begin, size_t end) override
+        {
+            assert(mCurrentContent != nullptr);
+            assert(end <= mCurrentContent->size());
+            assert(begin <= mCurrentContent->size());
+
+            Utf8Point begin_ = mCurrentContent->data() + begin;
+            Utf8Point end_ = mCurrentContent->data() + end;
+
+            StyleImpl* styleImpl = static_cast<StyleImpl*>(style);
+
+            hashInput(Input::WriteContent);
+            hashStyle(styleImpl);
+            Misc::hashCombine(mInputHash, begin);
+            Misc::hashCombine(mInputHash, end);
+
+            mOperations.push_back({ Operation::Write, styleImpl, begin_, end_, 0 });
+        }
+
+        void lineBreak(float margin) override
+        {
+            assert(margin == 0); // TODO: figure out proper behavior here...
+
+            hashInput(Input::LineBreak);
+
+            mOperations.push_back({ Operation::LineBreak, nullptr, nullptr, nullptr, 0 });
+        }
+
+        void sectionBreak(int margin) override
+        {
+            hashInput(Input::SectionBreak);
+            Misc::hashCombine(mInputHash, margin);
+
+            mOperations.push_back({ Operation::SectionBreak, nullptr, nullptr, nullptr, margin });
+        }
+
+        void setSectionAlignment(Alignment sectionAlignment) override
+        {
+            const int alignment = static_cast<int>(sectionAlignment);
+
+            hashInput(Input::SectionAlignment);
+            Misc::hashCombine(mInputHash, alignment);
+
+            mOperations.push_back({ Operation::SetSectionAlignment, nullptr, nullptr, nullptr, alignment });
+        }
+
+        TypesetBook::Ptr complete() override
+        {
+            const LayoutKey key{ mInputHash, mPageWidth, mPageHeight,
+                MWBase::Environment::get().getWindowManager()->getFontHeight() };
+
+            LayoutCache::iterator cached = std::find_if(
+                sLayoutCache.begin(), sLayoutCache.end(), [&](const auto& v) { return v.first == key; });
+
+            if (cached != sLayoutCache.end())
+            {
+                sLayoutCache.splice(sLayoutCache.begin(), sLayoutCache, cached);
+                sLastLayoutDuration = {};
+                return cached->second;
+            }
+
+            mBook->mLayout = std::make_unique<Layout>(*mBook, mPageWidth, mPageHeight, std::move(mOperations));
+
+            sLayoutCache.emplace_front(key, mBook);
+            if (sLayoutCache.size() > sLayoutCacheSize)
+                sLayoutCache.pop_back();
+
+            return mBook;
+        }
+    };
+
     BookTypesetter::Ptr BookTypesetter::create(int pageWidth, int pageHeight)
     {
         return std::make_shared<TypesetBookImpl::Typesetter>(pageWidth, pageHeight);
     }
 
+    std::chrono::steady_clock::duration BookTypesetter::getLastLayoutDuration()
+    {
+        return sLastLayoutDuration;
+    }
+
     namespace
     {
         struct RenderXform
@@ -741,41 +1026,74 @@ namespace MWGui
             }
         };
 
+        struct GlyphQuad
+        {
+            MyGUI::FloatRect mVertexRect;
+            MyGUI::FloatRect mTextureRect;
+            uint32_t mColour;
+        };
+
+        // Glyph quads of a single font on the displayed page. Positions are relative to the page top, so the
+        // batch is reused while the widget moves or scrolls and is rebuilt only when the page changes. Hover
+        // and press only recolour the quads of interactive runs.
+        struct GlyphBatch
+        {
+            struct Line
+            {
+                float mTop;
+                float mBottom;
+                std::size_t mEnd; // index past the last quad of the line
+            };
+
+            struct InteractiveRun
+            {
+                const TypesetBookImpl::StyleImpl* mStyle;
+                std::size_t mBegin;
+                std::size_t mEnd;
+            };
+
+            std::vector<GlyphQuad> mQuads;
+            std::vector<Line> mLines;
+            std::vector<InteractiveRun> mInteractiveRuns;
+            bool mValid = false;
+            bool mColoursValid = false;
+        };
+
+        uint32_t toVertexColour(const MyGUI::Colour& colour, MyGUI::VertexColourType vertexColourType)
+        {
+            uint32_t result = MyGUI::texture_utility::toColourARGB(colour) | 0xFF000000;
+            MyGUI::texture_utility::convertColour(result, vertexColourType);
+            return result;
+        }
+
         struct GlyphStream
         {
-            float mZ;
             uint32_t mC;
             MyGUI::IFont* mFont;
-            MyGUI::FloatPoint mOrigin;
+            float mPageTop;
             MyGUI::FloatPoint mCursor;
-            MyGUI::Vertex* mVertices;
-            RenderXform mRenderXform;
+            GlyphBatch& mBatch;
             MyGUI::VertexColourType mVertexColourType;
 
-            GlyphStream(MyGUI::IFont* font, float left, float top, float Z, MyGUI::Vertex* vertices,
-                RenderXform const& renderXform)
-                : mZ(Z)
-                , mC(0)
+            GlyphStream(MyGUI::IFont* font, float pageTop, GlyphBatch& batch)
+                : mC(0)
                 , mFont(font)
-                , mOrigin(left, top)
-                , mVertices(vertices)
-                , mRenderXform(renderXform)
+                , mPageTop(pageTop)
+                , mBatch(batch)
             {
                 assert(font != nullptr);
                 mVertexColourType = MyGUI::RenderManager::getInstance().getVertexFormat();
             }
 
-            ~GlyphStream() = default;
-
-            MyGUI::Vertex* end() const { return mVertices; }
-
-            void reset(float left, float top, MyGUI::Colour colour)
+            void reset(float left, float top, float bottom, MyGUI::Colour colour)
             {
-                mC = MyGUI::texture_utility::toColourARGB(colour) | 0xFF000000;
-                MyGUI::texture_utility::convertColour(mC, mVertexColourType);
+                mC = toVertexColour(colour, mVertexColourType);
+
+                mCursor.left = left;
+                mCursor.top = top - mPageTop;
 
-                mCursor.left = mOrigin.left + left;
-                mCursor.top = mOrigin.top + top;
+                if (mBatch.mLines.empty() || mBatch.mLines.back().mTop != mCursor.top)
+                    mBatch.mLines.push_back({ mCursor.top, bottom - mPageTop, mBatch.mQuads.size() });
             }
 
             void emitGlyph(wchar_t ch)
@@ -785,17 +1103,16 @@ namespace MWGui
                 if (!info.charFound)
                     return;
 
-                MyGUI::FloatRect vr;
+                GlyphQuad& quad = mBatch.mQuads.emplace_back();
 
-                vr.left = mCursor.left + info.bearingX;
-                vr.top = mCursor.top + info.bearingY;
-                vr.right = vr.left + info.width;
-                vr.bottom = vr.top + info.height;
+                quad.mVertexRect.left = mCursor.left + info.bearingX;
+                quad.mVertexRect.top = mCursor.top + info.bearingY;
+                quad.mVertexRect.right = quad.mVertexRect.left + info.width;
+                quad.mVertexRect.bottom = quad.mVertexRect.top + info.height;
+                quad.mTextureRect = info.uvRect;
+                quad.mColour = mC;
 
-                MyGUI::FloatRect tr = info.uvRect;
-
-                if (mRenderXform.clip(vr, tr))
-                    quad(vr, tr);
+                mBatch.mLines.back().mEnd = mBatch.mQuads.size();
 
                 mCursor.left += static_cast<int>(info.bearingX + info.advance);
             }
@@ -807,19 +1124,44 @@ namespace MWGui
                 if (info.charFound)
                     mCursor.left += static_cast<int>(info.bearingX + info.advance);
             }
+        };
 
-        private:
-            void quad(const MyGUI::FloatRect& vr, const MyGUI::FloatRect& tr)
+        struct VertexStream
+        {
+            float mZ;
+            MyGUI::FloatPoint mOrigin;
+            MyGUI::Vertex* mVertices;
+            RenderXform mRenderXform;
+
+            VertexStream(float left, float top, float Z, MyGUI::Vertex* vertices, RenderXform const& renderXform)
+                : mZ(Z)
+                , mOrigin(left, top)
+                , mVertices(vertices)
+                , mRenderXform(renderXform)
             {
-                vertex(vr.left, vr.top, tr.left, tr.top);
-                vertex(vr.right, vr.top, tr.right, tr.top);
-                vertex(vr.left, vr.bottom, tr.left, tr.bottom);
-                vertex(vr.right, vr.top, tr.right, tr.top);
-                vertex(vr.left, vr.bottom, tr.left, tr.bottom);
-                vertex(vr.right, vr.bottom, tr.right, tr.bottom);
             }
 
-            void vertex(float x, float y, float u, float v)
+            MyGUI::Vertex* end() const { return mVertices; }
+
+            void emitQuad(const GlyphQuad& quad)
+            {
+                MyGUI::FloatRect vr(quad.mVertexRect.left + mOrigin.left, quad.mVertexRect.top + mOrigin.top,
+                    quad.mVertexRect.right + mOrigin.left, quad.mVertexRect.bottom + mOrigin.top);
+                MyGUI::FloatRect tr = quad.mTextureRect;
+
+                if (!mRenderXform.clip(vr, tr))
+                    return;
+
+                vertex(vr.left, vr.top, tr.left, tr.top, quad.mColour);
+                vertex(vr.right, vr.top, tr.right, tr.top, quad.mColour);
+                vertex(vr.left, vr.bottom, tr.left, tr.bottom, quad.mColour);
+                vertex(vr.right, vr.top, tr.right, tr.top, quad.mColour);
+                vertex(vr.left, vr.bottom, tr.left, tr.bottom, quad.mColour);
+                vertex(vr.right, vr.bottom, tr.right, tr.bottom, quad.mColour);
+            }
+
+        private:
+            void vertex(float x, float y, float u, float v, uint32_t colour)
             {
                 MyGUI::FloatPoint pt = mRenderXform(MyGUI::FloatPoint(x, y));
 
@@ -828,7 +1170,7 @@ namespace MWGui
                 mVertices->z = mZ;
                 mVertices->u = u;
                 mVertices->v = v;
-                mVertices->colour = mC;
+                mVertices->colour = colour;
 
                 ++mVertices;
             }
@@ -854,6 +1196,7 @@ namespace MWGui
             MyGUI::ITexture* mTexture;
             MyGUI::RenderItem* mRenderItem;
             PageDisplay* mDisplay;
+            GlyphBatch mBatch;
 
             TextFormat(MyGUI::IFont* id, PageDisplay* display)
                 : mFont(id)
@@ -913,7 +1256,7 @@ namespace MWGui
             if (!mBook)
                 return {};
 
-            if (mPage >= mBook->mPages.size())
+            if (mBook->getPage(mPage) == nullptr)
                 return {};
 
             MyGUI::IntPoint pos(left, top);
@@ -956,7 +1299,12 @@ namespace MWGui
             {
                 MyGUI::IFont* Font = mBook->affectedFont(mFocusItem);
 
+                // The hit test margin can reach a line of the neighbouring page, which may use other fonts
                 ActiveTextFormats::iterator i = mActiveTextFormats.find(Font);
+                if (i == mActiveTextFormats.end())
+                    return;
+
+                i->second->mBatch.mColoursValid = false;
 
                 if (mNode)
                     mNode->outOfDate(i->second->mRenderItem);
@@ -968,7 +1316,7 @@ namespace MWGui
             if (!mBook)
                 return;
 
-            if (mPage >= mBook->mPages.size())
+            if (mBook->getPage(mPage) == nullptr)
                 return;
 
             dirtyFocusItem();
@@ -1015,6 +1363,8 @@ namespace MWGui
 
             if (pos && mLastDown == MyGUI::MouseButton::None)
             {
+                dirtyFocusItem();
+
                 mFocusItem = pos->top <= mViewBottom ? mBook->hitTestWithMargin(pos->left, pos->top) : nullptr;
                 mItemActive = true;
 
@@ -1051,63 +1401,39 @@ namespace MWGui
 
             if (mBook != newBook)
             {
-                mFocusItem = nullptr;
-                mItemActive = 0;
+                mBook = newBook;
 
-                for (ActiveTextFormats::iterator i = mActiveTextFormats.begin(); i != mActiveTextFormats.end(); ++i)
-                {
-                    if (mNode != nullptr && i->second != nullptr)
-                        i->second->destroyDrawItem(mNode);
-                    i->second.reset();
-                }
-
-                mActiveTextFormats.clear();
-
-                if (newBook != nullptr)
-                {
-                    createActiveFormats(newBook);
-
-                    mBook = newBook;
+                if (mBook != nullptr)
                     setPage(newPage);
-
-                    if (newPage < mBook->mPages.size())
-                    {
-                        mViewTop = mBook->mPages[newPage].first;
-                        mViewBottom = mBook->mPages[newPage].second;
-                    }
-                    else
-                    {
-                        mViewTop = 0;
-                        mViewBottom = 0;
-                    }
-                }
                 else
-                {
-                    mBook.reset();
                     resetPage();
-                    mViewTop = 0;
-                    mViewBottom = 0;
-                }
             }
             else if (mBook && isPageDifferent(newPage))
-            {
-                if (mNode != nullptr)
-                    for (ActiveTextFormats::iterator i = mActiveTextFormats.begin(); i != mActiveTextFormats.end(); ++i)
-                        mNode->outOfDate(i->second->mRenderItem);
-
                 setPage(newPage);
+            else
+                return;
 
-                if (newPage < mBook->mPages.size())
-                {
-                    mViewTop = mBook->mPages[newPage].first;
-                    mViewBottom = mBook->mPages[newPage].second;
-                }
-                else
-                {
-                    mViewTop = 0;
-                    mViewBottom = 0;
-                }
+            // The draw items are sized for the displayed page, so they are recreated when it changes
+            mFocusItem = nullptr;
+            mItemActive = false;
+
+            destroyActiveFormats();
+
+            const TypesetBookImpl::Page* page = mBook != nullptr ? mBook->getPage(newPage) : nullptr;
+
+            if (page != nullptr)
+            {
+                mViewTop = page->first;
+                mViewBottom = page->second;
+            }
+            else
+            {
+                mViewTop = 0;
+                mViewBottom = 0;
             }
+
+            if (mBook != nullptr)
+                createActiveFormats();
         }
 
         struct CreateActiveFormat
@@ -1138,15 +1464,27 @@ namespace MWGui
             }
         };
 
-        void createActiveFormats(std::shared_ptr<TypesetBookImpl> newBook)
+        void createActiveFormats()
         {
-            newBook->visitRuns(0, 0x7FFFFFFF, CreateActiveFormat(this));
+            mBook->visitRuns(mViewTop, mViewBottom, CreateActiveFormat(this));
 
             if (mNode != nullptr)
                 for (ActiveTextFormats::iterator i = mActiveTextFormats.begin(); i != mActiveTextFormats.end(); ++i)
                     i->second->createDrawItem(mNode);
         }
 
+        void destroyActiveFormats()
+        {
+            for (ActiveTextFormats::iterator i = mActiveTextFormats.begin(); i != mActiveTextFormats.end(); ++i)
+            {
+                if (mNode != nullptr && i->second != nullptr)
+                    i->second->destroyDrawItem(mNode);
+                i->second.reset();
+            }
+
+            mActiveTextFormats.clear();
+        }
+
         void setVisible(bool newVisible) override
         {
             if (mVisible == newVisible)
@@ -1158,6 +1496,8 @@ namespace MWGui
             {
                 // reset input state
                 mLastDown = MyGUI::MouseButton::None;
+                dirtyFocusItem();
+
                 mFocusItem = nullptr;
                 mItemActive = 0;
             }
@@ -1190,14 +1530,12 @@ namespace MWGui
 
             void operator()(Section const& section, Line const& line, Run const& run) const
             {
-                bool isActive = run.mStyle->mInteractiveId && (run.mStyle == this_->mFocusItem);
-
-                MyGUI::Colour colour = isActive
-                    ? (this_->mItemActive ? run.mStyle->mActiveColour : run.mStyle->mHotColour)
-                    : run.mStyle->mNormalColour;
-
                 glyphStream.reset(static_cast<float>(section.mRect.left + line.mRect.left + run.mLeft),
-                    static_cast<float>(line.mRect.top), colour);
+                    static_cast<float>(line.mRect.top), static_cast<float>(line.mRect.bottom),
+                    this_->getColour(*run.mStyle));
+
+                GlyphBatch& batch = glyphStream.mBatch;
+                const std::size_t begin = batch.mQuads.size();
 
                 Utf8Stream stream(run.mRange);
 
@@ -1213,9 +1551,52 @@ namespace MWGui
                     else
                         glyphStream.emitSpace(code_point);
                 }
+
+                if (run.mStyle->mInteractiveId != 0)
+                    batch.mInteractiveRuns.push_back({ run.mStyle, begin, batch.mQuads.size() });
             }
         };
 
+        MyGUI::Colour getColour(const Style& style) const
+        {
+            if (style.mInteractiveId == 0 || &style != mFocusItem)
+                return style.mNormalColour;
+            return mItemActive ? style.mActiveColour : style.mHotColour;
+        }
+
+        /*
+            lay out glyphs of the current page for this text format
+        */
+        void updateBatch(TextFormat& textFormat)
+        {
+            GlyphBatch& batch = textFormat.mBatch;
+
+            batch.mQuads.clear();
+            batch.mLines.clear();
+            batch.mInteractiveRuns.clear();
+
+            GlyphStream glyphStream(textFormat.mFont, static_cast<float>(mViewTop), batch);
+
+            mBook->visitRuns(mViewTop, mViewBottom, textFormat.mFont, RenderRun(this, glyphStream));
+
+            batch.mValid = true;
+            batch.mColoursValid = true;
+        }
+
+        void updateBatchColours(GlyphBatch& batch)
+        {
+            const MyGUI::VertexColourType vertexColourType = MyGUI::RenderManager::getInstance().getVertexFormat();
+
+            for (const GlyphBatch::InteractiveRun& run : batch.mInteractiveRuns)
+            {
+                const uint32_t colour = toVertexColour(getColour(*run.mStyle), vertexColourType);
+                for (std::size_t i = run.mBegin; i < run.mEnd; ++i)
+                    batch.mQuads[i].mColour = colour;
+            }
+
+            batch.mColoursValid = true;
+        }
+
         /*
             queue up rendering operations for this text format
         */
@@ -1224,21 +1605,34 @@ namespace MWGui
             if (!mVisible)
                 return;
 
+            if (!textFormat.mBatch.mValid)
+                updateBatch(textFormat);
+            else if (!textFormat.mBatch.mColoursValid)
+                updateBatchColours(textFormat.mBatch);
+
+            const GlyphBatch& batch = textFormat.mBatch;
+
             MyGUI::Vertex* vertices = textFormat.mRenderItem->getCurrentVertexBuffer();
 
             RenderXform renderXform(mCroppedParent, textFormat.mRenderItem->getRenderTarget()->getInfo());
 
             float z = SceneUtil::AutoDepth::isReversed() ? 1.f : -1.f;
 
-            GlyphStream glyphStream(textFormat.mFont, static_cast<float>(mCoord.left),
-                static_cast<float>(mCoord.top - mViewTop), z /*mNode->getNodeDepth()*/, vertices, renderXform);
+            VertexStream vertexStream(static_cast<float>(mCoord.left), static_cast<float>(mCoord.top),
+                z /*mNode->getNodeDepth()*/, vertices, renderXform);
+
+            const float visibleTop = renderXform.clipTop - mCoord.top;
+            const float visibleBottom = renderXform.clipBottom - mCoord.top;
 
-            int visit_top = (std::max)(mViewTop, mViewTop + int(renderXform.clipTop));
-            int visit_bottom = (std::min)(mViewBottom, mViewTop + int(renderXform.clipBottom));
+            auto line = std::partition_point(batch.mLines.begin(), batch.mLines.end(),
+                [&](const GlyphBatch::Line& v) { return v.mBottom <= visibleTop; });
+            std::size_t quad = line == batch.mLines.begin() ? 0 : std::prev(line)->mEnd;
 
-            mBook->visitRuns(visit_top, visit_bottom, textFormat.mFont, RenderRun(this, glyphStream));
+            for (; line != batch.mLines.end() && line->mTop < visibleBottom; ++line)
+                for (; quad < line->mEnd; ++quad)
+                    vertexStream.emitQuad(batch.mQuads[quad]);
 
-            textFormat.mRenderItem->setLastVertexCount(glyphStream.end() - vertices);
+            textFormat.mRenderItem->setLastVertexCount(vertexStream.end() - vertices);
         }
 
         // ISubWidget should not necessarily be a drawitem
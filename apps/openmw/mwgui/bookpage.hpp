@@ -5,6 +5,7 @@
 #include "MyGUI_IFont.h"
 #include "MyGUI_Widget.h"
 
+#include <chrono>
 #include <cstdint>
 #include <functional>
 #include <memory>
@@ -106,6 +107,10 @@ namespace MWGui
         /// A factory function for creating the default implementation of a book typesetter
         static Ptr create(int pageWidth, int pageHeight);
 
+        /// Return the time spent laying out the most recently laid out document so far. Zero if the last
+        /// completed document was taken from the cache.
+        static std::chrono::steady_clock::duration getLastLayoutDuration();
+
         /// Create a simple text style consisting of a font and a text color.
         virtual Style* createStyle(const std::string& fontName, const Colour& colour, bool useBookFont = true) = 0;
 
@@ -145,7 +150,8 @@ namespace MWGui
         /// using the specified style.
         virtual void write(Style* Style, size_t Begin, size_t End) = 0;
 
-        /// Finalize the document layout, and return a pointer to it.
+        /// Finalize the document, and return a pointer to it. Pages are laid out when they are first
+        /// requested. A document typeset from the same input at the same page size is shared.
         virtual TypesetBook::Ptr complete() = 0;
     };
 
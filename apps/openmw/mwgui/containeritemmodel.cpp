@@ -1,6 +1,10 @@
 #include "containeritemmodel.hpp"
 
 #include <algorithm>
+#include <string_view>
+#include <unordered_map>
+
+#include <components/misc/strings/algorithm.hpp>
 
 #include "../mwmechanics/actorutil.hpp"
 #include "../mwmechanics/creaturestats.hpp"
@@ -152,6 +156,29 @@ namespace MWGui
     void ContainerItemModel::update()
     {
         mItems.clear();
+
+        // Only items with the same id can stack, so an item is compared only to the stacks with its id
+        std::unordered_map<std::string_view, std::vector<std::size_t>, Misc::StringUtils::CiHash,
+            Misc::StringUtils::CiEqual>
+            stacksById;
+
+        const auto addItem = [&](const MWWorld::Ptr& item) {
+            std::vector<std::size_t>& stacksWithId = stacksById[item.getCellRef().getRefId()];
+            for (const std::size_t index : stacksWithId)
+            {
+                if (stacks(item, mItems[index].mBase))
+                {
+                    // we already have an item stack of this kind, add to it
+                    mItems[index].mCount += item.getRefData().getCount();
+                    return;
+                }
+            }
+
+            // no stack yet, create one
+            stacksWithId.push_back(mItems.size());
+            mItems.emplace_back(item, this, item.getRefData().getCount());
+        };
+
         for (auto& source : mItemSources)
         {
             MWWorld::ContainerStore& store = source.first.getClass().getContainerStore(source.first);
@@ -161,47 +188,11 @@ namespace MWGui
                 if (!(*it).getClass().showsInInventory(*it))
                     continue;
 
-                bool found = false;
-                for (ItemStack& itemStack : mItems)
-                {
-                    if (stacks(*it, itemStack.mBase))
-                    {
-                        // we already have an item stack of this kind, add to it
-                        itemStack.mCount += it->getRefData().getCount();
-                        found = true;
-                        break;
-                    }
-                }
-
-                if (!found)
-                {
-                    // no stack yet, create one
-                    ItemStack newItem(*it, this, it->getRefData().getCount());
-                    mItems.push_back(newItem);
-                }
+                addItem(*it);
             }
         }
         for (MWWorld::Ptr& source : mWorldItems)
-        {
-            bool found = false;
-            for (ItemStack& itemStack : mItems)
-            {
-                if (stacks(source, itemStack.mBase))
-                {
-                    // we already have an item stack of this kind, add to it
-                    itemStack.mCount += source.getRefData().getCount();
-                    found = true;
-                    break;
-                }
-            }
-
-            if (!found)
-            {
-                // no stack yet, create one
-                ItemStack newItem(source, this, source.getRefData().getCount());
-                mItems.push_back(newItem);
-            }
-        }
+            addItem(source);
     }
     bool ContainerItemModel::onDropItem(const MWWorld::Ptr& item, int count)
     {
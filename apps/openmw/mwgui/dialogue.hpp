@@ -1,6 +1,7 @@
 #ifndef MWGUI_DIALOGE_H
 #define MWGUI_DIALOGE_H
 
+#include <map>
 #include <memory>
 
 #include "referenceinterface.hpp"
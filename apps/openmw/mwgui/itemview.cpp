@@ -1,5 +1,6 @@
 #include "itemview.hpp"
 
+#include <algorithm>
 #include <cmath>
 
 #include <MyGUI_FactoryManager.h>
@@ -12,9 +13,17 @@
 
 namespace MWGui
 {
+    namespace
+    {
+        constexpr int itemSize = 42;
+        constexpr int scrollBarHeight = 18;
+    }
 
     ItemView::ItemView()
         : mScrollView(nullptr)
+        , mDragArea(nullptr)
+        , mRows(1)
+        , mFirstVisibleColumn(0)
     {
     }
 
@@ -34,41 +43,37 @@ namespace MWGui
             throw std::runtime_error("Item view needs a scroll view");
 
         mScrollView->setCanvasAlign(MyGUI::Align::Left | MyGUI::Align::Top);
+
+        // The scroll view doesn't report dragging of its scroll bar, so the offset is checked every frame
+        MyGUI::Gui::getInstance().eventFrameStart += MyGUI::newDelegate(this, &ItemView::onFrameStart);
+    }
+
+    void ItemView::shutdownOverride()
+    {
+        MyGUI::Gui::getInstance().eventFrameStart -= MyGUI::newDelegate(this, &ItemView::onFrameStart);
+
+        Base::shutdownOverride();
     }
 
     void ItemView::layoutWidgets()
     {
-        if (!mScrollView->getChildCount())
+        if (mDragArea == nullptr)
             return;
 
-        int x = 0;
-        int y = 0;
-        MyGUI::Widget* dragArea = mScrollView->getChildAt(0);
+        const int count = mModel ? static_cast<int>(mModel->getItemCount()) : 0;
         int maxHeight = mScrollView->getHeight();
 
-        int rows = maxHeight / 42;
+        int rows = maxHeight / itemSize;
         rows = std::max(rows, 1);
-        bool showScrollbar = int(std::ceil(dragArea->getChildCount() / float(rows))) > mScrollView->getWidth() / 42;
+        bool showScrollbar = int(std::ceil(count / float(rows))) > mScrollView->getWidth() / itemSize;
         if (showScrollbar)
-            maxHeight -= 18;
-
-        for (unsigned int i = 0; i < dragArea->getChildCount(); ++i)
-        {
-            MyGUI::Widget* w = dragArea->getChildAt(i);
-
-            w->setPosition(x, y);
+            maxHeight -= scrollBarHeight;
 
-            y += 42;
-
-            if (y > maxHeight - 42 && i < dragArea->getChildCount() - 1)
-            {
-                x += 42;
-                y = 0;
-            }
-        }
-        x += 42;
+        mRows = std::max(maxHeight / itemSize, 1);
+        const int columns = (count + mRows - 1) / mRows;
 
-        MyGUI::IntSize size = MyGUI::IntSize(std::max(mScrollView->getSize().width, x), mScrollView->getSize().height);
+        MyGUI::IntSize size = MyGUI::IntSize(
+            std::max(mScrollView->getSize().width, columns * itemSize), mScrollView->getSize().height);
 
         // Canvas size must be expressed with VScroll disabled, otherwise MyGUI would expand the scroll area when the
         // scrollbar is hidden
@@ -77,32 +82,37 @@ namespace MWGui
         mScrollView->setCanvasSize(size);
         mScrollView->setVisibleVScroll(true);
         mScrollView->setVisibleHScroll(true);
-        dragArea->setSize(size);
+        mDragArea->setSize(size);
+
+        updateVisibleItems(true);
     }
 
-    void ItemView::update()
+    void ItemView::updateVisibleItems(bool force)
     {
-        while (mScrollView->getChildCount())
-            MyGUI::Gui::getInstance().destroyWidget(mScrollView->getChildAt(0));
-
-        if (!mModel)
+        if (mDragArea == nullptr)
             return;
 
-        mModel->update();
+        const int firstColumn = std::max(0, -mScrollView->getViewOffset().left / itemSize);
+        if (!force && firstColumn == mFirstVisibleColumn)
+            return;
+        mFirstVisibleColumn = firstColumn;
 
-        MyGUI::Widget* dragArea = mScrollView->createWidget<MyGUI::Widget>(
-            "", 0, 0, mScrollView->getWidth(), mScrollView->getHeight(), MyGUI::Align::Stretch);
-        dragArea->setNeedMouseFocus(true);
-        dragArea->eventMouseButtonClick += MyGUI::newDelegate(this, &ItemView::onSelectedBackground);
-        dragArea->eventMouseWheel += MyGUI::newDelegate(this, &ItemView::onMouseWheelMoved);
+        // One more column for the partially visible one on each side
+        const int visibleColumns = mScrollView->getWidth() / itemSize + 2;
+        const int count = mModel ? static_cast<int>(mModel->getItemCount()) : 0;
+        const int first = std::min(count, firstColumn * mRows);
+        const int last = std::min(count, (firstColumn + visibleColumns) * mRows);
 
-        for (ItemModel::ModelIndex i = 0; i < static_cast<int>(mModel->getItemCount()); ++i)
+        std::size_t used = 0;
+        for (ItemModel::ModelIndex i = first; i < last; ++i, ++used)
         {
+            if (used == mItemWidgets.size())
+                mItemWidgets.push_back(createItemWidget());
+
             const ItemStack& item = mModel->getItem(i);
 
-            ItemWidget* itemWidget = dragArea->createWidget<ItemWidget>(
-                "MW_ItemIcon", MyGUI::IntCoord(0, 0, 42, 42), MyGUI::Align::Default);
-            itemWidget->setUserString("ToolTipType", "ItemModelIndex");
+            ItemWidget* itemWidget = mItemWidgets[used];
+            itemWidget->setPosition((i / mRows) * itemSize, (i % mRows) * itemSize);
             itemWidget->setUserData(std::make_pair(i, mModel.get()));
             ItemWidget::ItemState state = ItemWidget::None;
             if (item.mType == ItemStack::Type_Barter)
@@ -111,9 +121,38 @@ namespace MWGui
                 state = ItemWidget::Equip;
             itemWidget->setItem(item.mBase, state);
             itemWidget->setCount(item.mCount);
+            itemWidget->setVisible(true);
+        }
+
+        for (; used < mItemWidgets.size(); ++used)
+        {
+            mItemWidgets[used]->setItem(MWWorld::Ptr());
+            mItemWidgets[used]->setVisible(false);
+        }
+    }
+
+    ItemWidget* ItemView::createItemWidget()
+    {
+        ItemWidget* itemWidget = mDragArea->createWidget<ItemWidget>(
+            "MW_ItemIcon", MyGUI::IntCoord(0, 0, itemSize, itemSize), MyGUI::Align::Default);
+        itemWidget->setUserString("ToolTipType", "ItemModelIndex");
+        itemWidget->eventMouseButtonClick += MyGUI::newDelegate(this, &ItemView::onSelectedItem);
+        itemWidget->eventMouseWheel += MyGUI::newDelegate(this, &ItemView::onMouseWheelMoved);
+        return itemWidget;
+    }
+
+    void ItemView::update()
+    {
+        if (mModel)
+            mModel->update();
 
-            itemWidget->eventMouseButtonClick += MyGUI::newDelegate(this, &ItemView::onSelectedItem);
-            itemWidget->eventMouseWheel += MyGUI::newDelegate(this, &ItemView::onMouseWheelMoved);
+        if (mDragArea == nullptr)
+        {
+            mDragArea = mScrollView->createWidget<MyGUI::Widget>(
+                "", 0, 0, mScrollView->getWidth(), mScrollView->getHeight(), MyGUI::Align::Stretch);
+            mDragArea->setNeedMouseFocus(true);
+            mDragArea->eventMouseButtonClick += MyGUI::newDelegate(this, &ItemView::onSelectedBackground);
+            mDragArea->eventMouseWheel += MyGUI::newDelegate(this, &ItemView::onMouseWheelMoved);
         }
 
         layoutWidgets();
@@ -122,6 +161,7 @@ namespace MWGui
     void ItemView::resetScrollBars()
     {
         mScrollView->setViewOffset(MyGUI::IntPoint(0, 0));
+        updateVisibleItems(false);
     }
 
     void ItemView::onSelectedItem(MyGUI::Widget* sender)
@@ -142,6 +182,12 @@ namespace MWGui
         else
             mScrollView->setViewOffset(
                 MyGUI::IntPoint(static_cast<int>(mScrollView->getViewOffset().left + _rel * 0.3f), 0));
+        updateVisibleItems(false);
+    }
+
+    void ItemView::onFrameStart(float /*dt*/)
+    {
+        updateVisibleItems(false);
     }
 
     void ItemView::setSize(const MyGUI::IntSize& _value)
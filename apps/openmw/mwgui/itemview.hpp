@@ -1,13 +1,18 @@
 #ifndef MWGUI_ITEMVIEW_H
 #define MWGUI_ITEMVIEW_H
 
+#include <vector>
+
 #include <MyGUI_Widget.h>
 
 #include "itemmodel.hpp"
 
 namespace MWGui
 {
+    class ItemWidget;
 
+    /// @brief Grid of item icons filled by columns. Widgets are created only for the visible columns and reused
+    /// when the view is scrolled or the model is updated.
     class ItemView final : public MyGUI::Widget
     {
         MYGUI_RTTI_DERIVED(ItemView)
@@ -33,18 +38,29 @@ namespace MWGui
 
     private:
         void initialiseOverride() override;
+        void shutdownOverride() override;
 
         void layoutWidgets();
 
+        /// Bind item widgets to the items in the visible columns if they have changed or \a force is set
+        void updateVisibleItems(bool force);
+
+        ItemWidget* createItemWidget();
+
         void setSize(const MyGUI::IntSize& _value) override;
         void setCoord(const MyGUI::IntCoord& _value) override;
 
         void onSelectedItem(MyGUI::Widget* sender);
         void onSelectedBackground(MyGUI::Widget* sender);
         void onMouseWheelMoved(MyGUI::Widget* _sender, int _rel);
+        void onFrameStart(float dt);
 
         std::unique_ptr<ItemModel> mModel;
         MyGUI::ScrollView* mScrollView;
+        MyGUI::Widget* mDragArea;
+        std::vector<ItemWidget*> mItemWidgets;
+        int mRows;
+        int mFirstVisibleColumn;
     };
 
 }
@@ -1,6 +1,7 @@
 #include "journalviewmodel.hpp"
 
 #include <map>
+#include <set>
 
 #include <MyGUI_LanguageManager.h>
 
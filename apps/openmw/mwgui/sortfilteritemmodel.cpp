@@ -1,5 +1,9 @@
 #include "sortfilteritemmodel.hpp"
 
+#include <algorithm>
+#include <string_view>
+#include <utility>
+
 #include "../mwbase/environment.hpp"
 #include "../mwbase/world.hpp"
 #include <components/debug/debuglog.hpp>
@@ -60,11 +64,54 @@ namespace
         return std::numeric_limits<unsigned int>::max();
     }
 
-    bool compareType(unsigned int type1, unsigned int type2)
+    int getChargePercent(const MWWorld::Ptr& item)
     {
-        return getTypeOrder(type1) < getTypeOrder(type2);
+        std::string_view enchantmentId = item.getClass().getEnchantment(item);
+        if (enchantmentId.empty())
+            return -1;
+
+        const ESM::Enchantment* ench
+            = MWBase::Environment::get().getWorld()->getStore().get<ESM::Enchantment>().search(enchantmentId);
+        if (!ench)
+            return -1;
+
+        if (ench->mData.mType == ESM::Enchantment::ConstantEffect)
+            return 101;
+
+        return static_cast<int>(item.getCellRef().getNormalizedEnchantmentCharge(ench->mData.mCharge) * 100);
     }
 
+    // Item properties used for sorting, computed once per item instead of once per comparison
+    struct SortKey
+    {
+        MWGui::ItemStack::Type mStackType;
+        unsigned int mTypeOrder;
+        std::string mName;
+        int mChargePercent;
+        bool mHasItemHealth;
+        int mItemHealth;
+        float mRemainingUsageTime;
+        int mValue;
+        float mWeight;
+        std::string_view mId;
+
+        explicit SortKey(const MWGui::ItemStack& item)
+        {
+            const MWWorld::Ptr& base = item.mBase;
+            const MWWorld::Class& cls = base.getClass();
+            mStackType = item.mType;
+            mTypeOrder = getTypeOrder(base.getType());
+            mName = Utf8Stream::lowerCaseUtf8(cls.getName(base));
+            mChargePercent = getChargePercent(base);
+            mHasItemHealth = cls.hasItemHealth(base);
+            mItemHealth = mHasItemHealth ? cls.getItemHealth(base) : 0;
+            mRemainingUsageTime = cls.getRemainingUsageTime(base);
+            mValue = cls.getValue(base);
+            mWeight = cls.getWeight(base);
+            mId = base.getCellRef().getRefId();
+        }
+    };
+
     struct Compare
     {
         bool mSortByType;
@@ -72,25 +119,19 @@ namespace
             : mSortByType(true)
         {
         }
-        bool operator()(const MWGui::ItemStack& left, const MWGui::ItemStack& right)
+        bool operator()(const SortKey& left, const SortKey& right) const
         {
-            if (mSortByType && left.mType != right.mType)
-                return left.mType < right.mType;
+            if (mSortByType && left.mStackType != right.mStackType)
+                return left.mStackType < right.mStackType;
 
             float result = 0;
 
             // compare items by type
-            auto leftType = left.mBase.getType();
-            auto rightType = right.mBase.getType();
-
-            if (leftType != rightType)
-                return compareType(leftType, rightType);
+            if (left.mTypeOrder != right.mTypeOrder)
+                return left.mTypeOrder < right.mTypeOrder;
 
             // compare items by name
-            std::string leftName = Utf8Stream::lowerCaseUtf8(left.mBase.getClass().getName(left.mBase));
-            std::string rightName = Utf8Stream::lowerCaseUtf8(right.mBase.getClass().getName(right.mBase));
-
-            result = leftName.compare(rightName);
+            result = left.mName.compare(right.mName);
             if (result != 0)
                 return result < 0;
 
@@ -98,73 +139,35 @@ namespace
             // 1. enchanted items showed before non-enchanted
             // 2. item with lesser charge percent comes after items with more charge percent
             // 3. item with constant effect comes before items with non-constant effects
-            int leftChargePercent = -1;
-            int rightChargePercent = -1;
-            leftName = left.mBase.getClass().getEnchantment(left.mBase);
-            rightName = right.mBase.getClass().getEnchantment(right.mBase);
-
-            if (!leftName.empty())
-            {
-                const ESM::Enchantment* ench
-                    = MWBase::Environment::get().getWorld()->getStore().get<ESM::Enchantment>().search(leftName);
-                if (ench)
-                {
-                    if (ench->mData.mType == ESM::Enchantment::ConstantEffect)
-                        leftChargePercent = 101;
-                    else
-                        leftChargePercent = static_cast<int>(
-                            left.mBase.getCellRef().getNormalizedEnchantmentCharge(ench->mData.mCharge) * 100);
-                }
-            }
-
-            if (!rightName.empty())
-            {
-                const ESM::Enchantment* ench
-                    = MWBase::Environment::get().getWorld()->getStore().get<ESM::Enchantment>().search(rightName);
-                if (ench)
-                {
-                    if (ench->mData.mType == ESM::Enchantment::ConstantEffect)
-                        rightChargePercent = 101;
-                    else
-                        rightChargePercent = static_cast<int>(
-                            right.mBase.getCellRef().getNormalizedEnchantmentCharge(ench->mData.mCharge) * 100);
-                }
-            }
-
-            result = leftChargePercent - rightChargePercent;
+            result = left.mChargePercent - right.mChargePercent;
             if (result != 0)
                 return result > 0;
 
             // compare items by condition
-            if (left.mBase.getClass().hasItemHealth(left.mBase) && right.mBase.getClass().hasItemHealth(right.mBase))
+            if (left.mHasItemHealth && right.mHasItemHealth)
             {
-                result = left.mBase.getClass().getItemHealth(left.mBase)
-                    - right.mBase.getClass().getItemHealth(right.mBase);
+                result = left.mItemHealth - right.mItemHealth;
                 if (result != 0)
                     return result > 0;
             }
 
             // compare items by remaining usage time
-            result = left.mBase.getClass().getRemainingUsageTime(left.mBase)
-                - right.mBase.getClass().getRemainingUsageTime(right.mBase);
+            result = left.mRemainingUsageTime - right.mRemainingUsageTime;
             if (result != 0)
                 return result > 0;
 
             // compare items by value
-            result = left.mBase.getClass().getValue(left.mBase) - right.mBase.getClass().getValue(right.mBase);
+            result = left.mValue - right.mValue;
             if (result != 0)
                 return result > 0;
 
             // compare items by weight
-            result = left.mBase.getClass().getWeight(left.mBase) - right.mBase.getClass().getWeight(right.mBase);
+            result = left.mWeight - right.mWeight;
             if (result != 0)
                 return result > 0;
 
             // compare items by Id
-            leftName = left.mBase.getCellRef().getRefId();
-            rightName = right.mBase.getCellRef().getRefId();
-
-            result = leftName.compare(rightName);
+            result = left.mId.compare(right.mId);
             return result < 0;
         }
     };
@@ -382,9 +385,22 @@ namespace MWGui
                 mItems.push_back(item);
         }
 
+        std::vector<std::pair<SortKey, std::size_t>> keys;
+        keys.reserve(mItems.size());
+        for (std::size_t i = 0; i < mItems.size(); ++i)
+            keys.emplace_back(SortKey(mItems[i]), i);
+
         Compare cmp;
         cmp.mSortByType = mSortByType;
-        std::sort(mItems.begin(), mItems.end(), cmp);
+        std::sort(keys.begin(), keys.end(), [&](const auto& left, const auto& right) {
+            return cmp(left.first, right.first);
+        });
+
+        std::vector<ItemStack> sorted;
+        sorted.reserve(mItems.size());
+        for (const auto& [key, index] : keys)
+            sorted.push_back(std::move(mItems[index]));
+        mItems = std::move(sorted);
     }
 
     void SortFilterItemModel::onClose()
@@ -6,6 +6,7 @@
 #include <filesystem>
 #include <thread>
 
+#include <osg/Stats>
 #include <osgViewer/Viewer>
 
 #include <MyGUI_ClipboardManager.h>
@@ -841,6 +842,12 @@ namespace MWGui
         mHud->setPlayerPos(x, y, u, v);
     }
 
+    void WindowManager::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+    {
+        stats.setAttribute(frameNumber, "GUI BookLayout",
+            std::chrono::duration_cast<std::chrono::microseconds>(BookTypesetter::getLastLayoutDuration()).count());
+    }
+
     void WindowManager::update(float frameDuration)
     {
         handleScheduledMessageBoxes();
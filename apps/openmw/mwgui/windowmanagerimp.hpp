@@ -65,6 +65,7 @@ namespace Translation
 namespace osg
 {
     class Group;
+    class Stats;
 }
 namespace osgViewer
 {
@@ -276,6 +277,8 @@ namespace MWGui
 
         void update(float duration);
 
+        void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
+
         /**
          * Fetches a GMST string from the store, if there is no setting with the given
          * ID or it is not a string the default string is returned.
@@ -71,6 +71,12 @@ namespace MWLua
             });
         };
 
+        api["recordLuaProfile"] = [lua = context.mLua](int frames) {
+            if (frames <= 0)
+                throw std::runtime_error("Number of frames should be positive");
+            lua->getHandlerProfiler().startRecording(frames);
+        };
+
         return LuaUtil::makeReadOnly(api);
     }
 }
@@ -4,6 +4,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <utility>
 
 #include <components/lua/luastate.hpp>
 #include <components/lua/scriptscontainer.hpp>
@@ -24,6 +25,12 @@ namespace MWLua
 
         MWBase::LuaManager::ActorControls* getActorControls() { return &mData.mControls; }
 
+        ObjectId getObjectId() const { return mData.id(); }
+
+        // Time passed since the last `onUpdate` while the object was active. Used by local scripts update shards.
+        void addTimeSinceUpdate(float dt) { mTimeSinceUpdate += dt; }
+        float takeTimeSinceUpdate() { return std::exchange(mTimeSinceUpdate, 0.f); }
+
         struct SelfObject : public LObject
         {
             class CachedStat
@@ -92,6 +99,7 @@ namespace MWLua
         EngineHandlerList mOnInactiveHandlers{ "onInactive" };
         EngineHandlerList mOnConsumeHandlers{ "onConsume" };
         EngineHandlerList mOnActivatedHandlers{ "onActivated" };
+        float mTimeSinceUpdate = 0;
     };
 
 }
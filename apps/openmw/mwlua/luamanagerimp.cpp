@@ -1,6 +1,8 @@
 #include "luamanagerimp.hpp"
 
 #include <filesystem>
+#include <fstream>
+#include <utility>
 
 #include <osg/Stats>
 
@@ -45,12 +47,16 @@ namespace MWLua
         return { .mInstructionLimit = Settings::Manager::getUInt64("instruction limit per call", "Lua"),
             .mMemoryLimit = Settings::Manager::getUInt64("memory limit", "Lua"),
             .mSmallAllocMaxSize = Settings::Manager::getUInt64("small alloc max size", "Lua"),
-            .mLogMemoryUsage = Settings::Manager::getBool("log memory usage", "Lua") };
+            .mLogMemoryUsage = Settings::Manager::getBool("log memory usage", "Lua"),
+            .mProfileHandlers = Settings::Manager::getBool("lua handler profiler", "Lua") };
     }
 
-    LuaManager::LuaManager(const VFS::Manager* vfs, const std::filesystem::path& libsDir)
-        : mLua(vfs, &mConfiguration, createLuaStateSettings())
+    LuaManager::LuaManager(
+        const VFS::Manager* vfs, const std::filesystem::path& libsDir, const std::filesystem::path& userDataPath)
+        : mUserDataPath(userDataPath)
+        , mLua(vfs, &mConfiguration, createLuaStateSettings())
         , mUiResourceManager(vfs)
+        , mUpdateShards(std::max(Settings::Manager::getInt("local scripts update shards", "Lua"), 1))
     {
         Log(Debug::Info) << "Lua version: " << LuaUtil::getLuaVersion();
         mLua.addInternalLibSearchPath(libsDir);
@@ -81,6 +87,7 @@ namespace MWLua
         context.mWorldView = &mWorldView;
         context.mLocalEventQueue = &mLocalEvents;
         context.mGlobalEventQueue = &mGlobalEvents;
+        context.mEventDataPool = &mEventDataPool;
         context.mSerializer = mGlobalSerializer.get();
 
         Context localContext = context;
@@ -157,11 +164,17 @@ namespace MWLua
         mGlobalScripts.statsNextFrame();
         for (LocalScripts* scripts : mActiveLocalScripts)
             scripts->statsNextFrame();
-
-        std::vector<GlobalEvent> globalEvents = std::move(mGlobalEvents);
-        std::vector<LocalEvent> localEvents = std::move(mLocalEvents);
-        mGlobalEvents = std::vector<GlobalEvent>();
-        mLocalEvents = std::vector<LocalEvent>();
+        mLua.getHandlerProfiler().nextFrame();
+        if (mLua.getHandlerProfiler().isRecordingFinished())
+            writeHandlerProfile();
+
+        // Events sent during processing go to the next frame. Both queues keep their capacity between frames.
+        GlobalEventQueue& globalEvents = mProcessedGlobalEvents;
+        LocalEventQueue& localEvents = mProcessedLocalEvents;
+        globalEvents.clear();
+        localEvents.clear();
+        std::swap(globalEvents, mGlobalEvents);
+        std::swap(localEvents, mLocalEvents);
 
         if (!mWorldView.isPaused())
         { // Update time and process timers
@@ -187,6 +200,10 @@ namespace MWLua
                 Log(Debug::Debug) << "Ignored event " << e.mEventName << " to L" << idToString(e.mDest)
                                   << ". Object not found or has no attached scripts";
         }
+        for (GlobalEvent& e : globalEvents)
+            mEventDataPool.release(std::move(e.mEventData));
+        for (LocalEvent& e : localEvents)
+            mEventDataPool.release(std::move(e.mEventData));
 
         // Run queued callbacks
         for (CallbackWithData& c : mQueuedCallbacks)
@@ -211,10 +228,7 @@ namespace MWLua
         mLocalEngineEvents.clear();
 
         if (!mWorldView.isPaused())
-        {
-            for (LocalScripts* scripts : mActiveLocalScripts)
-                scripts->update(frameDuration);
-        }
+            updateLocalScripts(frameDuration);
 
         // Engine handlers in global scripts
         if (mPlayerChanged)
@@ -250,6 +264,30 @@ namespace MWLua
             mGlobalScripts.update(frameDuration);
     }
 
+    std::size_t LuaManager::getUpdateShard(const LocalScripts& scripts) const
+    {
+        return static_cast<std::size_t>(scripts.getObjectId().mIndex) % mUpdateShards;
+    }
+
+    void LuaManager::updateLocalScripts(float frameDuration)
+    {
+        const std::size_t shard = mNextUpdateShard;
+        mNextUpdateShard = (mNextUpdateShard + 1) % mUpdateShards;
+
+        const LocalScripts* playerScripts = mPlayer.getRefData().getLuaScripts();
+        for (LocalScripts* scripts : mActiveLocalScripts)
+        {
+            if (scripts == playerScripts)
+            {
+                scripts->update(frameDuration);
+                continue;
+            }
+            scripts->addTimeSinceUpdate(frameDuration);
+            if (getUpdateShard(*scripts) == shard)
+                scripts->update(scripts->takeTimeSinceUpdate());
+        }
+    }
+
     void LuaManager::synchronizedUpdate()
     {
         if (mPlayer.isEmpty())
@@ -363,6 +401,8 @@ namespace MWLua
         }
         if (localScripts)
         {
+            // Time spent inactive is not passed to the first `onUpdate`
+            localScripts->takeTimeSinceUpdate();
             mActiveLocalScripts.insert(localScripts);
             mLocalEngineEvents.push_back({ getId(ptr), LocalScripts::OnActive{} });
         }
@@ -625,6 +665,22 @@ namespace MWLua
         stats.setAttribute(frameNumber, "Lua UsedMemory", mLua.getTotalMemoryUsage());
     }
 
+    void LuaManager::writeHandlerProfile()
+    {
+        LuaUtil::HandlerProfiler& profiler = mLua.getHandlerProfiler();
+        const std::filesystem::path tracePath = mUserDataPath / "lua_profile.json";
+        const std::filesystem::path stacksPath = mUserDataPath / "lua_profile.folded";
+        std::ofstream trace(tracePath);
+        profiler.writeChromeTrace(trace, mConfiguration);
+        trace.close();
+        std::ofstream stacks(stacksPath);
+        profiler.writeCollapsedStacks(stacks, mConfiguration);
+        stacks.close();
+        profiler.clearRecording();
+        Log(Debug::Info) << "Lua profile is saved to " << tracePath << " (Chrome trace) and " << stacksPath
+                         << " (collapsed stacks)";
+    }
+
     std::string LuaManager::formatResourceUsageStats() const
     {
         if (!LuaUtil::LuaState::isProfilerEnabled())
@@ -663,6 +719,54 @@ namespace MWLua
 
         using Stats = LuaUtil::ScriptsContainer::ScriptStats;
 
+        if (mUpdateShards > 1)
+        {
+            std::vector<std::size_t> shardObjects(mUpdateShards, 0);
+            std::vector<std::vector<Stats>> shardStats(mUpdateShards);
+            const LocalScripts* playerScripts = mPlayer.isEmpty() ? nullptr : mPlayer.getRefData().getLuaScripts();
+            for (LocalScripts* scripts : mActiveLocalScripts)
+            {
+                if (scripts == playerScripts)
+                    continue;
+                const std::size_t shard = getUpdateShard(*scripts);
+                ++shardObjects[shard];
+                scripts->collectStats(shardStats[shard]);
+            }
+
+            out << "Local scripts update shards = " << mUpdateShards << " (section [Lua] in settings.cfg)\n";
+            for (std::size_t shard = 0; shard < shardStats.size(); ++shard)
+            {
+                float ops = 0;
+                int64_t memory = 0;
+                for (const Stats& stats : shardStats[shard])
+                {
+                    ops += stats.mAvgInstructionCount;
+                    memory += stats.mMemoryUsage;
+                }
+                out << "  Shard " << std::setw(3) << std::left << shard << std::right;
+                out << std::setw(valueW) << shardObjects[shard] << " objects";
+                out << std::setw(valueW) << static_cast<int64_t>(ops) << " ops";
+                outMemSize(memory);
+                out << "\n";
+            }
+            out << "\n";
+        }
+
+        const LuaUtil::HandlerProfiler& handlerProfiler = mLua.getHandlerProfiler();
+        if (handlerProfiler.isEnabled())
+        {
+            out << "Top handlers by time per frame (lua handler profiler = true)\n";
+            for (const LuaUtil::HandlerProfiler::HandlerStats& stats : handlerProfiler.getTopHandlers(20))
+            {
+                out << std::right << std::fixed << std::setprecision(3);
+                out << std::setw(valueW - 3) << stats.mAvgFrameTime * 1000 << " ms";
+                out << std::setw(valueW) << stats.mCallCount << " calls  ";
+                out << std::defaultfloat << std::left << mConfiguration[stats.mScriptId].mScriptPath << " "
+                    << LuaUtil::HandlerProfiler::getHandlerName(stats.mType, stats.mName) << "\n";
+            }
+            out << std::right << "\n";
+        }
+
         std::vector<Stats> activeStats;
         mGlobalScripts.collectStats(activeStats);
         for (LocalScripts* scripts : mActiveLocalScripts)
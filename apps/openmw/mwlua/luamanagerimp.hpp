@@ -26,7 +26,8 @@ namespace MWLua
     class LuaManager : public MWBase::LuaManager
     {
     public:
-        LuaManager(const VFS::Manager* vfs, const std::filesystem::path& libsDir);
+        LuaManager(const VFS::Manager* vfs, const std::filesystem::path& libsDir,
+            const std::filesystem::path& userDataPath);
 
         // Called by engine.cpp when the environment is fully initialized.
         void init();
@@ -129,10 +130,14 @@ namespace MWLua
         void initConfiguration();
         LocalScripts* createLocalScripts(const MWWorld::Ptr& ptr,
             std::optional<LuaUtil::ScriptIdsWithInitializationData> autoStartConf = std::nullopt);
+        std::size_t getUpdateShard(const LocalScripts& scripts) const;
+        void updateLocalScripts(float frameDuration);
+        void writeHandlerProfile();
 
         bool mInitialized = false;
         bool mGlobalScriptsStarted = false;
         bool mProcessingInputEvents = false;
+        std::filesystem::path mUserDataPath;
         LuaUtil::ScriptsConfiguration mConfiguration;
         LuaUtil::LuaState mLua;
         LuaUi::ResourceManager mUiResourceManager;
@@ -147,6 +152,11 @@ namespace MWLua
 
         GlobalScripts mGlobalScripts{ &mLua };
         std::set<LocalScripts*> mActiveLocalScripts;
+
+        // Active local scripts (except player scripts) are split into shards by object id. Only one shard receives
+        // `onUpdate` per frame, every script gets the time it was active since its previous update.
+        std::size_t mUpdateShards;
+        std::size_t mNextUpdateShard = 0;
         WorldView mWorldView;
 
         bool mPlayerChanged = false;
@@ -155,6 +165,9 @@ namespace MWLua
 
         GlobalEventQueue mGlobalEvents;
         LocalEventQueue mLocalEvents;
+        GlobalEventQueue mProcessedGlobalEvents;
+        LocalEventQueue mProcessedLocalEvents;
+        LuaUtil::BinaryDataPool mEventDataPool;
 
         std::unique_ptr<LuaUtil::UserdataSerializer> mGlobalSerializer;
         std::unique_ptr<LuaUtil::UserdataSerializer> mLocalSerializer;
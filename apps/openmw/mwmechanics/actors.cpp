@@ -1150,6 +1150,9 @@ namespace MWMechanics
 
     Actors::Actors()
         : mSmoothMovement(Settings::Manager::getBool("smooth movement", "Game"))
+        , mAnimationLodDistance(std::max(0.f, Settings::Manager::getFloat("animation lod distance", "Game")))
+        , mMaxAnimationLodUpdateInterval(static_cast<unsigned>(
+              std::max(1, Settings::Manager::getInt("max animation lod update interval", "Game"))))
     {
         mTimerDisposeSummonsCorpses
             = 0.2f; // We should add a delay between summoned creature death and its corpse despawning
@@ -1654,6 +1657,7 @@ namespace MWMechanics
 
             // Animation/movement update
             CharacterController* playerCharacter = nullptr;
+            mThrottledAnimationsCount = 0;
             for (Actor& actor : mActors)
             {
                 const float dist = (playerPos - actor.getPtr().getRefData().getPosition().asVec3()).length();
@@ -1674,6 +1678,16 @@ namespace MWMechanics
                 CharacterController& ctrl = actor.getCharacterController();
                 ctrl.setActive(active);
 
+                // Bone update interval grows by one frame every animation lod distance, text keys and movement
+                // still use the exact animation time
+                unsigned int updateInterval = 1;
+                if (!isPlayer && mAnimationLodDistance > 0)
+                    updateInterval = std::min(
+                        static_cast<unsigned>(dist / mAnimationLodDistance) + 1, mMaxAnimationLodUpdateInterval);
+                const bool hasSkeleton = ctrl.setAnimationUpdateInterval(updateInterval);
+                if (inRange && updateInterval > 1 && hasSkeleton)
+                    ++mThrottledAnimationsCount;
+
                 if (!inRange)
                 {
                     actor.getPtr().getRefData().getBaseNode()->setNodeMask(0);
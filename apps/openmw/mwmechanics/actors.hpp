@@ -46,6 +46,9 @@ namespace MWMechanics
         std::list<Actor>::const_iterator end() const { return mActors.end(); }
         std::size_t size() const { return mActors.size(); }
 
+        /// Number of actors with animation updated at a reduced rate in the last frame
+        std::size_t getThrottledAnimationsCount() const { return mThrottledAnimationsCount; }
+
         void notifyDied(const MWWorld::Ptr& actor);
 
         /// Check if the target actor was detected by an observer
@@ -188,6 +191,9 @@ namespace MWMechanics
         float mSneakSkillTimer = 0; // Times sneak skill progress from "avoid notice"
         float mActorsProcessingRange;
         bool mSmoothMovement;
+        float mAnimationLodDistance;
+        unsigned int mMaxAnimationLodUpdateInterval;
+        std::size_t mThrottledAnimationsCount = 0;
         MusicType mCurrentMusic = MusicType::Title;
 
         void updateVisibility(const MWWorld::Ptr& ptr, CharacterController& ctrl) const;
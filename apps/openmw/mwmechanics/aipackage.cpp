@@ -134,6 +134,10 @@ bool MWMechanics::AiPackage::pathTo(const MWWorld::Ptr& actor, const osg::Vec3f&
 
     mLastDestinationTolerance = destTolerance;
 
+    // Path requested on one of the previous frames
+    if (mPathFinder.updateAsyncPath(actor, actor.getCell(), getPathGridGraph(actor.getCell())) && mDestInLOS)
+        preferDirectPath(position, dest);
+
     const float distToTarget = distance(position, dest);
     const bool isDestReached = (distToTarget <= destTolerance);
     const bool actorCanMoveByZ = canActorMoveByZAxis(actor);
@@ -152,26 +156,18 @@ bool MWMechanics::AiPackage::pathTo(const MWWorld::Ptr& actor, const osg::Vec3f&
 
         if (!mIsShortcutting)
         {
-            if (wasShortcutting || doesPathNeedRecalc(dest, actor)) // if need to rebuild path
+            // if need to rebuild path and it's not being built already
+            if ((wasShortcutting || doesPathNeedRecalc(dest, actor)) && !mPathFinder.isAsyncPathPending())
             {
-                mPathFinder.buildLimitedPath(actor, position, dest, actor.getCell(), getPathGridGraph(actor.getCell()),
-                    agentBounds, getNavigatorFlags(actor), getAreaCosts(actor), endTolerance, pathType);
+                mPathFinder.buildLimitedPathAsync(actor, position, dest, actor.getCell(),
+                    getPathGridGraph(actor.getCell()), agentBounds, getNavigatorFlags(actor), getAreaCosts(actor),
+                    endTolerance, pathType);
                 mRotateOnTheRunChecks = 3;
+                mDestInLOS = destInLOS;
 
-                // give priority to go directly on target if there is minimal opportunity
-                if (destInLOS && mPathFinder.getPath().size() > 1)
-                {
-                    // get point just before dest
-                    auto pPointBeforeDest = mPathFinder.getPath().rbegin() + 1;
-
-                    // if start point is closer to the target then last point of path (excluding target itself) then go
-                    // straight on the target
-                    if (distance(position, dest) <= distance(dest, *pPointBeforeDest))
-                    {
-                        mPathFinder.clearPath();
-                        mPathFinder.addPointToPath(dest);
-                    }
-                }
+                // path is built immediately for actors not using navmesh
+                if (!mPathFinder.isAsyncPathPending() && destInLOS)
+                    preferDirectPath(position, dest);
             }
 
             if (!mPathFinder.getPath().empty()) // Path has points in it
@@ -403,6 +399,24 @@ bool MWMechanics::AiPackage::checkWayIsClearForActor(
     return false;
 }
 
+void MWMechanics::AiPackage::preferDirectPath(const osg::Vec3f& position, const osg::Vec3f& dest)
+{
+    // give priority to go directly on target if there is minimal opportunity
+    if (mPathFinder.getPath().size() <= 1)
+        return;
+
+    // get point just before dest
+    auto pPointBeforeDest = mPathFinder.getPath().rbegin() + 1;
+
+    // if start point is closer to the target then last point of path (excluding target itself) then go
+    // straight on the target
+    if (distance(position, dest) <= distance(dest, *pPointBeforeDest))
+    {
+        mPathFinder.clearPath();
+        mPathFinder.addPointToPath(dest);
+    }
+}
+
 bool MWMechanics::AiPackage::doesPathNeedRecalc(const osg::Vec3f& newDest, const MWWorld::Ptr& actor) const
 {
     return mPathFinder.getPath().empty() || getPathDistance(actor, mPathFinder.getPath().back(), newDest) > 10
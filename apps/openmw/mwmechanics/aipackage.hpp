@@ -167,12 +167,15 @@ namespace MWMechanics
         short mRotateOnTheRunChecks; // attempts to check rotation to the pathpoint on the run possibility
 
         bool mIsShortcutting; // if shortcutting at the moment
+        bool mDestInLOS = false; // if destination was in line of sight when path was requested
         bool mShortcutProhibited; // shortcutting may be prohibited after unsuccessful attempt
         osg::Vec3f mShortcutFailPos; // position of last shortcut fail
         float mLastDestinationTolerance = 0;
 
     private:
         bool isNearInactiveCell(osg::Vec3f position);
+
+        void preferDirectPath(const osg::Vec3f& position, const osg::Vec3f& dest);
     };
 }
 
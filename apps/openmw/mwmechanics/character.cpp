@@ -2836,6 +2836,11 @@ namespace MWMechanics
         mAnimation->setActive(active);
     }
 
+    bool CharacterController::setAnimationUpdateInterval(unsigned int interval) const
+    {
+        return mAnimation->setUpdateInterval(interval);
+    }
+
     void CharacterController::setHeadTrackTarget(const MWWorld::ConstPtr& target)
     {
         mHeadTrackTarget = target;
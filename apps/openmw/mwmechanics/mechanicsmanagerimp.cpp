@@ -1941,6 +1941,7 @@ namespace MWMechanics
     void MechanicsManager::reportStats(unsigned int frameNumber, osg::Stats& stats) const
     {
         stats.setAttribute(frameNumber, "Mechanics Actors", mActors.size());
+        stats.setAttribute(frameNumber, "Mechanics AnimationLod", mActors.getThrottledAnimationsCount());
         stats.setAttribute(frameNumber, "Mechanics Objects", mObjects.size());
     }
 
@@ -89,6 +89,41 @@ namespace
         return 2.0 * halfExtents.z();
     }
 
+    bool canUseNavMesh(const MWWorld::ConstPtr& actor)
+    {
+        return !actor.getClass().isPureWaterCreature(actor) && !actor.getClass().isPureFlyingCreature(actor);
+    }
+
+    osg::Vec3f getLimitedPathEnd(
+        const DetourNavigator::Navigator& navigator, const osg::Vec3f& startPoint, const osg::Vec3f& endPoint)
+    {
+        const auto maxDistance
+            = std::min(navigator.getMaxNavmeshAreaRealRadius(), static_cast<float>(Constants::CellSizeInUnits));
+        const auto startToEnd = endPoint - startPoint;
+        const auto distance = startToEnd.length();
+        if (distance <= maxDistance)
+            return endPoint;
+        return startPoint + startToEnd * maxDistance / distance;
+    }
+
+    DetourNavigator::Status checkNavigatorStatus(const MWWorld::ConstPtr& actor, const osg::Vec3f& startPoint,
+        const osg::Vec3f& endPoint, const DetourNavigator::Flags flags, MWMechanics::PathType pathType,
+        DetourNavigator::Status status)
+    {
+        if (pathType == MWMechanics::PathType::Partial && status == DetourNavigator::Status::PartialPath)
+            return DetourNavigator::Status::Success;
+
+        if (status != DetourNavigator::Status::Success)
+        {
+            Log(Debug::Debug) << "Build path by navigator error: \"" << DetourNavigator::getMessage(status)
+                              << "\" for \"" << actor.getClass().getName(actor) << "\" (" << actor.getBase()
+                              << ") from " << startPoint << " to " << endPoint << " with flags ("
+                              << DetourNavigator::WriteFlags{ flags } << ")";
+        }
+
+        return status;
+    }
+
     // Returns true if turn in `p2` is less than 10 degrees and all the 3 points are almost on one line.
     bool isAlmostStraight(const osg::Vec3f& p1, const osg::Vec3f& p2, const osg::Vec3f& p3, float pointTolerance)
     {
@@ -362,6 +397,7 @@ namespace MWMechanics
 
     void PathFinder::buildStraightPath(const osg::Vec3f& endPoint)
     {
+        mAsyncQuery.reset();
         mPath.clear();
         mPath.push_back(endPoint);
         mConstructed = true;
@@ -370,6 +406,7 @@ namespace MWMechanics
     void PathFinder::buildPathByPathgrid(const osg::Vec3f& startPoint, const osg::Vec3f& endPoint,
         const MWWorld::CellStore* cell, const PathgridGraph& pathgridGraph)
     {
+        mAsyncQuery.reset();
         mPath.clear();
         mCell = cell;
 
@@ -382,6 +419,7 @@ namespace MWMechanics
         const osg::Vec3f& endPoint, const DetourNavigator::AgentBounds& agentBounds, const DetourNavigator::Flags flags,
         const DetourNavigator::AreaCosts& areaCosts, float endTolerance, PathType pathType)
     {
+        mAsyncQuery.reset();
         mPath.clear();
 
         // If it's not possible to build path over navmesh due to disabled navmesh generation fallback to straight path
@@ -402,12 +440,13 @@ namespace MWMechanics
         const DetourNavigator::AgentBounds& agentBounds, const DetourNavigator::Flags flags,
         const DetourNavigator::AreaCosts& areaCosts, float endTolerance, PathType pathType)
     {
+        mAsyncQuery.reset();
         mPath.clear();
         mCell = cell;
 
         DetourNavigator::Status status = DetourNavigator::Status::NavMeshNotFound;
 
-        if (!actor.getClass().isPureWaterCreature(actor) && !actor.getClass().isPureFlyingCreature(actor))
+        if (canUseNavMesh(actor))
         {
             status = buildPathByNavigatorImpl(actor, startPoint, endPoint, agentBounds, flags, areaCosts, endTolerance,
                 pathType, std::back_inserter(mPath));
@@ -415,6 +454,15 @@ namespace MWMechanics
                 mPath.clear();
         }
 
+        completePath(actor, startPoint, endPoint, pathgridGraph, agentBounds, flags, areaCosts, endTolerance, pathType,
+            status);
+    }
+
+    void PathFinder::completePath(const MWWorld::ConstPtr& actor, const osg::Vec3f& startPoint,
+        const osg::Vec3f& endPoint, const PathgridGraph& pathgridGraph, const DetourNavigator::AgentBounds& agentBounds,
+        const DetourNavigator::Flags flags, const DetourNavigator::AreaCosts& areaCosts, float endTolerance,
+        PathType pathType, DetourNavigator::Status status)
+    {
         if (status != DetourNavigator::Status::NavMeshNotFound && mPath.empty()
             && (flags & DetourNavigator::Flag_usePathgrid) == 0)
         {
@@ -445,18 +493,7 @@ namespace MWMechanics
         const auto status = DetourNavigator::findPath(
             *navigator, agentBounds, stepSize, startPoint, endPoint, flags, areaCosts, endTolerance, out);
 
-        if (pathType == PathType::Partial && status == DetourNavigator::Status::PartialPath)
-            return DetourNavigator::Status::Success;
-
-        if (status != DetourNavigator::Status::Success)
-        {
-            Log(Debug::Debug) << "Build path by navigator error: \"" << DetourNavigator::getMessage(status)
-                              << "\" for \"" << actor.getClass().getName(actor) << "\" (" << actor.getBase()
-                              << ") from " << startPoint << " to " << endPoint << " with flags ("
-                              << DetourNavigator::WriteFlags{ flags } << ")";
-        }
-
-        return status;
+        return checkNavigatorStatus(actor, startPoint, endPoint, flags, pathType, status);
     }
 
     void PathFinder::buildPathByNavMeshToNextPoint(const MWWorld::ConstPtr& actor,
@@ -506,14 +543,61 @@ namespace MWMechanics
         const DetourNavigator::AreaCosts& areaCosts, float endTolerance, PathType pathType)
     {
         const auto navigator = MWBase::Environment::get().getWorld()->getNavigator();
-        const auto maxDistance
-            = std::min(navigator->getMaxNavmeshAreaRealRadius(), static_cast<float>(Constants::CellSizeInUnits));
-        const auto startToEnd = endPoint - startPoint;
-        const auto distance = startToEnd.length();
-        if (distance <= maxDistance)
-            return buildPath(actor, startPoint, endPoint, cell, pathgridGraph, agentBounds, flags, areaCosts,
+        buildPath(actor, startPoint, getLimitedPathEnd(*navigator, startPoint, endPoint), cell, pathgridGraph,
+            agentBounds, flags, areaCosts, endTolerance, pathType);
+    }
+
+    void PathFinder::buildLimitedPathAsync(const MWWorld::ConstPtr& actor, const osg::Vec3f& startPoint,
+        const osg::Vec3f& endPoint, const MWWorld::CellStore* cell, const PathgridGraph& pathgridGraph,
+        const DetourNavigator::AgentBounds& agentBounds, const DetourNavigator::Flags flags,
+        const DetourNavigator::AreaCosts& areaCosts, float endTolerance, PathType pathType)
+    {
+        if (!canUseNavMesh(actor))
+            return buildLimitedPath(actor, startPoint, endPoint, cell, pathgridGraph, agentBounds, flags, areaCosts,
                 endTolerance, pathType);
-        const auto end = startPoint + startToEnd * maxDistance / distance;
-        buildPath(actor, startPoint, end, cell, pathgridGraph, agentBounds, flags, areaCosts, endTolerance, pathType);
+        const auto navigator = MWBase::Environment::get().getWorld()->getNavigator();
+        const DetourNavigator::PathQuery query{
+            .mAgentBounds = agentBounds,
+            .mStepSize = getPathStepSize(actor),
+            .mStart = startPoint,
+            .mEnd = getLimitedPathEnd(*navigator, startPoint, endPoint),
+            .mIncludeFlags = flags,
+            .mAreaCosts = areaCosts,
+            .mEndTolerance = endTolerance,
+        };
+        mAsyncQuery = AsyncQuery{ navigator->postPathQuery(query), query, pathType };
+    }
+
+    bool PathFinder::updateAsyncPath(
+        const MWWorld::ConstPtr& actor, const MWWorld::CellStore* cell, const PathgridGraph& pathgridGraph)
+    {
+        if (!mAsyncQuery.has_value())
+            return false;
+
+        const auto navigator = MWBase::Environment::get().getWorld()->getNavigator();
+        std::optional<DetourNavigator::PathQueryResult> result = navigator->takePathQueryResult(mAsyncQuery->mId);
+        if (!result.has_value())
+        {
+            // Result is discarded, a new query is posted when the path needs to be rebuilt
+            if (!navigator->isPathQueryPending(mAsyncQuery->mId))
+                mAsyncQuery.reset();
+            return false;
+        }
+
+        const AsyncQuery asyncQuery = std::move(*mAsyncQuery);
+        const DetourNavigator::PathQuery& query = asyncQuery.mQuery;
+        mAsyncQuery.reset();
+        mPath.clear();
+        mCell = cell;
+
+        const DetourNavigator::Status status = checkNavigatorStatus(
+            actor, query.mStart, query.mEnd, query.mIncludeFlags, asyncQuery.mPathType, result->mStatus);
+        if (status == DetourNavigator::Status::Success)
+            mPath.assign(result->mPath.begin(), result->mPath.end());
+
+        completePath(actor, query.mStart, query.mEnd, pathgridGraph, query.mAgentBounds, query.mIncludeFlags,
+            query.mAreaCosts, query.mEndTolerance, asyncQuery.mPathType, status);
+
+        return true;
     }
 }
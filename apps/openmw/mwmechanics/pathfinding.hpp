@@ -4,9 +4,11 @@
 #include <cassert>
 #include <deque>
 #include <iterator>
+#include <optional>
 
 #include <components/detournavigator/areatype.hpp>
 #include <components/detournavigator/flags.hpp>
+#include <components/detournavigator/pathquery.hpp>
 #include <components/detournavigator/status.hpp>
 #include <components/esm/defs.hpp>
 #include <components/esm3/loadpgrd.hpp>
@@ -18,11 +20,6 @@ namespace MWWorld
     class Ptr;
 }
 
-namespace DetourNavigator
-{
-    struct AgentBounds;
-}
-
 namespace MWMechanics
 {
     class PathgridGraph;
@@ -93,6 +90,7 @@ namespace MWMechanics
             mConstructed = false;
             mPath.clear();
             mCell = nullptr;
+            mAsyncQuery.reset();
         }
 
         void buildStraightPath(const osg::Vec3f& endPoint);
@@ -119,12 +117,25 @@ namespace MWMechanics
             const DetourNavigator::AgentBounds& agentBounds, const DetourNavigator::Flags flags,
             const DetourNavigator::AreaCosts& areaCosts, float endTolerance, PathType pathType);
 
+        /// Same as buildLimitedPath but path over navmesh is found in background. Current path is kept until
+        /// updateAsyncPath gets the result on the next frame or later.
+        void buildLimitedPathAsync(const MWWorld::ConstPtr& actor, const osg::Vec3f& startPoint,
+            const osg::Vec3f& endPoint, const MWWorld::CellStore* cell, const PathgridGraph& pathgridGraph,
+            const DetourNavigator::AgentBounds& agentBounds, const DetourNavigator::Flags flags,
+            const DetourNavigator::AreaCosts& areaCosts, float endTolerance, PathType pathType);
+
+        /// Replaces path by the result of buildLimitedPathAsync when it's ready. Returns true if path is replaced.
+        bool updateAsyncPath(
+            const MWWorld::ConstPtr& actor, const MWWorld::CellStore* cell, const PathgridGraph& pathgridGraph);
+
+        bool isAsyncPathPending() const { return mAsyncQuery.has_value(); }
+
         /// Remove front point if exist and within tolerance
         void update(const osg::Vec3f& position, float pointTolerance, float destinationTolerance,
             bool shortenIfAlmostStraight, bool canMoveByZ, const DetourNavigator::AgentBounds& agentBounds,
             const DetourNavigator::Flags flags);
 
-        bool checkPathCompleted() const { return mConstructed && mPath.empty(); }
+        bool checkPathCompleted() const { return mConstructed && mPath.empty() && !mAsyncQuery.has_value(); }
 
         /// In radians
         float getZAngleToNext(float x, float y) const;
@@ -201,11 +212,20 @@ namespace MWMechanics
         }
 
     private:
+        struct AsyncQuery
+        {
+            DetourNavigator::PathQueryId mId;
+            DetourNavigator::PathQuery mQuery;
+            PathType mPathType;
+        };
+
         bool mConstructed;
         std::deque<osg::Vec3f> mPath;
 
         const MWWorld::CellStore* mCell;
 
+        std::optional<AsyncQuery> mAsyncQuery;
+
         void buildPathByPathgridImpl(const osg::Vec3f& startPoint, const osg::Vec3f& endPoint,
             const PathgridGraph& pathgridGraph, std::back_insert_iterator<std::deque<osg::Vec3f>> out);
 
@@ -213,6 +233,11 @@ namespace MWMechanics
             const osg::Vec3f& startPoint, const osg::Vec3f& endPoint, const DetourNavigator::AgentBounds& agentBounds,
             const DetourNavigator::Flags flags, const DetourNavigator::AreaCosts& areaCosts, float endTolerance,
             PathType pathType, std::back_insert_iterator<std::deque<osg::Vec3f>> out);
+
+        void completePath(const MWWorld::ConstPtr& actor, const osg::Vec3f& startPoint, const osg::Vec3f& endPoint,
+            const PathgridGraph& pathgridGraph, const DetourNavigator::AgentBounds& agentBounds,
+            const DetourNavigator::Flags flags, const DetourNavigator::AreaCosts& areaCosts, float endTolerance,
+            PathType pathType, DetourNavigator::Status status);
     };
 }
 
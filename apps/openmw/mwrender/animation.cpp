@@ -544,6 +544,14 @@ namespace MWRender
             mSkeleton->setActive(static_cast<SceneUtil::Skeleton::ActiveType>(active));
     }
 
+    bool Animation::setUpdateInterval(unsigned int interval)
+    {
+        if (!mSkeleton)
+            return false;
+        mSkeleton->setUpdateInterval(interval);
+        return true;
+    }
+
     void Animation::updatePtr(const MWWorld::Ptr& ptr)
     {
         mPtr = ptr;
@@ -362,6 +362,11 @@ namespace MWRender
         /// 0 = Inactive, 1 = Active in place, 2 = Active
         void setActive(int active);
 
+        /// Update object skeleton, if one exists, only every \a interval frames. Doesn't affect text keys and movement.
+        /// @return false if there is no skeleton, so the interval has no effect.
+        /// @see SceneUtil::Skeleton::setUpdateInterval
+        bool setUpdateInterval(unsigned int interval);
+
         osg::Group* getOrCreateObjectRoot();
 
         osg::Group* getObjectRoot();
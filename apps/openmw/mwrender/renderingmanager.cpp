@@ -45,6 +45,7 @@
 
 #include <components/misc/constants.hpp>
 
+#include <components/terrain/diskcache.hpp>
 #include <components/terrain/quadtreeworld.hpp>
 #include <components/terrain/terraingrid.hpp>
 
@@ -338,7 +339,8 @@ namespace MWRender
     RenderingManager::RenderingManager(osgViewer::Viewer* viewer, osg::ref_ptr<osg::Group> rootNode,
         Resource::ResourceSystem* resourceSystem, SceneUtil::WorkQueue* workQueue,
         const std::filesystem::path& resourcePath, DetourNavigator::Navigator& navigator,
-        const MWWorld::GroundcoverStore& groundcoverStore, SceneUtil::UnrefQueue& unrefQueue)
+        const MWWorld::GroundcoverStore& groundcoverStore, SceneUtil::UnrefQueue& unrefQueue,
+        const std::filesystem::path& userDataPath)
         : mSkyBlending(Settings::Manager::getBool("sky blending", "Fog"))
         , mViewer(viewer)
         , mRootNode(rootNode)
@@ -493,6 +495,17 @@ namespace MWRender
 
         mTerrainStorage = std::make_unique<TerrainStorage>(mResourceSystem, normalMapPattern, heightMapPattern,
             useTerrainNormalMaps, specularMapPattern, useTerrainSpecularMaps);
+        if (Settings::Manager::getBool("disk cache", "Terrain"))
+        {
+            try
+            {
+                mTerrainStorage->setDiskCache(std::make_unique<Terrain::DiskCache>(userDataPath / "terrain"));
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Error) << "Failed to create terrain disk cache: " << e.what();
+            }
+        }
         const float lodFactor = Settings::Manager::getFloat("lod factor", "Terrain");
 
         bool groundcover = Settings::Manager::getBool("enabled", "Groundcover");
@@ -0,0 +1,149 @@
+#include "scriptcache.hpp"
+
+#include <components/debug/debuglog.hpp>
+#include <components/files/conversion.hpp>
+
+#include <extern/smhasher/MurmurHash3.h>
+
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+
+namespace MWScript
+{
+    namespace
+    {
+        constexpr std::array<char, 8> magic = { 'O', 'M', 'W', 'S', 'C', 'R', 'P', 'T' };
+
+        // Increase when the file format changes
+        constexpr std::uint32_t formatVersion = 1;
+
+        constexpr std::array<char, 3> localTypes = { 's', 'l', 'f' };
+
+        template <class T>
+        void writeValue(std::ostream& stream, const T& value)
+        {
+            stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        void writeString(std::ostream& stream, std::string_view value)
+        {
+            writeValue(stream, static_cast<std::uint32_t>(value.size()));
+            stream.write(value.data(), static_cast<std::streamsize>(value.size()));
+        }
+
+        template <class T>
+        T readValue(std::istream& stream)
+        {
+            T value;
+            if (!stream.read(reinterpret_cast<char*>(&value), sizeof(T)))
+                throw std::runtime_error("unexpected end of file");
+            return value;
+        }
+
+        std::string readString(std::istream& stream)
+        {
+            std::string value(readValue<std::uint32_t>(stream), '\0');
+            if (!stream.read(value.data(), static_cast<std::streamsize>(value.size())))
+                throw std::runtime_error("unexpected end of file");
+            return value;
+        }
+    }
+
+    ScriptHash getScriptHash(std::string_view text)
+    {
+        ScriptHash result{ 0, 0 };
+        const ScriptHash seed{ 0, 0 };
+        MurmurHash3_x64_128(text.data(), static_cast<int>(text.size()), seed.data(), result.data());
+        return result;
+    }
+
+    ScriptCache readScriptCache(const std::filesystem::path& path, const ScriptHash& key)
+    {
+        std::ifstream stream(path, std::ios::binary);
+        if (!stream.is_open())
+            return {};
+
+        try
+        {
+            if (readValue<std::array<char, 8>>(stream) != magic || readValue<std::uint32_t>(stream) != formatVersion
+                || readValue<ScriptHash>(stream) != key)
+                return {};
+
+            ScriptCache result;
+            const std::uint32_t scriptsCount = readValue<std::uint32_t>(stream);
+            for (std::uint32_t i = 0; i < scriptsCount; ++i)
+            {
+                std::string id = readString(stream);
+                CachedScript& script = result[std::move(id)];
+                script.mHash = readValue<ScriptHash>(stream);
+                script.mByteCode.resize(readValue<std::uint32_t>(stream));
+                if (!stream.read(reinterpret_cast<char*>(script.mByteCode.data()),
+                        static_cast<std::streamsize>(script.mByteCode.size() * sizeof(Interpreter::Type_Code))))
+                    throw std::runtime_error("unexpected end of file");
+                for (const char type : localTypes)
+                {
+                    const std::uint32_t localsCount = readValue<std::uint32_t>(stream);
+                    for (std::uint32_t j = 0; j < localsCount; ++j)
+                        script.mLocals.declare(type, readString(stream));
+                }
+            }
+            return result;
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to read script cache \"" << Files::pathToUnicodeString(path)
+                                << "\": " << e.what();
+            return {};
+        }
+    }
+
+    void writeScriptCache(const std::filesystem::path& path, const ScriptHash& key, const ScriptCache& cache)
+    {
+        std::filesystem::path tempPath = path;
+        tempPath += ".tmp";
+
+        {
+            std::ofstream stream(tempPath, std::ios::binary | std::ios::trunc);
+            if (!stream.is_open())
+            {
+                Log(Debug::Warning) << "Failed to open script cache \"" << Files::pathToUnicodeString(tempPath)
+                                    << "\" for writing";
+                return;
+            }
+
+            writeValue(stream, magic);
+            writeValue(stream, formatVersion);
+            writeValue(stream, key);
+            writeValue(stream, static_cast<std::uint32_t>(cache.size()));
+            for (const auto& [id, script] : cache)
+            {
+                writeString(stream, id);
+                writeValue(stream, script.mHash);
+                writeValue(stream, static_cast<std::uint32_t>(script.mByteCode.size()));
+                stream.write(reinterpret_cast<const char*>(script.mByteCode.data()),
+                    static_cast<std::streamsize>(script.mByteCode.size() * sizeof(Interpreter::Type_Code)));
+                for (const char type : localTypes)
+                {
+                    const std::vector<std::string>& locals = script.mLocals.get(type);
+                    writeValue(stream, static_cast<std::uint32_t>(locals.size()));
+                    for (const std::string& name : locals)
+                        writeString(stream, name);
+                }
+            }
+
+            if (!stream.flush())
+            {
+                Log(Debug::Warning) << "Failed to write script cache \"" << Files::pathToUnicodeString(tempPath)
+                                    << "\"";
+                return;
+            }
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(tempPath, path, ec);
+        if (ec)
+            Log(Debug::Warning) << "Failed to replace script cache \"" << Files::pathToUnicodeString(path)
+                                << "\": " << ec.message();
+    }
+}
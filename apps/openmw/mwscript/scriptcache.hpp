@@ -0,0 +1,39 @@
+#ifndef GAME_SCRIPT_SCRIPTCACHE_H
+#define GAME_SCRIPT_SCRIPTCACHE_H
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <components/compiler/locals.hpp>
+#include <components/interpreter/types.hpp>
+
+namespace MWScript
+{
+    using ScriptHash = std::array<std::uint64_t, 2>;
+
+    ScriptHash getScriptHash(std::string_view text);
+
+    struct CachedScript
+    {
+        ScriptHash mHash;
+        std::vector<Interpreter::Type_Code> mByteCode;
+        Compiler::Locals mLocals;
+    };
+
+    /// Compiled scripts by lower case id
+    using ScriptCache = std::unordered_map<std::string, CachedScript>;
+
+    /// Return scripts from the cache file written for the same \a key. Return empty cache if there is no such file,
+    /// it is written for another key or can't be read.
+    ScriptCache readScriptCache(const std::filesystem::path& path, const ScriptHash& key);
+
+    /// Replace the cache file. Errors are logged and otherwise ignored.
+    void writeScriptCache(const std::filesystem::path& path, const ScriptHash& key, const ScriptCache& cache);
+}
+
+#endif
@@ -1,12 +1,15 @@
 #include "scriptmanagerimp.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <exception>
 #include <sstream>
+#include <thread>
 
 #include <components/debug/debuglog.hpp>
 
+#include <components/esm3/loadglob.hpp>
 #include <components/esm3/loadscpt.hpp>
 
 #include <components/misc/strings/lower.hpp>
@@ -20,6 +23,7 @@
 
 #include "extensions.hpp"
 #include "interpretercontext.hpp"
+#include "scriptcache.hpp"
 
 namespace MWScript
 {
@@ -30,6 +34,7 @@ namespace MWScript
         , mCompilerContext(compilerContext)
         , mParser(mErrorHandler, mCompilerContext)
         , mOpcodesInstalled(false)
+        , mWarningsMode(warningsMode)
         , mGlobalScripts(store)
     {
         mErrorHandler.setWarningsMode(warningsMode);
@@ -41,56 +46,108 @@ namespace MWScript
         std::sort(mScriptBlacklist.begin(), mScriptBlacklist.end());
     }
 
-    bool ScriptManager::compile(std::string_view name)
+    std::optional<ScriptManager::CompiledScript> ScriptManager::compile(
+        const ESM::Script& script, Compiler::StreamErrorHandler& errorHandler, Compiler::FileParser& parser) const
     {
-        mParser.reset();
-        mErrorHandler.reset();
+        parser.reset();
+        errorHandler.reset();
+        errorHandler.setContext(script.mId);
 
-        if (const ESM::Script* script = mStore.get<ESM::Script>().find(name))
+        bool Success = true;
+        try
         {
-            mErrorHandler.setContext(script->mId);
-
-            bool Success = true;
-            try
-            {
-                std::istringstream input(script->mScriptText);
+            std::istringstream input(script.mScriptText);
 
-                Compiler::Scanner scanner(mErrorHandler, input, mCompilerContext.getExtensions());
+            Compiler::Scanner scanner(errorHandler, input, mCompilerContext.getExtensions());
 
-                scanner.scan(mParser);
+            scanner.scan(parser);
 
-                if (!mErrorHandler.isGood())
-                    Success = false;
-            }
-            catch (const Compiler::SourceException&)
-            {
-                // error has already been reported via error handler
-                Success = false;
-            }
-            catch (const std::exception& error)
-            {
-                Log(Debug::Error) << "Error: An exception has been thrown: " << error.what();
+            if (!errorHandler.isGood())
                 Success = false;
-            }
+        }
+        catch (const Compiler::SourceException&)
+        {
+            // error has already been reported via error handler
+            Success = false;
+        }
+        catch (const std::exception& error)
+        {
+            Log(Debug::Error) << "Error: An exception has been thrown: " << error.what();
+            Success = false;
+        }
 
-            if (!Success)
-            {
-                Log(Debug::Error) << "Error: script compiling failed: " << name;
-            }
+        if (!Success)
+        {
+            Log(Debug::Error) << "Error: script compiling failed: " << script.mId;
+            return std::nullopt;
+        }
 
-            if (Success)
-            {
-                std::vector<Interpreter::Type_Code> code;
-                mParser.getCode(code);
-                mScripts.emplace(name, CompiledScript(code, mParser.getLocals()));
+        std::vector<Interpreter::Type_Code> code;
+        parser.getCode(code);
+        return CompiledScript(std::move(code), parser.getLocals());
+    }
 
-                return true;
-            }
+    bool ScriptManager::compile(std::string_view name)
+    {
+        if (const ESM::Script* script = mStore.get<ESM::Script>().find(name))
+        {
+            std::optional<CompiledScript> compiled = compile(*script, mErrorHandler, mParser);
+            if (!compiled.has_value())
+                return false;
+
+            mScripts.emplace(name, std::move(*compiled));
+            return true;
         }
 
         return false;
     }
 
+    std::vector<const ESM::Script*> ScriptManager::getScriptsToCompile() const
+    {
+        std::vector<const ESM::Script*> result;
+
+        for (const ESM::Script& script : mStore.get<ESM::Script>())
+        {
+            if (!std::binary_search(
+                    mScriptBlacklist.begin(), mScriptBlacklist.end(), Misc::StringUtils::lowerCase(script.mId)))
+                result.push_back(&script);
+        }
+
+        return result;
+    }
+
+    std::vector<std::optional<ScriptManager::CompiledScript>> ScriptManager::compile(
+        const std::vector<const ESM::Script*>& scripts, std::size_t threads)
+    {
+        std::vector<std::optional<CompiledScript>> result(scripts.size());
+        std::atomic_size_t next = 0;
+
+        // Each thread has own parser and error handler, compiler context and extensions are shared
+        const auto work = [&] {
+            Compiler::StreamErrorHandler errorHandler;
+            errorHandler.setWarningsMode(mWarningsMode);
+            Compiler::FileParser parser(errorHandler, mCompilerContext);
+            for (std::size_t i = next++; i < scripts.size(); i = next++)
+                result[i] = compile(*scripts[i], errorHandler, parser);
+        };
+
+        if (threads == 0)
+            threads = std::max(std::thread::hardware_concurrency(), 1u);
+        threads = std::min(threads, std::max<std::size_t>(scripts.size(), 1));
+
+        std::vector<std::thread> workers;
+        workers.reserve(threads - 1);
+        for (std::size_t i = 1; i < threads; ++i)
+            workers.emplace_back(work);
+
+        work();
+
+        for (std::thread& worker : workers)
+            worker.join();
+
+        return result;
+    }
+
     bool ScriptManager::run(std::string_view name, Interpreter::Context& interpreterContext)
     {
         // compile script
@@ -121,7 +178,12 @@ namespace MWScript
                     mOpcodesInstalled = true;
                 }
 
-                mInterpreter.run(&iter->second.mByteCode[0], iter->second.mByteCode.size(), interpreterContext);
+                CompiledScript& script = iter->second;
+                if (!script.mProgram.has_value())
+                    script.mProgram = mInterpreter.decode(script.mByteCode.data(), script.mByteCode.size());
+
+                mInterpreter.run(
+                    *script.mProgram, script.mByteCode.data(), script.mByteCode.size(), interpreterContext);
                 return true;
             }
             catch (const MissingImplicitRefError& e)
@@ -149,26 +211,100 @@ namespace MWScript
 
     std::pair<int, int> ScriptManager::compileAll()
     {
-        int count = 0;
+        const std::vector<const ESM::Script*> scripts = getScriptsToCompile();
+        std::vector<std::optional<CompiledScript>> compiled = compile(scripts, 0);
+
         int success = 0;
 
-        for (auto& script : mStore.get<ESM::Script>())
+        for (std::size_t i = 0; i < scripts.size(); ++i)
         {
-            if (!std::binary_search(
-                    mScriptBlacklist.begin(), mScriptBlacklist.end(), Misc::StringUtils::lowerCase(script.mId)))
+            if (!compiled[i].has_value())
+                continue;
+
+            mScripts.insert_or_assign(scripts[i]->mId, std::move(*compiled[i]));
+            ++success;
+        }
+
+        return std::make_pair(static_cast<int>(scripts.size()), success);
+    }
+
+    std::pair<int, int> ScriptManager::precompileAll(
+        std::size_t threads, const std::filesystem::path& cachePath, std::string_view cacheKey)
+    {
+        const std::vector<const ESM::Script*> scripts = getScriptsToCompile();
+
+        // Result of compilation depends on the script text, types of global variables and locals of other scripts
+        std::vector<std::pair<std::string, ScriptHash>> hashes;
+        hashes.reserve(scripts.size());
+        for (const ESM::Script* script : scripts)
+            hashes.emplace_back(Misc::StringUtils::lowerCase(script->mId), getScriptHash(script->mScriptText));
+        std::sort(hashes.begin(), hashes.end());
+
+        std::vector<std::pair<std::string, int>> globals;
+        for (const ESM::Global& global : mStore.get<ESM::Global>())
+            globals.emplace_back(Misc::StringUtils::lowerCase(global.mId), static_cast<int>(global.mValue.getType()));
+        std::sort(globals.begin(), globals.end());
+
+        std::ostringstream key;
+        key << cacheKey << '\n';
+        for (const auto& [id, type] : globals)
+            key << id << ' ' << type << '\n';
+        for (const auto& [id, hash] : hashes)
+            key << id << ' ' << hash[0] << ' ' << hash[1] << '\n';
+        const ScriptHash keyHash = getScriptHash(key.str());
+
+        ScriptCache cache = readScriptCache(cachePath, keyHash);
+
+        int success = 0;
+        std::vector<const ESM::Script*> notCached;
+
+        for (const ESM::Script* script : scripts)
+        {
+            const auto it = cache.find(Misc::StringUtils::lowerCase(script->mId));
+            if (it == cache.end() || it->second.mHash != getScriptHash(script->mScriptText))
             {
-                ++count;
+                notCached.push_back(script);
+                continue;
+            }
 
-                if (compile(script.mId))
-                    ++success;
+            mScripts.insert_or_assign(script->mId, CompiledScript(it->second.mByteCode, it->second.mLocals));
+            ++success;
+        }
+
+        if (notCached.empty())
+            return std::make_pair(static_cast<int>(scripts.size()), success);
+
+        std::vector<std::optional<CompiledScript>> compiled = compile(notCached, threads);
+        bool changed = false;
+
+        for (std::size_t i = 0; i < notCached.size(); ++i)
+        {
+            const ESM::Script& script = *notCached[i];
+
+            if (!compiled[i].has_value())
+            {
+                // Don't try to compile it again on the first run
+                mScripts.insert_or_assign(script.mId, CompiledScript({}, {}));
+                continue;
             }
+
+            cache.insert_or_assign(Misc::StringUtils::lowerCase(script.mId),
+                CachedScript{ getScriptHash(script.mScriptText), compiled[i]->mByteCode, compiled[i]->mLocals });
+            mScripts.insert_or_assign(script.mId, std::move(*compiled[i]));
+            changed = true;
+            ++success;
         }
 
-        return std::make_pair(count, success);
+        if (changed)
+            writeScriptCache(cachePath, keyHash, cache);
+
+        return std::make_pair(static_cast<int>(scripts.size()), success);
     }
 
     const Compiler::Locals& ScriptManager::getLocals(std::string_view name)
     {
+        const std::lock_guard lock(mLocalsMutex);
+
         {
             auto iter = mScripts.find(name);
 
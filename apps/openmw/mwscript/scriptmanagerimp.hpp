@@ -1,14 +1,22 @@
 #ifndef GAME_SCRIPT_SCRIPTMANAGER_H
 #define GAME_SCRIPT_SCRIPTMANAGER_H
 
+#include <cstddef>
+#include <filesystem>
 #include <map>
+#include <mutex>
+#include <optional>
 #include <set>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 #include <components/compiler/fileparser.hpp>
 #include <components/compiler/streamerrorhandler.hpp>
 
 #include <components/interpreter/interpreter.hpp>
+#include <components/interpreter/program.hpp>
 #include <components/interpreter/types.hpp>
 
 #include "../mwbase/scriptmanager.hpp"
@@ -25,6 +33,11 @@ namespace Compiler
     class Context;
 }
 
+namespace ESM
+{
+    struct Script;
+}
+
 namespace Interpreter
 {
     class Context;
@@ -41,16 +54,18 @@ namespace MWScript
         Compiler::FileParser mParser;
         Interpreter::Interpreter mInterpreter;
         bool mOpcodesInstalled;
+        int mWarningsMode;
 
         struct CompiledScript
         {
             std::vector<Interpreter::Type_Code> mByteCode;
+            std::optional<Interpreter::Program> mProgram; // decoded on first run
             Compiler::Locals mLocals;
             std::set<std::string> mInactive;
 
-            CompiledScript(const std::vector<Interpreter::Type_Code>& code, const Compiler::Locals& locals)
-                : mByteCode(code)
-                , mLocals(locals)
+            CompiledScript(std::vector<Interpreter::Type_Code> code, Compiler::Locals locals)
+                : mByteCode(std::move(code))
+                , mLocals(std::move(locals))
             {
             }
         };
@@ -61,6 +76,18 @@ namespace MWScript
         std::unordered_map<std::string, Compiler::Locals, ::Misc::StringUtils::CiHash, ::Misc::StringUtils::CiEqual>
             mOtherLocals;
         std::vector<std::string> mScriptBlacklist;
+        // Compiler context requests locals of other scripts from the compiling threads
+        std::recursive_mutex mLocalsMutex;
+
+        std::optional<CompiledScript> compile(const ESM::Script& script, Compiler::StreamErrorHandler& errorHandler,
+            Compiler::FileParser& parser) const;
+
+        std::vector<const ESM::Script*> getScriptsToCompile() const;
+
+        /// Compile \a scripts using \a threads threads including the calling one, 0 means the number of hardware
+        /// threads. Result has the same order as \a scripts, failed scripts have no value.
+        std::vector<std::optional<CompiledScript>> compile(
+            const std::vector<const ESM::Script*>& scripts, std::size_t threads);
 
     public:
         ScriptManager(const MWWorld::ESMStore& store, Compiler::Context& compilerContext, int warningsMode,
@@ -79,6 +106,13 @@ namespace MWScript
         ///< Compile all scripts
         /// \return count, success
 
+        std::pair<int, int> precompileAll(
+            std::size_t threads, const std::filesystem::path& cachePath, std::string_view cacheKey);
+        ///< Compile all scripts in parallel using \a threads threads, 0 means the number of hardware threads.
+        /// Byte code is loaded from the cache at \a cachePath instead if it was written for the same \a cacheKey and
+        /// the same scripts and global variables. The cache is updated with newly compiled scripts.
+        /// \return count, success
+
         const Compiler::Locals& getLocals(std::string_view name) override;
         ///< Return locals for script \a name.
 
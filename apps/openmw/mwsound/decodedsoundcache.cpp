@@ -0,0 +1,79 @@
+#include "decodedsoundcache.hpp"
+
+#include <components/debug/debuglog.hpp>
+#include <components/misc/resourcehelpers.hpp>
+
+namespace MWSound
+{
+    std::shared_ptr<const DecodedSound> decodeSound(Sound_Decoder& decoder, const std::string& fname)
+    {
+        auto result = std::make_shared<DecodedSound>();
+
+        try
+        {
+            decoder.open(Misc::ResourceHelpers::correctSoundPath(fname, decoder.mResourceMgr));
+            decoder.getInfo(&result->mSampleRate, &result->mChannelConfig, &result->mSampleType);
+            decoder.readAll(result->mData);
+            decoder.close();
+        }
+        catch (std::exception& e)
+        {
+            Log(Debug::Error) << "Failed to load audio from " << fname << ": " << e.what();
+            result->mData.clear();
+        }
+
+        return result;
+    }
+
+    DecodedSoundCache::DecodedSoundCache(std::size_t maxSize)
+        : mMaxSize(maxSize)
+    {
+    }
+
+    std::shared_ptr<const DecodedSound> DecodedSoundCache::get(std::string_view name)
+    {
+        const std::lock_guard lock(mMutex);
+        const auto it = mIndex.find(name);
+        if (it == mIndex.end())
+            return nullptr;
+        mEntries.splice(mEntries.begin(), mEntries, it->second);
+        return it->second->second;
+    }
+
+    void DecodedSoundCache::insert(const std::string& name, std::shared_ptr<const DecodedSound> sound)
+    {
+        const std::lock_guard lock(mMutex);
+        if (mIndex.find(name) != mIndex.end())
+            return;
+        mSize += sound->mData.size();
+        mEntries.emplace_front(name, std::move(sound));
+        mIndex.emplace(mEntries.front().first, mEntries.begin());
+        evict();
+    }
+
+    std::size_t DecodedSoundCache::getSize() const
+    {
+        const std::lock_guard lock(mMutex);
+        return mSize;
+    }
+
+    void DecodedSoundCache::clear()
+    {
+        const std::lock_guard lock(mMutex);
+        mIndex.clear();
+        mEntries.clear();
+        mSize = 0;
+    }
+
+    void DecodedSoundCache::evict()
+    {
+        // Keep at least the newest entry so a single sound bigger than the cache is still shared while in use
+        while (mSize > mMaxSize && mEntries.size() > 1)
+        {
+            const Entry& oldest = mEntries.back();
+            mSize -= oldest.second->mData.size();
+            mIndex.erase(oldest.first);
+            mEntries.pop_back();
+        }
+    }
+}
@@ -0,0 +1,59 @@
+#ifndef GAME_SOUND_DECODEDSOUNDCACHE_H
+#define GAME_SOUND_DECODEDSOUNDCACHE_H
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "sound_decoder.hpp"
+
+namespace MWSound
+{
+    /// Fully decoded PCM data of a sound file.
+    struct DecodedSound
+    {
+        int mSampleRate = 0;
+        ChannelConfig mChannelConfig = ChannelConfig_Mono;
+        SampleType mSampleType = SampleType_UInt8;
+        std::vector<char> mData;
+    };
+
+    /// Decode the whole file using the given decoder. Never throws: on failure the returned sound has no data,
+    /// which the output substitutes with silence.
+    std::shared_ptr<const DecodedSound> decodeSound(Sound_Decoder& decoder, const std::string& fname);
+
+    /// Thread-safe memory-bounded LRU cache of decoded sounds, keyed by normalized resource name.
+    /// Decoded data is shared between all sound buffers using the same file.
+    class DecodedSoundCache
+    {
+    public:
+        explicit DecodedSoundCache(std::size_t maxSize);
+
+        std::shared_ptr<const DecodedSound> get(std::string_view name);
+
+        void insert(const std::string& name, std::shared_ptr<const DecodedSound> sound);
+
+        std::size_t getSize() const;
+
+        void clear();
+
+    private:
+        using Entry = std::pair<std::string, std::shared_ptr<const DecodedSound>>;
+
+        const std::size_t mMaxSize;
+        mutable std::mutex mMutex;
+        std::size_t mSize = 0;
+        // NOTE: entries are stored in front-newest order.
+        std::list<Entry> mEntries;
+        std::unordered_map<std::string_view, std::list<Entry>::iterator> mIndex;
+
+        void evict();
+    };
+}
+
+#endif
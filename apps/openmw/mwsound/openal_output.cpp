@@ -15,6 +15,7 @@
 #include <components/misc/resourcehelpers.hpp>
 #include <components/vfs/manager.hpp>
 
+#include "decodedsoundcache.hpp"
 #include "loudness.hpp"
 #include "openal_output.hpp"
 #include "sound.hpp"
@@ -959,43 +960,32 @@ namespace MWSound
         }
     }
 
-    std::pair<Sound_Handle, size_t> OpenAL_Output::loadSound(const std::string& fname)
+    std::pair<Sound_Handle, size_t> OpenAL_Output::loadSound(const DecodedSound& sound)
     {
         getALError();
 
-        std::vector<char> data;
+        const char* data = sound.mData.data();
+        ALsizei dataSize = static_cast<ALsizei>(sound.mData.size());
         ALenum format = AL_NONE;
-        int srate = 0;
+        int srate = sound.mSampleRate;
 
-        try
-        {
-            DecoderPtr decoder = mManager.getDecoder();
-            decoder->open(Misc::ResourceHelpers::correctSoundPath(fname, decoder->mResourceMgr));
-
-            ChannelConfig chans;
-            SampleType type;
-            decoder->getInfo(&srate, &chans, &type);
-            format = getALFormat(chans, type);
-            if (format)
-                decoder->readAll(data);
-        }
-        catch (std::exception& e)
-        {
-            Log(Debug::Error) << "Failed to load audio from " << fname << ": " << e.what();
-        }
+        if (dataSize > 0)
+            format = getALFormat(sound.mChannelConfig, sound.mSampleType);
 
-        if (data.empty())
+        static const std::vector<char> silence(8000, -128);
+        if (format == AL_NONE)
         {
             // If we failed to get any usable audio, substitute with silence.
             format = AL_FORMAT_MONO8;
             srate = 8000;
-            data.assign(8000, -128);
+            data = silence.data();
+            dataSize = static_cast<ALsizei>(silence.size());
         }
 
         ALint size;
         ALuint buf = 0;
         alGenBuffers(1, &buf);
-        alBufferData(buf, format, data.data(), data.size(), srate);
+        alBufferData(buf, format, data, dataSize, srate);
         alGetBufferi(buf, AL_SIZE, &size);
         if (getALError() != AL_NO_ERROR)
         {
@@ -4,12 +4,17 @@
 #include "../mwbase/world.hpp"
 #include "../mwworld/esmstore.hpp"
 
+#include "decodedsoundcache.hpp"
+#include "soundmanagerimp.hpp"
+
 #include <components/debug/debuglog.hpp>
 #include <components/esm3/loadsoun.hpp>
+#include <components/sceneutil/workqueue.hpp>
 #include <components/settings/settings.hpp>
 #include <components/vfs/manager.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 
 namespace MWSound
@@ -36,9 +41,48 @@ namespace MWSound
         }
     }
 
-    SoundBufferPool::SoundBufferPool(const VFS::Manager& vfs, Sound_Output& output)
+    /// Worker thread item: decode a sound file into the shared decoded sound cache.
+    class DecodeSoundItem : public SceneUtil::WorkItem
+    {
+    public:
+        DecodeSoundItem(DecoderPtr decoder, const std::string& resourceName, std::shared_ptr<DecodedSoundCache> cache)
+            : mDecoder(std::move(decoder))
+            , mResourceName(resourceName)
+            , mCache(std::move(cache))
+        {
+        }
+
+        void doWork() override
+        {
+            if (mAbort)
+                return;
+            mResult = mCache->get(mResourceName);
+            if (mResult != nullptr)
+                return;
+            mResult = decodeSound(*mDecoder, mResourceName);
+            mCache->insert(mResourceName, mResult);
+        }
+
+        void abort() override { mAbort = true; }
+
+        /// May be called only after the item is done. Returns nullptr when aborted.
+        const std::shared_ptr<const DecodedSound>& getResult() const { return mResult; }
+
+    private:
+        DecoderPtr mDecoder;
+        std::string mResourceName;
+        std::shared_ptr<DecodedSoundCache> mCache;
+        std::shared_ptr<const DecodedSound> mResult;
+        std::atomic_bool mAbort{ false };
+    };
+
+    SoundBufferPool::SoundBufferPool(const VFS::Manager& vfs, Sound_Output& output, SceneUtil::WorkQueue* workQueue)
         : mVfs(&vfs)
         , mOutput(&output)
+        , mWorkQueue(Settings::Manager::getBool("async decoding", "Sound") ? workQueue : nullptr)
+        , mDecodedSounds(std::make_shared<DecodedSoundCache>(
+              static_cast<std::size_t>(std::max(Settings::Manager::getInt("decoded cache max", "Sound"), 0)) * 1024
+              * 1024))
         , mBufferCacheMax(std::max(Settings::Manager::getInt("buffer cache max", "Sound"), 1) * 1024 * 1024)
         , mBufferCacheMin(
               std::min(static_cast<std::size_t>(std::max(Settings::Manager::getInt("buffer cache min", "Sound"), 1))
@@ -58,13 +102,13 @@ namespace MWSound
         if (it != mBufferNameMap.end())
         {
             Sound_Buffer* sfx = it->second;
-            if (sfx->getHandle() != nullptr)
+            if (sfx->getHandle() != nullptr || sfx->isPending())
                 return sfx;
         }
         return nullptr;
     }
 
-    Sound_Buffer* SoundBufferPool::load(const std::string& soundId)
+    Sound_Buffer* SoundBufferPool::find(const std::string& soundId)
     {
         if (mBufferNameMap.empty())
         {
@@ -72,49 +116,131 @@ namespace MWSound
                 insertSound(Misc::StringUtils::lowerCase(sound.mId), sound);
         }
 
-        Sound_Buffer* sfx;
         const auto it = mBufferNameMap.find(soundId);
         if (it != mBufferNameMap.end())
-            sfx = it->second;
+            return it->second;
+
+        const ESM::Sound* sound = MWBase::Environment::get().getWorld()->getStore().get<ESM::Sound>().search(soundId);
+        if (sound == nullptr)
+            return nullptr;
+        return insertSound(soundId, *sound);
+    }
+
+    Sound_Buffer* SoundBufferPool::load(const std::string& soundId)
+    {
+        Sound_Buffer* sfx = find(soundId);
+        if (sfx == nullptr)
+            return nullptr;
+
+        if (sfx->getHandle() != nullptr || sfx->mPending)
+            return sfx;
+
+        if (const auto decoded = mDecodedSounds->get(sfx->getResourceName()))
+            loadBuffer(*sfx, *decoded);
+        else if (mWorkQueue != nullptr)
+        {
+            startDecoding(sfx->getResourceName());
+            sfx->mPending = true;
+            mPendingBuffers.push_back(sfx);
+            return sfx;
+        }
         else
         {
-            const ESM::Sound* sound
-                = MWBase::Environment::get().getWorld()->getStore().get<ESM::Sound>().search(soundId);
-            if (sound == nullptr)
-                return {};
-            sfx = insertSound(soundId, *sound);
+            const DecoderPtr decoder = mOutput->mManager.getDecoder();
+            std::shared_ptr<const DecodedSound> decoded = decodeSound(*decoder, sfx->getResourceName());
+            mDecodedSounds->insert(sfx->getResourceName(), decoded);
+            loadBuffer(*sfx, *decoded);
         }
 
         if (sfx->getHandle() == nullptr)
+            return nullptr;
+
+        return sfx;
+    }
+
+    void SoundBufferPool::preload(const std::vector<std::string>& soundIds)
+    {
+        if (mWorkQueue == nullptr)
+            return;
+
+        for (const std::string& soundId : soundIds)
         {
-            auto [handle, size] = mOutput->loadSound(sfx->getResourceName());
-            if (handle == nullptr)
-                return {};
+            const Sound_Buffer* sfx = find(Misc::StringUtils::lowerCase(soundId));
+            if (sfx == nullptr || sfx->getHandle() != nullptr || mDecodedSounds->get(sfx->getResourceName()) != nullptr)
+                continue;
+            startDecoding(sfx->getResourceName());
+        }
+    }
 
-            sfx->mHandle = handle;
+    void SoundBufferPool::update()
+    {
+        for (auto it = mDecodeItems.begin(); it != mDecodeItems.end();)
+        {
+            if (!it->second->isDone())
+            {
+                ++it;
+                continue;
+            }
 
-            mBufferCacheSize += size;
-            if (mBufferCacheSize > mBufferCacheMax)
+            const std::shared_ptr<const DecodedSound>& result = it->second->getResult();
+            const auto pendingEnd = std::partition(mPendingBuffers.begin(), mPendingBuffers.end(),
+                [&](const Sound_Buffer* sfx) { return sfx->getResourceName() != it->first; });
+            for (auto pending = pendingEnd; pending != mPendingBuffers.end(); ++pending)
             {
-                unloadUnused();
-                if (!mUnusedBuffers.empty() && mBufferCacheSize > mBufferCacheMax)
-                    Log(Debug::Warning) << "No unused sound buffers to free, using " << mBufferCacheSize << " bytes!";
+                Sound_Buffer& sfx = **pending;
+                sfx.mPending = false;
+                if (result != nullptr)
+                    loadBuffer(sfx, *result);
             }
-            mUnusedBuffers.push_front(sfx);
+            mPendingBuffers.erase(pendingEnd, mPendingBuffers.end());
+
+            it = mDecodeItems.erase(it);
         }
+    }
 
-        return sfx;
+    void SoundBufferPool::startDecoding(const std::string& resourceName)
+    {
+        if (mDecodeItems.find(resourceName) != mDecodeItems.end())
+            return;
+
+        osg::ref_ptr<DecodeSoundItem> item(
+            new DecodeSoundItem(mOutput->mManager.getDecoder(), resourceName, mDecodedSounds));
+        mWorkQueue->addWorkItem(item);
+        mDecodeItems.emplace(resourceName, std::move(item));
+    }
+
+    void SoundBufferPool::loadBuffer(Sound_Buffer& sfx, const DecodedSound& decoded)
+    {
+        auto [handle, size] = mOutput->loadSound(decoded);
+        if (handle == nullptr)
+            return;
+
+        mBufferCacheSize += size;
+        if (mBufferCacheSize > mBufferCacheMax)
+        {
+            unloadUnused();
+            if (mUsage.hasUnused() && mBufferCacheSize > mBufferCacheMax)
+                Log(Debug::Warning) << "No unused sound buffers to free, using " << mBufferCacheSize << " bytes!";
+        }
+        mUsage.loaded(sfx, handle);
     }
 
     void SoundBufferPool::clear()
     {
+        for (auto& [name, item] : mDecodeItems)
+            item->abort();
+        mDecodeItems.clear();
+        for (Sound_Buffer* sfx : mPendingBuffers)
+            sfx->mPending = false;
+        mPendingBuffers.clear();
+
         for (auto& sfx : mSoundBuffers)
         {
             if (sfx.mHandle)
                 mOutput->unloadSound(sfx.mHandle);
             sfx.mHandle = nullptr;
         }
-        mUnusedBuffers.clear();
+        mUsage.clear();
     }
 
     Sound_Buffer* SoundBufferPool::insertSound(const std::string& soundId, const ESM::Sound& sound)
@@ -144,14 +270,7 @@ namespace MWSound
 
     void SoundBufferPool::unloadUnused()
     {
-        while (!mUnusedBuffers.empty() && mBufferCacheSize > mBufferCacheMin)
-        {
-            Sound_Buffer* const unused = mUnusedBuffers.back();
-
-            mBufferCacheSize -= mOutput->unloadSound(unused->getHandle());
-            unused->mHandle = nullptr;
-
-            mUnusedBuffers.pop_back();
-        }
+        while (mUsage.hasUnused() && mBufferCacheSize > mBufferCacheMin)
+            mBufferCacheSize -= mOutput->unloadSound(mUsage.takeUnused());
     }
 }
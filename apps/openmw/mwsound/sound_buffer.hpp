@@ -3,8 +3,13 @@
 
 #include <algorithm>
 #include <deque>
+#include <memory>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <osg/ref_ptr>
 
 #include "sound_output.hpp"
 
@@ -18,9 +23,17 @@ namespace VFS
     class Manager;
 }
 
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+
 namespace MWSound
 {
     class SoundBufferPool;
+    class SoundBufferUsage;
+    class DecodedSoundCache;
+    class DecodeSoundItem;
 
     class Sound_Buffer
     {
@@ -44,6 +57,9 @@ namespace MWSound
 
         float getMaxDist() const noexcept { return mMaxDist; }
 
+        /// The sound data is still being decoded in background. Playback has to be deferred until it's ready.
+        bool isPending() const noexcept { return mPending; }
+
     private:
         std::string mResourceName;
         float mVolume;
@@ -51,14 +67,68 @@ namespace MWSound
         float mMaxDist;
         Sound_Handle mHandle = nullptr;
         std::size_t mUses = 0;
+        bool mPending = false;
 
         friend class SoundBufferPool;
+        friend class SoundBufferUsage;
+    };
+
+    /// Counts sounds using each buffer and keeps the loaded buffers not used by any sound in front-newest order, so
+    /// the least recently used ones can be unloaded first.
+    /// @note Only buffers with a handle are listed as unused and every buffer is listed at most once. A buffer
+    /// released while still pending is listed when it's loaded.
+    class SoundBufferUsage
+    {
+    public:
+        void use(Sound_Buffer& sfx)
+        {
+            if (sfx.mUses++ == 0)
+            {
+                const auto it = std::find(mUnusedBuffers.begin(), mUnusedBuffers.end(), &sfx);
+                if (it != mUnusedBuffers.end())
+                    mUnusedBuffers.erase(it);
+            }
+        }
+
+        void release(Sound_Buffer& sfx)
+        {
+            if (--sfx.mUses == 0 && sfx.mHandle != nullptr)
+                mUnusedBuffers.push_front(&sfx);
+        }
+
+        /// Assign the handle of the buffer data that just finished loading.
+        void loaded(Sound_Buffer& sfx, Sound_Handle handle)
+        {
+            sfx.mHandle = handle;
+            // Pending buffers may already be in use by the sounds waiting for them
+            if (sfx.mUses == 0)
+                mUnusedBuffers.push_front(&sfx);
+        }
+
+        bool hasUnused() const { return !mUnusedBuffers.empty(); }
+
+        /// Reset the handle of the least recently used unused buffer and return it to be unloaded.
+        /// Returns nullptr if there are no unused buffers.
+        Sound_Handle takeUnused()
+        {
+            if (mUnusedBuffers.empty())
+                return nullptr;
+            Sound_Buffer* const unused = mUnusedBuffers.back();
+            mUnusedBuffers.pop_back();
+            return std::exchange(unused->mHandle, nullptr);
+        }
+
+        /// Forget all unused buffers. Handles have to be reset by the caller.
+        void clear() { mUnusedBuffers.clear(); }
+
+    private:
+        std::deque<Sound_Buffer*> mUnusedBuffers;
     };
 
     class SoundBufferPool
     {
     public:
-        SoundBufferPool(const VFS::Manager& vfs, Sound_Output& output);
+        SoundBufferPool(const VFS::Manager& vfs, Sound_Output& output, SceneUtil::WorkQueue* workQueue);
 
         SoundBufferPool(const SoundBufferPool&) = delete;
 
@@ -70,39 +140,44 @@ namespace MWSound
 
         /// Lookup a soundId for its sound data (resource name, local volume,
         /// minRange, and maxRange), and ensure it's ready for use.
+        /// @note With asynchronous decoding the returned buffer may still be pending, see Sound_Buffer::isPending.
         Sound_Buffer* load(const std::string& soundId);
 
-        void use(Sound_Buffer& sfx)
-        {
-            if (sfx.mUses++ == 0)
-            {
-                const auto it = std::find(mUnusedBuffers.begin(), mUnusedBuffers.end(), &sfx);
-                if (it != mUnusedBuffers.end())
-                    mUnusedBuffers.erase(it);
-            }
-        }
+        /// Start decoding the given sounds in background so that later load calls don't have to wait for it.
+        void preload(const std::vector<std::string>& soundIds);
 
-        void release(Sound_Buffer& sfx)
-        {
-            if (--sfx.mUses == 0)
-                mUnusedBuffers.push_front(&sfx);
-        }
+        /// Upload sounds that finished decoding. Has to be called regularly from the main thread.
+        void update();
+
+        void use(Sound_Buffer& sfx) { mUsage.use(sfx); }
+
+        void release(Sound_Buffer& sfx) { mUsage.release(sfx); }
 
         void clear();
 
     private:
         const VFS::Manager* const mVfs;
         Sound_Output* mOutput;
+        SceneUtil::WorkQueue* mWorkQueue;
+        std::shared_ptr<DecodedSoundCache> mDecodedSounds;
         std::deque<Sound_Buffer> mSoundBuffers;
         std::unordered_map<std::string, Sound_Buffer*> mBufferNameMap;
         std::size_t mBufferCacheMax;
         std::size_t mBufferCacheMin;
         std::size_t mBufferCacheSize = 0;
-        // NOTE: unused buffers are stored in front-newest order.
-        std::deque<Sound_Buffer*> mUnusedBuffers;
+        SoundBufferUsage mUsage;
+        // Decoding in progress by resource name
+        std::unordered_map<std::string, osg::ref_ptr<DecodeSoundItem>> mDecodeItems;
+        std::vector<Sound_Buffer*> mPendingBuffers;
+
+        inline Sound_Buffer* find(const std::string& soundId);
 
         inline Sound_Buffer* insertSound(const std::string& soundId, const ESM::Sound& sound);
 
+        void startDecoding(const std::string& resourceName);
+
+        void loadBuffer(Sound_Buffer& sfx, const DecodedSound& decoded);
+
         inline void unloadUnused();
     };
 }
@@ -11,6 +11,7 @@ namespace MWSound
 {
     class SoundManager;
     struct Sound_Decoder;
+    struct DecodedSound;
     class Sound;
     class Stream;
 
@@ -43,7 +44,7 @@ namespace MWSound
         virtual std::vector<std::string> enumerateHrtf() = 0;
         virtual void setHrtf(const std::string& hrtfname, HrtfMode hrtfmode) = 0;
 
-        virtual std::pair<Sound_Handle, size_t> loadSound(const std::string& fname) = 0;
+        virtual std::pair<Sound_Handle, size_t> loadSound(const DecodedSound& sound) = 0;
         virtual size_t unloadSound(Sound_Handle data) = 0;
 
         virtual bool playSound(Sound* sound, Sound_Handle data, float offset) = 0;
@@ -78,11 +78,11 @@ namespace MWSound
         return static_cast<int>(a) | static_cast<int>(b);
     }
 
-    SoundManager::SoundManager(const VFS::Manager* vfs, bool useSound)
+    SoundManager::SoundManager(const VFS::Manager* vfs, bool useSound, SceneUtil::WorkQueue* workQueue)
         : mVFS(vfs)
         , mOutput(new OpenAL_Output(*this))
         , mWaterSoundUpdater(makeWaterSoundUpdaterSettings())
-        , mSoundBuffers(*vfs, *mOutput)
+        , mSoundBuffers(*vfs, *mOutput, workQueue)
         , mListenerUnderwater(false)
         , mListenerPos(0, 0, 0)
         , mListenerDir(1, 0, 0)
@@ -517,7 +517,7 @@ namespace MWSound
             params.mFlags = mode | type | Play_2D;
             return params;
         }());
-        if (!mOutput->playSound(sound.get(), sfx->getHandle(), offset))
+        if (!startSound(sound.get(), *sfx, offset))
             return nullptr;
 
         Sound* result = sound.get();
@@ -557,7 +557,7 @@ namespace MWSound
                 params.mFlags = mode | type | Play_2D;
                 return params;
             }());
-            played = mOutput->playSound(sound.get(), sfx->getHandle(), offset);
+            played = startSound(sound.get(), *sfx, offset);
         }
         else
         {
@@ -573,7 +573,7 @@ namespace MWSound
                 params.mFlags = mode | type | Play_3D;
                 return params;
             }());
-            played = mOutput->playSound3D(sound.get(), sfx->getHandle(), offset);
+            played = startSound(sound.get(), *sfx, offset);
         }
         if (!played)
             return nullptr;
@@ -613,7 +613,7 @@ namespace MWSound
             params.mFlags = mode | type | Play_3D;
             return params;
         }());
-        if (!mOutput->playSound3D(sound.get(), sfx->getHandle(), offset))
+        if (!startSound(sound.get(), *sfx, offset))
             return nullptr;
 
         Sound* result = sound.get();
@@ -622,10 +622,57 @@ namespace MWSound
         return result;
     }
 
+    bool SoundManager::startSound(Sound* sound, Sound_Buffer& sfx, float offset)
+    {
+        if (sfx.isPending())
+        {
+            // Started by startPendingSounds once decoding is done
+            mPendingSounds.push_back(PendingSound{ sound, &sfx, offset });
+            return true;
+        }
+        if (sound->getIs3D())
+            return mOutput->playSound3D(sound, sfx.getHandle(), offset);
+        return mOutput->playSound(sound, sfx.getHandle(), offset);
+    }
+
+    void SoundManager::startPendingSounds()
+    {
+        std::size_t i = 0;
+        while (i < mPendingSounds.size())
+        {
+            const PendingSound pending = mPendingSounds[i];
+            if (pending.mBuffer->isPending())
+            {
+                ++i;
+                continue;
+            }
+            mPendingSounds[i] = mPendingSounds.back();
+            mPendingSounds.pop_back();
+            // Sounds failed to start are cleaned up by updateSounds as not playing
+            if (pending.mBuffer->getHandle() != nullptr)
+                startSound(pending.mSound, *pending.mBuffer, pending.mOffset);
+        }
+    }
+
+    bool SoundManager::isPendingSound(const Sound* sound) const
+    {
+        return std::any_of(mPendingSounds.begin(), mPendingSounds.end(),
+            [&](const PendingSound& pending) { return pending.mSound == sound; });
+    }
+
+    void SoundManager::finishSound(Sound* sound)
+    {
+        const auto it = std::find_if(mPendingSounds.begin(), mPendingSounds.end(),
+            [&](const PendingSound& pending) { return pending.mSound == sound; });
+        if (it != mPendingSounds.end())
+            mPendingSounds.erase(it);
+        mOutput->finishSound(sound);
+    }
+
     void SoundManager::stopSound(Sound* sound)
     {
         if (sound)
-            mOutput->finishSound(sound);
+            finishSound(sound);
     }
 
     void SoundManager::stopSound(Sound_Buffer* sfx, const MWWorld::ConstPtr& ptr)
@@ -636,7 +683,7 @@ namespace MWSound
             for (SoundBufferRefPair& snd : snditer->second.mList)
             {
                 if (snd.second == sfx)
-                    mOutput->finishSound(snd.first.get());
+                    finishSound(snd.first.get());
             }
         }
     }
@@ -659,7 +706,7 @@ namespace MWSound
         if (snditer != mActiveSounds.end())
         {
             for (SoundBufferRefPair& snd : snditer->second.mList)
-                mOutput->finishSound(snd.first.get());
+                finishSound(snd.first.get());
         }
         SaySoundMap::iterator sayiter = mSaySoundsQueue.find(ptr.mRef);
         if (sayiter != mSaySoundsQueue.end())
@@ -676,7 +723,7 @@ namespace MWSound
             if (ref != nullptr && ref != MWMechanics::getPlayer().mRef && sound.mCell == cell)
             {
                 for (SoundBufferRefPair& sndbuf : sound.mList)
-                    mOutput->finishSound(sndbuf.first.get());
+                    finishSound(sndbuf.first.get());
             }
         }
 
@@ -717,7 +764,8 @@ namespace MWSound
             Sound_Buffer* sfx = mSoundBuffers.lookup(Misc::StringUtils::lowerCase(soundId));
             return std::find_if(snditer->second.mList.cbegin(), snditer->second.mList.cend(),
                        [this, sfx](const SoundBufferRefPair& snd) -> bool {
-                           return snd.second == sfx && mOutput->isSoundPlaying(snd.first.get());
+                           return snd.second == sfx
+                               && (isPendingSound(snd.first.get()) || mOutput->isSoundPlaying(snd.first.get()));
                        })
                 != snditer->second.mList.cend();
         }
@@ -810,7 +858,7 @@ namespace MWSound
                 break;
             case WaterSoundAction::PlaySound:
                 if (mNearWaterSound)
-                    mOutput->finishSound(mNearWaterSound);
+                    finishSound(mNearWaterSound);
                 mNearWaterSound = playSound(update.mId, update.mVolume, 1.0f, Type::Sfx, PlayMode::Loop);
                 break;
         }
@@ -907,7 +955,7 @@ namespace MWSound
             env = Env_Underwater;
         else if (mUnderwaterSound)
         {
-            mOutput->finishSound(mUnderwaterSound);
+            finishSound(mUnderwaterSound);
             mUnderwaterSound = nullptr;
         }
 
@@ -934,9 +982,15 @@ namespace MWSound
                     cull3DSound(sound);
                 }
 
+                if (isPendingSound(sound))
+                {
+                    ++sndidx;
+                    continue;
+                }
+
                 if (!sound->updateFade(duration) || !mOutput->isSoundPlaying(sound))
                 {
-                    mOutput->finishSound(sound);
+                    finishSound(sound);
                     if (sound == mUnderwaterSound)
                         mUnderwaterSound = nullptr;
                     if (sound == mNearWaterSound)
@@ -1032,6 +1086,8 @@ namespace MWSound
         if (!mOutput->isInitialized() || mPlaybackPaused)
             return;
 
+        mSoundBuffers.update();
+        startPendingSounds();
         updateSounds(duration);
         if (MWBase::Environment::get().getStateManager()->getState() != MWBase::StateManager::State_NoGame)
         {
@@ -1040,6 +1096,14 @@ namespace MWSound
         }
     }
 
+    void SoundManager::preloadSounds(const std::vector<std::string>& soundIds)
+    {
+        if (!mOutput->isInitialized())
+            return;
+
+        mSoundBuffers.preload(soundIds);
+    }
+
     void SoundManager::processChangedSettings(const Settings::CategorySettingVector& settings)
     {
         mVolumeSettings.update();
@@ -1202,11 +1266,12 @@ namespace MWSound
         {
             for (SoundBufferRefPair& sndbuf : snd.second.mList)
             {
-                mOutput->finishSound(sndbuf.first.get());
+                finishSound(sndbuf.first.get());
                 mSoundBuffers.release(*sndbuf.second);
             }
         }
         mActiveSounds.clear();
+        mPendingSounds.clear();
         mUnderwaterSound = nullptr;
         mNearWaterSound = nullptr;
 
@@ -24,6 +24,11 @@ namespace VFS
     class Manager;
 }
 
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+
 namespace ESM
 {
     struct Sound;
@@ -74,6 +79,16 @@ namespace MWSound
         typedef std::map<const MWWorld::LiveCellRefBase*, ActiveSound> SoundMap;
         SoundMap mActiveSounds;
 
+        // Active sounds waiting for their buffer to be decoded
+        struct PendingSound
+        {
+            Sound* mSound;
+            Sound_Buffer* mBuffer;
+            float mOffset;
+        };
+
+        std::vector<PendingSound> mPendingSounds;
+
         struct SaySound
         {
             const MWWorld::CellStore* mCell;
@@ -125,6 +140,11 @@ namespace MWSound
         void advanceMusic(const std::string& filename);
         void startRandomTitle();
 
+        bool startSound(Sound* sound, Sound_Buffer& sfx, float offset);
+        void startPendingSounds();
+        bool isPendingSound(const Sound* sound) const;
+        void finishSound(Sound* sound);
+
         void cull3DSound(SoundBase* sound);
 
         void updateSounds(float duration);
@@ -151,12 +171,13 @@ namespace MWSound
     protected:
         DecoderPtr getDecoder();
         friend class OpenAL_Output;
+        friend class SoundBufferPool;
 
         void stopSound(Sound_Buffer* sfx, const MWWorld::ConstPtr& ptr);
         ///< Stop the given object from playing given sound buffer.
 
     public:
-        SoundManager(const VFS::Manager* vfs, bool useSound);
+        SoundManager(const VFS::Manager* vfs, bool useSound, SceneUtil::WorkQueue* workQueue);
         ~SoundManager() override;
 
         void processChangedSettings(const Settings::CategorySettingVector& settings) override;
@@ -256,6 +277,9 @@ namespace MWSound
         void resumeSounds(MWSound::BlockerType blocker) override;
         ///< Resumes all previously paused sounds.
 
+        void preloadSounds(const std::vector<std::string>& soundIds) override;
+        ///< Decode the given sounds in background, so they are ready when first played.
+
         void pausePlayback() override;
         void resumePlayback() override;
 
@@ -2,9 +2,15 @@
 
 #include <atomic>
 #include <limits>
+#include <unordered_set>
 
 #include <components/debug/debuglog.hpp>
 #include <components/esm3/loadcell.hpp>
+#include <components/esm3/loadcrea.hpp>
+#include <components/esm3/loadligh.hpp>
+#include <components/esm3/loadnpc.hpp>
+#include <components/esm3/loadregn.hpp>
+#include <components/esm3/loadsndg.hpp>
 #include <components/loadinglistener/reporter.hpp>
 #include <components/misc/resourcehelpers.hpp>
 #include <components/misc/strings/lower.hpp>
@@ -16,10 +22,15 @@
 #include <components/terrain/world.hpp>
 #include <components/vfs/manager.hpp>
 
+#include "../mwbase/environment.hpp"
+#include "../mwbase/soundmanager.hpp"
+#include "../mwbase/world.hpp"
+
 #include "../mwrender/landmanager.hpp"
 
 #include "cellstore.hpp"
 #include "class.hpp"
+#include "esmstore.hpp"
 
 namespace
 {
@@ -67,6 +78,84 @@ namespace MWWorld
         std::vector<std::string>& mOut;
     };
 
+    struct ListSoundsVisitor
+    {
+        bool operator()(const MWWorld::ConstPtr& ptr)
+        {
+            switch (ptr.getType())
+            {
+                case ESM::Creature::sRecordId:
+                {
+                    const ESM::Creature* creature = ptr.get<ESM::Creature>()->mBase;
+                    mCreatures.insert(Misc::StringUtils::lowerCase(
+                        creature->mOriginal.empty() ? ptr.getCellRef().getRefId() : creature->mOriginal));
+                    break;
+                }
+                case ESM::NPC::sRecordId:
+                    mHasNpcs = true;
+                    break;
+                case ESM::Light::sRecordId:
+                {
+                    const std::string_view sound = ptr.getClass().getSound(ptr);
+                    if (!sound.empty())
+                        mSounds.emplace_back(sound);
+                    break;
+                }
+            }
+            return true;
+        }
+
+        std::vector<std::string> mSounds;
+        std::unordered_set<std::string> mCreatures;
+        bool mHasNpcs = false;
+    };
+
+    CellPreloader::CreatureSoundGens makeCreatureSoundGens(const Store<ESM::SoundGenerator>& store)
+    {
+        CellPreloader::CreatureSoundGens result;
+        for (const ESM::SoundGenerator& soundGen : store)
+        {
+            if (!soundGen.mCreature.empty())
+                result[Misc::StringUtils::lowerCase(soundGen.mCreature)].push_back(soundGen.mSound);
+        }
+        return result;
+    }
+
+    /// List sounds likely to be played soon after entering the cell: looped object sounds, actor soundgens and region
+    /// sounds.
+    std::vector<std::string> listSoundsToPreload(
+        const CellStore& cell, const ESMStore& store, const CellPreloader::CreatureSoundGens& creatureSoundGens)
+    {
+        ListSoundsVisitor visitor;
+        cell.forEachConst(visitor);
+
+        for (const std::string& creature : visitor.mCreatures)
+        {
+            const auto it = creatureSoundGens.find(creature);
+            if (it != creatureSoundGens.end())
+                visitor.mSounds.insert(visitor.mSounds.end(), it->second.begin(), it->second.end());
+        }
+
+        if (visitor.mHasNpcs)
+        {
+            constexpr std::string_view footsteps[] = { "FootBareLeft", "FootBareRight", "FootLightLeft",
+                "FootLightRight", "FootMedLeft", "FootMedRight", "FootHeavyLeft", "FootHeavyRight" };
+            visitor.mSounds.insert(visitor.mSounds.end(), std::begin(footsteps), std::end(footsteps));
+        }
+
+        const ESM::Cell& esmCell = *cell.getCell();
+        if (esmCell.isExterior() && !esmCell.mRegion.empty())
+        {
+            if (const ESM::Region* region = store.get<ESM::Region>().search(esmCell.mRegion))
+            {
+                for (const ESM::Region::SoundRef& soundRef : region->mSoundList)
+                    visitor.mSounds.push_back(soundRef.mSound);
+            }
+        }
+
+        return std::move(visitor.mSounds);
+    }
+
     /// Worker thread item: preload models in a cell.
     class PreloadItem : public SceneUtil::WorkItem
     {
@@ -232,6 +321,7 @@ namespace MWWorld
         , mPreloadInstances(true)
         , mLastResourceCacheUpdate(0.0)
         , mLoadedTerrainTimestamp(0.0)
+        , mCreatureSoundGensInit(false)
     {
     }
 
@@ -309,6 +399,15 @@ namespace MWWorld
         mWorkQueue->addWorkItem(item);
 
         mPreloadCells[cell] = PreloadEntry(timestamp, item);
+
+        const ESMStore& store = MWBase::Environment::get().getWorld()->getStore();
+        if (!mCreatureSoundGensInit)
+        {
+            mCreatureSoundGens = makeCreatureSoundGens(store.get<ESM::SoundGenerator>());
+            mCreatureSoundGensInit = true;
+        }
+        MWBase::Environment::get().getSoundManager()->preloadSounds(
+            listSoundsToPreload(*cell, store, mCreatureSoundGens));
     }
 
     void CellPreloader::notifyLoaded(CellStore* cell)
@@ -6,6 +6,9 @@
 #include <osg/Vec3f>
 #include <osg/Vec4i>
 #include <osg/ref_ptr>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace Resource
 {
@@ -76,6 +79,9 @@ namespace MWWorld
         void abortTerrainPreloadExcept(const PositionCellGrid* exceptPos);
         bool isTerrainLoaded(const CellPreloader::PositionCellGrid& position, double referenceTime) const;
 
+        /// Sound generator sounds by lower case creature id.
+        typedef std::unordered_map<std::string, std::vector<std::string>> CreatureSoundGens;
+
     private:
         Resource::ResourceSystem* mResourceSystem;
         Resource::BulletShapeManager* mBulletShapeManager;
@@ -116,6 +122,10 @@ namespace MWWorld
 
         std::vector<PositionCellGrid> mLoadedTerrainPositions;
         double mLoadedTerrainTimestamp;
+
+        // Built on first use, content records don't change afterwards
+        CreatureSoundGens mCreatureSoundGens;
+        bool mCreatureSoundGensInit;
     };
 
 }
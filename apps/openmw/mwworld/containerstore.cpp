@@ -101,7 +101,17 @@ MWWorld::ContainerStoreIterator MWWorld::ContainerStore::getState(
     ref.load(state);
     collection.mList.push_back(ref);
 
-    return ContainerStoreIterator(this, --collection.mList.end());
+    ContainerStoreIterator it(this, --collection.mList.end());
+    if (mStackIndex.isUpToDate())
+        mStackIndex.add(it->getCellRef().getRefId(), it);
+    return it;
+}
+
+template <typename T>
+void MWWorld::ContainerStore::addToStackIndex(CellRefList<T>& collection)
+{
+    for (auto it = collection.mList.begin(); it != collection.mList.end(); ++it)
+        mStackIndex.add(it->mRef.getRefId(), ContainerStoreIterator(this, it));
 }
 
 void MWWorld::ContainerStore::storeEquipmentState(
@@ -221,9 +231,10 @@ MWWorld::ContainerStoreIterator MWWorld::ContainerStore::restack(const MWWorld::
 {
     resolve();
     MWWorld::ContainerStoreIterator retval = end();
-    for (MWWorld::ContainerStoreIterator iter(begin()); iter != end(); ++iter)
+    const std::vector<ContainerStoreIterator>& candidates = getStacks(item.getCellRef().getRefId());
+    for (const MWWorld::ContainerStoreIterator& iter : candidates)
     {
-        if (item == *iter)
+        if (iter->getRefData().getCount() && item == *iter)
         {
             retval = iter;
             break;
@@ -233,9 +244,9 @@ MWWorld::ContainerStoreIterator MWWorld::ContainerStore::restack(const MWWorld::
     if (retval == end())
         throw std::runtime_error("item is not from this container");
 
-    for (MWWorld::ContainerStoreIterator iter(begin()); iter != end(); ++iter)
+    for (const MWWorld::ContainerStoreIterator& iter : candidates)
     {
-        if (stacks(*iter, item))
+        if (iter->getRefData().getCount() && stacks(*iter, item))
         {
             iter->getRefData().setCount(
                 addItems(iter->getRefData().getCount(false), item.getRefData().getCount(false)));
@@ -359,7 +370,6 @@ MWWorld::ContainerStoreIterator MWWorld::ContainerStore::addImp(const Ptr& ptr,
 {
     if (markModified)
         resolve();
-    int type = getType(ptr);
 
     const MWWorld::ESMStore& esmStore = MWBase::Environment::get().getWorld()->getStore();
 
@@ -370,9 +380,9 @@ MWWorld::ContainerStoreIterator MWWorld::ContainerStore::addImp(const Ptr& ptr,
     {
         int realCount = count * ptr.getClass().getValue(ptr);
 
-        for (MWWorld::ContainerStoreIterator iter(begin(type)); iter != end(); ++iter)
+        for (const MWWorld::ContainerStoreIterator& iter : getStacks(MWWorld::ContainerStore::sGoldId))
         {
-            if (Misc::StringUtils::ciEqual(iter->getCellRef().getRefId(), MWWorld::ContainerStore::sGoldId))
+            if (iter->getRefData().getCount())
             {
                 iter->getRefData().setCount(addItems(iter->getRefData().getCount(false), realCount));
                 flagAsModified();
@@ -385,9 +395,9 @@ MWWorld::ContainerStoreIterator MWWorld::ContainerStore::addImp(const Ptr& ptr,
     }
 
     // determine whether to stack or not
-    for (MWWorld::ContainerStoreIterator iter(begin(type)); iter != end(); ++iter)
+    for (const MWWorld::ContainerStoreIterator& iter : getStacks(ptr.getCellRef().getRefId()))
     {
-        if (stacks(*iter, ptr))
+        if (iter->getRefData().getCount() && stacks(*iter, ptr))
         {
             // stack
             iter->getRefData().setCount(addItems(iter->getRefData().getCount(false), count));
@@ -458,10 +468,36 @@ MWWorld::ContainerStoreIterator MWWorld::ContainerStore::addNewStack(const Const
 
     it->getRefData().setCount(count);
 
+    if (mStackIndex.isUpToDate())
+        mStackIndex.add(it->getCellRef().getRefId(), it);
+
     flagAsModified();
     return it;
 }
 
+const std::vector<MWWorld::ContainerStoreIterator>& MWWorld::ContainerStore::getStacks(std::string_view id)
+{
+    if (!mStackIndex.isUpToDate())
+    {
+        mStackIndex.clear();
+        addToStackIndex(potions);
+        addToStackIndex(appas);
+        addToStackIndex(armors);
+        addToStackIndex(books);
+        addToStackIndex(clothes);
+        addToStackIndex(ingreds);
+        addToStackIndex(lights);
+        addToStackIndex(lockpicks);
+        addToStackIndex(miscItems);
+        addToStackIndex(probes);
+        addToStackIndex(repairs);
+        addToStackIndex(weapons);
+        mStackIndex.setUpToDate();
+    }
+
+    return mStackIndex.get(id);
+}
+
 void MWWorld::ContainerStore::rechargeItems(float duration)
 {
     if (!mRechargingItemsUpToDate)
@@ -23,6 +23,7 @@
 
 #include "cellreflist.hpp"
 #include "ptr.hpp"
+#include "stackindex.hpp"
 
 namespace ESM
 {
@@ -130,6 +131,7 @@ namespace MWWorld
         unsigned int mSeed;
         MWWorld::Ptr mPtr;
         std::weak_ptr<ResolutionListener> mResolutionListener;
+        StackIndex<ContainerStoreIterator> mStackIndex;
 
         ContainerStoreIterator addImp(const Ptr& ptr, int count, bool markModified = true);
         void addInitialItem(
@@ -140,6 +142,9 @@ namespace MWWorld
         template <typename T>
         ContainerStoreIterator getState(CellRefList<T>& collection, const ESM::ObjectState& state);
 
+        template <typename T>
+        void addToStackIndex(CellRefList<T>& collection);
+
         template <typename T>
         void storeState(const LiveCellRef<T>& ref, ESM::ObjectState& state) const;
 
@@ -223,6 +228,11 @@ namespace MWWorld
         ContainerStoreIterator addNewStack(const ConstPtr& ptr, int count);
         ///< Add the item to this container (do not try to stack it onto existing items)
 
+        const std::vector<ContainerStoreIterator>& getStacks(std::string_view id);
+        ///< @return all stacks with refID \a id in the order they were added, including the ones with zero count.
+        ///
+        /// \note The result is invalidated by adding a new stack.
+
         virtual void flagAsModified();
 
         /// + and - operations that can deal with negative stacks
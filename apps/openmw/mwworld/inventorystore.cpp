@@ -703,9 +703,9 @@ MWWorld::ContainerStoreIterator MWWorld::InventoryStore::unequipItemQuantity(
 
     // Move items to an existing stack if possible, otherwise split count items out into a new stack.
     // Moving counts manually here, since ContainerStore's restack can't target unequipped stacks.
-    for (MWWorld::ContainerStoreIterator iter(begin()); iter != end(); ++iter)
+    for (const MWWorld::ContainerStoreIterator& iter : getStacks(item.getCellRef().getRefId()))
     {
-        if (stacks(*iter, item) && !isEquipped(*iter))
+        if (iter->getRefData().getCount() && stacks(*iter, item) && !isEquipped(*iter))
         {
             iter->getRefData().setCount(addItems(iter->getRefData().getCount(false), count));
             item.getRefData().setCount(subtractItems(item.getRefData().getCount(false), count));
@@ -0,0 +1,67 @@
+#ifndef OPENMW_MWWORLD_STACKINDEX_H
+#define OPENMW_MWWORLD_STACKINDEX_H
+
+#include <components/misc/strings/algorithm.hpp>
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace MWWorld
+{
+    /// Item stacks of a container grouped by ref id (case insensitive) in the order they were added. Only items with
+    /// the same ref id can stack, so a lookup replaces a scan over the whole container.
+    ///
+    /// \note Values usually refer to the container owning the index, so a copy is empty and out of date and has to be
+    /// rebuilt by the new owner.
+    template <class Value>
+    class StackIndex
+    {
+    public:
+        StackIndex() = default;
+
+        StackIndex(const StackIndex& /*other*/) {}
+
+        StackIndex& operator=(const StackIndex& /*other*/)
+        {
+            clear();
+            return *this;
+        }
+
+        bool isUpToDate() const { return mUpToDate; }
+
+        void setUpToDate() { mUpToDate = true; }
+
+        void clear()
+        {
+            mStacks.clear();
+            mUpToDate = false;
+        }
+
+        void add(std::string_view id, const Value& value)
+        {
+            auto it = mStacks.find(id);
+            if (it == mStacks.end())
+                it = mStacks.emplace(std::string(id), std::vector<Value>()).first;
+            it->second.push_back(value);
+        }
+
+        /// \note The result is invalidated by adding a stack with the same id.
+        const std::vector<Value>& get(std::string_view id) const
+        {
+            static const std::vector<Value> empty;
+            const auto it = mStacks.find(id);
+            if (it == mStacks.end())
+                return empty;
+            return it->second;
+        }
+
+    private:
+        std::unordered_map<std::string, std::vector<Value>, Misc::StringUtils::CiHash, Misc::StringUtils::CiEqual>
+            mStacks;
+        bool mUpToDate = false;
+    };
+}
+
+#endif
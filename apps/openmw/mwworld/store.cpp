@@ -1038,6 +1038,10 @@ namespace MWWorld
         std::sort(mShared.begin(), mShared.end(),
             [](const ESM::Dialogue* l, const ESM::Dialogue* r) -> bool { return l->mId < r->mId; });
 
+        mInfoIndices.clear();
+        for (const ESM::Dialogue* dial : mShared)
+            mInfoIndices.emplace(dial, MWDialogue::InfoIndex(*dial));
+
         mKeywordSearchModFlag = true;
     }
 
@@ -1093,6 +1097,7 @@ namespace MWWorld
         }
         else
         {
+            mInfoIndices.erase(&found->second);
             found->second.loadData(esm, isDeleted);
             dialogue.mId = found->second.mId;
         }
@@ -1104,6 +1109,9 @@ namespace MWWorld
 
     bool Store<ESM::Dialogue>::eraseStatic(std::string_view id)
     {
+        if (const ESM::Dialogue* dialogue = search(id))
+            mInfoIndices.erase(dialogue);
+
         if (eraseFromMap(mStatic, id))
             mKeywordSearchModFlag = true;
 
@@ -1137,6 +1145,14 @@ namespace MWWorld
 
         return mKeywordSearch;
     }
+
+    const MWDialogue::InfoIndex* Store<ESM::Dialogue>::getInfoIndex(const ESM::Dialogue& dialogue) const
+    {
+        const auto it = mInfoIndices.find(&dialogue);
+        if (it == mInfoIndices.end())
+            return nullptr;
+        return &it->second;
+    }
 }
 
 template class MWWorld::Store<ESM::Activator>;
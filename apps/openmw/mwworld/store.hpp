@@ -15,6 +15,7 @@
 #include <components/misc/rng.hpp>
 #include <components/misc/strings/algorithm.hpp>
 
+#include "../mwdialogue/infoindex.hpp"
 #include "../mwdialogue/keywordsearch.hpp"
 
 namespace ESM
@@ -479,6 +480,9 @@ namespace MWWorld
         mutable bool mKeywordSearchModFlag;
         mutable MWDialogue::KeywordSearch<std::string, int /*unused*/> mKeywordSearch;
 
+        /// Built by setUp, entries of modified dialogues are dropped until the next setUp
+        std::unordered_map<const ESM::Dialogue*, MWDialogue::InfoIndex> mInfoIndices;
+
     public:
         Store();
 
@@ -501,6 +505,9 @@ namespace MWWorld
         void listIdentifier(std::vector<std::string>& list) const override;
 
         const MWDialogue::KeywordSearch<std::string, int>& getDialogIdKeywordSearch() const;
+
+        /// @return nullptr if the dialogue was modified since the last setUp
+        const MWDialogue::InfoIndex* getInfoIndex(const ESM::Dialogue& dialogue) const;
     };
 
 } // end namespace
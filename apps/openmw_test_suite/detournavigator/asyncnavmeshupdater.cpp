@@ -4,6 +4,7 @@
 #include <components/detournavigator/dbrefgeometryobject.hpp>
 #include <components/detournavigator/makenavmesh.hpp>
 #include <components/detournavigator/navmeshdbutils.hpp>
+#include <components/detournavigator/preparednavmeshdata.hpp>
 #include <components/detournavigator/serialization.hpp>
 #include <components/loadinglistener/loadinglistener.hpp>
 
@@ -13,8 +14,10 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
 #include <limits>
 #include <map>
+#include <numeric>
 
 namespace
 {
@@ -81,6 +84,35 @@ namespace
         EXPECT_NE(navMeshCacheItem->lockConst()->getImpl().getTileRefAt(0, 0, 0), 0u);
     }
 
+    TEST_F(DetourNavigatorAsyncNavMeshUpdaterTest, post_should_count_latency_of_added_tile)
+    {
+        mRecastMeshManager.setWorldspace(mWorldspace, nullptr);
+        addHeightFieldPlane(mRecastMeshManager);
+        AsyncNavMeshUpdater updater(mSettings, mRecastMeshManager, mOffMeshConnectionsManager, nullptr);
+        const auto navMeshCacheItem = std::make_shared<GuardedNavMeshCacheItem>(makeEmptyNavMesh(mSettings), 1);
+        const std::map<TilePosition, ChangeType> changedTiles{ { TilePosition{ 0, 0 }, ChangeType::add } };
+        updater.post(mAgentBounds, navMeshCacheItem, mPlayerTile, mWorldspace, changedTiles);
+        updater.wait(WaitConditionType::allJobsDone, &mListener);
+        const auto stats = updater.getStats();
+        EXPECT_EQ(std::accumulate(stats.mJobLatencies.begin(), stats.mJobLatencies.end(), std::size_t{ 0 }), 1);
+        EXPECT_EQ(stats.mCancelled, 0);
+    }
+
+    TEST_F(DetourNavigatorAsyncNavMeshUpdaterTest, prepare_navmesh_tile_data_should_return_null_when_cancelled)
+    {
+        mRecastMeshManager.setWorldspace(mWorldspace, nullptr);
+        addHeightFieldPlane(mRecastMeshManager);
+        const TilePosition tilePosition(0, 0);
+        const auto recastMesh = mRecastMeshManager.getMesh(mWorldspace, tilePosition);
+        ASSERT_NE(recastMesh, nullptr);
+        std::atomic_bool cancelled{ false };
+        EXPECT_NE(prepareNavMeshTileData(*recastMesh, tilePosition, mAgentBounds, mSettings.mRecast, &cancelled),
+            nullptr);
+        cancelled = true;
+        EXPECT_EQ(prepareNavMeshTileData(*recastMesh, tilePosition, mAgentBounds, mSettings.mRecast, &cancelled),
+            nullptr);
+    }
+
     TEST_F(DetourNavigatorAsyncNavMeshUpdaterTest, repeated_post_should_lead_to_cache_hit)
     {
         mRecastMeshManager.setWorldspace(mWorldspace, nullptr);
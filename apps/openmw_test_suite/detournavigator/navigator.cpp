@@ -20,9 +20,12 @@
 #include <gtest/gtest.h>
 
 #include <array>
+#include <chrono>
 #include <deque>
 #include <limits>
 #include <memory>
+#include <optional>
+#include <thread>
 
 MATCHER_P3(Vec3fEq, x, y, z, "")
 {
@@ -198,6 +201,53 @@ namespace
             << mPath;
     }
 
+    TEST_F(DetourNavigatorNavigatorTest, path_query_should_return_same_path_as_find_path)
+    {
+        constexpr std::array<float, 5 * 5> heightfieldData{ {
+            0, 0, 0, 0, 0, // row 0
+            0, -25, -25, -25, -25, // row 1
+            0, -25, -100, -100, -100, // row 2
+            0, -25, -100, -100, -100, // row 3
+            0, -25, -100, -100, -100, // row 4
+        } };
+        const HeightfieldSurface surface = makeSquareHeightfieldSurface(heightfieldData);
+        const int cellSize = mHeightfieldTileSize * (surface.mSize - 1);
+
+        mNavigator->addAgent(mAgentBounds);
+        auto updateGuard = mNavigator->makeUpdateGuard();
+        mNavigator->addHeightfield(mCellPosition, cellSize, surface, updateGuard.get());
+        mNavigator->update(mPlayerPosition, updateGuard.get());
+        updateGuard.reset();
+        mNavigator->wait(WaitConditionType::requiredTilesPresent, &mListener);
+
+        const PathQuery query{ mAgentBounds, mStepSize, mStart, mEnd, Flag_walk, mAreaCosts, mEndTolerance };
+        const PathQueryId id = mNavigator->postPathQuery(query);
+        EXPECT_TRUE(mNavigator->isPathQueryPending(id));
+        mNavigator->update(mPlayerPosition, nullptr);
+        while (mNavigator->isPathQueryPending(id))
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+        const std::optional<PathQueryResult> result = mNavigator->takePathQueryResult(id);
+        ASSERT_TRUE(result.has_value());
+        EXPECT_EQ(result->mStatus, Status::Success);
+        EXPECT_FALSE(mNavigator->takePathQueryResult(id).has_value());
+
+        EXPECT_EQ(
+            findPath(*mNavigator, mAgentBounds, mStepSize, mStart, mEnd, Flag_walk, mAreaCosts, mEndTolerance, mOut),
+            Status::Success);
+        EXPECT_THAT(result->mPath, ElementsAreArray(mPath));
+    }
+
+    TEST_F(DetourNavigatorNavigatorTest, path_query_for_empty_should_return_nav_mesh_not_found)
+    {
+        const PathQuery query{ mAgentBounds, mStepSize, mStart, mEnd, Flag_walk, mAreaCosts, mEndTolerance };
+        const PathQueryId id = mNavigator->postPathQuery(query);
+        EXPECT_FALSE(mNavigator->isPathQueryPending(id));
+        const std::optional<PathQueryResult> result = mNavigator->takePathQueryResult(id);
+        ASSERT_TRUE(result.has_value());
+        EXPECT_EQ(result->mStatus, Status::NavMeshNotFound);
+    }
+
     TEST_F(DetourNavigatorNavigatorTest, add_object_should_change_navmesh)
     {
         mSettings.mWaitUntilMinDistanceToPlayer = 0;
@@ -1204,6 +1254,43 @@ namespace
         EXPECT_EQ(mNavigator->getNavMesh(mAgentBounds)->lockConst()->getVersion(), version);
     }
 
+    TEST_F(DetourNavigatorNavigatorTest, find_path_over_many_tiles_should_follow_route_over_tile_graph)
+    {
+        mSettings.mDetour.mMaxLocalPathTiles = 2;
+        mNavigator.reset(new NavigatorImpl(
+            mSettings, std::make_unique<NavMeshDb>(":memory:", std::numeric_limits<std::uint64_t>::max())));
+
+        const HeightfieldPlane plane{ 100 };
+        const int cellSize = ESM::Land::REAL_SIZE;
+        const osg::Vec3f playerPosition(cellSize / 2, cellSize / 2, 0);
+        const osg::Vec3f start(1000, 1000, 101);
+        const osg::Vec3f end(7000, 7000, 101);
+
+        mNavigator->addAgent(mAgentBounds);
+        mNavigator->addHeightfield(mCellPosition, cellSize, plane, nullptr);
+        mNavigator->update(playerPosition, nullptr);
+        mNavigator->wait(WaitConditionType::allJobsDone, &mListener);
+
+        const RecastSettings& recast = mSettings.mRecast;
+        const auto route = mNavigator->getNavMesh(mAgentBounds)
+                               ->lockConst()
+                               ->getTileGraph()
+                               .findRoute(getTilePosition(recast, toNavMeshCoordinates(recast, start)),
+                                   getTilePosition(recast, toNavMeshCoordinates(recast, end)), Flag_walk, 1024);
+        ASSERT_TRUE(route.has_value());
+        EXPECT_GT(route->size(), mSettings.mDetour.mMaxLocalPathTiles + 1);
+
+        EXPECT_EQ(
+            findPath(*mNavigator, mAgentBounds, mStepSize, start, end, Flag_walk, mAreaCosts, mEndTolerance, mOut),
+            Status::Success);
+
+        ASSERT_FALSE(mPath.empty());
+        EXPECT_THAT(mPath.front(), Vec3fEq(1000, 1000, 101.99999237060546875));
+        EXPECT_THAT(mPath.back(), Vec3fEq(7000, 7000, 101.99999237060546875));
+        for (std::size_t i = 1; i < mPath.size(); ++i)
+            EXPECT_LE((mPath[i] - mPath[i - 1]).length(), mStepSize + 1e-3) << i;
+    }
+
     TEST_F(DetourNavigatorNavigatorTest, add_agent_with_zero_coordinate_should_not_have_nav_mesh)
     {
         constexpr std::array<float, 5 * 5> heightfieldData{ {
@@ -168,6 +168,38 @@ namespace
                     << "x=" << x << " y=" << y;
     }
 
+    TEST_F(DetourNavigatorNavMeshDbTest, set_tile_input_digest_should_replace_existing_value)
+    {
+        const std::string worldspace = "sys::default";
+        ASSERT_EQ(mDb.setTileInputDigest(worldspace, TilePosition{ 1, 2 }, 13), 1);
+        ASSERT_EQ(mDb.setTileInputDigest(worldspace, TilePosition{ 1, 2 }, -42), 1);
+        ASSERT_EQ(mDb.setTileInputDigest("other", TilePosition{ 1, 2 }, 7), 1);
+        const std::vector<TileInputDigest> digests = mDb.getTileInputDigests(worldspace);
+        ASSERT_EQ(digests.size(), 1);
+        EXPECT_EQ(digests[0].mTilePosition, TilePosition(1, 2));
+        EXPECT_EQ(digests[0].mValue, -42);
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbTest,
+        delete_tile_input_digests_outside_range_should_leave_digests_inside_given_rectangle)
+    {
+        const std::string worldspace = "sys::default";
+        for (int x = -2; x <= 2; ++x)
+            for (int y = -2; y <= 2; ++y)
+                ASSERT_EQ(mDb.setTileInputDigest(worldspace, TilePosition{ x, y }, x * 10 + y), 1);
+        const TilesPositionsRange range{ TilePosition{ -1, -1 }, TilePosition{ 2, 2 } };
+        ASSERT_EQ(mDb.deleteTileInputDigestsOutsideRange(worldspace, range), 16);
+        const std::vector<TileInputDigest> digests = mDb.getTileInputDigests(worldspace);
+        ASSERT_EQ(digests.size(), 9);
+        for (const TileInputDigest& digest : digests)
+        {
+            const int x = digest.mTilePosition.x();
+            const int y = digest.mTilePosition.y();
+            EXPECT_TRUE(-1 <= x && x <= 1 && -1 <= y && y <= 1) << "x=" << x << " y=" << y;
+            EXPECT_EQ(digest.mValue, x * 10 + y);
+        }
+    }
+
     TEST_F(DetourNavigatorNavMeshDbTest, should_support_file_size_limit)
     {
         mDb = NavMeshDb(":memory:", 4096);
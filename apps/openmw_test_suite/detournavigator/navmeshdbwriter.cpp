@@ -0,0 +1,148 @@
+#include <components/detournavigator/navmeshdb.hpp>
+#include <components/detournavigator/navmeshdbwriter.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <future>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../testing_util.hpp"
+
+namespace
+{
+    using namespace testing;
+    using namespace DetourNavigator;
+
+    struct DetourNavigatorNavMeshDbWriterTest : Test
+    {
+        const std::string mWorldspace = "sys::default";
+        const std::vector<std::byte> mInput{ std::byte{ 1 }, std::byte{ 2 }, std::byte{ 3 } };
+        const std::vector<std::byte> mData{ std::byte{ 4 }, std::byte{ 5 }, std::byte{ 6 } };
+
+        NavMeshDbWriter::Operation makeInsertTile(std::int64_t tileId, const TilePosition& tilePosition) const
+        {
+            return [=, this](NavMeshDb& db) {
+                db.insertTile(TileId{ tileId }, mWorldspace, tilePosition, TileVersion{ 1 }, mInput, mData);
+            };
+        }
+    };
+
+    TEST_F(DetourNavigatorNavMeshDbWriterTest, flush_should_commit_enqueued_operations)
+    {
+        NavMeshDbWriter writer(NavMeshDb(":memory:", std::numeric_limits<std::uint64_t>::max()), 1000,
+            std::chrono::hours(1), nullptr);
+        for (int i = 0; i < 10; ++i)
+            writer.enqueue(makeInsertTile(i + 1, TilePosition{ i, 0 }));
+        writer.flush();
+        writer.stop();
+        EXPECT_EQ(writer.getDb().getMaxTileId(), TileId{ 10 });
+        EXPECT_TRUE(writer.getDb().findTile(mWorldspace, TilePosition{ 9, 0 }, mInput).has_value());
+        EXPECT_EQ(writer.getTransactionsCount(), 1);
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbWriterTest, should_group_operations_into_batches)
+    {
+        NavMeshDbWriter writer(NavMeshDb(":memory:", std::numeric_limits<std::uint64_t>::max()), 10,
+            std::chrono::hours(1), nullptr);
+        for (int i = 0; i < 100; ++i)
+            writer.enqueue(makeInsertTile(i + 1, TilePosition{ i, 0 }));
+        writer.stop();
+        EXPECT_EQ(writer.getDb().getMaxTileId(), TileId{ 100 });
+        EXPECT_GE(writer.getTransactionsCount(), 1);
+        EXPECT_LE(writer.getTransactionsCount(), 10);
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbWriterTest, should_not_commit_more_than_max_batch_size_operations_at_once)
+    {
+        NavMeshDbWriter writer(NavMeshDb(":memory:", std::numeric_limits<std::uint64_t>::max()), 2,
+            std::chrono::hours(1), nullptr);
+        std::promise<void> started;
+        std::promise<void> resume;
+        const std::shared_future<void> resumed = resume.get_future().share();
+        const NavMeshDbWriter::Operation insertFirst = makeInsertTile(1, TilePosition{ 0, 0 });
+        writer.enqueue([&, resumed](NavMeshDb& db) {
+            started.set_value();
+            resumed.wait();
+            insertFirst(db);
+        });
+        writer.enqueue(makeInsertTile(2, TilePosition{ 1, 0 }));
+        started.get_future().wait();
+        // Fill the queue up to 2 batches while the first one is written
+        for (int i = 2; i < 6; ++i)
+            writer.enqueue(makeInsertTile(i + 1, TilePosition{ i, 0 }));
+        resume.set_value();
+        writer.flush();
+        writer.stop();
+        EXPECT_EQ(writer.getDb().getMaxTileId(), TileId{ 6 });
+        EXPECT_EQ(writer.getTransactionsCount(), 3);
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbWriterTest, should_commit_incomplete_batch_after_delay)
+    {
+        NavMeshDbWriter writer(NavMeshDb(":memory:", std::numeric_limits<std::uint64_t>::max()), 1000,
+            std::chrono::milliseconds(1), nullptr);
+        writer.enqueue(makeInsertTile(1, TilePosition{ 0, 0 }));
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (writer.getTransactionsCount() == 0 && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        EXPECT_EQ(writer.getTransactionsCount(), 1);
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbWriterTest, should_rollback_failed_batch_and_discard_further_operations)
+    {
+        std::vector<std::string> errors;
+        NavMeshDbWriter writer(NavMeshDb(":memory:", std::numeric_limits<std::uint64_t>::max()), 1000,
+            std::chrono::hours(1), [&](const std::exception& e) { errors.emplace_back(e.what()); });
+        writer.enqueue(makeInsertTile(1, TilePosition{ 0, 0 }));
+        writer.flush();
+        writer.enqueue(makeInsertTile(2, TilePosition{ 1, 0 }));
+        writer.enqueue(makeInsertTile(1, TilePosition{ 2, 0 }));
+        writer.flush();
+        writer.enqueue(makeInsertTile(3, TilePosition{ 3, 0 }));
+        writer.stop();
+        EXPECT_EQ(errors.size(), 1);
+        EXPECT_EQ(writer.getDb().getMaxTileId(), TileId{ 1 });
+        EXPECT_EQ(writer.getTransactionsCount(), 1);
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbWriterTest, discard_should_drop_queued_and_further_operations)
+    {
+        NavMeshDbWriter writer(NavMeshDb(":memory:", std::numeric_limits<std::uint64_t>::max()), 1000,
+            std::chrono::hours(1), nullptr);
+        writer.enqueue(makeInsertTile(1, TilePosition{ 0, 0 }));
+        writer.flush();
+        writer.enqueue(makeInsertTile(2, TilePosition{ 1, 0 }));
+        writer.discard();
+        writer.enqueue(makeInsertTile(3, TilePosition{ 2, 0 }));
+        writer.flush();
+        writer.stop();
+        EXPECT_EQ(writer.getDb().getMaxTileId(), TileId{ 1 });
+        EXPECT_EQ(writer.getTransactionsCount(), 1);
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbWriterTest, reader_should_find_committed_tiles)
+    {
+        const std::filesystem::path path = TestingOpenMW::temporaryFilePath("navmeshdbwriter_test.db");
+        std::filesystem::remove(path);
+        {
+            NavMeshDb db(path.string(), std::numeric_limits<std::uint64_t>::max());
+            db.enableWriteAheadLog(1000);
+            NavMeshDbWriter writer(std::move(db), 1000, std::chrono::hours(1), nullptr);
+            writer.enqueue(makeInsertTile(1, TilePosition{ 0, 0 }));
+            {
+                NavMeshDbReader reader(path.string());
+                EXPECT_FALSE(reader.findTile(mWorldspace, TilePosition{ 0, 0 }, mInput).has_value());
+                writer.flush();
+                EXPECT_TRUE(reader.findTile(mWorldspace, TilePosition{ 0, 0 }, mInput).has_value());
+            }
+            writer.stop();
+            writer.getDb().disableWriteAheadLog();
+        }
+        std::filesystem::remove(path);
+    }
+}
@@ -0,0 +1,162 @@
+#include <components/detournavigator/recastarenaallocator.hpp>
+#include <components/detournavigator/recastglobalallocator.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <thread>
+
+namespace
+{
+    using namespace testing;
+    using namespace DetourNavigator;
+
+    constexpr std::size_t blockSize = 1024;
+
+    TEST(DetourNavigatorRecastArenaAllocatorTest, alloc_should_return_sequential_pointers_from_one_block)
+    {
+        RecastArenaAllocator allocator(blockSize);
+        void* const first = allocator.alloc(10, blockSize);
+        void* const second = allocator.alloc(10, blockSize);
+        EXPECT_EQ(getDataPtrBufferType(first), BufferType_arena);
+        EXPECT_EQ(getDataPtrBufferType(second), BufferType_arena);
+        EXPECT_EQ(static_cast<char*>(second) - static_cast<char*>(first), sizeof(std::size_t) + 16);
+        EXPECT_EQ(allocator.getReservedSize(), blockSize);
+    }
+
+    TEST(DetourNavigatorRecastArenaAllocatorTest, alloc_should_return_nullptr_when_blocks_exceed_max_size)
+    {
+        RecastArenaAllocator allocator(blockSize);
+        EXPECT_NE(allocator.alloc(blockSize / 2, blockSize), nullptr);
+        EXPECT_EQ(allocator.alloc(blockSize / 2 + 1, blockSize), nullptr);
+        EXPECT_EQ(allocator.alloc(2 * blockSize, 2 * blockSize), nullptr);
+        EXPECT_EQ(allocator.getReservedSize(), blockSize);
+    }
+
+    TEST(DetourNavigatorRecastArenaAllocatorTest, alloc_should_add_block_for_large_allocation)
+    {
+        RecastArenaAllocator allocator(blockSize);
+        EXPECT_NE(allocator.alloc(2 * blockSize, 4 * blockSize), nullptr);
+        EXPECT_EQ(allocator.getReservedSize(), 2 * blockSize + sizeof(std::size_t));
+    }
+
+    TEST(DetourNavigatorRecastArenaAllocatorTest, reset_should_reuse_blocks)
+    {
+        RecastArenaAllocator allocator(blockSize);
+        void* const first = allocator.alloc(blockSize / 2, 2 * blockSize);
+        allocator.alloc(blockSize / 2, 2 * blockSize);
+        EXPECT_EQ(allocator.getReservedSize(), 2 * blockSize);
+        allocator.reset(2 * blockSize);
+        EXPECT_EQ(allocator.getReservedSize(), 2 * blockSize);
+        EXPECT_EQ(allocator.alloc(blockSize / 2, 2 * blockSize), first);
+        EXPECT_EQ(allocator.getHighWaterMark(), 2 * (blockSize / 2 + sizeof(std::size_t)));
+    }
+
+    TEST(DetourNavigatorRecastArenaAllocatorTest, reset_should_release_blocks_over_max_size)
+    {
+        RecastArenaAllocator allocator(blockSize);
+        allocator.alloc(blockSize / 2, 2 * blockSize);
+        allocator.alloc(blockSize / 2, 2 * blockSize);
+        allocator.reset(blockSize);
+        EXPECT_EQ(allocator.getReservedSize(), blockSize);
+        allocator.reset(0);
+        EXPECT_EQ(allocator.getReservedSize(), 0);
+    }
+
+    struct DetourNavigatorRecastGlobalAllocatorTest : Test
+    {
+        ~DetourNavigatorRecastGlobalAllocatorTest() { RecastGlobalAllocator::setArenaMaxSize(64 * 1024 * 1024); }
+    };
+
+    TEST_F(DetourNavigatorRecastGlobalAllocatorTest, perm_alloc_should_use_heap_without_arena_scope)
+    {
+        void* const ptr = RecastGlobalAllocator::alloc(10, RC_ALLOC_PERM);
+        EXPECT_EQ(getDataPtrBufferType(ptr), BufferType_perm);
+        RecastGlobalAllocator::free(ptr);
+    }
+
+    TEST_F(DetourNavigatorRecastGlobalAllocatorTest, perm_alloc_should_use_arena_in_arena_scope)
+    {
+        const RecastGlobalAllocator::ArenaScope scope;
+        void* const ptr = RecastGlobalAllocator::alloc(10, RC_ALLOC_PERM);
+        EXPECT_EQ(getDataPtrBufferType(ptr), BufferType_arena);
+        RecastGlobalAllocator::free(ptr);
+    }
+
+    TEST_F(DetourNavigatorRecastGlobalAllocatorTest, perm_alloc_should_use_heap_in_disabled_nested_scope)
+    {
+        // Poly mesh and poly mesh detail are allocated this way since they outlive the arena
+        const RecastGlobalAllocator::ArenaScope scope;
+        void* ptr = nullptr;
+        {
+            const RecastGlobalAllocator::ArenaScope heapScope(false);
+            ptr = RecastGlobalAllocator::alloc(10, RC_ALLOC_PERM);
+        }
+        EXPECT_EQ(getDataPtrBufferType(ptr), BufferType_perm);
+        void* const arenaPtr = RecastGlobalAllocator::alloc(10, RC_ALLOC_PERM);
+        EXPECT_EQ(getDataPtrBufferType(arenaPtr), BufferType_arena);
+        RecastGlobalAllocator::free(arenaPtr);
+        RecastGlobalAllocator::free(ptr);
+    }
+
+    TEST_F(DetourNavigatorRecastGlobalAllocatorTest, temp_alloc_should_not_use_arena)
+    {
+        const RecastGlobalAllocator::ArenaScope scope;
+        void* const ptr = RecastGlobalAllocator::alloc(10, RC_ALLOC_TEMP);
+        EXPECT_EQ(getDataPtrBufferType(ptr), BufferType_temp);
+        RecastGlobalAllocator::free(ptr);
+    }
+
+    TEST_F(DetourNavigatorRecastGlobalAllocatorTest, end_of_outermost_scope_should_reset_arena)
+    {
+        void* first = nullptr;
+        {
+            const RecastGlobalAllocator::ArenaScope scope;
+            first = RecastGlobalAllocator::alloc(10, RC_ALLOC_PERM);
+        }
+        const RecastGlobalAllocator::ArenaScope scope;
+        EXPECT_EQ(RecastGlobalAllocator::alloc(10, RC_ALLOC_PERM), first);
+    }
+
+    TEST_F(DetourNavigatorRecastGlobalAllocatorTest, end_of_nested_scope_should_not_reset_arena)
+    {
+        const RecastGlobalAllocator::ArenaScope scope;
+        void* first = nullptr;
+        {
+            const RecastGlobalAllocator::ArenaScope nested;
+            first = RecastGlobalAllocator::alloc(10, RC_ALLOC_PERM);
+        }
+        EXPECT_NE(RecastGlobalAllocator::alloc(10, RC_ALLOC_PERM), first);
+    }
+
+    TEST_F(DetourNavigatorRecastGlobalAllocatorTest, arena_should_be_thread_local_and_reused_by_the_same_thread)
+    {
+        void* mainThreadPtr = nullptr;
+        {
+            const RecastGlobalAllocator::ArenaScope scope;
+            mainThreadPtr = RecastGlobalAllocator::alloc(10, RC_ALLOC_PERM);
+        }
+        void* first = nullptr;
+        void* second = nullptr;
+        std::thread thread([&] {
+            {
+                const RecastGlobalAllocator::ArenaScope scope;
+                first = RecastGlobalAllocator::alloc(10, RC_ALLOC_PERM);
+            }
+            const RecastGlobalAllocator::ArenaScope scope;
+            second = RecastGlobalAllocator::alloc(10, RC_ALLOC_PERM);
+        });
+        thread.join();
+        EXPECT_NE(first, mainThreadPtr);
+        EXPECT_EQ(first, second);
+    }
+
+    TEST_F(DetourNavigatorRecastGlobalAllocatorTest, perm_alloc_over_arena_max_size_should_fall_back_to_heap)
+    {
+        RecastGlobalAllocator::setArenaMaxSize(1024 * 1024);
+        const RecastGlobalAllocator::ArenaScope scope;
+        void* const ptr = RecastGlobalAllocator::alloc(2 * 1024 * 1024, RC_ALLOC_PERM);
+        EXPECT_EQ(getDataPtrBufferType(ptr), BufferType_perm);
+        RecastGlobalAllocator::free(ptr);
+    }
+}
@@ -0,0 +1,387 @@
+#include <components/esm3terrain/storage.hpp>
+#include <components/misc/constants.hpp>
+
+#include <gtest/gtest.h>
+
+#include <osg/Array>
+
+#include <cmath>
+#include <cstddef>
+#include <map>
+#include <random>
+#include <utility>
+
+namespace
+{
+    using namespace testing;
+
+    constexpr int worldSize = 4;
+
+    // Random landscape of worldSize x worldSize cells with a hole at (2, 1)
+    class TestStorage final : public ESMTerrain::Storage
+    {
+    public:
+        explicit TestStorage(bool alteration)
+            : ESMTerrain::Storage(nullptr)
+            , mAlteration(alteration)
+        {
+            std::minstd_rand random;
+            std::uniform_int_distribution<int> heightDistribution(-1000, 1000);
+            std::uniform_int_distribution<int> normalDistribution(-30, 30);
+            std::uniform_int_distribution<int> colourDistribution(0, 255);
+            for (int x = 0; x < worldSize; ++x)
+            {
+                for (int y = 0; y < worldSize; ++y)
+                {
+                    if (x == 2 && y == 1)
+                        continue;
+                    ESM::Land& land = mLands[std::make_pair(x, y)];
+                    land.blank();
+                    ESM::Land::LandData& data = *land.getLandData();
+                    for (int i = 0; i < ESM::Land::LAND_NUM_VERTS; ++i)
+                    {
+                        data.mHeights[i] = static_cast<float>(heightDistribution(random));
+                        data.mNormals[i * 3] = static_cast<ESM::Land::VNML>(normalDistribution(random));
+                        data.mNormals[i * 3 + 1] = static_cast<ESM::Land::VNML>(normalDistribution(random));
+                        data.mNormals[i * 3 + 2] = 100;
+                        for (int j = 0; j < 3; ++j)
+                            data.mColours[i * 3 + j] = static_cast<unsigned char>(colourDistribution(random));
+                    }
+                }
+            }
+        }
+
+        osg::ref_ptr<const ESMTerrain::LandObject> getLand(int cellX, int cellY) override
+        {
+            const auto it = mLands.find(std::make_pair(cellX, cellY));
+            if (it == mLands.end())
+                return nullptr;
+            return new ESMTerrain::LandObject(&it->second,
+                ESM::Land::DATA_VHGT | ESM::Land::DATA_VNML | ESM::Land::DATA_VCLR | ESM::Land::DATA_VTEX);
+        }
+
+        const ESM::LandTexture* getLandTexture(int /*index*/, short /*plugin*/) override { return nullptr; }
+
+        void getBounds(float& minX, float& maxX, float& minY, float& maxY) override
+        {
+            minX = 0;
+            maxX = worldSize;
+            minY = 0;
+            maxY = worldSize;
+        }
+
+        bool isAltered() const { return mAlteration; }
+
+        static float alteredHeight(int col, int row) { return static_cast<float>(col * 3 - row); }
+
+        static void alterColour(int col, int row, osg::Vec4ub& color)
+        {
+            color.r() = static_cast<unsigned char>(color.r() + col);
+            color.g() = static_cast<unsigned char>(color.g() + row);
+        }
+
+    private:
+        std::map<std::pair<int, int>, ESM::Land> mLands;
+        bool mAlteration;
+
+        bool useAlteration() const override { return mAlteration; }
+
+        void adjustColor(int col, int row, const ESM::Land::LandData* /*heightData*/, osg::Vec4ub& color) const override
+        {
+            alterColour(col, row, color);
+        }
+
+        float getAlteredHeight(int col, int row) const override { return alteredHeight(col, row); }
+    };
+
+    // Vertex buffer generation as it was implemented before it was split into row passes, kept to check the output
+    // doesn't change
+    class ReferenceGenerator
+    {
+    public:
+        explicit ReferenceGenerator(TestStorage& storage)
+            : mStorage(storage)
+        {
+        }
+
+        void fillVertexBuffers(int lodLevel, float size, const osg::Vec2f& center, osg::Vec3Array& positions,
+            osg::Vec3Array& normals, osg::Vec4ubArray& colours)
+        {
+            // LOD level n means every 2^n-th vertex is kept
+            size_t increment = static_cast<size_t>(1) << lodLevel;
+
+            osg::Vec2f origin = center - osg::Vec2f(size / 2.f, size / 2.f);
+
+            int startCellX = static_cast<int>(std::floor(origin.x()));
+            int startCellY = static_cast<int>(std::floor(origin.y()));
+
+            size_t numVerts = static_cast<size_t>(size * (ESM::Land::LAND_SIZE - 1) / increment + 1);
+
+            positions.resize(numVerts * numVerts);
+            normals.resize(numVerts * numVerts);
+            colours.resize(numVerts * numVerts);
+
+            osg::Vec3f normal;
+            osg::Vec4ub color;
+
+            float vertY = 0;
+            float vertX = 0;
+
+            const bool alteration = mStorage.isAltered();
+
+            float vertY_ = 0; // of current cell corner
+            for (int cellY = startCellY; cellY < startCellY + std::ceil(size); ++cellY)
+            {
+                float vertX_ = 0; // of current cell corner
+                for (int cellX = startCellX; cellX < startCellX + std::ceil(size); ++cellX)
+                {
+                    const ESMTerrain::LandObject* land = getLand(cellX, cellY);
+                    const ESM::Land::LandData* heightData = nullptr;
+                    const ESM::Land::LandData* normalData = nullptr;
+                    const ESM::Land::LandData* colourData = nullptr;
+                    if (land)
+                    {
+                        heightData = land->getData(ESM::Land::DATA_VHGT);
+                        normalData = land->getData(ESM::Land::DATA_VNML);
+                        colourData = land->getData(ESM::Land::DATA_VCLR);
+                    }
+
+                    int rowStart = 0;
+                    int colStart = 0;
+                    if (vertY_ != 0)
+                        colStart += increment;
+                    if (vertX_ != 0)
+                        rowStart += increment;
+
+                    rowStart += (origin.x() - startCellX) * ESM::Land::LAND_SIZE;
+                    colStart += (origin.y() - startCellY) * ESM::Land::LAND_SIZE;
+                    int rowEnd
+                        = std::min(static_cast<int>(rowStart + std::min(1.f, size) * (ESM::Land::LAND_SIZE - 1) + 1),
+                            static_cast<int>(ESM::Land::LAND_SIZE));
+                    int colEnd
+                        = std::min(static_cast<int>(colStart + std::min(1.f, size) * (ESM::Land::LAND_SIZE - 1) + 1),
+                            static_cast<int>(ESM::Land::LAND_SIZE));
+
+                    vertY = vertY_;
+                    for (int col = colStart; col < colEnd; col += increment)
+                    {
+                        vertX = vertX_;
+                        for (int row = rowStart; row < rowEnd; row += increment)
+                        {
+                            int srcArrayIndex = col * ESM::Land::LAND_SIZE * 3 + row * 3;
+
+                            float height = ESM::Land::DEFAULT_HEIGHT;
+                            if (heightData)
+                                height = heightData->mHeights[col * ESM::Land::LAND_SIZE + row];
+                            if (alteration)
+                                height += TestStorage::alteredHeight(col, row);
+                            positions[static_cast<unsigned int>(vertX * numVerts + vertY)]
+                                = osg::Vec3f((vertX / float(numVerts - 1) - 0.5f) * size * Constants::CellSizeInUnits,
+                                    (vertY / float(numVerts - 1) - 0.5f) * size * Constants::CellSizeInUnits, height);
+
+                            if (normalData)
+                            {
+                                for (int i = 0; i < 3; ++i)
+                                    normal[i] = normalData->mNormals[srcArrayIndex + i];
+
+                                normal.normalize();
+                            }
+                            else
+                                normal = osg::Vec3f(0, 0, 1);
+
+                            if (col == ESM::Land::LAND_SIZE - 1 || row == ESM::Land::LAND_SIZE - 1)
+                                fixNormal(normal, cellX, cellY, col, row);
+
+                            if ((row == 0 || row == ESM::Land::LAND_SIZE - 1)
+                                && (col == 0 || col == ESM::Land::LAND_SIZE - 1))
+                                averageNormal(normal, cellX, cellY, col, row);
+
+                            normals[static_cast<unsigned int>(vertX * numVerts + vertY)] = normal;
+
+                            if (colourData)
+                            {
+                                for (int i = 0; i < 3; ++i)
+                                    color[i] = colourData->mColours[srcArrayIndex + i];
+                            }
+                            else
+                            {
+                                color.r() = 255;
+                                color.g() = 255;
+                                color.b() = 255;
+                            }
+                            if (alteration)
+                                TestStorage::alterColour(col, row, color);
+
+                            if (col == ESM::Land::LAND_SIZE - 1 || row == ESM::Land::LAND_SIZE - 1)
+                                fixColour(color, cellX, cellY, col, row);
+
+                            color.a() = 255;
+
+                            colours[static_cast<unsigned int>(vertX * numVerts + vertY)] = color;
+
+                            ++vertX;
+                        }
+                        ++vertY;
+                    }
+                    vertX_ = vertX;
+                }
+                vertY_ = vertY;
+            }
+        }
+
+    private:
+        TestStorage& mStorage;
+        std::map<std::pair<int, int>, osg::ref_ptr<const ESMTerrain::LandObject>> mLands;
+
+        const ESMTerrain::LandObject* getLand(int cellX, int cellY)
+        {
+            const auto it = mLands.find(std::make_pair(cellX, cellY));
+            if (it != mLands.end())
+                return it->second.get();
+            return mLands.emplace(std::make_pair(cellX, cellY), mStorage.getLand(cellX, cellY)).first->second.get();
+        }
+
+        void fixNormal(osg::Vec3f& normal, int cellX, int cellY, int col, int row)
+        {
+            while (col >= ESM::Land::LAND_SIZE - 1)
+            {
+                ++cellY;
+                col -= ESM::Land::LAND_SIZE - 1;
+            }
+            while (row >= ESM::Land::LAND_SIZE - 1)
+            {
+                ++cellX;
+                row -= ESM::Land::LAND_SIZE - 1;
+            }
+            while (col < 0)
+            {
+                --cellY;
+                col += ESM::Land::LAND_SIZE - 1;
+            }
+            while (row < 0)
+            {
+                --cellX;
+                row += ESM::Land::LAND_SIZE - 1;
+            }
+
+            const ESMTerrain::LandObject* land = getLand(cellX, cellY);
+            const ESM::Land::LandData* data = land ? land->getData(ESM::Land::DATA_VNML) : nullptr;
+            if (data)
+            {
+                normal.x() = data->mNormals[col * ESM::Land::LAND_SIZE * 3 + row * 3];
+                normal.y() = data->mNormals[col * ESM::Land::LAND_SIZE * 3 + row * 3 + 1];
+                normal.z() = data->mNormals[col * ESM::Land::LAND_SIZE * 3 + row * 3 + 2];
+                normal.normalize();
+            }
+            else
+                normal = osg::Vec3f(0, 0, 1);
+        }
+
+        void averageNormal(osg::Vec3f& normal, int cellX, int cellY, int col, int row)
+        {
+            osg::Vec3f n1, n2, n3, n4;
+            fixNormal(n1, cellX, cellY, col + 1, row);
+            fixNormal(n2, cellX, cellY, col - 1, row);
+            fixNormal(n3, cellX, cellY, col, row + 1);
+            fixNormal(n4, cellX, cellY, col, row - 1);
+            normal = (n1 + n2 + n3 + n4);
+            normal.normalize();
+        }
+
+        void fixColour(osg::Vec4ub& color, int cellX, int cellY, int col, int row)
+        {
+            if (col == ESM::Land::LAND_SIZE - 1)
+            {
+                ++cellY;
+                col = 0;
+            }
+            if (row == ESM::Land::LAND_SIZE - 1)
+            {
+                ++cellX;
+                row = 0;
+            }
+
+            const ESMTerrain::LandObject* land = getLand(cellX, cellY);
+            const ESM::Land::LandData* data = land ? land->getData(ESM::Land::DATA_VCLR) : nullptr;
+            if (data)
+            {
+                color.r() = data->mColours[col * ESM::Land::LAND_SIZE * 3 + row * 3];
+                color.g() = data->mColours[col * ESM::Land::LAND_SIZE * 3 + row * 3 + 1];
+                color.b() = data->mColours[col * ESM::Land::LAND_SIZE * 3 + row * 3 + 2];
+            }
+            else
+            {
+                color.r() = 255;
+                color.g() = 255;
+                color.b() = 255;
+            }
+        }
+    };
+
+    struct Chunk
+    {
+        int mLodLevel;
+        float mSize;
+        osg::Vec2f mCenter;
+    };
+
+    struct ESM3TerrainStorageFillVertexBuffersTest : TestWithParam<Chunk>
+    {
+    };
+
+    template <class Array>
+    void expectEqualArrays(const Array& actual, const Array& expected)
+    {
+        ASSERT_EQ(actual.size(), expected.size());
+        for (std::size_t i = 0; i < actual.size(); ++i)
+            ASSERT_EQ(actual[i], expected[i]) << "at " << i;
+    }
+
+    void testFillVertexBuffers(bool alteration, const Chunk& chunk)
+    {
+        TestStorage storage(alteration);
+        osg::ref_ptr<osg::Vec3Array> positions(new osg::Vec3Array);
+        osg::ref_ptr<osg::Vec3Array> normals(new osg::Vec3Array);
+        osg::ref_ptr<osg::Vec4ubArray> colours(new osg::Vec4ubArray);
+        storage.fillVertexBuffers(chunk.mLodLevel, chunk.mSize, chunk.mCenter, positions, normals, colours);
+
+        osg::Vec3Array expectedPositions;
+        osg::Vec3Array expectedNormals;
+        osg::Vec4ubArray expectedColours;
+        ReferenceGenerator(storage).fillVertexBuffers(chunk.mLodLevel, chunk.mSize, chunk.mCenter,
+            expectedPositions, expectedNormals, expectedColours);
+
+        expectEqualArrays(*positions, expectedPositions);
+        expectEqualArrays(*normals, expectedNormals);
+        expectEqualArrays(*colours, expectedColours);
+    }
+
+    TEST_P(ESM3TerrainStorageFillVertexBuffersTest, shouldMatchReferenceImplementation)
+    {
+        testFillVertexBuffers(false, GetParam());
+    }
+
+    TEST_P(ESM3TerrainStorageFillVertexBuffersTest, shouldMatchReferenceImplementationWithAlteration)
+    {
+        testFillVertexBuffers(true, GetParam());
+    }
+
+    const Chunk chunks[] = {
+        // Inside the landscape
+        Chunk{ 0, 1, osg::Vec2f(1.5f, 2.5f) },
+        Chunk{ 1, 1, osg::Vec2f(1.5f, 1.5f) },
+        Chunk{ 0, 0.25f, osg::Vec2f(1.875f, 2.625f) },
+        Chunk{ 2, 2, osg::Vec2f(2, 2) },
+        // Next to the hole at (2, 1)
+        Chunk{ 0, 1, osg::Vec2f(1.5f, 1.5f) },
+        Chunk{ 3, 2, osg::Vec2f(3, 1) },
+        // At the landscape borders
+        Chunk{ 0, 1, osg::Vec2f(0.5f, 0.5f) },
+        Chunk{ 0, 1, osg::Vec2f(3.5f, 3.5f) },
+        Chunk{ 0, 0.25f, osg::Vec2f(3.875f, 0.125f) },
+        Chunk{ 3, 4, osg::Vec2f(2, 2) },
+        Chunk{ 5, 4, osg::Vec2f(2, 2) },
+    };
+
+    INSTANTIATE_TEST_SUITE_P(Chunks, ESM3TerrainStorageFillVertexBuffersTest, ValuesIn(chunks));
+}
@@ -1,5 +1,6 @@
 #include "gmock/gmock.h"
 #include <gtest/gtest.h>
+#include <sstream>
 
 #include <components/esm/luascripts.hpp>
 
@@ -464,4 +465,63 @@ CUSTOM, PLAYER: useInterface.lua
         EXPECT_EQ(internal::GetCapturedStdout(), "Ignored callback to the removed script some_script.lua\n");
     }
 
+    TEST_F(LuaScriptsContainerTest, HandlerProfiler)
+    {
+        using HandlerType = LuaUtil::HandlerProfiler::HandlerType;
+        LuaUtil::HandlerProfiler& profiler = mLua.getHandlerProfiler();
+        LuaUtil::ScriptsContainer scripts(&mLua, "Test");
+        int test1Id = *mCfg.findId("test1.lua");
+        int test2Id = *mCfg.findId("test2.lua");
+        EXPECT_TRUE(scripts.addCustomScript(test1Id));
+        EXPECT_TRUE(scripts.addCustomScript(test2Id));
+        std::string X = LuaUtil::serialize(mLua.sol().create_table_with("x", 0.5));
+
+        testing::internal::CaptureStdout();
+        scripts.update(1.5f);
+        profiler.nextFrame();
+        EXPECT_TRUE(profiler.getTopHandlers(10).empty());
+
+        profiler.setEnabled(true);
+        scripts.update(1.5f);
+        scripts.receiveEvent("Event1", X);
+        profiler.nextFrame();
+        std::vector<LuaUtil::HandlerProfiler::HandlerStats> top = profiler.getTopHandlers(10);
+        ASSERT_EQ(top.size(), 4);
+        for (const auto& stats : top)
+        {
+            EXPECT_TRUE(stats.mScriptId == test1Id || stats.mScriptId == test2Id);
+            EXPECT_EQ(stats.mCallCount, 1);
+            if (stats.mType == HandlerType::EngineHandler)
+                EXPECT_EQ(stats.mName, "onUpdate");
+            else
+            {
+                EXPECT_EQ(stats.mType, HandlerType::Event);
+                EXPECT_EQ(stats.mName, "Event1");
+            }
+        }
+        EXPECT_EQ(profiler.getTopHandlers(1).size(), 1);
+
+        profiler.setEnabled(false);
+        profiler.startRecording(1);
+        scripts.update(1.5f);
+        EXPECT_FALSE(profiler.isRecordingFinished());
+        profiler.nextFrame();
+        EXPECT_TRUE(profiler.isRecordingFinished());
+        internal::GetCapturedStdout();
+
+        std::stringstream stacks;
+        profiler.writeCollapsedStacks(stacks, mCfg);
+        EXPECT_THAT(stacks.str(), HasSubstr("test1.lua:onUpdate "));
+        EXPECT_THAT(stacks.str(), HasSubstr("test2.lua:onUpdate "));
+        EXPECT_THAT(stacks.str(), Not(HasSubstr("eventHandler")));
+
+        std::stringstream trace;
+        profiler.writeChromeTrace(trace, mCfg);
+        EXPECT_THAT(trace.str(), HasSubstr(R"("name":"onUpdate","cat":"test1.lua","ph":"X")"));
+
+        profiler.clearRecording();
+        EXPECT_FALSE(profiler.isRecordingFinished());
+        EXPECT_FALSE(profiler.isActive());
+    }
+
 }
@@ -193,6 +193,47 @@ namespace
         EXPECT_ERROR(lua.safe_script("ro_t.nested.x = 5"), "userdata value");
     }
 
+    TEST(LuaSerializationTest, RepeatedTableKeysAreWrittenOnce)
+    {
+        sol::state lua;
+        sol::table table(lua, sol::create);
+        for (int i = 1; i <= 10; ++i)
+        {
+            sol::table item(lua, sol::create);
+            item["position"] = i;
+            item["velocity"] = -i;
+            item["id"] = i;
+            table[i] = item;
+        }
+
+        std::string serialized = LuaUtil::serialize(table);
+        // version, table start, 10x (key, table start, 3x key, 3x value, table end), table end.
+        // Only the first "position" and "velocity" are written in full, the other ones are 3 byte references.
+        EXPECT_EQ(serialized.size(), 2 + 10 * (9 + 1 + 3 + 3 + 3 + 3 * 9 + 1) + 2 * (9 - 3) + 1);
+        EXPECT_EQ(serialized[0], 1);
+
+        sol::table res = LuaUtil::deserialize(lua, serialized);
+        for (int i = 1; i <= 10; ++i)
+        {
+            sol::table item = res[i];
+            EXPECT_EQ(item.get<int>("position"), i);
+            EXPECT_EQ(item.get<int>("velocity"), -i);
+            EXPECT_EQ(item.get<int>("id"), i);
+        }
+
+        std::string reserialized;
+        LuaUtil::serialize(reserialized, res);
+        EXPECT_EQ(reserialized.size(), serialized.size());
+        EXPECT_EQ(LuaUtil::serialize(sol::make_object<double>(lua, 1))[0], 0);
+    }
+
+    TEST(LuaSerializationTest, InvalidStringReference)
+    {
+        sol::state lua;
+        std::string data("\x01\x03\x05\x00\x00\x04", 6);
+        EXPECT_ERROR(LuaUtil::deserialize(lua, data), "Invalid string reference");
+    }
+
     struct TestStruct1
     {
         double a, b;
@@ -1,4 +1,5 @@
 #include <filesystem>
+#include <fstream>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -112,4 +113,69 @@ namespace
         EXPECT_TRUE(get<bool>(mLua, "temporary:get('y') == nil"));
     }
 
+    TEST(LuaUtilStorageTest, IncrementalSaving)
+    {
+        sol::state mLua;
+        LuaUtil::LuaStorage::initLuaBindings(mLua);
+        const auto tmpFile = std::filesystem::temp_directory_path() / "test_storage_incremental.bin";
+
+        LuaUtil::LuaStorage storage(mLua);
+        mLua["a"] = storage.getMutableSection("a");
+        mLua["b"] = storage.getMutableSection("b");
+        mLua["c"] = storage.getMutableSection("c");
+        mLua.safe_script("a:set('x', 1)");
+        mLua.safe_script("b:set('x', { y = 'abc' })");
+        mLua.safe_script("c:set('x', 3)");
+        storage.save(tmpFile);
+        const auto initialSize = std::filesystem::file_size(tmpFile);
+
+        storage.save(tmpFile);
+        EXPECT_EQ(std::filesystem::file_size(tmpFile), initialSize);
+
+        mLua.safe_script("a:set('x', 2)");
+        mLua.safe_script("c:reset()");
+        storage.save(tmpFile);
+        EXPECT_GT(std::filesystem::file_size(tmpFile), initialSize);
+
+        LuaUtil::LuaStorage storage2(mLua);
+        storage2.load(tmpFile);
+        mLua["a"] = storage2.getMutableSection("a");
+        mLua["b"] = storage2.getMutableSection("b");
+        mLua["c"] = storage2.getMutableSection("c");
+        EXPECT_EQ(get<int>(mLua, "a:get('x')"), 2);
+        EXPECT_EQ(get<std::string>(mLua, "b:get('x').y"), "abc");
+        EXPECT_TRUE(get<bool>(mLua, "c:get('x') == nil"));
+
+        // Rewriting the same section many times triggers compaction, so the file doesn't grow indefinitely.
+        for (int i = 0; i < 100; ++i)
+        {
+            mLua.safe_script("a:set('x', " + std::to_string(i) + ")");
+            storage2.save(tmpFile);
+        }
+        EXPECT_LT(std::filesystem::file_size(tmpFile), 3 * initialSize);
+
+        LuaUtil::LuaStorage storage3(mLua);
+        storage3.load(tmpFile);
+        mLua["a"] = storage3.getMutableSection("a");
+        EXPECT_EQ(get<int>(mLua, "a:get('x')"), 99);
+    }
+
+    TEST(LuaUtilStorageTest, LoadingOldFormat)
+    {
+        sol::state mLua;
+        LuaUtil::LuaStorage::initLuaBindings(mLua);
+        const auto tmpFile = std::filesystem::temp_directory_path() / "test_storage_old_format.bin";
+        {
+            std::ofstream fout(tmpFile, std::fstream::binary);
+            const std::string data
+                = LuaUtil::serialize(mLua.safe_script("return { s = { x = 5 } }").get<sol::object>());
+            fout.write(data.data(), data.size());
+        }
+
+        LuaUtil::LuaStorage storage(mLua);
+        storage.load(tmpFile);
+        mLua["s"] = storage.getMutableSection("s");
+        EXPECT_EQ(get<int>(mLua, "s:get('x')"), 5);
+    }
+
 }
@@ -0,0 +1,69 @@
+#include "apps/openmw/mwdialogue/infoindex.hpp"
+
+#include <components/esm3/loaddial.hpp>
+#include <components/esm3/loadinfo.hpp>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace MWDialogue;
+
+    struct MWDialogueInfoIndexTest : Test
+    {
+        ESM::Dialogue mDialogue;
+
+        ESM::DialInfo& addInfo(const std::string& id)
+        {
+            ESM::DialInfo& info = mDialogue.mInfo.emplace_back();
+            info.mId = id;
+            info.mFactionLess = false;
+            return info;
+        }
+
+        MWDialogueInfoIndexTest()
+        {
+            addInfo("generic");
+            addInfo("actor").mActor = "Fargoth";
+            addInfo("race").mRace = "Wood Elf";
+            addInfo("other race").mRace = "Dark Elf";
+            addInfo("class").mClass = "Commoner";
+            addInfo("faction").mFaction = "Mages Guild";
+            addInfo("factionless").mFactionLess = true;
+            addInfo("creature").mActor = "mudcrab";
+        }
+
+        static std::vector<std::string> getIds(const std::vector<const ESM::DialInfo*>& infos)
+        {
+            std::vector<std::string> result;
+            for (const ESM::DialInfo* info : infos)
+                result.push_back(info->mId);
+            return result;
+        }
+    };
+
+    TEST_F(MWDialogueInfoIndexTest, should_return_matching_infos_for_npc_in_dialogue_order)
+    {
+        const InfoIndex index(mDialogue);
+        const std::vector<std::string> expected{ "generic", "actor", "race", "class", "faction", "factionless" };
+        EXPECT_EQ(getIds(index.getCandidates("fargoth", true, "wood elf", "commoner", "mages guild")), expected);
+    }
+
+    TEST_F(MWDialogueInfoIndexTest, should_skip_infos_for_other_race_class_and_faction)
+    {
+        const InfoIndex index(mDialogue);
+        const std::vector<std::string> expected{ "generic", "other race", "factionless" };
+        EXPECT_EQ(getIds(index.getCandidates("dreynis", true, "Dark Elf", "Pilgrim", "")), expected);
+    }
+
+    TEST_F(MWDialogueInfoIndexTest, should_return_only_infos_for_creature_id)
+    {
+        const InfoIndex index(mDialogue);
+        const std::vector<std::string> expected{ "creature" };
+        EXPECT_EQ(getIds(index.getCandidates("Mudcrab", false, "wood elf", "commoner", "mages guild")), expected);
+    }
+}
@@ -129,3 +129,60 @@ TEST_F(KeywordSearchTest, keyword_test_russian_ascii_before)
     EXPECT_EQ(matches.size(), 1);
     EXPECT_EQ(std::string(matches[0].mBeg, matches[0].mEnd), "Доложить Каю Косадесу");
 }
+
+TEST_F(KeywordSearchTest, keyword_test_prefix_seeded_after_longer_keyword)
+{
+    MWDialogue::KeywordSearch<std::string, int> search;
+    search.seed("dwemer language", 1);
+    search.seed("dwemer", 2);
+
+    std::string text = "the dwemer and the dwemer language";
+
+    std::vector<MWDialogue::KeywordSearch<std::string, int>::Match> matches;
+    search.highlightKeywords(text.begin(), text.end(), matches);
+
+    ASSERT_EQ(matches.size(), 2);
+    EXPECT_EQ(std::string(matches[0].mBeg, matches[0].mEnd), "dwemer");
+    EXPECT_EQ(matches[0].mValue, 2);
+    EXPECT_EQ(std::string(matches[1].mBeg, matches[1].mEnd), "dwemer language");
+    EXPECT_EQ(matches[1].mValue, 1);
+}
+
+TEST_F(KeywordSearchTest, keyword_test_case_insensitive_match_at_text_end)
+{
+    MWDialogue::KeywordSearch<std::string, int> search;
+    search.seed("vivec", 0);
+    search.seed("c", 1);
+
+    std::string text = "Lord VIVEC or c";
+
+    std::vector<MWDialogue::KeywordSearch<std::string, int>::Match> matches;
+    search.highlightKeywords(text.begin(), text.end(), matches);
+
+    ASSERT_EQ(matches.size(), 2);
+    EXPECT_EQ(std::string(matches[0].mBeg, matches[0].mEnd), "VIVEC");
+    EXPECT_EQ(std::string(matches[1].mBeg, matches[1].mEnd), "c");
+
+    int value = -1;
+    EXPECT_TRUE(search.containsKeyword("Vivec", value));
+    EXPECT_EQ(value, 0);
+    EXPECT_FALSE(search.containsKeyword("viv", value));
+}
+
+TEST_F(KeywordSearchTest, keyword_test_single_char_match_followed_by_longer_keyword_prefix)
+{
+    // "c" must be found even though the following text continues the longer keyword "cbbc" that never completes
+    MWDialogue::KeywordSearch<std::string, int> search;
+    search.seed("c", 0);
+    search.seed("cbbc", 1);
+
+    std::string text = "AcBBB";
+
+    std::vector<MWDialogue::KeywordSearch<std::string, int>::Match> matches;
+    search.highlightKeywords(text.begin(), text.end(), matches);
+
+    ASSERT_EQ(matches.size(), 1);
+    EXPECT_EQ(std::string(matches[0].mBeg, matches[0].mEnd), "c");
+    EXPECT_EQ(matches[0].mBeg - text.begin(), 1);
+    EXPECT_EQ(matches[0].mValue, 0);
+}
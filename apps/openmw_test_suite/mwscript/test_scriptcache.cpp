@@ -0,0 +1,68 @@
+#include "apps/openmw/mwscript/scriptcache.hpp"
+
+#include "../testing_util.hpp"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace MWScript;
+
+    struct MWScriptScriptCacheTest : Test
+    {
+        const std::filesystem::path mPath = TestingOpenMW::temporaryFilePath("script_cache_test.cache");
+        const ScriptHash mKey = getScriptHash("key");
+
+        void TearDown() override { std::filesystem::remove(mPath); }
+    };
+
+    TEST_F(MWScriptScriptCacheTest, read_should_return_empty_cache_for_absent_file)
+    {
+        std::filesystem::remove(mPath);
+        EXPECT_TRUE(readScriptCache(mPath, mKey).empty());
+    }
+
+    TEST_F(MWScriptScriptCacheTest, read_should_return_written_scripts)
+    {
+        ScriptCache cache;
+        CachedScript& script = cache["script"];
+        script.mHash = getScriptHash("Begin script End");
+        script.mByteCode = { 1, 0, 0, 0, 42 };
+        script.mLocals.declare('s', "a");
+        script.mLocals.declare('f', "b");
+        writeScriptCache(mPath, mKey, cache);
+
+        const ScriptCache result = readScriptCache(mPath, mKey);
+        ASSERT_EQ(result.size(), 1);
+        const CachedScript& actual = result.at("script");
+        EXPECT_EQ(actual.mHash, script.mHash);
+        EXPECT_EQ(actual.mByteCode, script.mByteCode);
+        EXPECT_EQ(actual.mLocals.get('s'), std::vector<std::string>{ "a" });
+        EXPECT_TRUE(actual.mLocals.get('l').empty());
+        EXPECT_EQ(actual.mLocals.get('f'), std::vector<std::string>{ "b" });
+    }
+
+    TEST_F(MWScriptScriptCacheTest, read_should_return_empty_cache_for_different_key)
+    {
+        ScriptCache cache;
+        cache["script"].mByteCode = { 0, 0, 0, 0 };
+        writeScriptCache(mPath, mKey, cache);
+
+        EXPECT_TRUE(readScriptCache(mPath, getScriptHash("other key")).empty());
+    }
+
+    TEST_F(MWScriptScriptCacheTest, read_should_return_empty_cache_for_truncated_file)
+    {
+        ScriptCache cache;
+        cache["script"].mByteCode = { 0, 0, 0, 0 };
+        writeScriptCache(mPath, mKey, cache);
+        std::filesystem::resize_file(mPath, std::filesystem::file_size(mPath) - 1);
+
+        EXPECT_TRUE(readScriptCache(mPath, mKey).empty());
+    }
+}
@@ -53,6 +53,13 @@ namespace
             mInterpreter.run(&script.mByteCode[0], static_cast<int>(script.mByteCode.size()), context);
         }
 
+        void runDecoded(const CompiledScript& script, TestInterpreterContext& context)
+        {
+            const int codeSize = static_cast<int>(script.mByteCode.size());
+            const Interpreter::Program program = mInterpreter.decode(script.mByteCode.data(), codeSize);
+            mInterpreter.run(program, script.mByteCode.data(), codeSize, context);
+        }
+
         template <typename T, typename... TArgs>
         void installOpcode(int code, TArgs&&... args)
         {
@@ -535,6 +542,42 @@ messagebox,"this is a %g",a
         }
     }
 
+    TEST_F(MWScriptTest, mwscript_test_decoded_program_should_give_same_result_as_byte_code)
+    {
+        if (const auto script = compile(sScript3))
+        {
+            TestInterpreterContext expected;
+            TestInterpreterContext actual;
+            for (int i = 1; i < 100; ++i)
+            {
+                expected.setLocalShort(0, i);
+                actual.setLocalShort(0, i);
+                run(*script, expected);
+                runDecoded(*script, actual);
+                for (int j = 0; j < 5; ++j)
+                    EXPECT_EQ(actual.getLocalShort(j), expected.getLocalShort(j)) << i << " " << j;
+            }
+        }
+        else
+        {
+            FAIL();
+        }
+    }
+
+    TEST_F(MWScriptTest, mwscript_test_decoded_program_should_report_unknown_opcode)
+    {
+        registerExtensions();
+        if (const auto script = compile(sScript2))
+        {
+            TestInterpreterContext context;
+            EXPECT_THROW(runDecoded(*script, context), std::runtime_error);
+        }
+        else
+        {
+            FAIL();
+        }
+    }
+
     TEST_F(MWScriptTest, mwscript_test_forum_thread)
     {
         registerExtensions();
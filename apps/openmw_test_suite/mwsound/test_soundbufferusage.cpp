@@ -0,0 +1,71 @@
+#include "apps/openmw/mwsound/sound_buffer.hpp"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    using namespace testing;
+    using namespace MWSound;
+
+    struct MWSoundSoundBufferUsageTest : Test
+    {
+        SoundBufferUsage mUsage;
+        Sound_Buffer mBuffer{ "sound/a.wav", 1.0f, 1.0f, 100.0f };
+        int mData = 0;
+        Sound_Handle mHandle = &mData;
+    };
+
+    TEST_F(MWSoundSoundBufferUsageTest, loaded_buffer_should_be_unused)
+    {
+        mUsage.loaded(mBuffer, mHandle);
+        EXPECT_TRUE(mUsage.hasUnused());
+        EXPECT_EQ(mUsage.takeUnused(), mHandle);
+        EXPECT_EQ(mBuffer.getHandle(), nullptr);
+        EXPECT_FALSE(mUsage.hasUnused());
+    }
+
+    TEST_F(MWSoundSoundBufferUsageTest, used_buffer_should_not_be_unused)
+    {
+        mUsage.loaded(mBuffer, mHandle);
+        mUsage.use(mBuffer);
+        EXPECT_FALSE(mUsage.hasUnused());
+        EXPECT_EQ(mUsage.takeUnused(), nullptr);
+        EXPECT_EQ(mBuffer.getHandle(), mHandle);
+    }
+
+    TEST_F(MWSoundSoundBufferUsageTest, released_buffer_should_be_unused)
+    {
+        mUsage.loaded(mBuffer, mHandle);
+        mUsage.use(mBuffer);
+        mUsage.use(mBuffer);
+        mUsage.release(mBuffer);
+        EXPECT_FALSE(mUsage.hasUnused());
+        mUsage.release(mBuffer);
+        EXPECT_EQ(mUsage.takeUnused(), mHandle);
+    }
+
+    TEST_F(MWSoundSoundBufferUsageTest, buffer_released_while_pending_should_be_listed_once_when_loaded)
+    {
+        mUsage.use(mBuffer);
+        mUsage.release(mBuffer);
+        EXPECT_FALSE(mUsage.hasUnused());
+
+        mUsage.loaded(mBuffer, mHandle);
+        mUsage.use(mBuffer);
+
+        EXPECT_FALSE(mUsage.hasUnused());
+        EXPECT_EQ(mUsage.takeUnused(), nullptr);
+        EXPECT_EQ(mBuffer.getHandle(), mHandle);
+    }
+
+    TEST_F(MWSoundSoundBufferUsageTest, take_unused_should_return_oldest_unused_first)
+    {
+        Sound_Buffer other("sound/b.wav", 1.0f, 1.0f, 100.0f);
+        int otherData = 0;
+        mUsage.loaded(mBuffer, mHandle);
+        mUsage.loaded(other, &otherData);
+        EXPECT_EQ(mUsage.takeUnused(), mHandle);
+        EXPECT_EQ(mUsage.takeUnused(), &otherData);
+        EXPECT_EQ(mUsage.takeUnused(), nullptr);
+    }
+}
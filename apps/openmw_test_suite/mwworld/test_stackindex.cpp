@@ -0,0 +1,45 @@
+#include "apps/openmw/mwworld/stackindex.hpp"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace MWWorld;
+
+    TEST(MWWorldStackIndexTest, get_should_return_empty_for_absent_id)
+    {
+        StackIndex<int> index;
+        index.add("a", 1);
+        EXPECT_TRUE(index.get("b").empty());
+    }
+
+    TEST(MWWorldStackIndexTest, get_should_return_stacks_in_added_order_ignoring_case)
+    {
+        StackIndex<int> index;
+        index.add("Gold_001", 1);
+        index.add("a", 2);
+        index.add("gold_001", 3);
+        EXPECT_EQ(index.get("GOLD_001"), (std::vector<int>{ 1, 3 }));
+    }
+
+    TEST(MWWorldStackIndexTest, copy_should_be_empty_and_out_of_date)
+    {
+        StackIndex<int> index;
+        index.add("a", 1);
+        index.setUpToDate();
+
+        const StackIndex<int> copy(index);
+        EXPECT_FALSE(copy.isUpToDate());
+        EXPECT_TRUE(copy.get("a").empty());
+
+        StackIndex<int> assigned;
+        assigned.add("b", 2);
+        assigned.setUpToDate();
+        assigned = index;
+        EXPECT_FALSE(assigned.isUpToDate());
+        EXPECT_TRUE(assigned.get("b").empty());
+    }
+}
@@ -0,0 +1,132 @@
+#include "../detournavigator/settings.hpp"
+
+#include <apps/navmeshtool/worldspacedata.hpp>
+
+#include <components/detournavigator/agentbounds.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <map>
+#include <set>
+
+namespace
+{
+    using namespace testing;
+    using namespace NavMeshTool;
+    using DetourNavigator::AgentBounds;
+    using DetourNavigator::CollisionShapeType;
+    using DetourNavigator::TilePosition;
+    using DetourNavigator::TilesPositionsRange;
+
+    struct NavMeshToolTileInputDigestsTest : Test
+    {
+        const DetourNavigator::Settings mSettings = DetourNavigator::Tests::makeSettings();
+        const AgentBounds mAgentBounds{ CollisionShapeType::Aabb, osg::Vec3f(29, 29, 66) };
+        const TilesPositionsRange mRange{ TilePosition(0, 0), TilePosition(4, 2) };
+        WorldspaceNavMeshInput mInput{ "sys::default", mSettings.mRecast };
+
+        NavMeshToolTileInputDigestsTest()
+        {
+            mInput.mCellInputDigests.push_back(
+                CellInputDigest{ TilesPositionsRange{ TilePosition(0, 0), TilePosition(2, 2) }, 1 });
+            mInput.mCellInputDigests.push_back(
+                CellInputDigest{ TilesPositionsRange{ TilePosition(2, 0), TilePosition(4, 2) }, 2 });
+        }
+
+        std::map<TilePosition, std::int64_t> makeDigests() const
+        {
+            return makeTileInputDigests(mInput, mRange, mSettings.mRecast, mAgentBounds);
+        }
+    };
+
+    TEST_F(NavMeshToolTileInputDigestsTest, should_make_digest_for_each_tile_in_range)
+    {
+        const auto digests = makeDigests();
+        EXPECT_EQ(digests.size(), 8);
+        EXPECT_EQ(digests.count(TilePosition(0, 0)), 1);
+        EXPECT_EQ(digests.count(TilePosition(3, 1)), 1);
+    }
+
+    TEST_F(NavMeshToolTileInputDigestsTest, should_make_equal_digests_for_equal_input)
+    {
+        EXPECT_EQ(makeDigests(), makeDigests());
+    }
+
+    TEST_F(NavMeshToolTileInputDigestsTest, should_not_depend_on_cells_order)
+    {
+        const auto digests = makeDigests();
+        std::swap(mInput.mCellInputDigests[0], mInput.mCellInputDigests[1]);
+        EXPECT_EQ(makeDigests(), digests);
+    }
+
+    TEST_F(NavMeshToolTileInputDigestsTest, should_change_digest_only_for_tiles_affected_by_changed_cell)
+    {
+        const auto digests = makeDigests();
+        mInput.mCellInputDigests[1].mValue = 3;
+        const auto changed = makeDigests();
+        EXPECT_EQ(changed.at(TilePosition(0, 0)), digests.at(TilePosition(0, 0)));
+        EXPECT_EQ(changed.at(TilePosition(1, 1)), digests.at(TilePosition(1, 1)));
+        EXPECT_NE(changed.at(TilePosition(2, 0)), digests.at(TilePosition(2, 0)));
+        EXPECT_NE(changed.at(TilePosition(3, 1)), digests.at(TilePosition(3, 1)));
+    }
+
+    TEST_F(NavMeshToolTileInputDigestsTest, cell_without_tiles_range_should_affect_all_tiles)
+    {
+        const auto digests = makeDigests();
+        mInput.mCellInputDigests.push_back(CellInputDigest{ std::nullopt, 4 });
+        const auto changed = makeDigests();
+        for (const auto& [tilePosition, digest] : digests)
+            EXPECT_NE(changed.at(tilePosition), digest) << tilePosition.x() << " " << tilePosition.y();
+    }
+
+    TEST_F(NavMeshToolTileInputDigestsTest, should_change_all_digests_for_different_settings)
+    {
+        const auto digests = makeDigests();
+        DetourNavigator::RecastSettings settings = mSettings.mRecast;
+        settings.mMaxClimb += 1;
+        const auto changed = makeTileInputDigests(mInput, mRange, settings, mAgentBounds);
+        for (const auto& [tilePosition, digest] : digests)
+            EXPECT_NE(changed.at(tilePosition), digest) << tilePosition.x() << " " << tilePosition.y();
+    }
+
+    TEST_F(NavMeshToolTileInputDigestsTest, should_change_all_digests_for_different_agent_bounds)
+    {
+        const auto digests = makeDigests();
+        const AgentBounds agentBounds{ CollisionShapeType::Cylinder, mAgentBounds.mHalfExtents };
+        const auto changed = makeTileInputDigests(mInput, mRange, mSettings.mRecast, agentBounds);
+        for (const auto& [tilePosition, digest] : digests)
+            EXPECT_NE(changed.at(tilePosition), digest) << tilePosition.x() << " " << tilePosition.y();
+    }
+
+    TEST_F(NavMeshToolTileInputDigestsTest, find_unchanged_tiles_should_return_all_tiles_for_unchanged_input)
+    {
+        const auto stored = makeDigests();
+        const std::set<TilePosition> unchanged = findUnchangedTiles(stored, makeDigests());
+        EXPECT_EQ(unchanged.size(), stored.size());
+    }
+
+    TEST_F(NavMeshToolTileInputDigestsTest, find_unchanged_tiles_should_skip_tiles_affected_by_changed_cell)
+    {
+        const auto stored = makeDigests();
+        mInput.mCellInputDigests[1].mValue = 3;
+        const std::set<TilePosition> unchanged = findUnchangedTiles(stored, makeDigests());
+        EXPECT_THAT(unchanged,
+            ElementsAre(TilePosition(0, 0), TilePosition(0, 1), TilePosition(1, 0), TilePosition(1, 1)));
+    }
+
+    TEST_F(NavMeshToolTileInputDigestsTest, find_unchanged_tiles_should_skip_tiles_without_stored_digest)
+    {
+        auto stored = makeDigests();
+        stored.erase(TilePosition(0, 0));
+        const std::set<TilePosition> unchanged = findUnchangedTiles(stored, makeDigests());
+        EXPECT_EQ(unchanged.size(), 7);
+        EXPECT_EQ(unchanged.count(TilePosition(0, 0)), 0);
+    }
+
+    TEST_F(NavMeshToolTileInputDigestsTest, find_unchanged_tiles_should_return_nothing_without_stored_digests)
+    {
+        EXPECT_THAT(findUnchangedTiles({}, makeDigests()), IsEmpty());
+    }
+}
@@ -0,0 +1,62 @@
+#include <components/nif/nifkey.hpp>
+#include <components/nifosg/controller.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <memory>
+
+namespace
+{
+    using namespace testing;
+    using namespace NifOsg;
+
+    std::shared_ptr<Nif::FloatKeyMap> makeLinearTrack(std::size_t size)
+    {
+        auto result = std::make_shared<Nif::FloatKeyMap>();
+        result->mInterpolationType = Nif::InterpolationType_Linear;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            result->mTimes.push_back(static_cast<float>(i));
+            result->mKeys.push_back(Nif::FloatKey{ static_cast<float>(i * 10), 0, 0 });
+        }
+        return result;
+    }
+
+    TEST(NifOsgValueInterpolatorTest, should_return_default_value_for_empty_track)
+    {
+        const FloatInterpolator interpolator(std::make_shared<Nif::FloatKeyMap>(), 42);
+        EXPECT_TRUE(interpolator.empty());
+        EXPECT_EQ(interpolator.interpKey(1), 42);
+    }
+
+    TEST(NifOsgValueInterpolatorTest, should_clamp_time_to_track_bounds)
+    {
+        const FloatInterpolator interpolator(makeLinearTrack(3));
+        EXPECT_EQ(interpolator.interpKey(-1), 0);
+        EXPECT_EQ(interpolator.interpKey(5), 20);
+    }
+
+    struct NifOsgValueInterpolatorTrackSizeTest : TestWithParam<std::size_t>
+    {
+    };
+
+    TEST_P(NifOsgValueInterpolatorTrackSizeTest, should_interpolate_for_increasing_time)
+    {
+        const std::size_t size = GetParam();
+        const FloatInterpolator interpolator(makeLinearTrack(size));
+        for (float time = 0; time < static_cast<float>(size - 1); time += 0.25f)
+            EXPECT_FLOAT_EQ(interpolator.interpKey(time), time * 10) << time;
+    }
+
+    TEST_P(NifOsgValueInterpolatorTrackSizeTest, should_interpolate_for_arbitrary_time)
+    {
+        const std::size_t size = GetParam();
+        const FloatInterpolator interpolator(makeLinearTrack(size));
+        for (const float time : { 1.5f, 0.5f, size - 1.5f, 2.0f, 1.0f, size - 1.0f, 1.25f })
+            EXPECT_FLOAT_EQ(interpolator.interpKey(time), time * 10) << time;
+    }
+
+    INSTANTIATE_TEST_SUITE_P(LinearAndBinarySearch, NifOsgValueInterpolatorTrackSizeTest,
+        Values(3, Nif::FloatKeyMap::sLinearSearchMaxSize, Nif::FloatKeyMap::sLinearSearchMaxSize * 4));
+}
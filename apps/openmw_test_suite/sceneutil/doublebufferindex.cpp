@@ -0,0 +1,53 @@
+#include <components/sceneutil/doublebufferindex.hpp>
+
+#include <gtest/gtest.h>
+
+#include <optional>
+
+namespace
+{
+    using namespace testing;
+    using namespace SceneUtil;
+
+    TEST(SceneUtilDoubleBufferIndexTest, next_should_switch_buffer)
+    {
+        DoubleBufferIndex index;
+        const unsigned int initial = index.getCurrent();
+        EXPECT_NE(index.next(), initial);
+        EXPECT_EQ(index.next(), initial);
+    }
+
+    TEST(SceneUtilDoubleBufferIndexTest, get_current_should_return_last_written_buffer)
+    {
+        DoubleBufferIndex index;
+        const unsigned int written = index.next();
+        EXPECT_EQ(index.getCurrent(), written);
+        EXPECT_EQ(index.getCurrent(), written);
+    }
+
+    struct SceneUtilDoubleBufferIndexUpdateIntervalTest : TestWithParam<unsigned int>
+    {
+    };
+
+    TEST_P(SceneUtilDoubleBufferIndexUpdateIntervalTest, should_not_write_buffer_drawn_in_previous_frame)
+    {
+        const unsigned int interval = GetParam();
+        DoubleBufferIndex index;
+        std::optional<unsigned int> drawn;
+        for (unsigned int frame = 1; frame <= 4 * interval + 1; ++frame)
+        {
+            unsigned int current;
+            if ((frame - 1) % interval == 0)
+            {
+                current = index.next();
+                if (drawn.has_value())
+                    EXPECT_NE(current, *drawn) << "frame=" << frame;
+            }
+            else
+                current = index.getCurrent();
+            drawn = current;
+        }
+    }
+
+    INSTANTIATE_TEST_SUITE_P(UpdateIntervals, SceneUtilDoubleBufferIndexUpdateIntervalTest, Values(1u, 2u, 3u, 4u, 5u));
+}
@@ -0,0 +1,134 @@
+#include <components/sceneutil/skeleton.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <osg/Group>
+#include <osg/NodeVisitor>
+#include <osg/ref_ptr>
+
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace SceneUtil;
+
+    struct RecordingUpdateVisitor : osg::NodeVisitor
+    {
+        const osg::Node* mChild;
+        std::vector<unsigned int> mFrames;
+
+        explicit RecordingUpdateVisitor(const osg::Node* child)
+            : osg::NodeVisitor(osg::NodeVisitor::UPDATE_VISITOR, osg::NodeVisitor::TRAVERSE_ALL_CHILDREN)
+            , mChild(child)
+        {
+        }
+
+        void apply(osg::Node& node) override
+        {
+            if (&node == mChild)
+                mFrames.push_back(getTraversalNumber());
+            traverse(node);
+        }
+    };
+
+    struct SceneUtilSkeletonTest : Test
+    {
+        osg::ref_ptr<Skeleton> mSkeleton = new Skeleton;
+        osg::ref_ptr<osg::Group> mChild = new osg::Group;
+        RecordingUpdateVisitor mVisitor{ mChild.get() };
+
+        SceneUtilSkeletonTest() { mSkeleton->addChild(mChild); }
+
+        void update(unsigned int firstFrame, unsigned int lastFrame)
+        {
+            for (unsigned int frame = firstFrame; frame <= lastFrame; ++frame)
+            {
+                mVisitor.setTraversalNumber(frame);
+                mSkeleton->accept(mVisitor);
+            }
+        }
+    };
+
+    TEST_F(SceneUtilSkeletonTest, traverse_should_update_children_every_frame_by_default)
+    {
+        mSkeleton->updateBoneMatrices(1);
+        update(1, 4);
+        EXPECT_THAT(mVisitor.mFrames, ElementsAre(1, 2, 3, 4));
+    }
+
+    TEST_F(SceneUtilSkeletonTest, traverse_should_update_children_once_per_update_interval)
+    {
+        mSkeleton->setUpdateInterval(3);
+        mSkeleton->updateBoneMatrices(1);
+        update(1, 7);
+        EXPECT_THAT(mVisitor.mFrames, ElementsAre(1, 4, 7));
+    }
+
+    TEST_F(SceneUtilSkeletonTest, traverse_should_update_children_every_frame_for_zero_update_interval)
+    {
+        mSkeleton->setUpdateInterval(0);
+        mSkeleton->updateBoneMatrices(1);
+        update(1, 3);
+        EXPECT_THAT(mVisitor.mFrames, ElementsAre(1, 2, 3));
+    }
+
+    TEST_F(SceneUtilSkeletonTest, traverse_should_not_skip_update_until_bone_matrices_are_updated)
+    {
+        mSkeleton->setUpdateInterval(3);
+        update(1, 3);
+        EXPECT_THAT(mVisitor.mFrames, ElementsAre(1, 2, 3));
+    }
+
+    TEST_F(SceneUtilSkeletonTest, traverse_should_not_skip_update_after_child_is_added)
+    {
+        mSkeleton->setUpdateInterval(3);
+        mSkeleton->updateBoneMatrices(1);
+        update(1, 2);
+        mSkeleton->addChild(new osg::Group);
+        mSkeleton->updateBoneMatrices(3);
+        update(3, 4);
+        EXPECT_THAT(mVisitor.mFrames, ElementsAre(1, 3));
+    }
+
+    TEST_F(SceneUtilSkeletonTest, is_update_skipped_should_return_false_for_default_update_interval)
+    {
+        mSkeleton->updateBoneMatrices(1);
+        update(1, 2);
+        EXPECT_FALSE(mSkeleton->isUpdateSkipped(1));
+        EXPECT_FALSE(mSkeleton->isUpdateSkipped(2));
+    }
+
+    TEST_F(SceneUtilSkeletonTest, is_update_skipped_should_return_false_before_first_update)
+    {
+        mSkeleton->setUpdateInterval(3);
+        EXPECT_FALSE(mSkeleton->isUpdateSkipped(1));
+    }
+
+    TEST_F(SceneUtilSkeletonTest, is_update_skipped_should_return_false_for_frame_before_last_update)
+    {
+        mSkeleton->setUpdateInterval(3);
+        mSkeleton->updateBoneMatrices(1);
+        update(1, 4);
+        EXPECT_FALSE(mSkeleton->isUpdateSkipped(3));
+    }
+
+    TEST_F(SceneUtilSkeletonTest, is_update_skipped_should_return_true_for_frames_since_last_update)
+    {
+        mSkeleton->setUpdateInterval(3);
+        mSkeleton->updateBoneMatrices(1);
+        update(1, 5);
+        EXPECT_TRUE(mSkeleton->isUpdateSkipped(4));
+        EXPECT_TRUE(mSkeleton->isUpdateSkipped(5));
+    }
+
+    TEST_F(SceneUtilSkeletonTest, is_update_skipped_should_return_false_after_mark_dirty)
+    {
+        mSkeleton->setUpdateInterval(3);
+        mSkeleton->updateBoneMatrices(1);
+        update(1, 2);
+        mSkeleton->markDirty();
+        EXPECT_FALSE(mSkeleton->isUpdateSkipped(2));
+    }
+}
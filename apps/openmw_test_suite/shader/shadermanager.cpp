@@ -236,4 +236,26 @@ namespace
             EXPECT_FALSE(mManager.getShader(Files::pathToUnicodeString(templateName), mDefines, osg::Shader::VERTEX));
         });
     }
+
+    TEST_F(ShaderManagerTest, get_permutation_should_return_nullopt_for_absent_key)
+    {
+        EXPECT_EQ(mManager.getPermutation(ShaderManager::PermutationKey{ "objects", 42 }), std::nullopt);
+    }
+
+    TEST_F(ShaderManagerTest, get_permutation_should_return_added_program)
+    {
+        const osg::ref_ptr<osg::Program> program(new osg::Program);
+        mManager.addPermutation(ShaderManager::PermutationKey{ "objects", 42 }, program);
+        EXPECT_EQ(mManager.getPermutation(ShaderManager::PermutationKey{ "objects", 42 }), program);
+        EXPECT_EQ(mManager.getPermutation(ShaderManager::PermutationKey{ "objects", 13 }), std::nullopt);
+        EXPECT_EQ(mManager.getPermutation(ShaderManager::PermutationKey{ "terrain", 42 }), std::nullopt);
+    }
+
+    TEST_F(ShaderManagerTest, get_permutation_should_return_added_failed_program)
+    {
+        mManager.addPermutation(ShaderManager::PermutationKey{ "objects", 42 }, nullptr);
+        const auto program = mManager.getPermutation(ShaderManager::PermutationKey{ "objects", 42 });
+        ASSERT_TRUE(program.has_value());
+        EXPECT_FALSE(program->valid());
+    }
 }
@@ -0,0 +1,125 @@
+#include <components/terrain/diskcache.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <filesystem>
+
+#include "../testing_util.hpp"
+
+namespace
+{
+    using namespace testing;
+    using namespace TestingOpenMW;
+    using namespace Terrain;
+
+    struct TerrainDiskCacheTest : Test
+    {
+        const std::filesystem::path mPath = temporaryFilePath("terrain_disk_cache");
+        const osg::Vec2f mCenter{ 1.5f, -2.5f };
+        const float mSize = 1;
+        osg::ref_ptr<osg::Vec3Array> mPositions{ new osg::Vec3Array };
+        osg::ref_ptr<osg::Vec3Array> mNormals{ new osg::Vec3Array };
+        osg::ref_ptr<osg::Vec4ubArray> mColours{ new osg::Vec4ubArray };
+
+        TerrainDiskCacheTest()
+        {
+            std::filesystem::remove_all(mPath);
+            for (int i = 0; i < 9; ++i)
+            {
+                mPositions->push_back(osg::Vec3f(i, 2 * i, 3 * i));
+                mNormals->push_back(osg::Vec3f(0, 0, 1));
+                mColours->push_back(osg::Vec4ub(i, 255, 0, 255));
+            }
+        }
+
+        ~TerrainDiskCacheTest() { std::filesystem::remove_all(mPath); }
+    };
+
+    TEST_F(TerrainDiskCacheTest, shouldLoadStoredVertexBuffers)
+    {
+        DiskCache cache(mPath);
+        cache.storeVertexBuffers(mSize, mCenter, 2, 42, *mPositions, *mNormals, *mColours);
+
+        osg::Vec3Array positions;
+        osg::Vec3Array normals;
+        osg::Vec4ubArray colours;
+        ASSERT_TRUE(cache.loadVertexBuffers(mSize, mCenter, 2, 42, positions, normals, colours));
+        ASSERT_EQ(positions.size(), mPositions->size());
+        EXPECT_EQ(
+            std::memcmp(positions.getDataPointer(), mPositions->getDataPointer(), mPositions->getTotalDataSize()), 0);
+        EXPECT_EQ(std::memcmp(normals.getDataPointer(), mNormals->getDataPointer(), mNormals->getTotalDataSize()), 0);
+        EXPECT_EQ(std::memcmp(colours.getDataPointer(), mColours->getDataPointer(), mColours->getTotalDataSize()), 0);
+    }
+
+    TEST_F(TerrainDiskCacheTest, shouldNotLoadVertexBuffersForDifferentHashOrKey)
+    {
+        DiskCache cache(mPath);
+        cache.storeVertexBuffers(mSize, mCenter, 2, 42, *mPositions, *mNormals, *mColours);
+
+        osg::Vec3Array positions;
+        osg::Vec3Array normals;
+        osg::Vec4ubArray colours;
+        EXPECT_FALSE(cache.loadVertexBuffers(mSize, mCenter, 2, 13, positions, normals, colours));
+        EXPECT_FALSE(cache.loadVertexBuffers(mSize, mCenter, 1, 42, positions, normals, colours));
+        EXPECT_FALSE(cache.loadVertexBuffers(mSize / 2, mCenter, 2, 42, positions, normals, colours));
+        EXPECT_FALSE(cache.loadVertexBuffers(mSize, osg::Vec2f(1.5f, 2.5f), 2, 42, positions, normals, colours));
+    }
+
+    TEST_F(TerrainDiskCacheTest, shouldReplaceEntryWithDifferentHash)
+    {
+        DiskCache cache(mPath);
+        cache.storeVertexBuffers(mSize, mCenter, 0, 1, *mPositions, *mNormals, *mColours);
+        mPositions->front() = osg::Vec3f(-1, -1, -1);
+        cache.storeVertexBuffers(mSize, mCenter, 0, 2, *mPositions, *mNormals, *mColours);
+
+        osg::Vec3Array positions;
+        osg::Vec3Array normals;
+        osg::Vec4ubArray colours;
+        EXPECT_FALSE(cache.loadVertexBuffers(mSize, mCenter, 0, 1, positions, normals, colours));
+        ASSERT_TRUE(cache.loadVertexBuffers(mSize, mCenter, 0, 2, positions, normals, colours));
+        EXPECT_EQ(positions.front(), osg::Vec3f(-1, -1, -1));
+    }
+
+    TEST_F(TerrainDiskCacheTest, shouldLoadStoredBlendmaps)
+    {
+        DiskCache cache(mPath);
+        std::vector<osg::ref_ptr<osg::Image>> blendmaps;
+        for (int i = 0; i < 2; ++i)
+        {
+            osg::ref_ptr<osg::Image> image(new osg::Image);
+            image->allocateImage(4, 4, 1, GL_ALPHA, GL_UNSIGNED_BYTE);
+            std::memset(image->data(), i * 255, image->getTotalDataSize());
+            blendmaps.push_back(image);
+        }
+        const std::vector<std::string> layerTextures{ "textures/a.dds", "textures/b.dds" };
+        cache.storeBlendmaps(mSize, mCenter, 42, blendmaps, layerTextures);
+
+        std::vector<osg::ref_ptr<osg::Image>> loadedBlendmaps;
+        std::vector<std::string> loadedLayerTextures;
+        EXPECT_FALSE(cache.loadBlendmaps(mSize, mCenter, 13, loadedBlendmaps, loadedLayerTextures));
+        ASSERT_TRUE(cache.loadBlendmaps(mSize, mCenter, 42, loadedBlendmaps, loadedLayerTextures));
+        EXPECT_EQ(loadedLayerTextures, layerTextures);
+        ASSERT_EQ(loadedBlendmaps.size(), blendmaps.size());
+        for (std::size_t i = 0; i < blendmaps.size(); ++i)
+        {
+            ASSERT_EQ(loadedBlendmaps[i]->s(), 4);
+            ASSERT_EQ(loadedBlendmaps[i]->t(), 4);
+            EXPECT_EQ(std::memcmp(loadedBlendmaps[i]->data(), blendmaps[i]->data(), blendmaps[i]->getTotalDataSize()),
+                0);
+        }
+    }
+
+    TEST_F(TerrainDiskCacheTest, shouldLoadSingleLayerWithoutBlendmaps)
+    {
+        DiskCache cache(mPath);
+        cache.storeBlendmaps(mSize, mCenter, 42, {}, { "textures/a.dds" });
+
+        std::vector<osg::ref_ptr<osg::Image>> blendmaps;
+        std::vector<std::string> layerTextures;
+        ASSERT_TRUE(cache.loadBlendmaps(mSize, mCenter, 42, blendmaps, layerTextures));
+        EXPECT_THAT(layerTextures, ElementsAre("textures/a.dds"));
+        EXPECT_THAT(blendmaps, IsEmpty());
+    }
+}
@@ -52,19 +52,35 @@ namespace DetourNavigator
 
         auto getPriority(const Job& job) noexcept
         {
+            // Job id keeps the order of posting for otherwise equal jobs
             return std::make_tuple(-static_cast<std::underlying_type_t<JobState>>(job.mState), job.mProcessTime,
-                job.mChangeType, job.mTryNumber, job.mDistanceToPlayer, job.mDistanceToOrigin);
+                job.mChangeType, job.mTryNumber, job.mDistanceToPlayer, job.mDistanceToOrigin, job.mId);
         }
 
-        struct LessByJobPriority
+        // Makes a heap with the highest priority job at the front
+        struct GreaterByJobPriority
         {
-            bool operator()(JobIt lhs, JobIt rhs) const noexcept { return getPriority(*lhs) < getPriority(*rhs); }
+            bool operator()(JobIt lhs, JobIt rhs) const noexcept { return getPriority(*lhs) > getPriority(*rhs); }
         };
 
-        void insertPrioritizedJob(JobIt job, std::deque<JobIt>& queue)
+        void pushPrioritizedJob(JobIt job, std::vector<JobIt>& queue)
         {
-            const auto it = std::upper_bound(queue.begin(), queue.end(), job, LessByJobPriority{});
-            queue.insert(it, job);
+            queue.push_back(job);
+            std::push_heap(queue.begin(), queue.end(), GreaterByJobPriority{});
+        }
+
+        JobIt popPrioritizedJob(std::vector<JobIt>& queue)
+        {
+            std::pop_heap(queue.begin(), queue.end(), GreaterByJobPriority{});
+            const JobIt job = queue.back();
+            queue.pop_back();
+            return job;
+        }
+
+        std::size_t getJobLatencyBucket(std::chrono::steady_clock::duration latency)
+        {
+            const auto it = std::lower_bound(jobLatencyBucketBounds.begin(), jobLatencyBucketBounds.end(), latency);
+            return static_cast<std::size_t>(it - jobLatencyBucketBounds.begin());
         }
 
         auto getDbPriority(const Job& job) noexcept
@@ -98,7 +114,8 @@ namespace DetourNavigator
                 settings.mRecast, settings.mWriteToNavMeshDb);
         }
 
-        void updateJobs(std::deque<JobIt>& jobs, TilePosition playerTile, int maxTiles)
+        template <class T>
+        void updateJobs(T& jobs, TilePosition playerTile, int maxTiles)
         {
             for (JobIt job : jobs)
             {
@@ -142,6 +159,7 @@ namespace DetourNavigator
         , mNavMeshCacheItem(std::move(navMeshCacheItem))
         , mWorldspace(worldspace)
         , mChangedTile(changedTile)
+        , mPostTime(std::chrono::steady_clock::now())
         , mProcessTime(processTime)
         , mChangeType(changeType)
         , mDistanceToPlayer(distanceToPlayer)
@@ -187,7 +205,12 @@ namespace DetourNavigator
         std::unique_lock lock(mMutex);
 
         if (playerTileChanged)
+        {
             updateJobs(mWaiting, playerTile, maxTiles);
+            // Jobs in progress are checked by the processing threads
+            for (Job& job : mJobs)
+                job.mCancelled = !shouldAddTile(job.mChangedTile, playerTile, maxTiles);
+        }
 
         for (const auto& [changedTile, changeType] : changedTiles)
         {
@@ -206,12 +229,12 @@ namespace DetourNavigator
                 if (playerTileChanged)
                     mWaiting.push_back(it);
                 else
-                    insertPrioritizedJob(it, mWaiting);
+                    pushPrioritizedJob(it, mWaiting);
             }
         }
 
         if (playerTileChanged)
-            std::sort(mWaiting.begin(), mWaiting.end(), LessByJobPriority{});
+            std::make_heap(mWaiting.begin(), mWaiting.end(), GreaterByJobPriority{});
 
         Log(Debug::Debug) << "Posted " << mJobs.size() << " navigator jobs";
 
@@ -315,12 +338,14 @@ namespace DetourNavigator
             result.mJobs = mJobs.size();
             result.mWaiting = mWaiting.size();
             result.mPushed = mPushed.size();
+            result.mJobLatencies = mJobLatencies;
         }
         result.mProcessing = mProcessingTiles.lockConst()->size();
         if (mDbWorker != nullptr)
             result.mDb = mDbWorker->getStats();
         result.mCache = mNavMeshTilesCache.getStats();
         result.mDbGetTileHits = mDbGetTileHits.load(std::memory_order_relaxed);
+        result.mCancelled = mCancelledJobs.load(std::memory_order_relaxed);
         return result;
     }
 
@@ -433,11 +458,13 @@ namespace DetourNavigator
                 return JobStatus::MemoryCacheMiss;
             }
 
-            preparedNavMeshData
-                = prepareNavMeshTileData(*recastMesh, job.mChangedTile, job.mAgentBounds, mSettings.get().mRecast);
+            preparedNavMeshData = prepareNavMeshTileData(
+                *recastMesh, job.mChangedTile, job.mAgentBounds, mSettings.get().mRecast, &job.mCancelled);
 
             if (preparedNavMeshData == nullptr)
             {
+                if (job.mCancelled)
+                    return cancelJob(job, navMeshCacheItem);
                 Log(Debug::Debug) << "Null navmesh data for job " << job.mId;
                 navMeshCacheItem.lock()->markAsEmpty(job.mChangedTile);
                 return JobStatus::Done;
@@ -483,13 +510,15 @@ namespace DetourNavigator
 
         if (preparedNavMeshData == nullptr)
         {
-            preparedNavMeshData
-                = prepareNavMeshTileData(*job.mRecastMesh, job.mChangedTile, job.mAgentBounds, mSettings.get().mRecast);
+            preparedNavMeshData = prepareNavMeshTileData(
+                *job.mRecastMesh, job.mChangedTile, job.mAgentBounds, mSettings.get().mRecast, &job.mCancelled);
             generatedNavMeshData = true;
         }
 
         if (preparedNavMeshData == nullptr)
         {
+            if (job.mCancelled)
+                return cancelJob(job, navMeshCacheItem);
             Log(Debug::Debug) << "Null navmesh data for job " << job.mId;
             navMeshCacheItem.lock()->markAsEmpty(job.mChangedTile);
             return JobStatus::Done;
@@ -531,8 +560,10 @@ namespace DetourNavigator
         }
         else if (isSuccess(status) && status != UpdateNavMeshStatus::ignored)
         {
+            const std::size_t latencyBucket = getJobLatencyBucket(std::chrono::steady_clock::now() - job.mPostTime);
             const std::scoped_lock lock(mMutex);
             mPresentTiles.insert(std::make_tuple(job.mAgentBounds, job.mChangedTile));
+            ++mJobLatencies[latencyBucket];
         }
 
         writeDebugFiles(job, &recastMesh);
@@ -540,6 +571,14 @@ namespace DetourNavigator
         return isSuccess(status) ? JobStatus::Done : JobStatus::Fail;
     }
 
+    JobStatus AsyncNavMeshUpdater::cancelJob(const Job& job, GuardedNavMeshCacheItem& navMeshCacheItem)
+    {
+        Log(Debug::Debug) << "Cancelled job " << job.mId << ": too far from player";
+        ++mCancelledJobs;
+        navMeshCacheItem.lock()->removeTile(job.mChangedTile);
+        return JobStatus::Done;
+    }
+
     JobIt AsyncNavMeshUpdater::getNextJob()
     {
         std::unique_lock<std::mutex> lock(mMutex);
@@ -561,9 +600,7 @@ namespace DetourNavigator
         if (shouldStop)
             return mJobs.end();
 
-        const JobIt job = mWaiting.front();
-
-        mWaiting.pop_front();
+        const JobIt job = popPrioritizedJob(mWaiting);
 
         if (job->mRecastMesh != nullptr)
             return job;
@@ -572,7 +609,7 @@ namespace DetourNavigator
         {
             Log(Debug::Debug) << "Failed to lock tile by " << job->mId;
             ++job->mTryNumber;
-            insertPrioritizedJob(job, mWaiting);
+            pushPrioritizedJob(job, mWaiting);
             return mJobs.end();
         }
 
@@ -620,7 +657,7 @@ namespace DetourNavigator
         if (mPushed.emplace(job->mAgentBounds, job->mChangedTile).second)
         {
             ++job->mTryNumber;
-            insertPrioritizedJob(job, mWaiting);
+            pushPrioritizedJob(job, mWaiting);
             mHasJob.notify_all();
             return;
         }
@@ -668,7 +705,7 @@ namespace DetourNavigator
     {
         Log(Debug::Debug) << "Enqueueing job " << job->mId << " by thread=" << std::this_thread::get_id();
         const std::lock_guard lock(mMutex);
-        insertPrioritizedJob(job, mWaiting);
+        pushPrioritizedJob(job, mWaiting);
         mHasJob.notify_all();
     }
 
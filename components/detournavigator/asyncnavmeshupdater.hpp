@@ -28,6 +28,7 @@
 #include <set>
 #include <thread>
 #include <tuple>
+#include <vector>
 
 class dtNavMesh;
 
@@ -51,6 +52,7 @@ namespace DetourNavigator
         const std::weak_ptr<GuardedNavMeshCacheItem> mNavMeshCacheItem;
         const std::string mWorldspace;
         const TilePosition mChangedTile;
+        const std::chrono::steady_clock::time_point mPostTime;
         const std::chrono::steady_clock::time_point mProcessTime;
         unsigned mTryNumber = 0;
         ChangeType mChangeType;
@@ -61,6 +63,8 @@ namespace DetourNavigator
         std::shared_ptr<RecastMesh> mRecastMesh;
         std::optional<TileData> mCachedTileData;
         std::unique_ptr<PreparedNavMeshData> mGeneratedNavMeshData;
+        // Set when the tile goes out of range to stop navmesh generation in progress
+        std::atomic_bool mCancelled{ false };
 
         Job(const AgentBounds& agentBounds, std::weak_ptr<GuardedNavMeshCacheItem> navMeshCacheItem,
             std::string_view worldspace, const TilePosition& changedTile, ChangeType changeType, int distanceToPlayer,
@@ -171,7 +175,8 @@ namespace DetourNavigator
         std::condition_variable mDone;
         std::condition_variable mProcessed;
         std::list<Job> mJobs;
-        std::deque<JobIt> mWaiting;
+        // Binary heap by job priority with the next job at the front
+        std::vector<JobIt> mWaiting;
         std::set<std::tuple<AgentBounds, TilePosition>> mPushed;
         Misc::ScopeGuarded<TilePosition> mPlayerTile;
         NavMeshTilesCache mNavMeshTilesCache;
@@ -181,6 +186,8 @@ namespace DetourNavigator
         std::vector<std::thread> mThreads;
         std::unique_ptr<DbWorker> mDbWorker;
         std::atomic_size_t mDbGetTileHits{ 0 };
+        std::atomic_size_t mCancelledJobs{ 0 };
+        JobLatencyHistogram mJobLatencies{};
 
         void process() noexcept;
 
@@ -193,9 +200,9 @@ namespace DetourNavigator
         inline JobStatus handleUpdateNavMeshStatus(UpdateNavMeshStatus status, const Job& job,
             const GuardedNavMeshCacheItem& navMeshCacheItem, const RecastMesh& recastMesh);
 
-        JobIt getNextJob();
+        inline JobStatus cancelJob(const Job& job, GuardedNavMeshCacheItem& navMeshCacheItem);
 
-        void postThreadJob(JobIt job, std::deque<JobIt>& queue);
+        JobIt getNextJob();
 
         void writeDebugFiles(const Job& job, const RecastMesh* recastMesh) const;
 
@@ -0,0 +1,193 @@
+#include "asyncpathfinder.hpp"
+#include "findhierarchicalpath.hpp"
+#include "settings.hpp"
+#include "settingsutils.hpp"
+
+#include <DetourNavMeshQuery.h>
+
+#include <algorithm>
+#include <iterator>
+
+namespace DetourNavigator
+{
+    AsyncPathFinder::AsyncPathFinder(const Settings& settings)
+        : mSettings(settings)
+    {
+        mThreads.emplace_back([this] { run(); });
+        for (std::size_t i = 1; i < settings.mAsyncPathFinderThreads; ++i)
+            mThreads.emplace_back([this] { help(); });
+    }
+
+    AsyncPathFinder::~AsyncPathFinder()
+    {
+        stop();
+    }
+
+    PathQueryId AsyncPathFinder::post(const PathQuery& query, const SharedNavMeshCacheItem& navMesh)
+    {
+        const std::lock_guard lock(mMutex);
+        const PathQueryId id = mNextId++;
+        if (navMesh == nullptr)
+            mResults.emplace(id, Result{ PathQueryResult{ Status::NavMeshNotFound, {} }, mUpdates });
+        else
+        {
+            mPending.push_back(Request{ id, query, navMesh, PathQueryResult{} });
+            mPendingIds.insert(id);
+        }
+        return id;
+    }
+
+    void AsyncPathFinder::update()
+    {
+        {
+            const std::lock_guard lock(mMutex);
+            ++mUpdates;
+            std::erase_if(mResults, [&](const auto& v) { return mUpdates - v.second.mUpdate > maxResultAge; });
+            if (mProcessing || mPending.empty())
+                return;
+            // Group queries by navmesh to lock each one only for the chunks of its own queries
+            std::stable_sort(mPending.begin(), mPending.end(), [](const Request& lhs, const Request& rhs) {
+                return std::less<>()(lhs.mNavMesh.get(), rhs.mNavMesh.get());
+            });
+            mBatch.swap(mPending);
+            mProcessing = true;
+        }
+        mHasBatch.notify_one();
+    }
+
+    std::optional<PathQueryResult> AsyncPathFinder::take(PathQueryId id)
+    {
+        const std::lock_guard lock(mMutex);
+        const auto it = mResults.find(id);
+        if (it == mResults.end())
+            return std::nullopt;
+        PathQueryResult result = std::move(it->second.mValue);
+        mResults.erase(it);
+        return result;
+    }
+
+    bool AsyncPathFinder::isPending(PathQueryId id) const
+    {
+        const std::lock_guard lock(mMutex);
+        return mPendingIds.contains(id);
+    }
+
+    void AsyncPathFinder::stop()
+    {
+        {
+            const std::lock_guard lock(mMutex);
+            mShouldStop = true;
+        }
+        mHasBatch.notify_all();
+        mHasChunk.notify_all();
+        for (std::thread& thread : mThreads)
+            if (thread.joinable())
+                thread.join();
+    }
+
+    void AsyncPathFinder::run()
+    {
+        dtNavMeshQuery navMeshQuery;
+        while (true)
+        {
+            {
+                std::unique_lock lock(mMutex);
+                mHasBatch.wait(lock, [&] { return mShouldStop || mProcessing; });
+                if (mShouldStop)
+                    return;
+            }
+            processBatch(navMeshQuery);
+            const std::lock_guard lock(mMutex);
+            for (Request& request : mBatch)
+            {
+                mResults.emplace(request.mId, Result{ std::move(request.mResult), mUpdates });
+                mPendingIds.erase(request.mId);
+            }
+            mBatch.clear();
+            mProcessing = false;
+        }
+    }
+
+    void AsyncPathFinder::help()
+    {
+        dtNavMeshQuery navMeshQuery;
+        std::size_t generation = 0;
+        while (true)
+        {
+            const NavMeshCacheItem* navMesh = nullptr;
+            std::size_t end = 0;
+            {
+                std::unique_lock lock(mMutex);
+                mHasChunk.wait(lock,
+                    [&] { return mShouldStop || (mChunkNavMesh != nullptr && mChunkGeneration != generation); });
+                if (mShouldStop)
+                    return;
+                generation = mChunkGeneration;
+                navMesh = mChunkNavMesh;
+                end = mChunkEnd;
+                ++mActiveHelpers;
+            }
+            processChunk(navMeshQuery, *navMesh, end);
+            {
+                const std::lock_guard lock(mMutex);
+                --mActiveHelpers;
+            }
+            mChunkDone.notify_one();
+        }
+    }
+
+    void AsyncPathFinder::processBatch(dtNavMeshQuery& navMeshQuery)
+    {
+        const std::size_t chunkSize = 4 * mThreads.size();
+        for (std::size_t begin = 0; begin < mBatch.size();)
+        {
+            GuardedNavMeshCacheItem& navMesh = *mBatch[begin].mNavMesh;
+            std::size_t end = begin + 1;
+            while (end < mBatch.size() && end - begin < chunkSize && mBatch[end].mNavMesh.get() == &navMesh)
+                ++end;
+            // Navmesh is not changed while locked so all queries of the chunk use the same state
+            const auto locked = navMesh.lockConst();
+            const NavMeshCacheItem& impl = locked.get();
+            {
+                const std::lock_guard lock(mMutex);
+                if (mShouldStop)
+                    return;
+                mChunkNavMesh = &impl;
+                mChunkNext = begin;
+                mChunkEnd = end;
+                ++mChunkGeneration;
+            }
+            mHasChunk.notify_all();
+            processChunk(navMeshQuery, impl, end);
+            {
+                std::unique_lock lock(mMutex);
+                mChunkNavMesh = nullptr;
+                mChunkDone.wait(lock, [&] { return mActiveHelpers == 0; });
+            }
+            begin = end;
+        }
+    }
+
+    void AsyncPathFinder::processChunk(dtNavMeshQuery& navMeshQuery, const NavMeshCacheItem& navMesh, std::size_t end)
+    {
+        const Settings& settings = mSettings;
+        const bool initialized
+            = initNavMeshQuery(navMeshQuery, navMesh.getImpl(), settings.mDetour.mMaxNavMeshQueryNodes);
+        for (std::size_t i = mChunkNext.fetch_add(1); i < end; i = mChunkNext.fetch_add(1))
+        {
+            Request& request = mBatch[i];
+            if (!initialized)
+            {
+                request.mResult.mStatus = Status::InitNavMeshQueryFailed;
+                continue;
+            }
+            const PathQuery& query = request.mQuery;
+            request.mResult.mStatus = findHierarchicalPath(navMeshQuery, navMesh,
+                toNavMeshCoordinates(settings.mRecast, query.mAgentBounds.mHalfExtents),
+                toNavMeshCoordinates(settings.mRecast, query.mStepSize),
+                toNavMeshCoordinates(settings.mRecast, query.mStart),
+                toNavMeshCoordinates(settings.mRecast, query.mEnd), query.mIncludeFlags, query.mAreaCosts, settings,
+                query.mEndTolerance, std::back_inserter(request.mResult.mPath));
+        }
+    }
+}
@@ -0,0 +1,93 @@
+#ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_ASYNCPATHFINDER_H
+#define OPENMW_COMPONENTS_DETOURNAVIGATOR_ASYNCPATHFINDER_H
+
+#include "pathquery.hpp"
+#include "sharednavmeshcacheitem.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+class dtNavMeshQuery;
+
+namespace DetourNavigator
+{
+    struct Settings;
+    class NavMeshCacheItem;
+
+    // Solves path queries in batches on a separate thread pool. Queries posted between two update calls form a batch
+    // started by the second call, so results are available after the next update at the earliest. Queries over the
+    // same navmesh are processed in parallel in chunks, each chunk while the navmesh is locked. Results not taken
+    // during maxResultAge updates after the batch is done are discarded.
+    class AsyncPathFinder
+    {
+    public:
+        static constexpr std::size_t maxResultAge = 10;
+
+        explicit AsyncPathFinder(const Settings& settings);
+
+        ~AsyncPathFinder();
+
+        PathQueryId post(const PathQuery& query, const SharedNavMeshCacheItem& navMesh);
+
+        void update();
+
+        std::optional<PathQueryResult> take(PathQueryId id);
+
+        bool isPending(PathQueryId id) const;
+
+        void stop();
+
+    private:
+        struct Request
+        {
+            PathQueryId mId;
+            PathQuery mQuery;
+            SharedNavMeshCacheItem mNavMesh;
+            PathQueryResult mResult;
+        };
+
+        struct Result
+        {
+            PathQueryResult mValue;
+            std::size_t mUpdate;
+        };
+
+        std::reference_wrapper<const Settings> mSettings;
+        mutable std::mutex mMutex;
+        std::condition_variable mHasBatch;
+        std::condition_variable mHasChunk;
+        std::condition_variable mChunkDone;
+        PathQueryId mNextId = 1;
+        std::size_t mUpdates = 0;
+        std::vector<Request> mPending;
+        std::vector<Request> mBatch;
+        bool mProcessing = false;
+        std::map<PathQueryId, Result> mResults;
+        std::unordered_set<PathQueryId> mPendingIds;
+        const NavMeshCacheItem* mChunkNavMesh = nullptr;
+        std::size_t mChunkEnd = 0;
+        std::atomic_size_t mChunkNext{ 0 };
+        std::size_t mChunkGeneration = 0;
+        std::size_t mActiveHelpers = 0;
+        bool mShouldStop = false;
+        std::vector<std::thread> mThreads;
+
+        void run();
+
+        void help();
+
+        void processBatch(dtNavMeshQuery& navMeshQuery);
+
+        void processChunk(dtNavMeshQuery& navMeshQuery, const NavMeshCacheItem& navMesh, std::size_t end);
+    };
+}
+
+#endif
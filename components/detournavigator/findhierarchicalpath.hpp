@@ -0,0 +1,110 @@
+#ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_FINDHIERARCHICALPATH_H
+#define OPENMW_COMPONENTS_DETOURNAVIGATOR_FINDHIERARCHICALPATH_H
+
+#include "findsmoothpath.hpp"
+#include "navmeshcacheitem.hpp"
+#include "settings.hpp"
+#include "settingsutils.hpp"
+#include "status.hpp"
+#include "tilegraph.hpp"
+
+#include <DetourNavMeshQuery.h>
+
+#include <osg/Vec3f>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
+#include <vector>
+
+namespace DetourNavigator
+{
+    // When start and end are more than settings.mDetour.mMaxLocalPathTiles tiles apart plans a route over the tile
+    // graph first and then finds smooth path to the portal of every mMaxLocalPathTiles-th route edge one by one, so
+    // the cost of each local search doesn't depend on the total path length. Otherwise or if there is no route uses
+    // findSmoothPath directly. Uses navMeshQuery initialized for navMesh.
+    template <class OutputIterator>
+    Status findHierarchicalPath(const dtNavMeshQuery& navMeshQuery, const NavMeshCacheItem& navMesh,
+        const osg::Vec3f& halfExtents, const float stepSize, const osg::Vec3f& start, const osg::Vec3f& end,
+        const Flags includeFlags, const AreaCosts& areaCosts, const Settings& settings, float endTolerance,
+        OutputIterator out)
+    {
+        const std::size_t localTiles = settings.mDetour.mMaxLocalPathTiles;
+        const TilePosition startTile = getTilePosition(settings.mRecast, start);
+        const TilePosition endTile = getTilePosition(settings.mRecast, end);
+        const std::size_t tilesDistance = static_cast<std::size_t>(
+            std::max(std::abs(endTile.x() - startTile.x()), std::abs(endTile.y() - startTile.y())));
+
+        if (localTiles == 0 || tilesDistance <= localTiles)
+            return findSmoothPath(navMeshQuery, navMesh.getImpl(), halfExtents, stepSize, start, end, includeFlags,
+                areaCosts, settings, endTolerance, out);
+
+        const TileGraph& tileGraph = navMesh.getTileGraph();
+        const auto route = tileGraph.findRoute(
+            startTile, endTile, includeFlags, static_cast<std::size_t>(settings.mDetour.mMaxNavMeshQueryNodes));
+
+        if (!route.has_value())
+            return findSmoothPath(navMeshQuery, navMesh.getImpl(), halfExtents, stepSize, start, end, includeFlags,
+                areaCosts, settings, endTolerance, out);
+
+        std::vector<osg::Vec3f> segment;
+        osg::Vec3f segmentStart = start;
+        std::size_t pathSize = 0;
+
+        for (std::size_t i = 0; i + 1 < route->size();)
+        {
+            const std::size_t next = std::min(i + localTiles, route->size() - 1);
+            const bool last = next + 1 == route->size();
+            osg::Vec3f segmentEnd = end;
+            float segmentEndTolerance = endTolerance;
+
+            if (!last)
+            {
+                segmentEnd = tileGraph.findEdge((*route)[next - 1], (*route)[next])->mPortal;
+                segmentEndTolerance = 0;
+            }
+
+            segment.clear();
+            const Status status = findSmoothPath(navMeshQuery, navMesh.getImpl(), halfExtents, stepSize, segmentStart,
+                segmentEnd, includeFlags, areaCosts, settings, segmentEndTolerance, std::back_inserter(segment));
+
+            if (status != Status::Success && status != Status::PartialPath)
+                return pathSize == 0 ? status : Status::PartialPath;
+
+            // First point of the following segment repeats the last point of the previous one
+            for (auto it = segment.begin() + (pathSize == 0 || segment.empty() ? 0 : 1); it != segment.end(); ++it)
+            {
+                if (pathSize >= settings.mDetour.mMaxSmoothPathSize)
+                    return Status::Success;
+                *out++ = *it;
+                ++pathSize;
+            }
+
+            if (status == Status::PartialPath || segment.empty())
+                return Status::PartialPath;
+
+            if (last)
+                break;
+
+            segmentStart = toNavMeshCoordinates(settings.mRecast, segment.back());
+            i = next;
+        }
+
+        return Status::Success;
+    }
+
+    template <class OutputIterator>
+    Status findHierarchicalPath(const NavMeshCacheItem& navMesh, const osg::Vec3f& halfExtents, const float stepSize,
+        const osg::Vec3f& start, const osg::Vec3f& end, const Flags includeFlags, const AreaCosts& areaCosts,
+        const Settings& settings, float endTolerance, OutputIterator out)
+    {
+        dtNavMeshQuery navMeshQuery;
+        if (!initNavMeshQuery(navMeshQuery, navMesh.getImpl(), settings.mDetour.mMaxNavMeshQueryNodes))
+            return Status::InitNavMeshQueryFailed;
+
+        return findHierarchicalPath(navMeshQuery, navMesh, halfExtents, stepSize, start, end, includeFlags,
+            areaCosts, settings, endTolerance, out);
+    }
+}
+
+#endif
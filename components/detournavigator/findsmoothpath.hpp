@@ -251,15 +251,12 @@ namespace DetourNavigator
         return Status::Success;
     }
 
+    // Uses navMeshQuery initialized for navMesh, so the same query can be reused for multiple calls
     template <class OutputIterator>
-    Status findSmoothPath(const dtNavMesh& navMesh, const osg::Vec3f& halfExtents, const float stepSize,
-        const osg::Vec3f& start, const osg::Vec3f& end, const Flags includeFlags, const AreaCosts& areaCosts,
-        const Settings& settings, float endTolerance, OutputIterator out)
+    Status findSmoothPath(const dtNavMeshQuery& navMeshQuery, const dtNavMesh& navMesh, const osg::Vec3f& halfExtents,
+        const float stepSize, const osg::Vec3f& start, const osg::Vec3f& end, const Flags includeFlags,
+        const AreaCosts& areaCosts, const Settings& settings, float endTolerance, OutputIterator out)
     {
-        dtNavMeshQuery navMeshQuery;
-        if (!initNavMeshQuery(navMeshQuery, navMesh, settings.mDetour.mMaxNavMeshQueryNodes))
-            return Status::InitNavMeshQueryFailed;
-
         dtQueryFilter queryFilter;
         queryFilter.setIncludeFlags(includeFlags);
         queryFilter.setAreaCost(AreaType_water, areaCosts.mWater);
@@ -299,6 +296,19 @@ namespace DetourNavigator
 
         return partialPath ? Status::PartialPath : Status::Success;
     }
+
+    template <class OutputIterator>
+    Status findSmoothPath(const dtNavMesh& navMesh, const osg::Vec3f& halfExtents, const float stepSize,
+        const osg::Vec3f& start, const osg::Vec3f& end, const Flags includeFlags, const AreaCosts& areaCosts,
+        const Settings& settings, float endTolerance, OutputIterator out)
+    {
+        dtNavMeshQuery navMeshQuery;
+        if (!initNavMeshQuery(navMeshQuery, navMesh, settings.mDetour.mMaxNavMeshQueryNodes))
+            return Status::InitNavMeshQueryFailed;
+
+        return findSmoothPath(navMeshQuery, navMesh, halfExtents, stepSize, start, end, includeFlags, areaCosts,
+            settings, endTolerance, out);
+    }
 }
 
 #endif
@@ -8,6 +8,7 @@
 #include "offmeshconnection.hpp"
 #include "preparednavmeshdata.hpp"
 #include "recastcontext.hpp"
+#include "recastglobalallocator.hpp"
 #include "recastmesh.hpp"
 #include "recastmeshbuilder.hpp"
 #include "recastparams.hpp"
@@ -419,11 +420,12 @@ namespace DetourNavigator
             if (!erodeWalkableArea(context, params.mWalkableRadius, compact))
                 return false;
 
-            if (!buildDistanceField(context, compact))
+            if (!buildDistanceField(context, compact) || context.isCancelled())
                 return false;
 
             if (!buildRegions(
-                    context, compact, settings.mBorderSize, settings.mRegionMinArea, settings.mRegionMergeArea))
+                    context, compact, settings.mBorderSize, settings.mRegionMinArea, settings.mRegionMergeArea)
+                || context.isCancelled())
                 return false;
 
             rcContourSet contourSet;
@@ -433,12 +435,17 @@ namespace DetourNavigator
             if (contourSet.nconts == 0)
                 return false;
 
-            if (!buildPolyMesh(context, contourSet, settings.mMaxVertsPerPoly, polyMesh))
-                return false;
+            {
+                // Poly mesh is a part of the result and outlives the arena
+                const RecastGlobalAllocator::ArenaScope heapScope(false);
 
-            if (!buildPolyMeshDetail(
-                    context, polyMesh, compact, params.mSampleDist, params.mSampleMaxError, polyMeshDetail))
-                return false;
+                if (!buildPolyMesh(context, contourSet, settings.mMaxVertsPerPoly, polyMesh) || context.isCancelled())
+                    return false;
+
+                if (!buildPolyMeshDetail(
+                        context, polyMesh, compact, params.mSampleDist, params.mSampleMaxError, polyMeshDetail))
+                    return false;
+            }
 
             setPolyMeshFlags(polyMesh);
 
@@ -498,9 +505,13 @@ namespace DetourNavigator
 namespace DetourNavigator
 {
     std::unique_ptr<PreparedNavMeshData> prepareNavMeshTileData(const RecastMesh& recastMesh,
-        const TilePosition& tilePosition, const AgentBounds& agentBounds, const RecastSettings& settings)
+        const TilePosition& tilePosition, const AgentBounds& agentBounds, const RecastSettings& settings,
+        const std::atomic_bool* cancelled)
     {
-        RecastContext context(tilePosition, agentBounds);
+        // Intermediate Recast data is allocated on a thread local arena released when the function returns
+        const RecastGlobalAllocator::ArenaScope arenaScope;
+
+        RecastContext context(tilePosition, agentBounds, cancelled);
 
         const auto [minZ, maxZ] = getBoundsByZ(recastMesh, agentBounds.mHalfExtents.z(), settings);
 
@@ -512,13 +523,17 @@ namespace DetourNavigator
         const RecastParams params = makeRecastParams(settings, agentBounds);
 
         if (!rasterizeTriangles(
-                context, tilePosition, agentBounds.mHalfExtents.z(), recastMesh, settings, params, solid))
+                context, tilePosition, agentBounds.mHalfExtents.z(), recastMesh, settings, params, solid)
+            || context.isCancelled())
             return nullptr;
 
         rcFilterLowHangingWalkableObstacles(&context, params.mWalkableClimb, solid);
         rcFilterLedgeSpans(&context, params.mWalkableHeight, params.mWalkableClimb, solid);
         rcFilterWalkableLowHeightSpans(&context, params.mWalkableHeight, solid);
 
+        if (context.isCancelled())
+            return nullptr;
+
         std::unique_ptr<PreparedNavMeshData> result = std::make_unique<PreparedNavMeshData>();
 
         if (!fillPolyMesh(context, settings, params, solid, result->mPolyMesh, result->mPolyMeshDetail))
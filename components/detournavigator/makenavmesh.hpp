@@ -5,6 +5,7 @@
 #include "sharednavmesh.hpp"
 #include "tileposition.hpp"
 
+#include <atomic>
 #include <memory>
 #include <vector>
 
@@ -42,8 +43,10 @@ namespace DetourNavigator
             && recastMesh.getHeightfields().empty() && recastMesh.getFlatHeightfields().empty();
     }
 
+    // Returns nullptr when cancelled is set to true by another thread. The flag is checked between recast build steps.
     std::unique_ptr<PreparedNavMeshData> prepareNavMeshTileData(const RecastMesh& recastMesh,
-        const TilePosition& tilePosition, const AgentBounds& agentBounds, const RecastSettings& settings);
+        const TilePosition& tilePosition, const AgentBounds& agentBounds, const RecastSettings& settings,
+        const std::atomic_bool* cancelled = nullptr);
 
     NavMeshData makeNavMeshTileData(const PreparedNavMeshData& data,
         const std::vector<OffMeshConnection>& offMeshConnections, const AgentBounds& agentBounds,
@@ -2,10 +2,12 @@
 #define OPENMW_COMPONENTS_DETOURNAVIGATOR_NAVIGATOR_H
 
 #include <filesystem>
+#include <optional>
 
 #include "heightfieldshape.hpp"
 #include "objectid.hpp"
 #include "objecttransform.hpp"
+#include "pathquery.hpp"
 #include "recastmeshtiles.hpp"
 #include "sharednavmeshcacheitem.hpp"
 #include "waitconditiontype.hpp"
@@ -199,6 +201,21 @@ namespace DetourNavigator
         virtual RecastMeshTiles getRecastMeshTiles() const = 0;
 
         virtual float getMaxNavmeshAreaRealRadius() const = 0;
+
+        /**
+         * @brief postPathQuery adds path query to be processed in background. Queries posted between two update calls
+         * are processed together after the second call.
+         * @return id to get result with takePathQueryResult.
+         */
+        virtual PathQueryId postPathQuery(const PathQuery& query) = 0;
+
+        /**
+         * @brief takePathQueryResult returns result of the processed query once and removes it.
+         * Results not taken during several updates are discarded.
+         */
+        virtual std::optional<PathQueryResult> takePathQueryResult(PathQueryId id) = 0;
+
+        virtual bool isPathQueryPending(PathQueryId id) const = 0;
     };
 
     std::unique_ptr<Navigator> makeNavigator(const Settings& settings, const std::filesystem::path& userDataPath);
@@ -11,6 +11,7 @@ namespace DetourNavigator
     NavigatorImpl::NavigatorImpl(const Settings& settings, std::unique_ptr<NavMeshDb>&& db)
         : mSettings(settings)
         , mNavMeshManager(mSettings, std::move(db))
+        , mPathFinder(mSettings)
     {
     }
 
@@ -151,6 +152,7 @@ namespace DetourNavigator
     {
         removeUnusedNavMeshes();
         mNavMeshManager.update(playerPosition, getImpl(guard));
+        mPathFinder.update();
     }
 
     void NavigatorImpl::wait(WaitConditionType waitConditionType, Loading::Listener* listener)
@@ -215,4 +217,19 @@ namespace DetourNavigator
         const auto& settings = getSettings();
         return getRealTileSize(settings.mRecast) * getMaxNavmeshAreaRadius(settings);
     }
+
+    PathQueryId NavigatorImpl::postPathQuery(const PathQuery& query)
+    {
+        return mPathFinder.post(query, getNavMesh(query.mAgentBounds));
+    }
+
+    std::optional<PathQueryResult> NavigatorImpl::takePathQueryResult(PathQueryId id)
+    {
+        return mPathFinder.take(id);
+    }
+
+    bool NavigatorImpl::isPathQueryPending(PathQueryId id) const
+    {
+        return mPathFinder.isPending(id);
+    }
 }
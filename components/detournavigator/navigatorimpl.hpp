@@ -1,6 +1,7 @@
 #ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_NAVIGATORIMPL_H
 #define OPENMW_COMPONENTS_DETOURNAVIGATOR_NAVIGATORIMPL_H
 
+#include "asyncpathfinder.hpp"
 #include "navigator.hpp"
 #include "navmeshmanager.hpp"
 
@@ -74,6 +75,12 @@ namespace DetourNavigator
 
         float getMaxNavmeshAreaRealRadius() const override;
 
+        PathQueryId postPathQuery(const PathQuery& query) override;
+
+        std::optional<PathQueryResult> takePathQueryResult(PathQueryId id) override;
+
+        bool isPathQueryPending(PathQueryId id) const override;
+
     private:
         Settings mSettings;
         NavMeshManager mNavMeshManager;
@@ -81,6 +88,7 @@ namespace DetourNavigator
         std::map<AgentBounds, std::size_t> mAgents;
         std::unordered_map<ObjectId, ObjectId> mAvoidIds;
         std::unordered_map<ObjectId, ObjectId> mWaterIds;
+        AsyncPathFinder mPathFinder;
 
         inline bool addObjectImpl(
             const ObjectId id, const ObjectShapes& shapes, const btTransform& transform, const UpdateGuard* guard);
@@ -86,6 +86,15 @@ namespace DetourNavigator
 
         float getMaxNavmeshAreaRealRadius() const override { return std::numeric_limits<float>::max(); }
 
+        PathQueryId postPathQuery(const PathQuery& /*query*/) override { return 0; }
+
+        std::optional<PathQueryResult> takePathQueryResult(PathQueryId /*id*/) override
+        {
+            return PathQueryResult{ Status::NavMeshNotFound, {} };
+        }
+
+        bool isPathQueryPending(PathQueryId /*id*/) const override { return false; }
+
     private:
         Settings mDefaultSettings{};
         SharedNavMeshCacheItem mEmptyNavMeshCacheItem;
@@ -1,7 +1,7 @@
 #ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_NAVIGATORUTILS_H
 #define OPENMW_COMPONENTS_DETOURNAVIGATOR_NAVIGATORUTILS_H
 
-#include "findsmoothpath.hpp"
+#include "findhierarchicalpath.hpp"
 #include "flags.hpp"
 #include "navigator.hpp"
 #include "navmeshcacheitem.hpp"
@@ -36,7 +36,7 @@ namespace DetourNavigator
         if (navMesh == nullptr)
             return Status::NavMeshNotFound;
         const auto settings = navigator.getSettings();
-        return findSmoothPath(navMesh->lockConst()->getImpl(),
+        return findHierarchicalPath(navMesh->lockConst().get(),
             toNavMeshCoordinates(settings.mRecast, agentBounds.mHalfExtents),
             toNavMeshCoordinates(settings.mRecast, stepSize), toNavMeshCoordinates(settings.mRecast, start),
             toNavMeshCoordinates(settings.mRecast, end), includeFlags, areaCosts, settings, endTolerance, out);
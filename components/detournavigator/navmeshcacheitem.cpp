@@ -93,6 +93,7 @@ namespace DetourNavigator
                 tile->second.mData = std::move(navMeshData);
             }
             ++mVersion.mRevision;
+            mTileGraph.updateTile(*mImpl, position);
             return UpdateNavMeshStatusBuilder().added(true).removed(removed).getResult();
         }
         else
@@ -101,6 +102,7 @@ namespace DetourNavigator
             {
                 mUsedTiles.erase(position);
                 ++mVersion.mRevision;
+                mTileGraph.updateTile(*mImpl, position);
             }
             return UpdateNavMeshStatusBuilder()
                 .removed(removed)
@@ -117,6 +119,7 @@ namespace DetourNavigator
         {
             mUsedTiles.erase(position);
             ++mVersion.mRevision;
+            mTileGraph.updateTile(*mImpl, position);
         }
         return UpdateNavMeshStatusBuilder().removed(removed).getResult();
     }
@@ -129,6 +132,7 @@ namespace DetourNavigator
         {
             mUsedTiles.erase(position);
             ++mVersion.mRevision;
+            mTileGraph.updateTile(*mImpl, position);
         }
         return UpdateNavMeshStatusBuilder().removed(removed).getResult();
     }
@@ -4,6 +4,7 @@
 #include "navmeshdata.hpp"
 #include "navmeshtilescache.hpp"
 #include "sharednavmesh.hpp"
+#include "tilegraph.hpp"
 #include "tileposition.hpp"
 #include "version.hpp"
 
@@ -112,6 +113,8 @@ namespace DetourNavigator
 
         const Version& getVersion() const { return mVersion; }
 
+        const TileGraph& getTileGraph() const { return mTileGraph; }
+
         UpdateNavMeshStatus updateTile(
             const TilePosition& position, NavMeshTilesCache::Value&& cached, NavMeshData&& navMeshData);
 
@@ -141,6 +144,7 @@ namespace DetourNavigator
         Version mVersion;
         std::map<TilePosition, Tile> mUsedTiles;
         std::set<TilePosition> mEmptyTiles;
+        TileGraph mTileGraph;
     };
 }
 
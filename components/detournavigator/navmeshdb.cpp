@@ -11,6 +11,9 @@
 #include <sqlite3.h>
 
 #include <cstddef>
+#include <iterator>
+#include <limits>
+#include <string>
 #include <string_view>
 #include <vector>
 
@@ -48,6 +51,14 @@ namespace DetourNavigator
             CREATE UNIQUE INDEX IF NOT EXISTS index_unique_shapes_by_name_and_type_and_hash
                 ON shapes (name, type, hash);
 
+            CREATE TABLE IF NOT EXISTS tile_input_digests (
+                worldspace TEXT NOT NULL,
+                tile_position_x INTEGER NOT NULL,
+                tile_position_y INTEGER NOT NULL,
+                digest INTEGER NOT NULL,
+                PRIMARY KEY (worldspace, tile_position_x, tile_position_y)
+            );
+
             COMMIT;
         )";
 
@@ -128,6 +139,27 @@ namespace DetourNavigator
                    VALUES      (:shape_id, :name, :type, :hash)
         )";
 
+        constexpr std::string_view getTileInputDigestsQuery = R"(
+            SELECT tile_position_x, tile_position_y, digest
+              FROM tile_input_digests
+             WHERE worldspace = :worldspace
+        )";
+
+        constexpr std::string_view setTileInputDigestQuery = R"(
+            INSERT OR REPLACE INTO tile_input_digests ( worldspace,  tile_position_x,  tile_position_y,  digest)
+                   VALUES                             (:worldspace, :tile_position_x, :tile_position_y, :digest)
+        )";
+
+        constexpr std::string_view deleteTileInputDigestsOutsideRangeQuery = R"(
+            DELETE FROM tile_input_digests
+             WHERE worldspace = :worldspace
+               AND (   tile_position_x < :begin_tile_position_x
+                    OR tile_position_y < :begin_tile_position_y
+                    OR tile_position_x >= :end_tile_position_x
+                    OR tile_position_y >= :end_tile_position_y
+                   )
+        )";
+
         constexpr std::string_view vacuumQuery = R"(
             VACUUM;
         )";
@@ -152,6 +184,44 @@ namespace DetourNavigator
             if (const int ec = sqlite3_exec(&db, query.c_str(), nullptr, nullptr, nullptr); ec != SQLITE_OK)
                 throw std::runtime_error("Failed set max page count: " + std::string(sqlite3_errmsg(&db)));
         }
+
+        void executePragma(sqlite3& db, const std::string& query)
+        {
+            if (const int ec = sqlite3_exec(&db, query.c_str(), nullptr, nullptr, nullptr); ec != SQLITE_OK)
+                throw std::runtime_error("Failed to execute \"" + query + "\": " + std::string(sqlite3_errmsg(&db)));
+        }
+
+        std::optional<Tile> findTile(sqlite3& db, Sqlite3::Statement<DbQueries::FindTile>& statement,
+            std::string_view worldspace, const TilePosition& tilePosition, const std::vector<std::byte>& input)
+        {
+            Tile result;
+            auto row = std::tie(result.mTileId, result.mVersion);
+            const std::vector<std::byte> compressedInput = Misc::compress(input);
+            if (&row == request(db, statement, &row, 1, worldspace, tilePosition, compressedInput))
+                return {};
+            return result;
+        }
+
+        std::optional<TileData> getTileData(sqlite3& db, Sqlite3::Statement<DbQueries::GetTileData>& statement,
+            std::string_view worldspace, const TilePosition& tilePosition, const std::vector<std::byte>& input)
+        {
+            TileData result;
+            auto row = std::tie(result.mTileId, result.mVersion, result.mData);
+            const std::vector<std::byte> compressedInput = Misc::compress(input);
+            if (&row == request(db, statement, &row, 1, worldspace, tilePosition, compressedInput))
+                return {};
+            result.mData = Misc::decompress(result.mData);
+            return result;
+        }
+
+        std::optional<ShapeId> findShapeId(sqlite3& db, Sqlite3::Statement<DbQueries::FindShapeId>& statement,
+            std::string_view name, ShapeType type, const Sqlite3::ConstBlob& hash)
+        {
+            ShapeId shapeId;
+            if (&shapeId == request(db, statement, &shapeId, 1, name, type, hash))
+                return {};
+            return shapeId;
+        }
     }
 
     std::ostream& operator<<(std::ostream& stream, ShapeType value)
@@ -179,6 +249,9 @@ namespace DetourNavigator
         , mGetMaxShapeId(*mDb, DbQueries::GetMaxShapeId{})
         , mFindShapeId(*mDb, DbQueries::FindShapeId{})
         , mInsertShape(*mDb, DbQueries::InsertShape{})
+        , mGetTileInputDigests(*mDb, DbQueries::GetTileInputDigests{})
+        , mSetTileInputDigest(*mDb, DbQueries::SetTileInputDigest{})
+        , mDeleteTileInputDigestsOutsideRange(*mDb, DbQueries::DeleteTileInputDigestsOutsideRange{})
         , mVacuum(*mDb, DbQueries::Vacuum{})
     {
         const std::uint64_t dbPageSize = getPageSize(*mDb);
@@ -202,24 +275,13 @@ namespace DetourNavigator
     std::optional<Tile> NavMeshDb::findTile(
         std::string_view worldspace, const TilePosition& tilePosition, const std::vector<std::byte>& input)
     {
-        Tile result;
-        auto row = std::tie(result.mTileId, result.mVersion);
-        const std::vector<std::byte> compressedInput = Misc::compress(input);
-        if (&row == request(*mDb, mFindTile, &row, 1, worldspace, tilePosition, compressedInput))
-            return {};
-        return result;
+        return DetourNavigator::findTile(*mDb, mFindTile, worldspace, tilePosition, input);
     }
 
     std::optional<TileData> NavMeshDb::getTileData(
         std::string_view worldspace, const TilePosition& tilePosition, const std::vector<std::byte>& input)
     {
-        TileData result;
-        auto row = std::tie(result.mTileId, result.mVersion, result.mData);
-        const std::vector<std::byte> compressedInput = Misc::compress(input);
-        if (&row == request(*mDb, mGetTileData, &row, 1, worldspace, tilePosition, compressedInput))
-            return {};
-        result.mData = Misc::decompress(result.mData);
-        return result;
+        return DetourNavigator::getTileData(*mDb, mGetTileData, worldspace, tilePosition, input);
     }
 
     int NavMeshDb::insertTile(TileId tileId, std::string_view worldspace, const TilePosition& tilePosition,
@@ -261,10 +323,7 @@ namespace DetourNavigator
 
     std::optional<ShapeId> NavMeshDb::findShapeId(std::string_view name, ShapeType type, const Sqlite3::ConstBlob& hash)
     {
-        ShapeId shapeId;
-        if (&shapeId == request(*mDb, mFindShapeId, &shapeId, 1, name, type, hash))
-            return {};
-        return shapeId;
+        return DetourNavigator::findShapeId(*mDb, mFindShapeId, name, type, hash);
     }
 
     int NavMeshDb::insertShape(ShapeId shapeId, std::string_view name, ShapeType type, const Sqlite3::ConstBlob& hash)
@@ -272,11 +331,81 @@ namespace DetourNavigator
         return execute(*mDb, mInsertShape, shapeId, name, type, hash);
     }
 
+    std::vector<TileInputDigest> NavMeshDb::getTileInputDigests(std::string_view worldspace)
+    {
+        std::vector<std::tuple<int, int, std::int64_t>> rows;
+        request(*mDb, mGetTileInputDigests, std::back_inserter(rows), std::numeric_limits<std::size_t>::max(),
+            worldspace);
+        std::vector<TileInputDigest> result;
+        result.reserve(rows.size());
+        for (const auto& [x, y, digest] : rows)
+            result.push_back(TileInputDigest{ TilePosition(x, y), digest });
+        return result;
+    }
+
+    int NavMeshDb::setTileInputDigest(
+        std::string_view worldspace, const TilePosition& tilePosition, std::int64_t digest)
+    {
+        return execute(*mDb, mSetTileInputDigest, worldspace, tilePosition, digest);
+    }
+
+    int NavMeshDb::deleteTileInputDigestsOutsideRange(std::string_view worldspace, const TilesPositionsRange& range)
+    {
+        return execute(*mDb, mDeleteTileInputDigestsOutsideRange, worldspace, range);
+    }
+
     void NavMeshDb::vacuum()
     {
         execute(*mDb, mVacuum);
     }
 
+    std::string NavMeshDb::getPath() const
+    {
+        const char* const path = sqlite3_db_filename(mDb.get(), "main");
+        return path == nullptr ? std::string() : std::string(path);
+    }
+
+    void NavMeshDb::enableWriteAheadLog(int autoCheckpointPages)
+    {
+        executePragma(*mDb, "pragma journal_mode = WAL;");
+        // Durable enough with WAL, a power loss may only roll back the last transactions
+        executePragma(*mDb, "pragma synchronous = NORMAL;");
+        executePragma(*mDb, "pragma wal_autocheckpoint = " + std::to_string(autoCheckpointPages) + ";");
+    }
+
+    void NavMeshDb::disableWriteAheadLog()
+    {
+        executePragma(*mDb, "pragma wal_checkpoint(TRUNCATE);");
+        executePragma(*mDb, "pragma journal_mode = DELETE;");
+        executePragma(*mDb, "pragma synchronous = FULL;");
+    }
+
+    NavMeshDbReader::NavMeshDbReader(std::string_view path)
+        : mDb(Sqlite3::makeReadOnlyDb(path))
+        , mFindTile(*mDb, DbQueries::FindTile{})
+        , mGetTileData(*mDb, DbQueries::GetTileData{})
+        , mFindShapeId(*mDb, DbQueries::FindShapeId{})
+    {
+    }
+
+    std::optional<Tile> NavMeshDbReader::findTile(
+        std::string_view worldspace, const TilePosition& tilePosition, const std::vector<std::byte>& input)
+    {
+        return DetourNavigator::findTile(*mDb, mFindTile, worldspace, tilePosition, input);
+    }
+
+    std::optional<TileData> NavMeshDbReader::getTileData(
+        std::string_view worldspace, const TilePosition& tilePosition, const std::vector<std::byte>& input)
+    {
+        return DetourNavigator::getTileData(*mDb, mGetTileData, worldspace, tilePosition, input);
+    }
+
+    std::optional<ShapeId> NavMeshDbReader::findShapeId(
+        std::string_view name, ShapeType type, const Sqlite3::ConstBlob& hash)
+    {
+        return DetourNavigator::findShapeId(*mDb, mFindShapeId, name, type, hash);
+    }
+
     namespace DbQueries
     {
         std::string_view GetMaxTileId::text() noexcept
@@ -417,6 +546,45 @@ namespace DetourNavigator
             Sqlite3::bindParameter(db, statement, ":hash", hash);
         }
 
+        std::string_view GetTileInputDigests::text() noexcept
+        {
+            return getTileInputDigestsQuery;
+        }
+
+        void GetTileInputDigests::bind(sqlite3& db, sqlite3_stmt& statement, std::string_view worldspace)
+        {
+            Sqlite3::bindParameter(db, statement, ":worldspace", worldspace);
+        }
+
+        std::string_view SetTileInputDigest::text() noexcept
+        {
+            return setTileInputDigestQuery;
+        }
+
+        void SetTileInputDigest::bind(sqlite3& db, sqlite3_stmt& statement, std::string_view worldspace,
+            const TilePosition& tilePosition, std::int64_t digest)
+        {
+            Sqlite3::bindParameter(db, statement, ":worldspace", worldspace);
+            Sqlite3::bindParameter(db, statement, ":tile_position_x", tilePosition.x());
+            Sqlite3::bindParameter(db, statement, ":tile_position_y", tilePosition.y());
+            Sqlite3::bindParameter(db, statement, ":digest", digest);
+        }
+
+        std::string_view DeleteTileInputDigestsOutsideRange::text() noexcept
+        {
+            return deleteTileInputDigestsOutsideRangeQuery;
+        }
+
+        void DeleteTileInputDigestsOutsideRange::bind(
+            sqlite3& db, sqlite3_stmt& statement, std::string_view worldspace, const TilesPositionsRange& range)
+        {
+            Sqlite3::bindParameter(db, statement, ":worldspace", worldspace);
+            Sqlite3::bindParameter(db, statement, ":begin_tile_position_x", range.mBegin.x());
+            Sqlite3::bindParameter(db, statement, ":begin_tile_position_y", range.mBegin.y());
+            Sqlite3::bindParameter(db, statement, ":end_tile_position_x", range.mEnd.x());
+            Sqlite3::bindParameter(db, statement, ":end_tile_position_y", range.mEnd.y());
+        }
+
         std::string_view Vacuum::text() noexcept
         {
             return vacuumQuery;
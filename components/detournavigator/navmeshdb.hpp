@@ -17,6 +17,7 @@
 #include <memory>
 #include <optional>
 #include <stdexcept>
+#include <string>
 #include <string_view>
 #include <tuple>
 #include <utility>
@@ -45,6 +46,12 @@ namespace DetourNavigator
         std::vector<std::byte> mData;
     };
 
+    struct TileInputDigest
+    {
+        TilePosition mTilePosition;
+        std::int64_t mValue;
+    };
+
     enum class ShapeType
     {
         Collision = 1,
@@ -131,6 +138,26 @@ namespace DetourNavigator
                 ShapeType type, const Sqlite3::ConstBlob& hash);
         };
 
+        struct GetTileInputDigests
+        {
+            static std::string_view text() noexcept;
+            static void bind(sqlite3& db, sqlite3_stmt& statement, std::string_view worldspace);
+        };
+
+        struct SetTileInputDigest
+        {
+            static std::string_view text() noexcept;
+            static void bind(sqlite3& db, sqlite3_stmt& statement, std::string_view worldspace,
+                const TilePosition& tilePosition, std::int64_t digest);
+        };
+
+        struct DeleteTileInputDigestsOutsideRange
+        {
+            static std::string_view text() noexcept;
+            static void bind(
+                sqlite3& db, sqlite3_stmt& statement, std::string_view worldspace, const TilesPositionsRange& range);
+        };
+
         struct Vacuum
         {
             static std::string_view text() noexcept;
@@ -170,8 +197,26 @@ namespace DetourNavigator
 
         int insertShape(ShapeId shapeId, std::string_view name, ShapeType type, const Sqlite3::ConstBlob& hash);
 
+        // Digests of the content the tiles were generated from, written by navmeshtool to skip unchanged tiles.
+        std::vector<TileInputDigest> getTileInputDigests(std::string_view worldspace);
+
+        int setTileInputDigest(std::string_view worldspace, const TilePosition& tilePosition, std::int64_t digest);
+
+        int deleteTileInputDigestsOutsideRange(std::string_view worldspace, const TilesPositionsRange& range);
+
         void vacuum();
 
+        // Returns path to the database file or empty string for in-memory database.
+        std::string getPath() const;
+
+        // Switches the database to write-ahead log so NavMeshDbReader connections neither block nor are blocked by
+        // writes. The log is checkpointed into the database file after it grows by autoCheckpointPages.
+        void enableWriteAheadLog(int autoCheckpointPages);
+
+        // Checkpoints the write-ahead log and switches back to rollback journal so the database is a single file
+        // again. Other connections to the database must be closed.
+        void disableWriteAheadLog();
+
     private:
         Sqlite3::Db mDb;
         Sqlite3::Statement<DbQueries::GetMaxTileId> mGetMaxTileId;
@@ -185,8 +230,33 @@ namespace DetourNavigator
         Sqlite3::Statement<DbQueries::GetMaxShapeId> mGetMaxShapeId;
         Sqlite3::Statement<DbQueries::FindShapeId> mFindShapeId;
         Sqlite3::Statement<DbQueries::InsertShape> mInsertShape;
+        Sqlite3::Statement<DbQueries::GetTileInputDigests> mGetTileInputDigests;
+        Sqlite3::Statement<DbQueries::SetTileInputDigest> mSetTileInputDigest;
+        Sqlite3::Statement<DbQueries::DeleteTileInputDigestsOutsideRange> mDeleteTileInputDigestsOutsideRange;
         Sqlite3::Statement<DbQueries::Vacuum> mVacuum;
     };
+
+    // Read-only connection to an existing database. Doesn't see uncommitted changes of NavMeshDb. Each thread
+    // should use own reader.
+    class NavMeshDbReader
+    {
+    public:
+        explicit NavMeshDbReader(std::string_view path);
+
+        std::optional<Tile> findTile(
+            std::string_view worldspace, const TilePosition& tilePosition, const std::vector<std::byte>& input);
+
+        std::optional<TileData> getTileData(
+            std::string_view worldspace, const TilePosition& tilePosition, const std::vector<std::byte>& input);
+
+        std::optional<ShapeId> findShapeId(std::string_view name, ShapeType type, const Sqlite3::ConstBlob& hash);
+
+    private:
+        Sqlite3::Db mDb;
+        Sqlite3::Statement<DbQueries::FindTile> mFindTile;
+        Sqlite3::Statement<DbQueries::GetTileData> mGetTileData;
+        Sqlite3::Statement<DbQueries::FindShapeId> mFindShapeId;
+    };
 }
 
 #endif
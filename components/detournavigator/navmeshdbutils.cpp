@@ -33,36 +33,41 @@ namespace DetourNavigator
         }
     }
 
-    ShapeId resolveMeshSource(NavMeshDb& db, const MeshSource& source, ShapeId& nextShapeId)
+    std::optional<ShapeType> getShapeType(AreaType areaType)
     {
-        switch (source.mAreaType)
+        switch (areaType)
         {
             case AreaType_null:
-                return getShapeId(
-                    db, source.mShape->mFileName, ShapeType::Avoid, source.mShape->mFileHash, nextShapeId);
+                return ShapeType::Avoid;
             case AreaType_ground:
-                return getShapeId(
-                    db, source.mShape->mFileName, ShapeType::Collision, source.mShape->mFileHash, nextShapeId);
+                return ShapeType::Collision;
             default:
-                Log(Debug::Warning) << "Trying to resolve recast mesh source with unsupported area type: "
-                                    << source.mAreaType;
-                assert(false);
-                return ShapeId(0);
+                return std::nullopt;
+        }
+    }
+
+    ShapeId resolveMeshSource(NavMeshDb& db, const MeshSource& source, ShapeId& nextShapeId)
+    {
+        const std::optional<ShapeType> type = getShapeType(source.mAreaType);
+        if (!type.has_value())
+        {
+            Log(Debug::Warning) << "Trying to resolve recast mesh source with unsupported area type: "
+                                << source.mAreaType;
+            assert(false);
+            return ShapeId(0);
         }
+        return getShapeId(db, source.mShape->mFileName, *type, source.mShape->mFileHash, nextShapeId);
     }
 
     std::optional<ShapeId> resolveMeshSource(NavMeshDb& db, const MeshSource& source)
     {
-        switch (source.mAreaType)
+        const std::optional<ShapeType> type = getShapeType(source.mAreaType);
+        if (!type.has_value())
         {
-            case AreaType_null:
-                return findShapeId(db, source.mShape->mFileName, ShapeType::Avoid, source.mShape->mFileHash);
-            case AreaType_ground:
-                return findShapeId(db, source.mShape->mFileName, ShapeType::Collision, source.mShape->mFileHash);
-            default:
-                Log(Debug::Warning) << "Trying to resolve recast mesh source with unsupported area type: "
-                                    << source.mAreaType;
-                return std::nullopt;
+            Log(Debug::Warning) << "Trying to resolve recast mesh source with unsupported area type: "
+                                << source.mAreaType;
+            return std::nullopt;
         }
+        return findShapeId(db, source.mShape->mFileName, *type, source.mShape->mFileHash);
     }
 }
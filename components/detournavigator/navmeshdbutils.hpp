@@ -1,6 +1,7 @@
 #ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_NAVMESHDBUTILS_H
 #define OPENMW_COMPONENTS_DETOURNAVIGATOR_NAVMESHDBUTILS_H
 
+#include "areatype.hpp"
 #include "navmeshdb.hpp"
 
 #include <optional>
@@ -9,6 +10,9 @@ namespace DetourNavigator
 {
     struct MeshSource;
 
+    // Returns type of the shape stored in the database for the mesh source area type if there is any.
+    std::optional<ShapeType> getShapeType(AreaType areaType);
+
     ShapeId resolveMeshSource(NavMeshDb& db, const MeshSource& source, ShapeId& nextShapeId);
 
     std::optional<ShapeId> resolveMeshSource(NavMeshDb& db, const MeshSource& source);
@@ -0,0 +1,142 @@
+#include "navmeshdbwriter.hpp"
+
+#include <components/debug/debuglog.hpp>
+#include <components/sqlite3/transaction.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+namespace DetourNavigator
+{
+    NavMeshDbWriter::NavMeshDbWriter(NavMeshDb&& db, std::size_t maxBatchSize,
+        std::chrono::steady_clock::duration maxBatchDelay, ErrorHandler onError)
+        : mDb(std::move(db))
+        , mMaxBatchSize(std::max<std::size_t>(maxBatchSize, 1))
+        , mMaxBatchDelay(maxBatchDelay)
+        , mOnError(std::move(onError))
+        , mThread([this] { run(); })
+    {
+    }
+
+    NavMeshDbWriter::~NavMeshDbWriter()
+    {
+        stop();
+    }
+
+    void NavMeshDbWriter::enqueue(Operation&& operation)
+    {
+        std::unique_lock lock(mMutex);
+        // Keep up to 2 batches in the queue so producers don't wait while the previous batch is written
+        mHasSpace.wait(lock, [&] { return mQueue.size() < 2 * mMaxBatchSize || mShouldStop; });
+        if (mShouldStop)
+            throw std::logic_error("NavMeshDbWriter is stopped");
+        if (mDiscarded)
+            return;
+        if (mQueue.empty())
+            mBatchStart = std::chrono::steady_clock::now();
+        mQueue.push_back(std::move(operation));
+        ++mEnqueued;
+        if (mQueue.size() == 1 || mQueue.size() == mMaxBatchSize)
+            mHasOperations.notify_one();
+    }
+
+    void NavMeshDbWriter::flush()
+    {
+        std::unique_lock lock(mMutex);
+        const std::size_t enqueued = mEnqueued;
+        ++mFlushing;
+        mHasOperations.notify_one();
+        mProcessed.wait(lock, [&] { return mProcessedCount >= enqueued; });
+        --mFlushing;
+    }
+
+    void NavMeshDbWriter::discard()
+    {
+        {
+            const std::lock_guard lock(mMutex);
+            mDiscarded = true;
+            mProcessedCount += mQueue.size();
+            mQueue.clear();
+        }
+        mHasSpace.notify_all();
+        mProcessed.notify_all();
+    }
+
+    void NavMeshDbWriter::stop()
+    {
+        {
+            const std::lock_guard lock(mMutex);
+            mShouldStop = true;
+        }
+        mHasOperations.notify_one();
+        mHasSpace.notify_all();
+        if (mThread.joinable())
+            mThread.join();
+    }
+
+    std::size_t NavMeshDbWriter::getTransactionsCount() const
+    {
+        const std::lock_guard lock(mMutex);
+        return mTransactions;
+    }
+
+    void NavMeshDbWriter::run() noexcept
+    {
+        std::vector<Operation> batch;
+        while (true)
+        {
+            {
+                std::unique_lock lock(mMutex);
+                while (!mShouldStop && (mQueue.empty() || (mFlushing == 0 && mQueue.size() < mMaxBatchSize)))
+                {
+                    if (mQueue.empty())
+                        mHasOperations.wait(lock);
+                    else if (mHasOperations.wait_until(lock, mBatchStart + mMaxBatchDelay) == std::cv_status::timeout)
+                        break;
+                }
+                if (mQueue.empty())
+                    return;
+                // The queue may hold up to 2 batches, commit no more than one per transaction. The rest keeps the
+                // batch start of the taken operations, so it's committed no later than maxBatchDelay after enqueue.
+                const auto end = mQueue.begin() + static_cast<std::ptrdiff_t>(std::min(mQueue.size(), mMaxBatchSize));
+                batch.assign(std::make_move_iterator(mQueue.begin()), std::make_move_iterator(end));
+                mQueue.erase(mQueue.begin(), end);
+            }
+            mHasSpace.notify_all();
+
+            process(batch);
+
+            {
+                const std::lock_guard lock(mMutex);
+                mProcessedCount += batch.size();
+            }
+            mProcessed.notify_all();
+            batch.clear();
+        }
+    }
+
+    void NavMeshDbWriter::process(std::vector<Operation>& batch) noexcept
+    {
+        if (mFailed)
+            return;
+        try
+        {
+            Sqlite3::Transaction transaction = mDb.startTransaction(Sqlite3::TransactionMode::Immediate);
+            for (Operation& operation : batch)
+                operation(mDb);
+            transaction.commit();
+            const std::lock_guard lock(mMutex);
+            ++mTransactions;
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Error) << "Failed to write " << batch.size() << " operations to navmeshdb: " << e.what();
+            mFailed = true;
+            if (mOnError)
+                mOnError(e);
+        }
+    }
+}
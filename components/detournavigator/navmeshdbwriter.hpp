@@ -0,0 +1,76 @@
+#ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_NAVMESHDBWRITER_H
+#define OPENMW_COMPONENTS_DETOURNAVIGATOR_NAVMESHDBWRITER_H
+
+#include "navmeshdb.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace DetourNavigator
+{
+    // Executes operations over NavMeshDb on a dedicated thread in the order they are enqueued. Operations are grouped
+    // into transactions of maxBatchSize operations, a smaller batch is committed after maxBatchDelay since its first
+    // operation is enqueued. When an operation fails the transaction is rolled back, onError is called and all further
+    // operations are discarded.
+    class NavMeshDbWriter
+    {
+    public:
+        using Operation = std::function<void(NavMeshDb&)>;
+        using ErrorHandler = std::function<void(const std::exception&)>;
+
+        explicit NavMeshDbWriter(NavMeshDb&& db, std::size_t maxBatchSize,
+            std::chrono::steady_clock::duration maxBatchDelay, ErrorHandler onError);
+
+        ~NavMeshDbWriter();
+
+        // Blocks while there are too many queued operations to limit memory usage. Throws after stop.
+        void enqueue(Operation&& operation);
+
+        // Waits until all enqueued operations are committed or discarded.
+        void flush();
+
+        // Drops queued operations and all operations enqueued later. A batch that is already being written is
+        // still committed.
+        void discard();
+
+        // Flushes the queue and stops the thread. After that the database can be used directly.
+        void stop();
+
+        NavMeshDb& getDb() { return mDb; }
+
+        std::size_t getTransactionsCount() const;
+
+    private:
+        NavMeshDb mDb;
+        const std::size_t mMaxBatchSize;
+        const std::chrono::steady_clock::duration mMaxBatchDelay;
+        const ErrorHandler mOnError;
+        mutable std::mutex mMutex;
+        std::condition_variable mHasOperations;
+        std::condition_variable mHasSpace;
+        std::condition_variable mProcessed;
+        std::deque<Operation> mQueue;
+        std::chrono::steady_clock::time_point mBatchStart;
+        std::size_t mEnqueued = 0;
+        std::size_t mProcessedCount = 0;
+        std::size_t mTransactions = 0;
+        std::size_t mFlushing = 0;
+        bool mShouldStop = false;
+        bool mDiscarded = false;
+        bool mFailed = false;
+        std::thread mThread;
+
+        inline void run() noexcept;
+
+        inline void process(std::vector<Operation>& batch) noexcept;
+    };
+}
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_PATHQUERY_H
+#define OPENMW_COMPONENTS_DETOURNAVIGATOR_PATHQUERY_H
+
+#include "agentbounds.hpp"
+#include "areatype.hpp"
+#include "flags.hpp"
+#include "status.hpp"
+
+#include <osg/Vec3f>
+
+#include <cstdint>
+#include <vector>
+
+namespace DetourNavigator
+{
+    using PathQueryId = std::uint64_t;
+
+    // Arguments of findPath from navigatorutils.hpp
+    struct PathQuery
+    {
+        AgentBounds mAgentBounds;
+        float mStepSize = 0;
+        osg::Vec3f mStart;
+        osg::Vec3f mEnd;
+        Flags mIncludeFlags = Flag_none;
+        AreaCosts mAreaCosts;
+        float mEndTolerance = 0;
+    };
+
+    struct PathQueryResult
+    {
+        Status mStatus = Status::Success;
+        std::vector<osg::Vec3f> mPath;
+    };
+}
+
+#endif
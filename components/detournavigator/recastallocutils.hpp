@@ -14,6 +14,7 @@ namespace DetourNavigator
         BufferType_perm,
         BufferType_temp,
         BufferType_unused,
+        BufferType_arena,
     };
 
     inline BufferType* tempPtrBufferType(void* ptr)
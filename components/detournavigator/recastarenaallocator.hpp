@@ -0,0 +1,96 @@
+#ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_RECASTARENAALLOCATOR_H
+#define OPENMW_COMPONENTS_DETOURNAVIGATOR_RECASTARENAALLOCATOR_H
+
+#include "recastallocutils.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <memory>
+#include <vector>
+
+namespace DetourNavigator
+{
+    // Allocates memory sequentially from a list of blocks. Free is no-op, all memory is released at once by reset.
+    // Blocks are kept between resets for reuse while their total size is within the limit.
+    class RecastArenaAllocator
+    {
+    public:
+        explicit RecastArenaAllocator(std::size_t blockSize)
+            : mBlockSize(blockSize)
+        {
+        }
+
+        // Returns nullptr when allocation would make total size of blocks exceed maxSize.
+        void* alloc(std::size_t size, std::size_t maxSize)
+        {
+            const std::size_t itemSize = alignSize(sizeof(std::size_t) + size);
+            std::size_t block = mCurrent;
+            std::size_t used = mUsed;
+            while (block < mBlocks.size() && mBlocks[block].mSize - used < itemSize)
+            {
+                ++block;
+                used = 0;
+            }
+            if (block == mBlocks.size())
+            {
+                const std::size_t blockSize = std::max(mBlockSize, itemSize);
+                if (rcUnlikely(mReservedSize + blockSize > maxSize))
+                    return nullptr;
+                mBlocks.push_back(Block{ std::unique_ptr<char[]>(new char[blockSize]), blockSize });
+                mReservedSize += blockSize;
+            }
+            void* const ptr = mBlocks[block].mData.get() + used;
+            mCurrent = block;
+            mUsed = used + itemSize;
+            mAllocatedSize += itemSize;
+            mHighWaterMark = std::max(mHighWaterMark, mAllocatedSize);
+            setPermPtrBufferType(ptr, BufferType_arena);
+            return getPermPtrDataPtr(ptr);
+        }
+
+        void free(void* ptr)
+        {
+            assert(ptr == nullptr || BufferType_arena == getDataPtrBufferType(ptr));
+            static_cast<void>(ptr);
+        }
+
+        // Invalidates all allocated memory and releases the most recently allocated blocks over maxSize.
+        void reset(std::size_t maxSize)
+        {
+            while (!mBlocks.empty() && mReservedSize > maxSize)
+            {
+                mReservedSize -= mBlocks.back().mSize;
+                mBlocks.pop_back();
+            }
+            mCurrent = 0;
+            mUsed = 0;
+            mAllocatedSize = 0;
+        }
+
+        std::size_t getReservedSize() const { return mReservedSize; }
+
+        std::size_t getHighWaterMark() const { return mHighWaterMark; }
+
+    private:
+        struct Block
+        {
+            std::unique_ptr<char[]> mData;
+            std::size_t mSize;
+        };
+
+        const std::size_t mBlockSize;
+        std::vector<Block> mBlocks;
+        std::size_t mCurrent = 0;
+        std::size_t mUsed = 0;
+        std::size_t mReservedSize = 0;
+        std::size_t mAllocatedSize = 0;
+        std::size_t mHighWaterMark = 0;
+
+        static std::size_t alignSize(std::size_t size)
+        {
+            return (size + sizeof(std::size_t) - 1) / sizeof(std::size_t) * sizeof(std::size_t);
+        }
+    };
+}
+
+#endif
@@ -32,8 +32,10 @@ namespace DetourNavigator
         }
     }
 
-    RecastContext::RecastContext(const TilePosition& tilePosition, const AgentBounds& agentBounds)
+    RecastContext::RecastContext(
+        const TilePosition& tilePosition, const AgentBounds& agentBounds, const std::atomic_bool* cancelled)
         : mPrefix(formatPrefix(tilePosition, agentBounds))
+        , mCancelled(cancelled)
     {
     }
 
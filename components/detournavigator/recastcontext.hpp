@@ -3,6 +3,7 @@
 
 #include "tileposition.hpp"
 
+#include <atomic>
 #include <string>
 
 #include <Recast.h>
@@ -14,12 +15,16 @@ namespace DetourNavigator
     class RecastContext final : public rcContext
     {
     public:
-        explicit RecastContext(const TilePosition& tilePosition, const AgentBounds& agentBounds);
+        explicit RecastContext(const TilePosition& tilePosition, const AgentBounds& agentBounds,
+            const std::atomic_bool* cancelled = nullptr);
 
         const std::string& getPrefix() const { return mPrefix; }
 
+        bool isCancelled() const { return mCancelled != nullptr && mCancelled->load(std::memory_order_relaxed); }
+
     private:
         std::string mPrefix;
+        const std::atomic_bool* mCancelled;
 
         void doLog(rcLogCategory category, const char* msg, int len) override;
     };
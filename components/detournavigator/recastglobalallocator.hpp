@@ -1,8 +1,10 @@
 #ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_RECASTGLOBALALLOCATOR_H
 #define OPENMW_COMPONENTS_DETOURNAVIGATOR_RECASTGLOBALALLOCATOR_H
 
+#include "recastarenaallocator.hpp"
 #include "recasttempallocator.hpp"
 
+#include <atomic>
 #include <cstdlib>
 
 namespace DetourNavigator
@@ -10,13 +12,49 @@ namespace DetourNavigator
     class RecastGlobalAllocator
     {
     public:
+        // Makes permanent allocations on the current thread use a thread local arena while the object exists.
+        // Arena memory is released when the outermost enabled scope ends, so allocated data must not outlive it.
+        // Scope with enabled = false suspends outer scope to allocate data that leaves it.
+        class ArenaScope
+        {
+        public:
+            explicit ArenaScope(bool enabled = true)
+                : mPrevEnabled(arenaEnabled())
+            {
+                arenaEnabled() = enabled;
+                if (enabled && !mPrevEnabled)
+                    arenaAllocator().reset(sArenaMaxSize.load(std::memory_order_relaxed));
+            }
+
+            ~ArenaScope()
+            {
+                const bool outermost = arenaEnabled() && !mPrevEnabled;
+                arenaEnabled() = mPrevEnabled;
+                if (outermost)
+                    arenaAllocator().reset(sArenaMaxSize.load(std::memory_order_relaxed));
+            }
+
+            ArenaScope(const ArenaScope&) = delete;
+
+            ArenaScope& operator=(const ArenaScope&) = delete;
+
+        private:
+            const bool mPrevEnabled;
+        };
+
         static void init() { instance(); }
 
+        // Limits memory kept by each thread local arena. Allocations over the limit fall back to the heap, 0 disables
+        // the arena. Takes effect for a thread when it enters the next outermost scope.
+        static void setArenaMaxSize(std::size_t value) { sArenaMaxSize.store(value, std::memory_order_relaxed); }
+
         static void* alloc(size_t size, rcAllocHint hint)
         {
             void* result = nullptr;
             if (rcLikely(hint == RC_ALLOC_TEMP))
                 result = tempAllocator().alloc(size);
+            else if (arenaEnabled())
+                result = arenaAllocator().alloc(size, sArenaMaxSize.load(std::memory_order_relaxed));
             if (rcUnlikely(!result))
                 result = allocPerm(size);
             return result;
@@ -26,16 +64,24 @@ namespace DetourNavigator
         {
             if (rcUnlikely(!ptr))
                 return;
-            if (rcLikely(BufferType_temp == getDataPtrBufferType(ptr)))
-                tempAllocator().free(ptr);
-            else
+            switch (getDataPtrBufferType(ptr))
             {
-                assert(BufferType_perm == getDataPtrBufferType(ptr));
-                std::free(getPermDataPtrHeapPtr(ptr));
+                case BufferType_temp:
+                    tempAllocator().free(ptr);
+                    break;
+                case BufferType_arena:
+                    arenaAllocator().free(ptr);
+                    break;
+                default:
+                    assert(BufferType_perm == getDataPtrBufferType(ptr));
+                    std::free(getPermDataPtrHeapPtr(ptr));
+                    break;
             }
         }
 
     private:
+        static inline std::atomic_size_t sArenaMaxSize{ 64ul * 1024ul * 1024ul };
+
         RecastGlobalAllocator() { rcAllocSetCustom(&RecastGlobalAllocator::alloc, &RecastGlobalAllocator::free); }
 
         static RecastGlobalAllocator& instance()
@@ -50,6 +96,18 @@ namespace DetourNavigator
             return value;
         }
 
+        static RecastArenaAllocator& arenaAllocator()
+        {
+            static thread_local RecastArenaAllocator value(1024ul * 1024ul);
+            return value;
+        }
+
+        static bool& arenaEnabled()
+        {
+            static thread_local bool value = false;
+            return value;
+        }
+
         static void* allocPerm(size_t size)
         {
             const auto ptr = std::malloc(size + sizeof(std::size_t));
@@ -45,6 +45,7 @@ namespace DetourNavigator
             = std::clamp(::Settings::Manager::getInt("max polygons per tile", "Navigator"), 1, (1 << 22) - 1);
         result.mMaxPolygonPathSize = ::Settings::Manager::getSize("max polygon path size", "Navigator");
         result.mMaxSmoothPathSize = ::Settings::Manager::getSize("max smooth path size", "Navigator");
+        result.mMaxLocalPathTiles = ::Settings::Manager::getSize("max local path tiles", "Navigator");
 
         return result;
     }
@@ -60,6 +61,8 @@ namespace DetourNavigator
             = ::Settings::Manager::getInt("wait until min distance to player", "Navigator");
         result.mAsyncNavMeshUpdaterThreads
             = ::Settings::Manager::getSize("async nav mesh updater threads", "Navigator");
+        result.mAsyncPathFinderThreads
+            = std::max<std::size_t>(1, ::Settings::Manager::getSize("async path finder threads", "Navigator"));
         result.mMaxNavMeshTilesCacheSize = ::Settings::Manager::getSize("max nav mesh tiles cache size", "Navigator");
         result.mEnableWriteRecastMeshToFile
             = ::Settings::Manager::getBool("enable write recast mesh to file", "Navigator");
@@ -2,16 +2,32 @@
 
 #include <osg/Stats>
 
+#include <string>
+
 namespace DetourNavigator
 {
     namespace
     {
+        std::array<std::string, std::tuple_size_v<JobLatencyHistogram>> makeJobLatencyNames()
+        {
+            std::array<std::string, std::tuple_size_v<JobLatencyHistogram>> result;
+            for (std::size_t i = 0; i < jobLatencyBucketBounds.size(); ++i)
+                result[i] = "NavMesh Latency <=" + std::to_string(jobLatencyBucketBounds[i].count()) + "ms";
+            result.back() = "NavMesh Latency >" + std::to_string(jobLatencyBucketBounds.back().count()) + "ms";
+            return result;
+        }
+
         void reportStats(const AsyncNavMeshUpdaterStats& stats, unsigned int frameNumber, osg::Stats& out)
         {
             out.setAttribute(frameNumber, "NavMesh Jobs", static_cast<double>(stats.mJobs));
             out.setAttribute(frameNumber, "NavMesh Waiting", static_cast<double>(stats.mWaiting));
             out.setAttribute(frameNumber, "NavMesh Pushed", static_cast<double>(stats.mPushed));
             out.setAttribute(frameNumber, "NavMesh Processing", static_cast<double>(stats.mProcessing));
+            out.setAttribute(frameNumber, "NavMesh Cancelled", static_cast<double>(stats.mCancelled));
+
+            const auto& latencyNames = getJobLatencyStatNames();
+            for (std::size_t i = 0; i < stats.mJobLatencies.size(); ++i)
+                out.setAttribute(frameNumber, latencyNames[i], static_cast<double>(stats.mJobLatencies[i]));
 
             if (stats.mDb.has_value())
             {
@@ -35,6 +51,12 @@ namespace DetourNavigator
         }
     }
 
+    const std::array<std::string, std::tuple_size_v<JobLatencyHistogram>>& getJobLatencyStatNames()
+    {
+        static const std::array<std::string, std::tuple_size_v<JobLatencyHistogram>> names = makeJobLatencyNames();
+        return names;
+    }
+
     void reportStats(const Stats& stats, unsigned int frameNumber, osg::Stats& out)
     {
         if (stats.mUpdater.has_value())
@@ -1,8 +1,11 @@
 #ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_STATS_H
 #define OPENMW_COMPONENTS_DETOURNAVIGATOR_STATS_H
 
+#include <array>
+#include <chrono>
 #include <cstddef>
 #include <optional>
+#include <string>
 
 namespace osg
 {
@@ -32,13 +35,34 @@ namespace DetourNavigator
         std::size_t mGetCount = 0;
     };
 
+    // Upper bounds of the job latency histogram buckets, the last bucket counts all longer latencies
+    inline constexpr std::array<std::chrono::milliseconds, 12> jobLatencyBucketBounds{
+        std::chrono::milliseconds(1),
+        std::chrono::milliseconds(2),
+        std::chrono::milliseconds(5),
+        std::chrono::milliseconds(10),
+        std::chrono::milliseconds(20),
+        std::chrono::milliseconds(50),
+        std::chrono::milliseconds(100),
+        std::chrono::milliseconds(200),
+        std::chrono::milliseconds(500),
+        std::chrono::milliseconds(1000),
+        std::chrono::milliseconds(2000),
+        std::chrono::milliseconds(5000),
+    };
+
+    using JobLatencyHistogram = std::array<std::size_t, jobLatencyBucketBounds.size() + 1>;
+
     struct AsyncNavMeshUpdaterStats
     {
         std::size_t mJobs = 0;
         std::size_t mWaiting = 0;
         std::size_t mPushed = 0;
         std::size_t mProcessing = 0;
+        std::size_t mCancelled = 0;
         std::size_t mDbGetTileHits = 0;
+        // Number of tiles by time from post to the tile being added to the navmesh
+        JobLatencyHistogram mJobLatencies{};
         std::optional<DbWorkerStats> mDb;
         NavMeshTilesCacheStats mCache;
     };
@@ -48,6 +72,9 @@ namespace DetourNavigator
         std::optional<AsyncNavMeshUpdaterStats> mUpdater;
     };
 
+    // Names of the stats attributes holding job latency histogram buckets
+    const std::array<std::string, std::tuple_size_v<JobLatencyHistogram>>& getJobLatencyStatNames();
+
     void reportStats(const Stats& stats, unsigned int frameNumber, osg::Stats& out);
 }
 
@@ -0,0 +1,201 @@
+#include "tilegraph.hpp"
+
+#include <DetourNavMesh.h>
+
+#include <osg/Vec2f>
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <queue>
+
+namespace DetourNavigator
+{
+    namespace
+    {
+        constexpr unsigned includeFlagsCount = 16;
+
+        static_assert(Flag_usePathgrid < includeFlagsCount);
+
+        std::uint16_t getPassable(Flags sourceFlags, Flags targetFlags)
+        {
+            std::uint16_t result = 0;
+            for (unsigned includeFlags = 1; includeFlags < includeFlagsCount; ++includeFlags)
+                if ((sourceFlags & includeFlags) != 0 && (targetFlags & includeFlags) != 0)
+                    result |= static_cast<std::uint16_t>(1 << includeFlags);
+            return result;
+        }
+
+        bool isPassable(const TileGraph::Edge& edge, Flags includeFlags)
+        {
+            return ((edge.mPassable >> (includeFlags & (includeFlagsCount - 1))) & 1) != 0;
+        }
+
+        osg::Vec2f getCenter(const dtMeshTile& tile)
+        {
+            return osg::Vec2f(tile.header->bmin[0] + tile.header->bmax[0], tile.header->bmin[2] + tile.header->bmax[2])
+                / 2;
+        }
+
+        osg::Vec3f getPortal(const dtMeshTile& tile, const dtPoly& poly, const dtLink& link)
+        {
+            const float* const a = tile.verts + poly.verts[link.edge] * 3;
+            const float* const b = tile.verts + poly.verts[(link.edge + 1) % poly.vertCount] * 3;
+            // Links to other tiles may cover only part of the edge
+            const float t = (static_cast<float>(link.bmin) + static_cast<float>(link.bmax)) / (2 * 255.0f);
+            return osg::Vec3f(a[0], a[1], a[2]) * (1 - t) + osg::Vec3f(b[0], b[1], b[2]) * t;
+        }
+
+        float getDistance(const TilePosition& lhs, const TilePosition& rhs)
+        {
+            return osg::Vec2f(static_cast<float>(lhs.x() - rhs.x()), static_cast<float>(lhs.y() - rhs.y())).length();
+        }
+    }
+
+    void TileGraph::updateTile(const dtNavMesh& navMesh, const TilePosition& position)
+    {
+        // Detour links polygons of all 8 neighbours
+        for (int x = -1; x <= 1; ++x)
+            for (int y = -1; y <= 1; ++y)
+                updateEdges(navMesh, position + TilePosition(x, y));
+    }
+
+    std::optional<std::vector<TilePosition>> TileGraph::findRoute(
+        const TilePosition& start, const TilePosition& end, Flags includeFlags, std::size_t maxNodes) const
+    {
+        struct Node
+        {
+            float mCost;
+            TilePosition mParent;
+        };
+
+        using Candidate = std::pair<float, TilePosition>;
+
+        if (!mEdges.contains(start))
+            return std::nullopt;
+
+        const auto greater = [](const Candidate& lhs, const Candidate& rhs) { return lhs.first > rhs.first; };
+        std::priority_queue<Candidate, std::vector<Candidate>, decltype(greater)> open(greater);
+        std::map<TilePosition, Node> nodes;
+        nodes.emplace(start, Node{ 0, start });
+        open.emplace(getDistance(start, end), start);
+        std::size_t visited = 0;
+
+        while (!open.empty())
+        {
+            const auto [estimate, position] = open.top();
+            open.pop();
+            const Node& node = nodes.find(position)->second;
+            if (estimate > node.mCost + getDistance(position, end))
+                continue;
+            if (position == end)
+                break;
+            if (++visited > maxNodes)
+                return std::nullopt;
+            const auto edges = mEdges.find(position);
+            if (edges == mEdges.end())
+                continue;
+            const float cost = node.mCost;
+            for (const Edge& edge : edges->second)
+            {
+                if (!isPassable(edge, includeFlags))
+                    continue;
+                const float targetCost = cost + getDistance(position, edge.mTarget);
+                const auto [target, inserted] = nodes.emplace(edge.mTarget, Node{ targetCost, position });
+                if (!inserted)
+                {
+                    if (target->second.mCost <= targetCost)
+                        continue;
+                    target->second = Node{ targetCost, position };
+                }
+                open.emplace(targetCost + getDistance(edge.mTarget, end), edge.mTarget);
+            }
+        }
+
+        if (!nodes.contains(end))
+            return std::nullopt;
+
+        std::vector<TilePosition> result;
+        for (TilePosition position = end; position != start; position = nodes.find(position)->second.mParent)
+            result.push_back(position);
+        result.push_back(start);
+        std::reverse(result.begin(), result.end());
+        return result;
+    }
+
+    const TileGraph::Edge* TileGraph::findEdge(const TilePosition& source, const TilePosition& target) const
+    {
+        const auto edges = mEdges.find(source);
+        if (edges == mEdges.end())
+            return nullptr;
+        const auto edge = std::find_if(edges->second.begin(), edges->second.end(),
+            [&](const Edge& v) { return v.mTarget == target; });
+        if (edge == edges->second.end())
+            return nullptr;
+        return &*edge;
+    }
+
+    std::size_t TileGraph::getEdgesCount() const
+    {
+        std::size_t result = 0;
+        for (const auto& [position, edges] : mEdges)
+            result += edges.size();
+        return result;
+    }
+
+    void TileGraph::updateEdges(const dtNavMesh& navMesh, const TilePosition& position)
+    {
+        const int layer = 0;
+        const dtMeshTile* const tile = navMesh.getTileAt(position.x(), position.y(), layer);
+        if (tile == nullptr || tile->header == nullptr)
+        {
+            mEdges.erase(position);
+            return;
+        }
+
+        std::vector<Edge> edges;
+        // Portal closest to the middle of the border between tiles is the most stable choice among rebuilds
+        std::vector<float> portalDistances;
+        const osg::Vec2f center = getCenter(*tile);
+
+        for (int i = 0; i < tile->header->polyCount; ++i)
+        {
+            const dtPoly& poly = tile->polys[i];
+            if (poly.getType() != DT_POLYTYPE_GROUND)
+                continue;
+            for (unsigned linkIndex = poly.firstLink; linkIndex != DT_NULL_LINK;
+                 linkIndex = tile->links[linkIndex].next)
+            {
+                const dtLink& link = tile->links[linkIndex];
+                if (link.side == 0xff)
+                    continue;
+                const dtMeshTile* targetTile = nullptr;
+                const dtPoly* targetPoly = nullptr;
+                navMesh.getTileAndPolyByRefUnsafe(link.ref, &targetTile, &targetPoly);
+                const TilePosition target(targetTile->header->x, targetTile->header->y);
+                if (target == position)
+                    continue;
+                const osg::Vec3f portal = getPortal(*tile, poly, link);
+                const osg::Vec2f border = (center + getCenter(*targetTile)) / 2;
+                const float portalDistance = (osg::Vec2f(portal.x(), portal.z()) - border).length2();
+                auto edge
+                    = std::find_if(edges.begin(), edges.end(), [&](const Edge& v) { return v.mTarget == target; });
+                if (edge == edges.end())
+                {
+                    edges.push_back(Edge{ target, portal, 0 });
+                    portalDistances.push_back(std::numeric_limits<float>::max());
+                    edge = std::prev(edges.end());
+                }
+                float& bestDistance = portalDistances[static_cast<std::size_t>(edge - edges.begin())];
+                edge->mPassable |= getPassable(poly.flags, targetPoly->flags);
+                if (portalDistance < bestDistance)
+                {
+                    edge->mPortal = portal;
+                    bestDistance = portalDistance;
+                }
+            }
+        }
+
+        mEdges.insert_or_assign(position, std::move(edges));
+    }
+}
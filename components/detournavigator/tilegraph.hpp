@@ -0,0 +1,52 @@
+#ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_TILEGRAPH_H
+#define OPENMW_COMPONENTS_DETOURNAVIGATOR_TILEGRAPH_H
+
+#include "flags.hpp"
+#include "tileposition.hpp"
+
+#include <osg/Vec3f>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <vector>
+
+class dtNavMesh;
+
+namespace DetourNavigator
+{
+    // Coarse connectivity graph over navmesh tiles. There is an edge from one tile to a neighbour when some of their
+    // polygons are linked. Each edge has a portal point on a linked polygon edge in navmesh coordinates to be used as
+    // an intermediate destination when path is refined.
+    class TileGraph
+    {
+    public:
+        struct Edge
+        {
+            TilePosition mTarget;
+            osg::Vec3f mPortal;
+            // Bit with index equal to include flags value is set when the edge is passable with these flags
+            std::uint16_t mPassable = 0;
+        };
+
+        // Updates edges of the given tile and its neighbours. Should be called after the tile is added or removed.
+        void updateTile(const dtNavMesh& navMesh, const TilePosition& position);
+
+        // Returns tiles sequence from start to end including both if there is a route over edges passable with
+        // includeFlags visiting no more than maxNodes tiles.
+        std::optional<std::vector<TilePosition>> findRoute(
+            const TilePosition& start, const TilePosition& end, Flags includeFlags, std::size_t maxNodes) const;
+
+        const Edge* findEdge(const TilePosition& source, const TilePosition& target) const;
+
+        std::size_t getEdgesCount() const;
+
+    private:
+        std::map<TilePosition, std::vector<Edge>> mEdges;
+
+        void updateEdges(const dtNavMesh& navMesh, const TilePosition& position);
+    };
+}
+
+#endif
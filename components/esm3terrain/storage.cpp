@@ -1,6 +1,10 @@
 #include "storage.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <set>
+#include <vector>
 
 #include <osg/Image>
 #include <osg/Plane>
@@ -10,6 +14,8 @@
 #include <components/misc/strings/algorithm.hpp>
 #include <components/vfs/manager.hpp>
 
+#include <extern/smhasher/MurmurHash3.h>
+
 namespace ESMTerrain
 {
 
@@ -95,85 +101,90 @@ namespace ESMTerrain
         return false;
     }
 
-    void Storage::fixNormal(osg::Vec3f& normal, int cellX, int cellY, int col, int row, LandCache& cache)
+    namespace
     {
-        while (col >= ESM::Land::LAND_SIZE - 1)
-        {
-            ++cellY;
-            col -= ESM::Land::LAND_SIZE - 1;
-        }
-        while (row >= ESM::Land::LAND_SIZE - 1)
-        {
-            ++cellX;
-            row -= ESM::Land::LAND_SIZE - 1;
-        }
-        while (col < 0)
+        constexpr int cellVertexCount = ESM::Land::LAND_SIZE - 1;
+
+        // Vertex of a chunk along one axis.
+        struct VertexSample
         {
-            --cellY;
-            col += ESM::Land::LAND_SIZE - 1;
-        }
-        while (row < 0)
+            int mCell;
+            int mIndex; // in [0, LAND_SIZE - 1]
+            // The same vertex addressed from the cell where it is not on the last row / column. Normals and colours
+            // don't always connect seamlessly between cells, so they are taken from there.
+            int mStitchedCell;
+            int mStitchedIndex; // in [0, LAND_SIZE - 2]
+        };
+
+        // Returns the vertices of a chunk along one axis in the order they are written into the vertex buffers.
+        std::vector<VertexSample> getVertexSamples(float origin, int startCell, float size, std::size_t increment)
         {
-            --cellX;
-            row += ESM::Land::LAND_SIZE - 1;
+            std::vector<VertexSample> result;
+            for (int cell = startCell; cell < startCell + std::ceil(size); ++cell)
+            {
+                int start = 0;
+                // Skip the first row / column unless we're at a chunk edge,
+                // since this row / column is already contained in a previous cell
+                // This is only relevant if we're creating a chunk spanning multiple cells
+                if (!result.empty())
+                    start += increment;
+
+                // Only relevant for chunks smaller than (contained in) one cell
+                start += (origin - startCell) * ESM::Land::LAND_SIZE;
+                const int end = std::min(static_cast<int>(start + std::min(1.f, size) * cellVertexCount + 1),
+                    static_cast<int>(ESM::Land::LAND_SIZE));
+
+                for (int index = start; index < end; index += increment)
+                {
+                    assert(index >= 0 && index < ESM::Land::LAND_SIZE);
+                    if (index == cellVertexCount)
+                        result.push_back(VertexSample{ cell, index, cell + 1, 0 });
+                    else
+                        result.push_back(VertexSample{ cell, index, cell, index });
+                }
+            }
+            return result;
         }
 
-        const LandObject* land = getLand(cellX, cellY, cache);
-        const ESM::Land::LandData* data = land ? land->getData(ESM::Land::DATA_VNML) : nullptr;
-        if (data)
+        void normalize(osg::Vec3f* values, std::size_t count)
         {
-            normal.x() = data->mNormals[col * ESM::Land::LAND_SIZE * 3 + row * 3];
-            normal.y() = data->mNormals[col * ESM::Land::LAND_SIZE * 3 + row * 3 + 1];
-            normal.z() = data->mNormals[col * ESM::Land::LAND_SIZE * 3 + row * 3 + 2];
-            normal.normalize();
+            // Same as osg::Vec3f::normalize but written as a plain loop over the whole row to be vectorized
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                float* const v = values[i].ptr();
+                const float length = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+                const float inverse = length > 0 ? 1.0f / length : 1.0f;
+                v[0] *= inverse;
+                v[1] *= inverse;
+                v[2] *= inverse;
+            }
         }
-        else
-            normal = osg::Vec3f(0, 0, 1);
     }
 
-    void Storage::averageNormal(osg::Vec3f& normal, int cellX, int cellY, int col, int row, LandCache& cache)
+    void Storage::fillVertexBuffers(int lodLevel, float size, const osg::Vec2f& center,
+        osg::ref_ptr<osg::Vec3Array> positions, osg::ref_ptr<osg::Vec3Array> normals,
+        osg::ref_ptr<osg::Vec4ubArray> colours)
     {
-        osg::Vec3f n1, n2, n3, n4;
-        fixNormal(n1, cellX, cellY, col + 1, row, cache);
-        fixNormal(n2, cellX, cellY, col - 1, row, cache);
-        fixNormal(n3, cellX, cellY, col, row + 1, cache);
-        fixNormal(n4, cellX, cellY, col, row - 1, cache);
-        normal = (n1 + n2 + n3 + n4);
-        normal.normalize();
-    }
+        LandCache cache;
 
-    void Storage::fixColour(osg::Vec4ub& color, int cellX, int cellY, int col, int row, LandCache& cache)
-    {
-        if (col == ESM::Land::LAND_SIZE - 1)
-        {
-            ++cellY;
-            col = 0;
-        }
-        if (row == ESM::Land::LAND_SIZE - 1)
+        if (mDiskCache == nullptr || useAlteration())
         {
-            ++cellX;
-            row = 0;
+            generateVertexBuffers(lodLevel, size, center, *positions, *normals, *colours, cache);
+            return;
         }
 
-        const LandObject* land = getLand(cellX, cellY, cache);
-        const ESM::Land::LandData* data = land ? land->getData(ESM::Land::DATA_VCLR) : nullptr;
-        if (data)
-        {
-            color.r() = data->mColours[col * ESM::Land::LAND_SIZE * 3 + row * 3];
-            color.g() = data->mColours[col * ESM::Land::LAND_SIZE * 3 + row * 3 + 1];
-            color.b() = data->mColours[col * ESM::Land::LAND_SIZE * 3 + row * 3 + 2];
-        }
-        else
-        {
-            color.r() = 255;
-            color.g() = 255;
-            color.b() = 255;
-        }
+        const std::uint64_t hash = getChunkHash(size, center, cache);
+        const std::size_t numVerts = static_cast<std::size_t>(size * (ESM::Land::LAND_SIZE - 1) / (1 << lodLevel) + 1);
+        if (mDiskCache->loadVertexBuffers(size, center, lodLevel, hash, *positions, *normals, *colours)
+            && positions->size() == numVerts * numVerts)
+            return;
+
+        generateVertexBuffers(lodLevel, size, center, *positions, *normals, *colours, cache);
+        mDiskCache->storeVertexBuffers(size, center, lodLevel, hash, *positions, *normals, *colours);
     }
 
-    void Storage::fillVertexBuffers(int lodLevel, float size, const osg::Vec2f& center,
-        osg::ref_ptr<osg::Vec3Array> positions, osg::ref_ptr<osg::Vec3Array> normals,
-        osg::ref_ptr<osg::Vec4ubArray> colours)
+    void Storage::generateVertexBuffers(int lodLevel, float size, const osg::Vec2f& center, osg::Vec3Array& positions,
+        osg::Vec3Array& normals, osg::Vec4ubArray& colours, LandCache& cache)
     {
         // LOD level n means every 2^n-th vertex is kept
         size_t increment = static_cast<size_t>(1) << lodLevel;
@@ -185,134 +196,152 @@ namespace ESMTerrain
 
         size_t numVerts = static_cast<size_t>(size * (ESM::Land::LAND_SIZE - 1) / increment + 1);
 
-        positions->resize(numVerts * numVerts);
-        normals->resize(numVerts * numVerts);
-        colours->resize(numVerts * numVerts);
-
-        osg::Vec3f normal;
-        osg::Vec4ub color;
+        positions.resize(numVerts * numVerts);
+        normals.resize(numVerts * numVerts);
+        colours.resize(numVerts * numVerts);
 
-        float vertY = 0;
-        float vertX = 0;
-
-        LandCache cache;
+        const std::vector<VertexSample> samplesX = getVertexSamples(origin.x(), startCellX, size, increment);
+        const std::vector<VertexSample> samplesY = getVertexSamples(origin.y(), startCellY, size, increment);
+        assert(samplesX.size() == numVerts); // Ensure we covered whole area
+        assert(samplesY.size() == numVerts); // Ensure we covered whole area
 
-        bool alteration = useAlteration();
+        std::vector<float> coordinates(numVerts);
+        for (std::size_t vert = 0; vert < numVerts; ++vert)
+            coordinates[vert] = (vert / float(numVerts - 1) - 0.5f) * size * Constants::CellSizeInUnits;
 
-        float vertY_ = 0; // of current cell corner
-        for (int cellY = startCellY; cellY < startCellY + std::ceil(size); ++cellY)
+        // Land data of the chunk cells and their neighbours since stitched vertices and corner normals may refer to
+        // a cell next to the chunk. Each land is fetched on first use instead of a map lookup per vertex.
+        struct CellData
         {
-            float vertX_ = 0; // of current cell corner
-            for (int cellX = startCellX; cellX < startCellX + std::ceil(size); ++cellX)
+            bool mLoaded = false;
+            const ESM::Land::LandData* mHeights = nullptr;
+            const ESM::Land::LandData* mNormals = nullptr;
+            const ESM::Land::LandData* mColours = nullptr;
+        };
+
+        const int minCellX = startCellX - 1;
+        const int minCellY = startCellY - 1;
+        const int gridSize = static_cast<int>(std::ceil(size)) + 2;
+        std::vector<CellData> grid(static_cast<std::size_t>(gridSize * gridSize));
+
+        const auto getCellData = [&](int cellX, int cellY) -> const CellData& {
+            assert(cellX >= minCellX && cellX < minCellX + gridSize);
+            assert(cellY >= minCellY && cellY < minCellY + gridSize);
+            CellData& cellData = grid[static_cast<std::size_t>((cellY - minCellY) * gridSize + cellX - minCellX)];
+            if (!cellData.mLoaded)
             {
-                const LandObject* land = getLand(cellX, cellY, cache);
-                const ESM::Land::LandData* heightData = nullptr;
-                const ESM::Land::LandData* normalData = nullptr;
-                const ESM::Land::LandData* colourData = nullptr;
-                if (land)
+                cellData.mLoaded = true;
+                if (const LandObject* land = getLand(cellX, cellY, cache))
                 {
-                    heightData = land->getData(ESM::Land::DATA_VHGT);
-                    normalData = land->getData(ESM::Land::DATA_VNML);
-                    colourData = land->getData(ESM::Land::DATA_VCLR);
+                    cellData.mHeights = land->getData(ESM::Land::DATA_VHGT);
+                    cellData.mNormals = land->getData(ESM::Land::DATA_VNML);
+                    cellData.mColours = land->getData(ESM::Land::DATA_VCLR);
                 }
+            }
+            return cellData;
+        };
 
-                int rowStart = 0;
-                int colStart = 0;
-                // Skip the first row / column unless we're at a chunk edge,
-                // since this row / column is already contained in a previous cell
-                // This is only relevant if we're creating a chunk spanning multiple cells
-                if (vertY_ != 0)
-                    colStart += increment;
-                if (vertX_ != 0)
-                    rowStart += increment;
-
-                // Only relevant for chunks smaller than (contained in) one cell
-                rowStart += (origin.x() - startCellX) * ESM::Land::LAND_SIZE;
-                colStart += (origin.y() - startCellY) * ESM::Land::LAND_SIZE;
-                int rowEnd = std::min(static_cast<int>(rowStart + std::min(1.f, size) * (ESM::Land::LAND_SIZE - 1) + 1),
-                    static_cast<int>(ESM::Land::LAND_SIZE));
-                int colEnd = std::min(static_cast<int>(colStart + std::min(1.f, size) * (ESM::Land::LAND_SIZE - 1) + 1),
-                    static_cast<int>(ESM::Land::LAND_SIZE));
-
-                vertY = vertY_;
-                for (int col = colStart; col < colEnd; col += increment)
-                {
-                    vertX = vertX_;
-                    for (int row = rowStart; row < rowEnd; row += increment)
-                    {
-                        int srcArrayIndex = col * ESM::Land::LAND_SIZE * 3 + row * 3;
-
-                        assert(row >= 0 && row < ESM::Land::LAND_SIZE);
-                        assert(col >= 0 && col < ESM::Land::LAND_SIZE);
-
-                        assert(vertX < numVerts);
-                        assert(vertY < numVerts);
-
-                        float height = defaultHeight;
-                        if (heightData)
-                            height = heightData->mHeights[col * ESM::Land::LAND_SIZE + row];
-                        if (alteration)
-                            height += getAlteredHeight(col, row);
-                        (*positions)[static_cast<unsigned int>(vertX * numVerts + vertY)]
-                            = osg::Vec3f((vertX / float(numVerts - 1) - 0.5f) * size * Constants::CellSizeInUnits,
-                                (vertY / float(numVerts - 1) - 0.5f) * size * Constants::CellSizeInUnits, height);
-
-                        if (normalData)
-                        {
-                            for (int i = 0; i < 3; ++i)
-                                normal[i] = normalData->mNormals[srcArrayIndex + i];
-
-                            normal.normalize();
-                        }
-                        else
-                            normal = osg::Vec3f(0, 0, 1);
-
-                        // Normals apparently don't connect seamlessly between cells
-                        if (col == ESM::Land::LAND_SIZE - 1 || row == ESM::Land::LAND_SIZE - 1)
-                            fixNormal(normal, cellX, cellY, col, row, cache);
-
-                        // some corner normals appear to be complete garbage (z < 0)
-                        if ((row == 0 || row == ESM::Land::LAND_SIZE - 1)
-                            && (col == 0 || col == ESM::Land::LAND_SIZE - 1))
-                            averageNormal(normal, cellX, cellY, col, row, cache);
-
-                        assert(normal.z() > 0);
-
-                        (*normals)[static_cast<unsigned int>(vertX * numVerts + vertY)] = normal;
-
-                        if (colourData)
-                        {
-                            for (int i = 0; i < 3; ++i)
-                                color[i] = colourData->mColours[srcArrayIndex + i];
-                        }
-                        else
-                        {
-                            color.r() = 255;
-                            color.g() = 255;
-                            color.b() = 255;
-                        }
-                        if (alteration)
-                            adjustColor(col, row, heightData, color); // Does nothing by default, override in OpenMW-CS
+        // Not normalized
+        const auto getStitchedNormal = [&](int cellX, int cellY, int row, int col) {
+            if (row < 0)
+            {
+                --cellX;
+                row += cellVertexCount;
+            }
+            else if (row >= cellVertexCount)
+            {
+                ++cellX;
+                row -= cellVertexCount;
+            }
+            if (col < 0)
+            {
+                --cellY;
+                col += cellVertexCount;
+            }
+            else if (col >= cellVertexCount)
+            {
+                ++cellY;
+                col -= cellVertexCount;
+            }
+            const ESM::Land::LandData* data = getCellData(cellX, cellY).mNormals;
+            if (data == nullptr)
+                return osg::Vec3f(0, 0, 1);
+            const int srcArrayIndex = col * ESM::Land::LAND_SIZE * 3 + row * 3;
+            return osg::Vec3f(
+                data->mNormals[srcArrayIndex], data->mNormals[srcArrayIndex + 1], data->mNormals[srcArrayIndex + 2]);
+        };
+
+        const auto getNormalizedStitchedNormal = [&](int cellX, int cellY, int row, int col) {
+            osg::Vec3f normal = getStitchedNormal(cellX, cellY, row, col);
+            normal.normalize();
+            return normal;
+        };
 
-                        // Unlike normals, colors mostly connect seamlessly between cells, but not always...
-                        if (col == ESM::Land::LAND_SIZE - 1 || row == ESM::Land::LAND_SIZE - 1)
-                            fixColour(color, cellX, cellY, col, row, cache);
+        const bool alteration = useAlteration();
 
-                        color.a() = 255;
+        // Output is indexed by vertX * numVerts + vertY, so each vertX is a contiguous row of every buffer
+        for (std::size_t vertX = 0; vertX < numVerts; ++vertX)
+        {
+            const VertexSample& x = samplesX[vertX];
+            osg::Vec3f* const rowPositions = &positions[vertX * numVerts];
+            osg::Vec3f* const rowNormals = &normals[vertX * numVerts];
+            osg::Vec4ub* const rowColours = &colours[vertX * numVerts];
 
-                        (*colours)[static_cast<unsigned int>(vertX * numVerts + vertY)] = color;
+            for (std::size_t vertY = 0; vertY < numVerts; ++vertY)
+            {
+                const VertexSample& y = samplesY[vertY];
+                const ESM::Land::LandData* heightData = getCellData(x.mCell, y.mCell).mHeights;
+                float height = defaultHeight;
+                if (heightData)
+                    height = heightData->mHeights[y.mIndex * ESM::Land::LAND_SIZE + x.mIndex];
+                if (alteration)
+                    height += getAlteredHeight(y.mIndex, x.mIndex);
+                rowPositions[vertY] = osg::Vec3f(coordinates[vertX], coordinates[vertY], height);
+            }
 
-                        ++vertX;
-                    }
-                    ++vertY;
+            for (std::size_t vertY = 0; vertY < numVerts; ++vertY)
+            {
+                const VertexSample& y = samplesY[vertY];
+                // some corner normals appear to be complete garbage (z < 0)
+                if (x.mStitchedIndex == 0 && y.mStitchedIndex == 0)
+                {
+                    const int cellX = x.mStitchedCell;
+                    const int cellY = y.mStitchedCell;
+                    rowNormals[vertY] = getNormalizedStitchedNormal(cellX, cellY, 0, 1)
+                        + getNormalizedStitchedNormal(cellX, cellY, 0, -1)
+                        + getNormalizedStitchedNormal(cellX, cellY, 1, 0)
+                        + getNormalizedStitchedNormal(cellX, cellY, -1, 0);
                 }
-                vertX_ = vertX;
+                else
+                    rowNormals[vertY]
+                        = getStitchedNormal(x.mStitchedCell, y.mStitchedCell, x.mStitchedIndex, y.mStitchedIndex);
             }
-            vertY_ = vertY;
+            normalize(rowNormals, numVerts);
 
-            assert(vertX_ == numVerts); // Ensure we covered whole area
+            for (std::size_t vertY = 0; vertY < numVerts; ++vertY)
+            {
+                const VertexSample& y = samplesY[vertY];
+                const CellData& cellData = getCellData(x.mStitchedCell, y.mStitchedCell);
+                osg::Vec4ub color(255, 255, 255, 255);
+                if (cellData.mColours)
+                {
+                    const int srcArrayIndex = y.mStitchedIndex * ESM::Land::LAND_SIZE * 3 + x.mStitchedIndex * 3;
+                    for (int i = 0; i < 3; ++i)
+                        color[i] = cellData.mColours->mColours[srcArrayIndex + i];
+                }
+                // Unlike normals, colors mostly connect seamlessly between cells, but not always...
+                // Vertices on the last row / column take the colour of the neighbour cell as is.
+                if (alteration && x.mIndex != cellVertexCount && y.mIndex != cellVertexCount)
+                {
+                    // Does nothing by default, override in OpenMW-CS
+                    adjustColor(y.mIndex, x.mIndex, cellData.mHeights, color);
+                    color.a() = 255;
+                }
+                rowColours[vertY] = color;
+            }
         }
-        assert(vertY_ == numVerts); // Ensure we covered whole area
+
+        assert(std::all_of(normals.begin(), normals.end(), [](const osg::Vec3f& v) { return v.z() > 0; }));
     }
 
     Storage::UniqueTextureId Storage::getVtexIndexAt(int cellX, int cellY, int x, int y, LandCache& cache)
@@ -376,6 +405,30 @@ namespace ESMTerrain
 
     void Storage::getBlendmaps(float chunkSize, const osg::Vec2f& chunkCenter, ImageVector& blendmaps,
         std::vector<Terrain::LayerInfo>& layerList)
+    {
+        LandCache cache;
+        std::vector<std::string> layerTextures;
+
+        if (mDiskCache == nullptr || useAlteration())
+        {
+            generateBlendmaps(chunkSize, chunkCenter, blendmaps, layerList, layerTextures, cache);
+            return;
+        }
+
+        const std::uint64_t hash = getChunkHash(chunkSize, chunkCenter, cache);
+        if (mDiskCache->loadBlendmaps(chunkSize, chunkCenter, hash, blendmaps, layerTextures))
+        {
+            for (const std::string& texture : layerTextures)
+                layerList.push_back(getLayerInfo(texture));
+            return;
+        }
+
+        generateBlendmaps(chunkSize, chunkCenter, blendmaps, layerList, layerTextures, cache);
+        mDiskCache->storeBlendmaps(chunkSize, chunkCenter, hash, blendmaps, layerTextures);
+    }
+
+    void Storage::generateBlendmaps(float chunkSize, const osg::Vec2f& chunkCenter, ImageVector& blendmaps,
+        std::vector<Terrain::LayerInfo>& layerList, std::vector<std::string>& layerTextures, LandCache& cache)
     {
         osg::Vec2f origin = chunkCenter - osg::Vec2f(chunkSize / 2.f, chunkSize / 2.f);
         int cellX = static_cast<int>(std::floor(origin.x()));
@@ -391,7 +444,6 @@ namespace ESMTerrain
         const int imageScaleFactor = 2;
         const int blendmapImageSize = blendmapSize * imageScaleFactor;
 
-        LandCache cache;
         std::map<UniqueTextureId, unsigned int> textureIndicesMap;
 
         for (int y = 0; y < blendmapSize; y++)
@@ -403,7 +455,8 @@ namespace ESMTerrain
                 if (found == textureIndicesMap.end())
                 {
                     unsigned int layerIndex = layerList.size();
-                    Terrain::LayerInfo info = getLayerInfo(getTextureName(id));
+                    std::string texture = getTextureName(id);
+                    Terrain::LayerInfo info = getLayerInfo(texture);
 
                     // look for existing diffuse map, which may be present when several plugins use the same texture
                     for (unsigned int i = 0; i < layerList.size(); ++i)
@@ -425,6 +478,7 @@ namespace ESMTerrain
                         memset(pData, 0, image->getTotalDataSize());
                         blendmaps.emplace_back(image);
                         layerList.emplace_back(info);
+                        layerTextures.push_back(std::move(texture));
                     }
                 }
                 unsigned int layerIndex = found->second;
@@ -536,6 +590,84 @@ namespace ESMTerrain
         }
     }
 
+    std::uint64_t Storage::getChunkHash(float size, const osg::Vec2f& center, LandCache& cache)
+    {
+        const osg::Vec2f origin = center - osg::Vec2f(size / 2.f, size / 2.f);
+        const int startCellX = static_cast<int>(std::floor(origin.x()));
+        const int startCellY = static_cast<int>(std::floor(origin.y()));
+        const int endCell = static_cast<int>(std::ceil(size));
+
+        // Borders of the chunk depend on the neighbour cells
+        std::vector<std::uint64_t> cellHashes;
+        for (int cellY = startCellY - 1; cellY <= startCellY + endCell; ++cellY)
+        {
+            for (int cellX = startCellX - 1; cellX <= startCellX + endCell; ++cellX)
+                cellHashes.push_back(getCellHash(cellX, cellY, cache));
+        }
+
+        std::array<std::uint64_t, 2> hash{ 0, 0 };
+        std::array<std::uint64_t, 2> result{ 0, 0 };
+        MurmurHash3_x64_128(cellHashes.data(), static_cast<int>(cellHashes.size() * sizeof(std::uint64_t)),
+            hash.data(), result.data());
+        return result[0];
+    }
+
+    std::uint64_t Storage::getCellHash(int cellX, int cellY, LandCache& cache)
+    {
+        {
+            const std::lock_guard lock(mCellHashesMutex);
+            const auto it = mCellHashes.find(std::make_pair(cellX, cellY));
+            if (it != mCellHashes.end())
+                return it->second;
+        }
+
+        std::array<std::uint64_t, 2> hash{ 0, 0 };
+        const auto add = [&](const void* data, std::size_t size) {
+            std::array<std::uint64_t, 2> result{ 0, 0 };
+            MurmurHash3_x64_128(data, static_cast<int>(size), hash.data(), result.data());
+            hash = result;
+        };
+
+        const LandObject* land = getLand(cellX, cellY, cache);
+        const std::int32_t plugin = land ? land->getPlugin() : -1;
+        add(&plugin, sizeof(plugin));
+        if (land)
+        {
+            for (const int flag : { ESM::Land::DATA_VHGT, ESM::Land::DATA_VNML, ESM::Land::DATA_VCLR })
+            {
+                const ESM::Land::LandData* data = land->getData(flag);
+                const std::uint8_t hasData = data != nullptr;
+                add(&hasData, sizeof(hasData));
+                if (data == nullptr)
+                    continue;
+                if (flag == ESM::Land::DATA_VHGT)
+                    add(data->mHeights, sizeof(data->mHeights));
+                else if (flag == ESM::Land::DATA_VNML)
+                    add(data->mNormals, sizeof(data->mNormals));
+                else
+                    add(data->mColours, sizeof(data->mColours));
+            }
+
+            // Blendmaps depend on the texture records too
+            if (const ESM::Land::LandData* data = land->getData(ESM::Land::DATA_VTEX))
+            {
+                add(data->mTextures, sizeof(data->mTextures));
+                const std::set<std::uint16_t> textures(std::begin(data->mTextures), std::end(data->mTextures));
+                for (const std::uint16_t texture : textures)
+                {
+                    if (texture == 0)
+                        continue;
+                    const std::string name = getTextureName(UniqueTextureId(texture, land->getPlugin()));
+                    add(name.data(), name.size());
+                }
+            }
+        }
+
+        const std::lock_guard lock(mCellHashesMutex);
+        mCellHashes.emplace(std::make_pair(cellX, cellY), hash[0]);
+        return hash[0];
+    }
+
     void Storage::adjustColor(int col, int row, const ESM::Land::LandData* heightData, osg::Vec4ub& color) const {}
 
     float Storage::getAlteredHeight(int col, int row) const
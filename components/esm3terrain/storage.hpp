@@ -2,8 +2,12 @@
 #define COMPONENTS_ESM_TERRAIN_STORAGE_H
 
 #include <cassert>
+#include <cstdint>
+#include <map>
+#include <memory>
 #include <mutex>
 
+#include <components/terrain/diskcache.hpp>
 #include <components/terrain/storage.hpp>
 
 #include <components/esm3/loadland.hpp>
@@ -55,6 +59,11 @@ namespace ESMTerrain
             const std::string& normalHeightMapPattern = "", bool autoUseNormalMaps = false,
             const std::string& specularMapPattern = "", bool autoUseSpecularMaps = false);
 
+        /// Store generated vertex buffers and blendmaps on disk and reuse them while the land data they were
+        /// generated from doesn't change. Not used when terrain is altered.
+        /// @note Land records must not change after chunks are created, hashes of the data are cached per cell.
+        void setDiskCache(std::unique_ptr<Terrain::DiskCache>&& diskCache) { mDiskCache = std::move(diskCache); }
+
         // Not implemented in this class, because we need different Store implementations for game and editor
         virtual osg::ref_ptr<const LandObject> getLand(int cellX, int cellY) = 0;
         virtual const ESM::LandTexture* getLandTexture(int index, short plugin) = 0;
@@ -116,12 +125,18 @@ namespace ESMTerrain
     private:
         const VFS::Manager* mVFS;
 
-        inline void fixNormal(osg::Vec3f& normal, int cellX, int cellY, int col, int row, LandCache& cache);
-        inline void fixColour(osg::Vec4ub& colour, int cellX, int cellY, int col, int row, LandCache& cache);
-        inline void averageNormal(osg::Vec3f& normal, int cellX, int cellY, int col, int row, LandCache& cache);
-
         inline const LandObject* getLand(int cellX, int cellY, LandCache& cache);
 
+        void generateVertexBuffers(int lodLevel, float size, const osg::Vec2f& center, osg::Vec3Array& positions,
+            osg::Vec3Array& normals, osg::Vec4ubArray& colours, LandCache& cache);
+
+        void generateBlendmaps(float chunkSize, const osg::Vec2f& chunkCenter, ImageVector& blendmaps,
+            std::vector<Terrain::LayerInfo>& layerList, std::vector<std::string>& layerTextures, LandCache& cache);
+
+        // Hash of all data used to generate vertex buffers and blendmaps of the chunk
+        std::uint64_t getChunkHash(float size, const osg::Vec2f& center, LandCache& cache);
+        std::uint64_t getCellHash(int cellX, int cellY, LandCache& cache);
+
         virtual bool useAlteration() const { return false; }
         virtual void adjustColor(int col, int row, const ESM::Land::LandData* heightData, osg::Vec4ub& color) const;
         virtual float getAlteredHeight(int col, int row) const;
@@ -145,6 +160,10 @@ namespace ESMTerrain
         bool mAutoUseSpecularMaps;
 
         Terrain::LayerInfo getLayerInfo(const std::string& texture);
+
+        std::unique_ptr<Terrain::DiskCache> mDiskCache;
+        std::map<std::pair<int, int>, std::uint64_t> mCellHashes;
+        std::mutex mCellHashesMutex;
     };
 
 }
@@ -20,37 +20,48 @@ namespace Interpreter
         throw std::runtime_error(error);
     }
 
-    template <typename T>
-    auto& getDispatcher(const T& segment, unsigned int seg, int opcode)
+    [[noreturn]] static void abortUnknownInstruction(Type_Code code)
     {
-        auto it = segment.find(opcode);
-        if (it == segment.end())
+        switch (code >> 30)
         {
-            abortUnknownCode(seg, opcode);
+            case 0:
+                abortUnknownCode(0, code >> 24);
+            case 2:
+                abortUnknownCode(2, (code >> 20) & 0x3ff);
+        }
+
+        switch (code >> 26)
+        {
+            case 0x30:
+                abortUnknownCode(3, (code >> 8) & 0x3ffff);
+            case 0x32:
+                abortUnknownCode(5, code & 0x3ffffff);
         }
-        return it->second;
+
+        abortUnknownSegment(code);
     }
 
-    void Interpreter::execute(Type_Code code)
+    Instruction Interpreter::decode(Type_Code code) const
     {
+        Instruction result;
+        result.mCode = code;
+
         unsigned int segSpec = code >> 30;
 
         switch (segSpec)
         {
             case 0:
             {
-                const int opcode = code >> 24;
-                const unsigned int arg0 = code & 0xffffff;
-
-                return getDispatcher(mSegment0, 0, opcode)->execute(mRuntime, arg0);
+                result.mOpcode1 = mSegment0.find(code >> 24);
+                result.mArg0 = code & 0xffffff;
+                return result;
             }
 
             case 2:
             {
-                const int opcode = (code >> 20) & 0x3ff;
-                const unsigned int arg0 = code & 0xfffff;
-
-                return getDispatcher(mSegment2, 2, opcode)->execute(mRuntime, arg0);
+                result.mOpcode1 = mSegment2.find((code >> 20) & 0x3ff);
+                result.mArg0 = code & 0xfffff;
+                return result;
             }
         }
 
@@ -60,21 +71,30 @@ namespace Interpreter
         {
             case 0x30:
             {
-                const int opcode = (code >> 8) & 0x3ffff;
-                const unsigned int arg0 = code & 0xff;
-
-                return getDispatcher(mSegment3, 3, opcode)->execute(mRuntime, arg0);
+                result.mOpcode1 = mSegment3.find((code >> 8) & 0x3ffff);
+                result.mArg0 = code & 0xff;
+                return result;
             }
 
             case 0x32:
             {
-                const int opcode = code & 0x3ffffff;
-
-                return getDispatcher(mSegment5, 5, opcode)->execute(mRuntime);
+                result.mOpcode0 = mSegment5.find(code & 0x3ffffff);
+                return result;
             }
         }
 
-        abortUnknownSegment(code);
+        return result;
+    }
+
+    void Interpreter::execute(const Instruction& instruction)
+    {
+        if (instruction.mOpcode1 != nullptr)
+            return instruction.mOpcode1->execute(mRuntime, instruction.mArg0);
+
+        if (instruction.mOpcode0 != nullptr)
+            return instruction.mOpcode0->execute(mRuntime);
+
+        abortUnknownInstruction(instruction.mCode);
     }
 
     void Interpreter::begin()
@@ -127,7 +147,51 @@ namespace Interpreter
             {
                 Type_Code runCode = codeBlock[mRuntime.getPC()];
                 mRuntime.setPC(mRuntime.getPC() + 1);
-                execute(runCode);
+                execute(decode(runCode));
+            }
+        }
+        catch (...)
+        {
+            end();
+            throw;
+        }
+
+        end();
+    }
+
+    Program Interpreter::decode(const Type_Code* code, int codeSize) const
+    {
+        assert(codeSize >= 4);
+
+        const int opcodes = static_cast<int>(code[0]);
+        const Type_Code* codeBlock = code + 4;
+
+        Program result;
+        result.mInstructions.reserve(opcodes);
+        for (int i = 0; i < opcodes; ++i)
+            result.mInstructions.push_back(decode(codeBlock[i]));
+        return result;
+    }
+
+    void Interpreter::run(const Program& program, const Type_Code* code, int codeSize, Context& context)
+    {
+        assert(codeSize >= 4);
+        assert(program.mInstructions.size() == code[0]);
+
+        begin();
+
+        try
+        {
+            mRuntime.configure(code, codeSize, context);
+
+            const Instruction* instructions = program.mInstructions.data();
+            const int opcodes = static_cast<int>(program.mInstructions.size());
+
+            while (mRuntime.getPC() >= 0 && mRuntime.getPC() < opcodes)
+            {
+                const Instruction& instruction = instructions[mRuntime.getPC()];
+                mRuntime.setPC(mRuntime.getPC() + 1);
+                execute(instruction);
             }
         }
         catch (...)
@@ -1,33 +1,75 @@
 #ifndef INTERPRETER_INTERPRETER_H_INCLUDED
 #define INTERPRETER_INTERPRETER_H_INCLUDED
 
+#include <array>
 #include <cassert>
-#include <map>
+#include <cstddef>
 #include <memory>
 #include <stack>
 #include <utility>
+#include <vector>
 
 #include "opcodes.hpp"
+#include "program.hpp"
 #include "runtime.hpp"
 #include "types.hpp"
 
 namespace Interpreter
 {
+    /// Opcode handlers of a segment indexed by the opcode. Opcodes of a segment are allocated in a few dense ranges
+    /// far from each other (core opcodes start from 0 and extensions from 0x2000000), so the table is split into pages
+    /// allocated only for used ranges.
+    template <typename T>
+    class OpcodeTable
+    {
+        static constexpr unsigned sPageBits = 12;
+        static constexpr std::size_t sPageSize = std::size_t(1) << sPageBits;
+
+        using Page = std::array<std::unique_ptr<T>, sPageSize>;
+
+        std::vector<std::unique_ptr<Page>> mPages;
+
+    public:
+        void insert(int code, std::unique_ptr<T>&& op)
+        {
+            assert(code >= 0);
+            const std::size_t page = static_cast<std::size_t>(code) >> sPageBits;
+            if (page >= mPages.size())
+                mPages.resize(page + 1);
+            if (mPages[page] == nullptr)
+                mPages[page] = std::make_unique<Page>();
+
+            std::unique_ptr<T>& slot = (*mPages[page])[static_cast<std::size_t>(code) & (sPageSize - 1)];
+            assert(slot == nullptr);
+            slot = std::move(op);
+        }
+
+        T* find(int code) const
+        {
+            const std::size_t page = static_cast<std::size_t>(code) >> sPageBits;
+            if (page >= mPages.size() || mPages[page] == nullptr)
+                return nullptr;
+            return (*mPages[page])[static_cast<std::size_t>(code) & (sPageSize - 1)].get();
+        }
+    };
+
     class Interpreter
     {
         std::stack<Runtime> mCallstack;
         bool mRunning;
         Runtime mRuntime;
-        std::map<int, std::unique_ptr<Opcode1>> mSegment0;
-        std::map<int, std::unique_ptr<Opcode1>> mSegment2;
-        std::map<int, std::unique_ptr<Opcode1>> mSegment3;
-        std::map<int, std::unique_ptr<Opcode0>> mSegment5;
+        OpcodeTable<Opcode1> mSegment0;
+        OpcodeTable<Opcode1> mSegment2;
+        OpcodeTable<Opcode1> mSegment3;
+        OpcodeTable<Opcode0> mSegment5;
 
         // not implemented
         Interpreter(const Interpreter&);
         Interpreter& operator=(const Interpreter&);
 
-        void execute(Type_Code code);
+        Instruction decode(Type_Code code) const;
+
+        void execute(const Instruction& instruction);
 
         void begin();
 
@@ -36,8 +78,7 @@ namespace Interpreter
         template <typename TSeg, typename TOp>
         void installSegment(TSeg& seg, int code, TOp&& op)
         {
-            assert(seg.find(code) == seg.end());
-            seg.emplace(code, std::move(op));
+            seg.insert(code, std::move(op));
         }
 
     public:
@@ -68,6 +109,13 @@ namespace Interpreter
         }
 
         void run(const Type_Code* code, int codeSize, Context& context);
+
+        Program decode(const Type_Code* code, int codeSize) const;
+        ///< Resolve opcodes of \a code to the installed handlers. Unknown opcodes are reported only when executed.
+
+        void run(const Program& program, const Type_Code* code, int codeSize, Context& context);
+        ///< Run \a program decoded from \a code by this interpreter. Unlike running \a code directly opcodes are not
+        /// looked up again.
     };
 }
 
@@ -0,0 +1,32 @@
+#ifndef INTERPRETER_PROGRAM_H_INCLUDED
+#define INTERPRETER_PROGRAM_H_INCLUDED
+
+#include <vector>
+
+#include "types.hpp"
+
+namespace Interpreter
+{
+    class Opcode0;
+    class Opcode1;
+
+    /// Instruction with the opcode resolved to its handler and the argument unpacked.
+    struct Instruction
+    {
+        Opcode0* mOpcode0 = nullptr;
+        Opcode1* mOpcode1 = nullptr;
+        unsigned int mArg0 = 0;
+        Type_Code mCode = 0; ///< original code, used to report an unknown opcode when executed
+    };
+
+    /// Instruction block of a compiled script decoded by Interpreter::decode.
+    ///
+    /// \note Handlers are owned by the interpreter that decoded the program, so it can be run only by the same
+    /// interpreter.
+    struct Program
+    {
+        std::vector<Instruction> mInstructions;
+    };
+}
+
+#endif
@@ -0,0 +1,185 @@
+#include "handlerprofiler.hpp"
+
+#include <algorithm>
+
+#include "configuration.hpp"
+
+namespace LuaUtil
+{
+    namespace
+    {
+        constexpr double avgCoef = 1.0 / 30; // averaging over approximately 30 frames
+
+        void writeJsonString(std::ostream& out, std::string_view str)
+        {
+            out << '"';
+            for (char c : str)
+            {
+                if (c == '"' || c == '\\')
+                    out << '\\' << c;
+                else if (static_cast<unsigned char>(c) < 0x20)
+                    out << ' ';
+                else
+                    out << c;
+            }
+            out << '"';
+        }
+
+        std::int64_t toMicroseconds(std::chrono::steady_clock::duration duration)
+        {
+            return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+        }
+    }
+
+    std::string HandlerProfiler::getHandlerName(HandlerType type, std::string_view name)
+    {
+        switch (type)
+        {
+            case HandlerType::EngineHandler:
+                return std::string(name);
+            case HandlerType::Event:
+                return "eventHandler[" + std::string(name) + "]";
+            case HandlerType::Timer:
+                return name.empty() ? std::string("timer") : "timer[" + std::string(name) + "]";
+        }
+        return std::string(name);
+    }
+
+    void HandlerProfiler::begin(int scriptId, HandlerType type, std::string_view name)
+    {
+        HandlersByName& handlers = mHandlers[scriptId][static_cast<std::size_t>(type)];
+        auto it = handlers.find(name);
+        if (it == handlers.end())
+        {
+            it = handlers.emplace(std::string(name), Handler{ scriptId, type, nullptr }).first;
+            it->second.mName = &it->first;
+        }
+        mStack.push_back(Frame{ &it->second, Clock::now() });
+    }
+
+    void HandlerProfiler::end()
+    {
+        const Clock::time_point now = Clock::now();
+        const Frame frame = mStack.back();
+        const Clock::duration duration = now - frame.mStart;
+        const Clock::duration selfTime = duration - frame.mNestedTime;
+
+        frame.mHandler->mFrameTime += std::chrono::duration<double>(selfTime).count();
+        ++frame.mHandler->mCallCount;
+
+        if (mRecordFramesLeft > 0 && frame.mStart >= mRecordingStart)
+        {
+            mTrace.push_back(TraceEvent{ frame.mHandler, frame.mStart, duration });
+            std::vector<const Handler*> stack;
+            stack.reserve(mStack.size());
+            for (const Frame& f : mStack)
+                stack.push_back(f.mHandler);
+            mCollapsedStacks[std::move(stack)] += selfTime;
+        }
+
+        mStack.pop_back();
+        if (!mStack.empty())
+            mStack.back().mNestedTime += duration;
+    }
+
+    void HandlerProfiler::nextFrame()
+    {
+        for (auto& [scriptId, handlersByType] : mHandlers)
+        {
+            for (HandlersByName& handlers : handlersByType)
+            {
+                for (auto& [name, handler] : handlers)
+                {
+                    handler.mAvgFrameTime = handler.mAvgFrameTime * (1 - avgCoef) + handler.mFrameTime * avgCoef;
+                    handler.mFrameTime = 0;
+                }
+            }
+        }
+
+        if (mRecordFramesLeft > 0)
+        {
+            mTraceFrames.push_back(Clock::now());
+            if (--mRecordFramesLeft == 0)
+                mRecordingFinished = true;
+        }
+    }
+
+    std::vector<HandlerProfiler::HandlerStats> HandlerProfiler::getTopHandlers(std::size_t count) const
+    {
+        std::vector<HandlerStats> result;
+        for (const auto& [scriptId, handlersByType] : mHandlers)
+        {
+            for (const HandlersByName& handlers : handlersByType)
+            {
+                for (const auto& [name, handler] : handlers)
+                    result.push_back(HandlerStats{
+                        handler.mScriptId, handler.mType, name, handler.mAvgFrameTime, handler.mCallCount });
+            }
+        }
+        const auto byTime
+            = [](const HandlerStats& l, const HandlerStats& r) { return l.mAvgFrameTime > r.mAvgFrameTime; };
+        if (result.size() > count)
+        {
+            std::partial_sort(result.begin(), result.begin() + count, result.end(), byTime);
+            result.resize(count);
+        }
+        else
+            std::sort(result.begin(), result.end(), byTime);
+        return result;
+    }
+
+    void HandlerProfiler::startRecording(std::size_t frames)
+    {
+        clearRecording();
+        mRecordFramesLeft = frames;
+        mRecordingStart = Clock::now();
+        mTraceFrames.push_back(mRecordingStart);
+    }
+
+    void HandlerProfiler::clearRecording()
+    {
+        mRecordFramesLeft = 0;
+        mRecordingFinished = false;
+        mTrace.clear();
+        mTraceFrames.clear();
+        mCollapsedStacks.clear();
+    }
+
+    void HandlerProfiler::writeChromeTrace(std::ostream& out, const ScriptsConfiguration& conf) const
+    {
+        out << "{\"traceEvents\":[\n";
+        bool first = true;
+        for (std::size_t i = 0; i < mTraceFrames.size(); ++i)
+        {
+            out << (first ? "" : ",\n") << "{\"name\":\"Frame " << i << "\",\"ph\":\"i\",\"s\":\"g\",\"ts\":"
+                << toMicroseconds(mTraceFrames[i] - mRecordingStart) << ",\"pid\":0,\"tid\":0}";
+            first = false;
+        }
+        for (const TraceEvent& event : mTrace)
+        {
+            out << (first ? "" : ",\n") << "{\"name\":";
+            writeJsonString(out, getHandlerName(event.mHandler->mType, *event.mHandler->mName));
+            out << ",\"cat\":";
+            writeJsonString(out, conf[event.mHandler->mScriptId].mScriptPath);
+            out << ",\"ph\":\"X\",\"ts\":" << toMicroseconds(event.mStart - mRecordingStart)
+                << ",\"dur\":" << toMicroseconds(event.mDuration) << ",\"pid\":0,\"tid\":0}";
+            first = false;
+        }
+        out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    }
+
+    void HandlerProfiler::writeCollapsedStacks(std::ostream& out, const ScriptsConfiguration& conf) const
+    {
+        for (const auto& [stack, time] : mCollapsedStacks)
+        {
+            for (std::size_t i = 0; i < stack.size(); ++i)
+            {
+                if (i > 0)
+                    out << ';';
+                out << conf[stack[i]->mScriptId].mScriptPath << ':'
+                    << getHandlerName(stack[i]->mType, *stack[i]->mName);
+            }
+            out << ' ' << toMicroseconds(time) << '\n';
+        }
+    }
+}
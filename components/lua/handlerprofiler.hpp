@@ -0,0 +1,130 @@
+#ifndef COMPONENTS_LUA_HANDLERPROFILER_H
+#define COMPONENTS_LUA_HANDLERPROFILER_H
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace LuaUtil
+{
+    class ScriptsConfiguration;
+
+    // Measures wall time of Lua handlers (engine handlers, event handlers, timer callbacks) per script and handler.
+    // Time of nested handlers (e.g. an event handler that synchronously calls an interface of another script) is not
+    // included into the time of the outer handler.
+    // Also can record every call during several frames and export the recording as a Chrome trace
+    // (chrome://tracing, Perfetto) and as collapsed stacks (flamegraph.pl, speedscope).
+    class HandlerProfiler
+    {
+    public:
+        enum class HandlerType
+        {
+            EngineHandler = 0,
+            Event = 1,
+            Timer = 2,
+        };
+
+        struct HandlerStats
+        {
+            int mScriptId;
+            HandlerType mType;
+            std::string_view mName;
+            double mAvgFrameTime; // seconds per frame, averaged over approximately 30 frames
+            std::uint64_t mCallCount;
+        };
+
+        class Scope
+        {
+        public:
+            Scope(HandlerProfiler& profiler, int scriptId, HandlerType type, std::string_view name)
+                : mProfiler(profiler.isActive() ? &profiler : nullptr)
+            {
+                if (mProfiler)
+                    mProfiler->begin(scriptId, type, name);
+            }
+
+            ~Scope()
+            {
+                if (mProfiler)
+                    mProfiler->end();
+            }
+
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+        private:
+            HandlerProfiler* mProfiler;
+        };
+
+        static std::string getHandlerName(HandlerType type, std::string_view name);
+
+        void setEnabled(bool value) { mEnabled = value; }
+        bool isEnabled() const { return mEnabled; }
+        bool isActive() const { return mEnabled || mRecordFramesLeft > 0; }
+
+        // Should be called once per frame before handlers of the frame are called.
+        void nextFrame();
+
+        // Returns `count` handlers with the highest average time per frame.
+        std::vector<HandlerStats> getTopHandlers(std::size_t count) const;
+
+        // Records every handler call during the given number of frames. The recording is finished when
+        // `isRecordingFinished` returns true. Profiling is active while recording even if the profiler is disabled.
+        void startRecording(std::size_t frames);
+        bool isRecordingFinished() const { return mRecordingFinished; }
+        void clearRecording();
+
+        void writeChromeTrace(std::ostream& out, const ScriptsConfiguration& conf) const;
+        void writeCollapsedStacks(std::ostream& out, const ScriptsConfiguration& conf) const;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct Handler
+        {
+            int mScriptId;
+            HandlerType mType;
+            const std::string* mName;
+            double mFrameTime = 0;
+            double mAvgFrameTime = 0;
+            std::uint64_t mCallCount = 0;
+        };
+
+        struct Frame
+        {
+            Handler* mHandler;
+            Clock::time_point mStart;
+            Clock::duration mNestedTime{ 0 };
+        };
+
+        struct TraceEvent
+        {
+            const Handler* mHandler;
+            Clock::time_point mStart;
+            Clock::duration mDuration;
+        };
+
+        using HandlersByName = std::map<std::string, Handler, std::less<>>;
+
+        void begin(int scriptId, HandlerType type, std::string_view name);
+        void end();
+
+        bool mEnabled = false;
+        std::map<int, std::array<HandlersByName, 3>> mHandlers;
+        std::vector<Frame> mStack;
+
+        std::size_t mRecordFramesLeft = 0;
+        bool mRecordingFinished = false;
+        Clock::time_point mRecordingStart;
+        std::vector<TraceEvent> mTrace;
+        std::vector<Clock::time_point> mTraceFrames;
+        std::map<std::vector<const Handler*>, Clock::duration> mCollapsedStacks;
+    };
+}
+
+#endif // COMPONENTS_LUA_HANDLERPROFILER_H
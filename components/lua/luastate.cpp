@@ -170,6 +170,7 @@ namespace LuaUtil
     {
         if (sProfilerEnabled)
             lua_sethook(mLuaHolder.get(), &countHook, LUA_MASKCOUNT, countHookStep);
+        mHandlerProfiler.setEnabled(settings.mProfileHandlers);
 
         mSol.open_libraries(sol::lib::base, sol::lib::coroutine, sol::lib::math, sol::lib::bit32, sol::lib::string,
             sol::lib::table, sol::lib::os, sol::lib::debug);
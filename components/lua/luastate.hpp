@@ -8,6 +8,7 @@
 #include <filesystem>
 
 #include "configuration.hpp"
+#include "handlerprofiler.hpp"
 
 namespace VFS
 {
@@ -32,6 +33,7 @@ namespace LuaUtil
         uint64_t mMemoryLimit = 0; // 0 is unlimited
         uint64_t mSmallAllocMaxSize = 1024 * 1024; // big default value efficiently disables memory tracking
         bool mLogMemoryUsage = false;
+        bool mProfileHandlers = false;
     };
 
     // Holds Lua state.
@@ -116,6 +118,9 @@ namespace LuaUtil
         static void disableProfiler() { sProfilerEnabled = false; }
         static bool isProfilerEnabled() { return sProfilerEnabled; }
 
+        HandlerProfiler& getHandlerProfiler() { return mHandlerProfiler; }
+        const HandlerProfiler& getHandlerProfiler() const { return mHandlerProfiler; }
+
     private:
         static sol::protected_function_result throwIfError(sol::protected_function_result&&);
         template <typename... Args>
@@ -173,6 +178,7 @@ namespace LuaUtil
         std::map<std::string, sol::object> mCommonPackages;
         const VFS::Manager* mVFS;
         std::vector<std::filesystem::path> mLibSearchPaths;
+        HandlerProfiler mHandlerProfiler;
 
         static bool sProfilerEnabled;
     };
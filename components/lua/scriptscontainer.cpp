@@ -313,6 +313,8 @@ namespace LuaUtil
         for (int i = list.size() - 1; i >= 0; --i)
         {
             const Handler& h = list[i];
+            HandlerProfiler::Scope profilerScope(
+                mLua.getHandlerProfiler(), h.mScriptId, HandlerProfiler::HandlerType::Event, eventName);
             try
             {
                 sol::object res = LuaUtil::call({ this, h.mScriptId }, h.mFn, data);
@@ -550,6 +552,10 @@ namespace LuaUtil
 
     void ScriptsContainer::callTimer(const Timer& t)
     {
+        const std::string_view profiledName
+            = t.mSerializable ? std::string_view(std::get<std::string>(t.mCallback)) : std::string_view();
+        HandlerProfiler::Scope profilerScope(
+            mLua.getHandlerProfiler(), t.mScriptId, HandlerProfiler::HandlerType::Timer, profiledName);
         try
         {
             Script& script = getScript(t.mScriptId);
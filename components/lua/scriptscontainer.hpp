@@ -181,6 +181,8 @@ namespace LuaUtil
         {
             for (Handler& handler : handlers.mList)
             {
+                HandlerProfiler::Scope profilerScope(mLua.getHandlerProfiler(), handler.mScriptId,
+                    HandlerProfiler::HandlerType::EngineHandler, handlers.mName);
                 try
                 {
                     LuaUtil::call({ this, handler.mScriptId }, handler.mFn, args...);
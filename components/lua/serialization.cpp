@@ -1,5 +1,9 @@
 #include "serialization.hpp"
 
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
 #include <osg/Matrixf>
 #include <osg/Quat>
 #include <osg/Vec2f>
@@ -15,7 +19,10 @@
 namespace LuaUtil
 {
 
-    constexpr unsigned char FORMAT_VERSION = 0;
+    // Version 1 adds STRING_REF. Data that doesn't use it is still written as version 0, so it remains readable by
+    // older versions of the engine.
+    constexpr unsigned char FORMAT_VERSION = 1;
+    constexpr unsigned char FORMAT_VERSION_WITHOUT_DICTIONARY = 0;
 
     enum class SerializedType : char
     {
@@ -24,6 +31,7 @@ namespace LuaUtil
         BOOLEAN = 0x2,
         TABLE_START = 0x3,
         TABLE_END = 0x4,
+        STRING_REF = 0x5, // + 16bit index of a table key that was already written in full
 
         VEC2 = 0x10,
         VEC3 = 0x11,
@@ -38,6 +46,26 @@ namespace LuaUtil
     constexpr unsigned char CUSTOM_FULL_FLAG = 0x40; // 0b01TTTTTT + 32bit dataSize
     constexpr unsigned char CUSTOM_COMPACT_FLAG = 0x80; // 0b1SSSSTTT. SSSS = dataSize, TTT = (typeName size - 1)
 
+    // Table keys that are at least this long are added to the dictionary. Shorter keys are cheaper to write in full.
+    constexpr std::size_t MIN_DICTIONARY_KEY_SIZE = 3;
+    constexpr std::size_t MAX_DICTIONARY_SIZE = std::numeric_limits<uint16_t>::max() + 1;
+
+    namespace
+    {
+        // Both sides assign indices to table keys in the order they are written in full, so the dictionary itself
+        // is never stored.
+        struct SerializationState
+        {
+            std::unordered_map<std::string_view, uint16_t> mKeys;
+            bool mUsesDictionary = false;
+        };
+
+        struct DeserializationState
+        {
+            std::vector<std::string_view> mKeys;
+        };
+    }
+
     static void appendType(BinaryData& out, SerializedType type)
     {
         out.push_back(static_cast<char>(type));
@@ -195,8 +223,33 @@ namespace LuaUtil
             throw std::runtime_error("Value is not serializable.");
     }
 
-    static void serialize(
-        BinaryData& out, const sol::object& obj, const UserdataSerializer* customSerializer, int recursionCounter)
+    static void serialize(BinaryData& out, const sol::object& obj, const UserdataSerializer* customSerializer,
+        SerializationState& state, int recursionCounter);
+
+    static void serializeKey(BinaryData& out, const sol::object& key, const UserdataSerializer* customSerializer,
+        SerializationState& state, int recursionCounter)
+    {
+        if (key.get_type() != sol::type::string)
+            return serialize(out, key, customSerializer, state, recursionCounter);
+        std::string_view str = key.as<std::string_view>();
+        if (str.size() >= MIN_DICTIONARY_KEY_SIZE)
+        {
+            auto it = state.mKeys.find(str);
+            if (it != state.mKeys.end())
+            {
+                appendType(out, SerializedType::STRING_REF);
+                appendValue<uint16_t>(out, it->second);
+                state.mUsesDictionary = true;
+                return;
+            }
+            if (state.mKeys.size() < MAX_DICTIONARY_SIZE)
+                state.mKeys.emplace(str, static_cast<uint16_t>(state.mKeys.size()));
+        }
+        appendString(out, str);
+    }
+
+    static void serialize(BinaryData& out, const sol::object& obj, const UserdataSerializer* customSerializer,
+        SerializationState& state, int recursionCounter)
     {
         if (obj.get_type() == sol::type::lightuserdata)
             throw std::runtime_error("Light userdata is not allowed to be serialized.");
@@ -213,8 +266,8 @@ namespace LuaUtil
             appendType(out, SerializedType::TABLE_START);
             for (auto& [key, value] : table)
             {
-                serialize(out, key, customSerializer, recursionCounter + 1);
-                serialize(out, value, customSerializer, recursionCounter + 1);
+                serializeKey(out, key, customSerializer, state, recursionCounter + 1);
+                serialize(out, value, customSerializer, state, recursionCounter + 1);
             }
             appendType(out, SerializedType::TABLE_END);
         }
@@ -235,8 +288,39 @@ namespace LuaUtil
             throw std::runtime_error("Unknown Lua type.");
     }
 
-    static void deserializeImpl(
-        lua_State* lua, std::string_view& binaryData, const UserdataSerializer* customSerializer, bool readOnly)
+    static void deserializeImpl(lua_State* lua, std::string_view& binaryData,
+        const UserdataSerializer* customSerializer, DeserializationState& state, bool readOnly);
+
+    static void deserializeKey(lua_State* lua, std::string_view& binaryData,
+        const UserdataSerializer* customSerializer, DeserializationState& state, bool readOnly)
+    {
+        if (binaryData.empty())
+            throw std::runtime_error("Unexpected end of serialized data.");
+        const unsigned char type = binaryData[0];
+        if (type == static_cast<unsigned char>(SerializedType::STRING_REF))
+        {
+            binaryData = binaryData.substr(1);
+            const uint16_t index = getValue<uint16_t>(binaryData);
+            if (index >= state.mKeys.size())
+                throw std::runtime_error("Invalid string reference in serialized data: " + std::to_string(index));
+            sol::stack::push<std::string_view>(lua, state.mKeys[index]);
+            return;
+        }
+        const std::string_view before = binaryData;
+        deserializeImpl(lua, binaryData, customSerializer, state, readOnly);
+        const bool isString = type == static_cast<unsigned char>(SerializedType::LONG_STRING)
+            || (type & (CUSTOM_COMPACT_FLAG | CUSTOM_FULL_FLAG | SHORT_STRING_FLAG)) == SHORT_STRING_FLAG;
+        if (!isString || state.mKeys.size() >= MAX_DICTIONARY_SIZE)
+            return;
+        // The string data is always the tail of what was consumed, so the dictionary can refer to binaryData itself.
+        const std::size_t size = lua_rawlen(lua, -1);
+        const std::size_t consumed = before.size() - binaryData.size();
+        if (size >= MIN_DICTIONARY_KEY_SIZE)
+            state.mKeys.push_back(before.substr(consumed - size, size));
+    }
+
+    static void deserializeImpl(lua_State* lua, std::string_view& binaryData,
+        const UserdataSerializer* customSerializer, DeserializationState& state, bool readOnly)
     {
         if (binaryData.empty())
             throw std::runtime_error("Unexpected end of serialized data.");
@@ -289,8 +373,8 @@ namespace LuaUtil
                 lua_createtable(lua, 0, 0);
                 while (!binaryData.empty() && binaryData[0] != char(SerializedType::TABLE_END))
                 {
-                    deserializeImpl(lua, binaryData, customSerializer, readOnly);
-                    deserializeImpl(lua, binaryData, customSerializer, readOnly);
+                    deserializeKey(lua, binaryData, customSerializer, state, readOnly);
+                    deserializeImpl(lua, binaryData, customSerializer, state, readOnly);
                     lua_settable(lua, -3);
                 }
                 if (binaryData.empty())
@@ -302,6 +386,8 @@ namespace LuaUtil
             }
             case SerializedType::TABLE_END:
                 throw std::runtime_error("Unexpected end of table during deserialization.");
+            case SerializedType::STRING_REF:
+                throw std::runtime_error("String reference is only allowed as a table key.");
             case SerializedType::VEC2:
             {
                 float x = getValue<double>(binaryData);
@@ -356,13 +442,22 @@ namespace LuaUtil
         throw std::runtime_error("Unknown type in serialized data: " + std::to_string(type));
     }
 
-    BinaryData serialize(const sol::object& obj, const UserdataSerializer* customSerializer)
+    void serialize(BinaryData& out, const sol::object& obj, const UserdataSerializer* customSerializer)
     {
+        out.clear();
         if (obj == sol::nil)
-            return "";
+            return;
+        SerializationState state;
+        out.push_back(FORMAT_VERSION_WITHOUT_DICTIONARY);
+        serialize(out, obj, customSerializer, state, 0);
+        if (state.mUsesDictionary)
+            out[0] = FORMAT_VERSION;
+    }
+
+    BinaryData serialize(const sol::object& obj, const UserdataSerializer* customSerializer)
+    {
         BinaryData res;
-        res.push_back(FORMAT_VERSION);
-        serialize(res, obj, customSerializer, 0);
+        serialize(res, obj, customSerializer);
         return res;
     }
 
@@ -371,14 +466,34 @@ namespace LuaUtil
     {
         if (binaryData.empty())
             return sol::nil;
-        if (binaryData[0] != FORMAT_VERSION)
+        if (static_cast<unsigned char>(binaryData[0]) > FORMAT_VERSION)
             throw std::runtime_error("Incorrect version of Lua serialization format: "
                 + std::to_string(static_cast<unsigned>(binaryData[0])));
         binaryData = binaryData.substr(1);
-        deserializeImpl(lua, binaryData, customSerializer, readOnly);
+        DeserializationState state;
+        deserializeImpl(lua, binaryData, customSerializer, state, readOnly);
         if (!binaryData.empty())
             throw std::runtime_error("Unexpected data after serialized object");
         return sol::stack::pop<sol::object>(lua);
     }
 
+    BinaryData BinaryDataPool::acquire()
+    {
+        if (mBuffers.empty())
+            return BinaryData();
+        BinaryData result = std::move(mBuffers.back());
+        mBuffers.pop_back();
+        return result;
+    }
+
+    void BinaryDataPool::release(BinaryData&& data)
+    {
+        // Don't keep rare huge buffers alive, and don't bother with buffers that fit into the small string storage.
+        if (mBuffers.size() >= sMaxBuffers || data.capacity() > sMaxBufferCapacity
+            || data.capacity() <= BinaryData().capacity())
+            return;
+        data.clear();
+        mBuffers.push_back(std::move(data));
+    }
+
 }
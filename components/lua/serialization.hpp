@@ -51,9 +51,28 @@ namespace LuaUtil
     };
 
     BinaryData serialize(const sol::object&, const UserdataSerializer* customSerializer = nullptr);
+    // Replaces the content of `out`. Reuses its capacity, so together with BinaryDataPool it doesn't allocate.
+    void serialize(BinaryData& out, const sol::object&, const UserdataSerializer* customSerializer = nullptr);
     sol::object deserialize(lua_State* lua, std::string_view binaryData,
         const UserdataSerializer* customSerializer = nullptr, bool readOnly = false);
 
+    // Keeps the memory of released buffers for serialization of short-lived data like event payloads.
+    // Not thread-safe.
+    class BinaryDataPool
+    {
+    public:
+        BinaryData acquire();
+        void release(BinaryData&& data);
+
+        std::size_t size() const { return mBuffers.size(); }
+
+    private:
+        static constexpr std::size_t sMaxBuffers = 1024;
+        static constexpr std::size_t sMaxBufferCapacity = 64 * 1024;
+
+        std::vector<BinaryData> mBuffers;
+    };
+
 }
 
 #endif // COMPONENTS_LUA_SERIALIZATION_H
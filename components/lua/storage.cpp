@@ -1,9 +1,11 @@
 #include "storage.hpp"
 
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 
 #include <components/debug/debuglog.hpp>
+#include <components/misc/endianness.hpp>
 
 namespace sol
 {
@@ -15,6 +17,48 @@ namespace sol
 
 namespace LuaUtil
 {
+    namespace
+    {
+        // The file is a sequence of records (32bit name size, name, 32bit data size, serialized section). Later
+        // records override earlier ones, a record with empty data removes the section. Files without this header
+        // are a single serialized table of all sections, as written by older versions.
+        constexpr std::string_view storageFileHeader = "OMWLUAS1";
+
+        void appendSize(std::string& out, std::size_t size)
+        {
+            const std::uint32_t value = Misc::toLittleEndian(static_cast<std::uint32_t>(size));
+            out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        void appendRecord(std::string& out, std::string_view sectionName, std::string_view data)
+        {
+            appendSize(out, sectionName.size());
+            out.append(sectionName);
+            appendSize(out, data.size());
+            out.append(data);
+        }
+
+        std::size_t getRecordSize(std::string_view sectionName, std::string_view data)
+        {
+            return 2 * sizeof(std::uint32_t) + sectionName.size() + data.size();
+        }
+
+        std::string_view readRecordField(std::string_view& data)
+        {
+            std::uint32_t size;
+            if (data.size() < sizeof(size))
+                throw std::runtime_error("Unexpected end of storage file");
+            std::memcpy(&size, data.data(), sizeof(size));
+            size = Misc::fromLittleEndian(size);
+            data.remove_prefix(sizeof(size));
+            if (data.size() < size)
+                throw std::runtime_error("Unexpected end of storage file");
+            std::string_view result = data.substr(0, size);
+            data.remove_prefix(size);
+            return result;
+        }
+    }
+
     LuaStorage::Value LuaStorage::Section::sEmpty;
 
     sol::object LuaStorage::Value::getCopy(lua_State* L) const
@@ -62,9 +106,33 @@ namespace LuaUtil
                 "Too many subscribe callbacks triggering in a chain, likely an infinite recursion");
     }
 
+    void LuaStorage::Section::ensureLoaded()
+    {
+        if (mLoaded)
+            return;
+        mLoaded = true;
+        try
+        {
+            sol::table values = deserialize(mStorage->mLua, mSerializedData);
+            for (const auto& [key, value] : values)
+                mValues[key.as<std::string>()] = Value(value);
+        }
+        catch (std::exception& e)
+        {
+            Log(Debug::Error) << "Can not read Lua storage section \"" << mSectionName << "\": " << e.what();
+        }
+    }
+
+    void LuaStorage::Section::markDirty()
+    {
+        mDirty = true;
+        mSerializedData.clear();
+    }
+
     void LuaStorage::Section::set(std::string_view key, const sol::object& value)
     {
         throwIfCallbackRecursionIsTooDeep();
+        markDirty();
         if (value != sol::nil)
             mValues[std::string(key)] = Value(value);
         else
@@ -81,6 +149,7 @@ namespace LuaUtil
     void LuaStorage::Section::setAll(const sol::optional<sol::table>& values)
     {
         throwIfCallbackRecursionIsTooDeep();
+        markDirty();
         mValues.clear();
         if (values)
         {
@@ -130,6 +199,7 @@ namespace LuaUtil
             if (section.mReadOnly)
                 throw std::runtime_error("Access to storage is read only");
             section.mSection->mPermanent = false;
+            section.mSection->markDirty();
         };
         sview["set"] = [](const SectionView& section, std::string_view key, const sol::object& value) {
             if (section.mReadOnly)
@@ -146,6 +216,8 @@ namespace LuaUtil
             it->second->mCallbacks.clear();
             if (!it->second->mPermanent)
             {
+                if (it->second->mPersisted)
+                    mRemovedSections.push_back(it->second->mSectionName);
                 it->second->mValues.clear();
                 it = mData.erase(it);
             }
@@ -163,6 +235,13 @@ namespace LuaUtil
                              << " bytes)";
             std::ifstream fin(path, std::fstream::binary);
             std::string serializedData((std::istreambuf_iterator<char>(fin)), std::istreambuf_iterator<char>());
+            if (std::string_view(serializedData).starts_with(storageFileHeader))
+            {
+                loadRecords(std::string_view(serializedData).substr(storageFileHeader.size()));
+                mFilePath = path;
+                mFileSize = serializedData.size();
+                return;
+            }
             sol::table data = deserialize(mLua, serializedData);
             for (const auto& [sectionName, sectionTable] : data)
             {
@@ -177,22 +256,97 @@ namespace LuaUtil
         }
     }
 
-    void LuaStorage::save(const std::filesystem::path& path) const
+    void LuaStorage::loadRecords(std::string_view data)
+    {
+        while (!data.empty())
+        {
+            const std::string_view sectionName = readRecordField(data);
+            const std::string_view sectionData = readRecordField(data);
+            if (sectionData.empty())
+            {
+                auto it = mData.find(sectionName);
+                if (it != mData.end())
+                    mData.erase(it);
+                continue;
+            }
+            const std::shared_ptr<Section>& section = getOrCreateSection(sectionName);
+            section->mValues.clear();
+            section->mSerializedData = sectionData;
+            section->mLoaded = false;
+            section->mPersisted = true;
+        }
+    }
+
+    void LuaStorage::save(const std::filesystem::path& path)
+    {
+        std::string records;
+        for (const std::string& sectionName : mRemovedSections)
+            appendRecord(records, sectionName, {});
+        mRemovedSections.clear();
+
+        std::size_t actualSize = storageFileHeader.size();
+        for (const auto& [sectionName, section] : mData)
+        {
+            if (section->mDirty)
+            {
+                section->mDirty = false;
+                if (section->mPermanent && !section->mValues.empty())
+                {
+                    section->mSerializedData = serialize(section->asTable());
+                    section->mPersisted = true;
+                }
+                else if (section->mPersisted)
+                    section->mPersisted = false;
+                else
+                    continue;
+                appendRecord(records, sectionName, section->mSerializedData);
+            }
+            if (section->mPersisted)
+                actualSize += getRecordSize(sectionName, section->mSerializedData);
+        }
+
+        if (path != mFilePath || !std::filesystem::exists(path) || mFileSize + records.size() > 2 * actualSize)
+        {
+            writeAllRecords(path);
+            return;
+        }
+        if (records.empty())
+            return;
+        Log(Debug::Info) << "Appending " << records.size() << " bytes to Lua storage \"" << path << "\"";
+        std::ofstream fout(path, std::fstream::binary | std::fstream::app);
+        fout.write(records.data(), records.size());
+        fout.close();
+        mFileSize += records.size();
+    }
+
+    void LuaStorage::writeAllRecords(const std::filesystem::path& path)
     {
-        sol::table data(mLua, sol::create);
+        std::string serializedData(storageFileHeader);
         for (const auto& [sectionName, section] : mData)
         {
-            if (section->mPermanent && !section->mValues.empty())
-                data[sectionName] = section->asTable();
+            if (section->mPersisted)
+                appendRecord(serializedData, sectionName, section->mSerializedData);
         }
-        std::string serializedData = serialize(data);
         Log(Debug::Info) << "Saving Lua storage \"" << path << "\" (" << serializedData.size() << " bytes)";
-        std::ofstream fout(path, std::fstream::binary);
+        // Write to a temporary file first to not lose the storage if the game is closed in the middle of saving.
+        std::filesystem::path tmpPath = path;
+        tmpPath += ".tmp";
+        std::ofstream fout(tmpPath, std::fstream::binary);
         fout.write(serializedData.data(), serializedData.size());
         fout.close();
+        std::filesystem::rename(tmpPath, path);
+        mFilePath = path;
+        mFileSize = serializedData.size();
     }
 
     const std::shared_ptr<LuaStorage::Section>& LuaStorage::getSection(std::string_view sectionName)
+    {
+        const std::shared_ptr<Section>& section = getOrCreateSection(sectionName);
+        section->ensureLoaded();
+        return section;
+    }
+
+    const std::shared_ptr<LuaStorage::Section>& LuaStorage::getOrCreateSection(std::string_view sectionName)
     {
         auto it = mData.find(sectionName);
         if (it != mData.end())
@@ -1,6 +1,7 @@
 #ifndef COMPONENTS_LUA_STORAGE_H
 #define COMPONENTS_LUA_STORAGE_H
 
+#include <filesystem>
 #include <map>
 #include <sol/sol.hpp>
 
@@ -21,8 +22,11 @@ namespace LuaUtil
         }
 
         void clearTemporaryAndRemoveCallbacks();
+        // Sections are deserialized lazily on the first access.
         void load(const std::filesystem::path& path);
-        void save(const std::filesystem::path& path) const;
+        // Appends sections changed since the previous load or save to the file. The whole file is rewritten if it
+        // is not the one used before, or if outdated records take more space than the actual data.
+        void save(const std::filesystem::path& path);
 
         sol::object getSection(std::string_view sectionName, bool readOnly);
         sol::object getMutableSection(std::string_view sectionName) { return getSection(sectionName, false); }
@@ -78,12 +82,19 @@ namespace LuaUtil
             sol::table asTable();
             void runCallbacks(sol::optional<std::string_view> changedKey);
             void throwIfCallbackRecursionIsTooDeep();
+            void ensureLoaded();
+            void markDirty();
 
             LuaStorage* mStorage;
             std::string mSectionName;
             std::map<std::string, Value, std::less<>> mValues;
             std::vector<Callback> mCallbacks;
             bool mPermanent = true;
+            // Serialized section as it is stored in the file. Empty if the section is dirty or not persisted.
+            std::string mSerializedData;
+            bool mLoaded = true;
+            bool mDirty = false;
+            bool mPersisted = false;
             static Value sEmpty;
         };
         struct SectionView
@@ -93,11 +104,18 @@ namespace LuaUtil
         };
 
         const std::shared_ptr<Section>& getSection(std::string_view sectionName);
+        const std::shared_ptr<Section>& getOrCreateSection(std::string_view sectionName);
+        void loadRecords(std::string_view data);
+        void writeAllRecords(const std::filesystem::path& path);
 
         lua_State* mLua;
         std::map<std::string_view, std::shared_ptr<Section>> mData;
         const Listener* mListener = nullptr;
         std::set<const Section*> mRunningCallbacks;
+        // Persisted sections that were removed, but are still present in the file.
+        std::vector<std::string> mRemovedSections;
+        std::filesystem::path mFilePath;
+        std::size_t mFileSize = 0;
     };
 
 }
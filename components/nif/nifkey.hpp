@@ -3,7 +3,12 @@
 #ifndef OPENMW_COMPONENTS_NIF_NIFKEY_HPP
 #define OPENMW_COMPONENTS_NIF_NIFKEY_HPP
 
-#include <map>
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <numeric>
+#include <type_traits>
+#include <vector>
 
 #include "exception.hpp"
 #include "niffile.hpp"
@@ -41,16 +46,38 @@ namespace Nif
     using Vector4Key = KeyT<osg::Vec4f>;
     using QuaternionKey = KeyT<osg::Quat>;
 
+    // Keyframe track stored as two arrays sorted by time to keep lookups cache friendly: mTimes has unique key times
+    // in ascending order and mKeys has corresponding values. Quaternion values are normalized on read.
     template <typename T, T (NIFStream::*getValue)()>
     struct KeyMapT
     {
-        using MapType = std::map<float, KeyT<T>>;
-
         using ValueType = T;
         using KeyType = KeyT<T>;
 
+        // Tracks up to this size are searched linearly
+        static constexpr std::size_t sLinearSearchMaxSize = 32;
+
         unsigned int mInterpolationType = InterpolationType_Unknown;
-        MapType mKeys;
+        std::vector<float> mTimes;
+        std::vector<KeyType> mKeys;
+
+        std::size_t size() const { return mTimes.size(); }
+
+        bool empty() const { return mTimes.empty(); }
+
+        // Returns index of the first key with time not less than the given one or size() if there is no such key
+        std::size_t lowerBound(float time) const
+        {
+            if (mTimes.size() <= sLinearSearchMaxSize)
+            {
+                // Branchless count over contiguous floats is vectorized by the compiler
+                std::size_t result = 0;
+                for (const float keyTime : mTimes)
+                    result += static_cast<std::size_t>(keyTime < time);
+                return result;
+            }
+            return static_cast<std::size_t>(std::lower_bound(mTimes.begin(), mTimes.end(), time) - mTimes.begin());
+        }
 
         // Read in a KeyGroup (see http://niftools.sourceforge.net/doc/nif/NiKeyframeData.html)
         void read(NIFStream* nif, bool morph = false)
@@ -81,7 +108,8 @@ namespace Nif
                 {
                     float time = nif->getFloat();
                     readValue(*nif, key);
-                    mKeys[time] = key;
+                    mTimes.push_back(time);
+                    mKeys.push_back(key);
                 }
             }
             else if (mInterpolationType == InterpolationType_Quadratic)
@@ -90,7 +118,8 @@ namespace Nif
                 {
                     float time = nif->getFloat();
                     readQuadratic(*nif, key);
-                    mKeys[time] = key;
+                    mTimes.push_back(time);
+                    mKeys.push_back(key);
                 }
             }
             else if (mInterpolationType == InterpolationType_TBC)
@@ -99,7 +128,8 @@ namespace Nif
                 {
                     float time = nif->getFloat();
                     readTBC(*nif, key);
-                    mKeys[time] = key;
+                    mTimes.push_back(time);
+                    mKeys.push_back(key);
                 }
             }
             else if (mInterpolationType == InterpolationType_XYZ)
@@ -116,9 +146,49 @@ namespace Nif
                 throw Nif::Exception("Unhandled interpolation type: " + std::to_string(mInterpolationType),
                     nif->getFile().getFilename());
             }
+
+            sortKeys();
+
+            if constexpr (std::is_same_v<T, osg::Quat>)
+                for (KeyType& v : mKeys)
+                    normalize(v.mValue);
         }
 
     private:
+        // Orders keys by time leaving only the last one of keys with the same time
+        void sortKeys()
+        {
+            if (std::adjacent_find(mTimes.begin(), mTimes.end(), std::greater_equal<>()) == mTimes.end())
+                return;
+            std::vector<std::size_t> order(mTimes.size());
+            std::iota(order.begin(), order.end(), std::size_t{ 0 });
+            std::stable_sort(
+                order.begin(), order.end(), [&](std::size_t l, std::size_t r) { return mTimes[l] < mTimes[r]; });
+            std::vector<float> times;
+            std::vector<KeyType> keys;
+            times.reserve(order.size());
+            keys.reserve(order.size());
+            for (const std::size_t i : order)
+            {
+                if (!times.empty() && times.back() == mTimes[i])
+                {
+                    keys.back() = mKeys[i];
+                    continue;
+                }
+                times.push_back(mTimes[i]);
+                keys.push_back(mKeys[i]);
+            }
+            mTimes = std::move(times);
+            mKeys = std::move(keys);
+        }
+
+        static void normalize(osg::Quat& value)
+        {
+            const double length = value.length();
+            if (length > 0)
+                value /= length;
+        }
+
         static void readValue(NIFStream& nif, KeyT<T>& key) { key.mValue = (nif.*getValue)(); }
 
         template <typename U>
@@ -9,8 +9,11 @@
 #include <components/sceneutil/nodecallback.hpp>
 #include <components/sceneutil/statesetupdater.hpp>
 
+#include <cstddef>
+#include <limits>
 #include <set>
 #include <type_traits>
+#include <vector>
 
 #include <osg/Texture2D>
 
@@ -39,23 +42,24 @@ namespace NifOsg
     template <typename MapT>
     class ValueInterpolator
     {
-        typename MapT::MapType::const_iterator retrieveKey(float time) const
+        std::size_t retrieveKey(float time) const
         {
-            // retrieve the current position in the map, optimized for the most common case
+            // retrieve the current position in the track, optimized for the most common case
             // where time moves linearly along the keyframe track
-            if (mLastHighKey != mKeys->mKeys.end())
+            const std::vector<float>& times = mKeys->mTimes;
+            if (mLastHighKey < times.size())
             {
-                if (time > mLastHighKey->first)
+                std::size_t highKey = mLastHighKey;
+                if (time > times[highKey])
                 {
                     // try if we're there by incrementing one
-                    ++mLastLowKey;
-                    ++mLastHighKey;
+                    ++highKey;
                 }
-                if (mLastHighKey != mKeys->mKeys.end() && time >= mLastLowKey->first && time <= mLastHighKey->first)
-                    return mLastHighKey;
+                if (highKey < times.size() && time >= times[highKey - 1] && time <= times[highKey])
+                    return highKey;
             }
 
-            return mKeys->mKeys.lower_bound(time);
+            return mKeys->lowerBound(time);
         }
 
     public:
@@ -76,22 +80,12 @@ namespace NifOsg
             if (interpolator->data.empty())
                 return;
             mKeys = interpolator->data->mKeyList;
-            if (mKeys)
-            {
-                mLastLowKey = mKeys->mKeys.end();
-                mLastHighKey = mKeys->mKeys.end();
-            }
         }
 
         ValueInterpolator(std::shared_ptr<const MapT> keys, ValueT defaultVal = ValueT())
             : mKeys(keys)
             , mDefaultVal(defaultVal)
         {
-            if (keys)
-            {
-                mLastLowKey = mKeys->mKeys.end();
-                mLastHighKey = mKeys->mKeys.end();
-            }
         }
 
         ValueT interpKey(float time) const
@@ -99,29 +93,30 @@ namespace NifOsg
             if (empty())
                 return mDefaultVal;
 
-            const typename MapT::MapType& keys = mKeys->mKeys;
+            const std::vector<float>& times = mKeys->mTimes;
+            const std::vector<typename MapT::KeyType>& keys = mKeys->mKeys;
 
-            if (time <= keys.begin()->first)
-                return keys.begin()->second.mValue;
+            if (time <= times.front())
+                return keys.front().mValue;
 
-            typename MapT::MapType::const_iterator it = retrieveKey(time);
+            const std::size_t highKey = retrieveKey(time);
 
             // now do the actual interpolation
-            if (it != keys.end())
+            if (highKey < times.size())
             {
                 // cache for next time
-                mLastHighKey = it;
-                mLastLowKey = --it;
+                mLastHighKey = highKey;
+                const std::size_t lowKey = highKey - 1;
 
-                float a = (time - mLastLowKey->first) / (mLastHighKey->first - mLastLowKey->first);
+                float a = (time - times[lowKey]) / (times[highKey] - times[lowKey]);
 
-                return interpolate(mLastLowKey->second, mLastHighKey->second, a, mKeys->mInterpolationType);
+                return interpolate(keys[lowKey], keys[highKey], a, mKeys->mInterpolationType);
             }
 
-            return keys.rbegin()->second.mValue;
+            return keys.back().mValue;
         }
 
-        bool empty() const { return !mKeys || mKeys->mKeys.empty(); }
+        bool empty() const { return !mKeys || mKeys->empty(); }
 
     private:
         template <typename ValueType>
@@ -171,8 +166,8 @@ namespace NifOsg
             }
         }
 
-        mutable typename MapT::MapType::const_iterator mLastLowKey;
-        mutable typename MapT::MapType::const_iterator mLastHighKey;
+        // Index of the upper key used last time, the lower one precedes it
+        mutable std::size_t mLastHighKey = std::numeric_limits<std::size_t>::max();
 
         std::shared_ptr<const MapT> mKeys;
 
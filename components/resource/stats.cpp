@@ -14,6 +14,7 @@
 #include <osgViewer/Renderer>
 #include <osgViewer/Viewer>
 
+#include <components/detournavigator/stats.hpp>
 #include <components/vfs/manager.hpp>
 
 namespace Resource
@@ -418,52 +419,65 @@ namespace Resource
             _resourceStatsChildNum = _switch->getNumChildren();
             _switch->addChild(group, false);
 
-            static const std::vector<std::string> statNames({
-                "FrameNumber",
-                "",
-                "Compiling",
-                "WorkQueue",
-                "WorkThread",
-                "UnrefQueue",
-                "",
-                "Texture",
-                "StateSet",
-                "Node",
-                "Shape",
-                "Shape Instance",
-                "Image",
-                "Nif",
-                "Keyframe",
-                "",
-                "Groundcover Chunk",
-                "Object Chunk",
-                "Terrain Chunk",
-                "Terrain Texture",
-                "Land",
-                "Composite",
-                "",
-                "NavMesh Jobs",
-                "NavMesh Waiting",
-                "NavMesh Pushed",
-                "NavMesh Processing",
-                "NavMesh DbJobs Write",
-                "NavMesh DbJobs Read",
-                "NavMesh DbCacheHitRate",
-                "NavMesh CacheSize",
-                "NavMesh UsedTiles",
-                "NavMesh CachedTiles",
-                "NavMesh CacheHitRate",
-                "",
-                "Mechanics Actors",
-                "Mechanics Objects",
-                "",
-                "Physics Actors",
-                "Physics Objects",
-                "Physics Projectiles",
-                "Physics HeightFields",
-                "",
-                "Lua UsedMemory",
-            });
+            static const std::vector<std::string> statNames = [] {
+                std::vector<std::string> result({
+                    "FrameNumber",
+                    "",
+                    "Compiling",
+                    "WorkQueue",
+                    "WorkThread",
+                    "UnrefQueue",
+                    "",
+                    "Texture",
+                    "StateSet",
+                    "Node",
+                    "Shape",
+                    "Shape Instance",
+                    "Image",
+                    "Nif",
+                    "Keyframe",
+                    "",
+                    "Groundcover Chunk",
+                    "Object Chunk",
+                    "Terrain Chunk",
+                    "Terrain Texture",
+                    "Land",
+                    "Composite",
+                    "Terrain Views",
+                    "Terrain Traversal",
+                    "",
+                    "NavMesh Jobs",
+                    "NavMesh Waiting",
+                    "NavMesh Pushed",
+                    "NavMesh Processing",
+                    "NavMesh Cancelled",
+                });
+                const auto& latencyNames = DetourNavigator::getJobLatencyStatNames();
+                result.insert(result.end(), latencyNames.begin(), latencyNames.end());
+                result.insert(result.end(), {
+                    "NavMesh DbJobs Write",
+                    "NavMesh DbJobs Read",
+                    "NavMesh DbCacheHitRate",
+                    "NavMesh CacheSize",
+                    "NavMesh UsedTiles",
+                    "NavMesh CachedTiles",
+                    "NavMesh CacheHitRate",
+                    "",
+                    "Mechanics Actors",
+                    "Mechanics AnimationLod",
+                    "Mechanics Objects",
+                    "",
+                    "Physics Actors",
+                    "Physics Objects",
+                    "Physics Projectiles",
+                    "Physics HeightFields",
+                    "",
+                    "Lua UsedMemory",
+                    "",
+                    "GUI BookLayout",
+                });
+                return result;
+            }();
 
             static const auto longest = std::max_element(statNames.begin(), statNames.end(),
                 [](const std::string& lhs, const std::string& rhs) { return lhs.size() < rhs.size(); });
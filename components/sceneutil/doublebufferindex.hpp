@@ -0,0 +1,27 @@
+#ifndef OPENMW_COMPONENTS_SCENEUTIL_DOUBLEBUFFERINDEX_H
+#define OPENMW_COMPONENTS_SCENEUTIL_DOUBLEBUFFERINDEX_H
+
+namespace SceneUtil
+{
+    /// @brief Selects which of two buffers to write and which to draw.
+    /// @par The index is toggled on each write rather than derived from the frame number, so a buffer drawn in the
+    /// previous frame is never overwritten even when some frames reuse the last result.
+    class DoubleBufferIndex
+    {
+    public:
+        /// Buffer holding the most recently written data.
+        unsigned int getCurrent() const { return mCurrent; }
+
+        /// Switch to the other buffer and return it for writing.
+        unsigned int next()
+        {
+            mCurrent ^= 1;
+            return mCurrent;
+        }
+
+    private:
+        unsigned int mCurrent = 0;
+    };
+}
+
+#endif
@@ -201,16 +201,17 @@ namespace SceneUtil
         }
 
         unsigned int traversalNumber = nv->getTraversalNumber();
-        if (mLastFrameNumber == traversalNumber || (mLastFrameNumber != 0 && !mSkeleton->getActive()))
+        if (mLastFrameNumber == traversalNumber
+            || (mLastFrameNumber != 0 && (!mSkeleton->getActive() || mSkeleton->isUpdateSkipped(mLastFrameNumber))))
         {
-            osg::Geometry& geom = *getGeometry(mLastFrameNumber);
+            osg::Geometry& geom = *mGeometry[mGeometryIndex.getCurrent()];
             nv->pushOntoNodePath(&geom);
             nv->apply(geom);
             nv->popFromNodePath();
             return;
         }
         mLastFrameNumber = traversalNumber;
-        osg::Geometry& geom = *getGeometry(mLastFrameNumber);
+        osg::Geometry& geom = *mGeometry[mGeometryIndex.next()];
 
         mSkeleton->updateBoneMatrices(traversalNumber);
 
@@ -404,12 +405,7 @@ namespace SceneUtil
 
     void RigGeometry::accept(osg::PrimitiveFunctor& func) const
     {
-        getGeometry(mLastFrameNumber)->accept(func);
-    }
-
-    osg::Geometry* RigGeometry::getGeometry(unsigned int frame) const
-    {
-        return mGeometry[frame % 2].get();
+        mGeometry[mGeometryIndex.getCurrent()]->accept(func);
     }
 
 }
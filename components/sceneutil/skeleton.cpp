@@ -49,6 +49,7 @@ namespace SceneUtil
         , mActive(copy.mActive)
         , mLastFrameNumber(0)
         , mLastCullFrameNumber(0)
+        , mUpdateInterval(copy.mUpdateInterval)
     {
     }
 
@@ -121,9 +122,20 @@ namespace SceneUtil
         return mActive != Inactive;
     }
 
+    void Skeleton::setUpdateInterval(unsigned int interval)
+    {
+        mUpdateInterval = std::max(interval, 1u);
+    }
+
+    bool Skeleton::isUpdateSkipped(unsigned int frameNumber) const
+    {
+        return mUpdateInterval > 1 && mLastUpdateFrameNumber != 0 && mLastUpdateFrameNumber <= frameNumber;
+    }
+
     void Skeleton::markDirty()
     {
         mLastFrameNumber = 0;
+        mLastUpdateFrameNumber = 0;
         mBoneCache.clear();
         mBoneCacheInit = false;
     }
@@ -136,6 +148,11 @@ namespace SceneUtil
                 return;
             if (mActive == SemiActive && mLastFrameNumber != 0 && mLastCullFrameNumber + 3 <= nv.getTraversalNumber())
                 return;
+            // Distant actors don't need smooth animation, unchanged bones also let child rigs skip skinning
+            if (mUpdateInterval > 1 && mLastFrameNumber != 0 && mLastUpdateFrameNumber != 0
+                && nv.getTraversalNumber() - mLastUpdateFrameNumber < mUpdateInterval)
+                return;
+            mLastUpdateFrameNumber = nv.getTraversalNumber();
         }
         else if (nv.getVisitorType() == osg::NodeVisitor::CULL_VISITOR)
             mLastCullFrameNumber = nv.getTraversalNumber();
@@ -56,6 +56,14 @@ namespace SceneUtil
 
         bool getActive() const;
 
+        /// Update bones only every \a interval frames. Child rigs are not skinned again until the next update.
+        /// @note The update traversal of the whole subtree is skipped in between, and poses are not interpolated.
+        void setUpdateInterval(unsigned int interval);
+
+        /// Return true if bones are throttled by the update interval and were not updated after \a frameNumber,
+        /// so the result of skinning in that frame can be reused.
+        bool isUpdateSkipped(unsigned int frameNumber) const;
+
         void traverse(osg::NodeVisitor& nv) override;
 
         void markDirty();
@@ -78,6 +86,9 @@ namespace SceneUtil
 
         unsigned int mLastFrameNumber;
         unsigned int mLastCullFrameNumber;
+
+        unsigned int mUpdateInterval = 1;
+        unsigned int mLastUpdateFrameNumber = 0;
     };
 
 }
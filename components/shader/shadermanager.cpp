@@ -4,6 +4,7 @@
 #include <chrono>
 #include <components/debug/debuglog.hpp>
 #include <components/files/conversion.hpp>
+#include <components/misc/hash.hpp>
 #include <components/misc/strings/algorithm.hpp>
 #include <components/misc/strings/format.hpp>
 #include <components/settings/settings.hpp>
@@ -553,6 +554,28 @@ namespace Shader
         return found->second;
     }
 
+    std::optional<osg::ref_ptr<osg::Program>> ShaderManager::getPermutation(const PermutationKey& key)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        const auto found = mPermutations.find(key);
+        if (found == mPermutations.end())
+            return std::nullopt;
+        return found->second;
+    }
+
+    void ShaderManager::addPermutation(const PermutationKey& key, osg::ref_ptr<osg::Program> program)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mPermutations.emplace(key, std::move(program));
+    }
+
+    std::size_t ShaderManager::PermutationKeyHash::operator()(const PermutationKey& key) const
+    {
+        std::size_t seed = std::hash<std::string>()(key.mShaderPrefix);
+        Misc::hashCombine(seed, key.mDefines);
+        return seed;
+    }
+
     osg::ref_ptr<osg::Program> ShaderManager::cloneProgram(const osg::Program* src)
     {
         osg::ref_ptr<osg::Program> program = static_cast<osg::Program*>(src->clone(osg::CopyOp::SHALLOW_COPY));
@@ -2,10 +2,13 @@
 #define OPENMW_COMPONENTS_SHADERMANAGER_H
 
 #include <array>
+#include <bitset>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <osg/ref_ptr>
@@ -47,6 +50,27 @@ namespace Shader
         osg::ref_ptr<osg::Program> getProgram(osg::ref_ptr<osg::Shader> vertexShader,
             osg::ref_ptr<osg::Shader> fragmentShader, const osg::Program* programTemplate = nullptr);
 
+        /// Compact identifier of a program permutation: the shader template prefix and the defines selecting the
+        /// permutation packed into a bitset. Meaning of the bits is up to the caller, equal keys must always stand
+        /// for the same defines.
+        struct PermutationKey
+        {
+            std::string mShaderPrefix;
+            std::bitset<64> mDefines;
+
+            bool operator==(const PermutationKey& other) const = default;
+        };
+
+        /// Retrieve the program stored for the permutation by addPermutation.
+        /// @return std::nullopt if there is no such permutation yet. The program is nullptr if shaders for the
+        /// permutation failed to compile.
+        /// @note Thread safe.
+        std::optional<osg::ref_ptr<osg::Program>> getPermutation(const PermutationKey& key);
+
+        /// Store the program created for the permutation to find it without building a DefineMap again.
+        /// @note Thread safe.
+        void addPermutation(const PermutationKey& key, osg::ref_ptr<osg::Program> program);
+
         const osg::Program* getProgramTemplate() const { return mProgramTemplate; }
         void setProgramTemplate(const osg::Program* program) { mProgramTemplate = program; }
 
@@ -105,6 +129,14 @@ namespace Shader
             ProgramMap;
         ProgramMap mPrograms;
 
+        struct PermutationKeyHash
+        {
+            std::size_t operator()(const PermutationKey& key) const;
+        };
+
+        // Programs are never removed and shaders are updated in place, so the stored programs stay valid
+        std::unordered_map<PermutationKey, osg::ref_ptr<osg::Program>, PermutationKeyHash> mPermutations;
+
         typedef std::vector<osg::ref_ptr<osg::Shader>> ShaderList;
         typedef std::map<osg::ref_ptr<osg::Shader>, ShaderList> LinkedShadersMap;
         LinkedShadersMap mLinkedShaders;
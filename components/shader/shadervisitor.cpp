@@ -1,5 +1,6 @@
 #include "shadervisitor.hpp"
 
+#include <optional>
 #include <set>
 #include <unordered_map>
 #include <unordered_set>
@@ -25,6 +26,7 @@
 #include <components/sceneutil/morphgeometry.hpp>
 #include <components/sceneutil/riggeometry.hpp>
 #include <components/sceneutil/riggeometryosgaextension.hpp>
+#include <components/stereo/multiview.hpp>
 #include <components/stereo/stereomanager.hpp>
 #include <components/vfs/manager.hpp>
 
@@ -286,6 +288,106 @@ namespace Shader
         return std::find(std::begin(defaultTextures), std::end(defaultTextures), name) != std::end(defaultTextures);
     }
 
+    // Defines picked by ShaderVisitor::createProgram in addition to the ones for textures
+    struct ProgramDefines
+    {
+        bool mParallax = false;
+        GLenum mAlphaFunc = GL_ALWAYS;
+        bool mAdditiveBlending = false;
+        bool mAlphaToCoverage = false;
+        bool mAdjustCoverage = false;
+        bool mUseGPUShader4 = false;
+        bool mSimpleLighting = false;
+        bool mNoForcedPPL = false;
+        bool mDisableNormals = false;
+        bool mSoftParticles = false;
+    };
+
+    ShaderManager::DefineMap makeDefineMap(const std::map<int, std::string>& textures, const ProgramDefines& defines)
+    {
+        ShaderManager::DefineMap defineMap;
+        for (const char* name : defaultTextures)
+        {
+            defineMap[name] = "0";
+            defineMap[std::string(name) + "UV"] = "0";
+        }
+        for (const auto& [unit, name] : textures)
+        {
+            defineMap[name] = "1";
+            defineMap[name + "UV"] = std::to_string(unit);
+        }
+
+        defineMap["parallax"] = defines.mParallax ? "1" : "0";
+        defineMap["alphaFunc"] = std::to_string(defines.mAlphaFunc);
+        defineMap["additiveBlending"] = defines.mAdditiveBlending ? "1" : "0";
+        defineMap["alphaToCoverage"] = defines.mAlphaToCoverage ? "1" : "0";
+        defineMap["adjustCoverage"] = defines.mAdjustCoverage ? "1" : "0";
+        if (defines.mUseGPUShader4)
+            defineMap["useGPUShader4"] = "1";
+        if (defines.mSimpleLighting)
+            defineMap["endLight"] = "0";
+        if (defines.mNoForcedPPL)
+            defineMap["forcePPL"] = "0";
+        if (defines.mDisableNormals)
+            defineMap["disableNormals"] = "1";
+        defineMap["softParticles"] = defines.mSoftParticles ? "1" : "0";
+
+        Stereo::Manager::instance().shaderStereoDefines(defineMap);
+
+        return defineMap;
+    }
+
+    // Packs the same information as makeDefineMap into a bitset. Every recognized texture gets a field holding its
+    // unit + 1 or 0 when it's absent. Returns std::nullopt for permutations that don't fit.
+    std::optional<ShaderManager::PermutationKey> makePermutationKey(
+        const std::string& shaderPrefix, const std::map<int, std::string>& textures, const ProgramDefines& defines)
+    {
+        constexpr std::size_t unitBits = 4;
+        constexpr std::size_t alphaFuncBits = 3;
+        constexpr std::size_t texturesBits = std::size(defaultTextures) * unitBits;
+        static_assert(texturesBits + alphaFuncBits + 10 <= 64);
+
+        ShaderManager::PermutationKey key{ shaderPrefix, {} };
+        const auto setField = [&](std::size_t offset, std::size_t size, unsigned value) {
+            for (std::size_t i = 0; i < size; ++i)
+                key.mDefines[offset + i] = (value >> i) & 1;
+        };
+
+        for (const auto& [unit, name] : textures)
+        {
+            const auto it = std::find(std::begin(defaultTextures), std::end(defaultTextures), name);
+            if (it == std::end(defaultTextures) || unit < 0 || unit + 1 >= (1 << unitBits))
+                return std::nullopt;
+            const std::size_t index = static_cast<std::size_t>(it - std::begin(defaultTextures));
+            setField(index * unitBits, unitBits, static_cast<unsigned>(unit + 1));
+        }
+
+        if (defines.mAlphaFunc < GL_NEVER || defines.mAlphaFunc > GL_ALWAYS)
+            return std::nullopt;
+        setField(texturesBits, alphaFuncBits, defines.mAlphaFunc - GL_NEVER);
+
+        std::size_t offset = texturesBits + alphaFuncBits;
+        for (const bool flag : { defines.mParallax, defines.mAdditiveBlending, defines.mAlphaToCoverage,
+                 defines.mAdjustCoverage, defines.mUseGPUShader4, defines.mSimpleLighting, defines.mNoForcedPPL,
+                 defines.mDisableNormals, defines.mSoftParticles, Stereo::getMultiview() })
+            key.mDefines[offset++] = flag;
+
+        return key;
+    }
+
+    osg::ref_ptr<osg::Program> makeProgram(ShaderManager& shaderManager, const std::string& shaderPrefix,
+        const std::map<int, std::string>& textures, const ProgramDefines& defines, const osg::Program* programTemplate)
+    {
+        const ShaderManager::DefineMap defineMap = makeDefineMap(textures, defines);
+        osg::ref_ptr<osg::Shader> vertexShader(
+            shaderManager.getShader(shaderPrefix + "_vertex.glsl", defineMap, osg::Shader::VERTEX));
+        osg::ref_ptr<osg::Shader> fragmentShader(
+            shaderManager.getShader(shaderPrefix + "_fragment.glsl", defineMap, osg::Shader::FRAGMENT));
+        if (!vertexShader || !fragmentShader)
+            return nullptr;
+        return shaderManager.getProgram(vertexShader, fragmentShader, programTemplate);
+    }
+
     void ShaderVisitor::applyStateSet(osg::ref_ptr<osg::StateSet> stateset, osg::Node& node)
     {
         osg::StateSet* writableStateSet = nullptr;
@@ -593,33 +695,24 @@ namespace Shader
         if (!previousAddedState)
             previousAddedState = new AddedState;
 
-        ShaderManager::DefineMap defineMap;
-        for (unsigned int i = 0; i < sizeof(defaultTextures) / sizeof(defaultTextures[0]); ++i)
-        {
-            defineMap[defaultTextures[i]] = "0";
-            defineMap[std::string(defaultTextures[i]) + std::string("UV")] = "0";
-        }
-        for (std::map<int, std::string>::const_iterator texIt = reqs.mTextures.begin(); texIt != reqs.mTextures.end();
-             ++texIt)
-        {
-            defineMap[texIt->second] = "1";
-            defineMap[texIt->second + std::string("UV")] = std::to_string(texIt->first);
-        }
+        ProgramDefines defines;
 
-        if (defineMap["diffuseMap"] == "0")
+        const bool hasDiffuseMap = std::any_of(reqs.mTextures.begin(), reqs.mTextures.end(),
+            [](const auto& texture) { return texture.second == "diffuseMap"; });
+        if (!hasDiffuseMap)
         {
             writableStateSet->addUniform(new osg::Uniform("useDiffuseMapForShadowAlpha", false));
             addedState->addUniform("useDiffuseMapForShadowAlpha");
         }
 
-        defineMap["parallax"] = reqs.mNormalHeight ? "1" : "0";
+        defines.mParallax = reqs.mNormalHeight;
 
         writableStateSet->addUniform(new osg::Uniform("colorMode", reqs.mColorMode));
         addedState->addUniform("colorMode");
 
-        defineMap["alphaFunc"] = std::to_string(reqs.mAlphaFunc);
+        defines.mAlphaFunc = reqs.mAlphaFunc;
 
-        defineMap["additiveBlending"] = reqs.mAdditiveBlending ? "1" : "0";
+        defines.mAdditiveBlending = reqs.mAdditiveBlending;
 
         osg::ref_ptr<osg::StateSet> removedState;
         if ((removedState = getRemovedState(*writableStateSet)) && !mAllowedToModifyStateSets)
@@ -627,8 +720,6 @@ namespace Shader
         if (!removedState)
             removedState = new osg::StateSet();
 
-        defineMap["alphaToCoverage"] = "0";
-        defineMap["adjustCoverage"] = "0";
         if (reqs.mAlphaFunc != osg::AlphaFunc::ALWAYS)
         {
             writableStateSet->addUniform(new osg::Uniform("alphaRef", reqs.mAlphaRef));
@@ -651,34 +742,31 @@ namespace Shader
             {
                 writableStateSet->setMode(GL_SAMPLE_ALPHA_TO_COVERAGE_ARB, osg::StateAttribute::ON);
                 addedState->setMode(GL_SAMPLE_ALPHA_TO_COVERAGE_ARB);
-                defineMap["alphaToCoverage"] = "1";
+                defines.mAlphaToCoverage = true;
             }
 
             // Adjusting coverage isn't safe with blending on as blending requires the alpha to be intact.
             // Maybe we could also somehow (e.g. userdata) detect when the diffuse map has coverage-preserving mip maps
             // in the future
             if (mAdjustCoverageForAlphaTest && !reqs.mAlphaBlend)
-                defineMap["adjustCoverage"] = "1";
+                defines.mAdjustCoverage = true;
 
             // Preventing alpha tested stuff shrinking as lower mip levels are used requires knowing the texture size
             osg::ref_ptr<osg::GLExtensions> exts = osg::GLExtensions::Get(0, false);
             if (exts && exts->isGpuShader4Supported)
-                defineMap["useGPUShader4"] = "1";
+                defines.mUseGPUShader4 = true;
             // We could fall back to a texture size uniform if EXT_gpu_shader4 is missing
         }
 
         bool simpleLighting = false;
         node.getUserValue("simpleLighting", simpleLighting);
-        if (simpleLighting)
-            defineMap["endLight"] = "0";
+        defines.mSimpleLighting = simpleLighting;
 
-        if (simpleLighting || dynamic_cast<osgParticle::ParticleSystem*>(&node))
-            defineMap["forcePPL"] = "0";
+        defines.mNoForcedPPL = simpleLighting || dynamic_cast<osgParticle::ParticleSystem*>(&node);
 
         if (reqs.mAlphaBlend && mSupportsNormalsRT)
         {
-            if (reqs.mSoftParticles)
-                defineMap["disableNormals"] = "1";
+            defines.mDisableNormals = reqs.mSoftParticles;
             writableStateSet->setAttribute(new osg::ColorMaski(1, false, false, false, false));
         }
 
@@ -701,24 +789,29 @@ namespace Shader
             updateRemovedState(*writableUserData, removedState);
         }
 
-        defineMap["softParticles"] = reqs.mSoftParticles ? "1" : "0";
-
-        Stereo::Manager::instance().shaderStereoDefines(defineMap);
+        defines.mSoftParticles = reqs.mSoftParticles;
 
         std::string shaderPrefix;
         if (!node.getUserValue("shaderPrefix", shaderPrefix))
             shaderPrefix = mDefaultShaderPrefix;
 
-        osg::ref_ptr<osg::Shader> vertexShader(
-            mShaderManager.getShader(shaderPrefix + "_vertex.glsl", defineMap, osg::Shader::VERTEX));
-        osg::ref_ptr<osg::Shader> fragmentShader(
-            mShaderManager.getShader(shaderPrefix + "_fragment.glsl", defineMap, osg::Shader::FRAGMENT));
+        // Most drawables share a few permutations, look them up by a compact key before building a DefineMap
+        const std::optional<ShaderManager::PermutationKey> key
+            = makePermutationKey(shaderPrefix, reqs.mTextures, defines);
+        std::optional<osg::ref_ptr<osg::Program>> program;
+        if (key)
+            program = mShaderManager.getPermutation(*key);
+        if (!program)
+        {
+            program = makeProgram(mShaderManager, shaderPrefix, reqs.mTextures, defines, mProgramTemplate);
+            if (key)
+                mShaderManager.addPermutation(*key, *program);
+        }
 
-        if (vertexShader && fragmentShader)
+        if (*program)
         {
-            auto program = mShaderManager.getProgram(vertexShader, fragmentShader, mProgramTemplate);
-            writableStateSet->setAttributeAndModes(program, osg::StateAttribute::ON);
-            addedState->setAttributeAndModes(program);
+            writableStateSet->setAttributeAndModes(*program, osg::StateAttribute::ON);
+            addedState->setAttributeAndModes(*program);
 
             for (std::map<int, std::string>::const_iterator texIt = reqs.mTextures.begin();
                  texIt != reqs.mTextures.end(); ++texIt)
@@ -13,22 +13,38 @@ namespace Sqlite3
         sqlite3_close_v2(handle);
     }
 
+    namespace
+    {
+        Db openDb(std::string_view path, int flags)
+        {
+            sqlite3* handle = nullptr;
+            if (const int ec = sqlite3_open_v2(std::string(path).c_str(), &handle, flags, nullptr); ec != SQLITE_OK)
+            {
+                const std::string message(sqlite3_errmsg(handle));
+                sqlite3_close(handle);
+                throw std::runtime_error("Failed to open database: " + message);
+            }
+            return Db(handle);
+        }
+    }
+
     Db makeDb(std::string_view path, const char* schema)
     {
-        sqlite3* handle = nullptr;
-        // All uses of NavMeshDb are protected by a mutex (navmeshtool) or serialized in a single thread (DbWorker)
+        // All uses of NavMeshDb are serialized in a single thread (DbWorker, NavMeshDbWriter)
         // so additional synchronization between threads is not required and SQLITE_OPEN_NOMUTEX can be used.
         // This is unsafe to use NavMeshDb without external synchronization because of internal state.
-        const int flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_NOMUTEX;
-        if (const int ec = sqlite3_open_v2(std::string(path).c_str(), &handle, flags, nullptr); ec != SQLITE_OK)
-        {
-            const std::string message(sqlite3_errmsg(handle));
-            sqlite3_close(handle);
-            throw std::runtime_error("Failed to open database: " + message);
-        }
-        Db result(handle);
-        if (const int ec = sqlite3_exec(result.get(), schema, nullptr, nullptr, nullptr); ec != SQLITE_OK)
+        Db result = openDb(path, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_NOMUTEX);
+        sqlite3* const handle = result.get();
+        if (const int ec = sqlite3_exec(handle, schema, nullptr, nullptr, nullptr); ec != SQLITE_OK)
             throw std::runtime_error("Failed create database schema: " + std::string(sqlite3_errmsg(handle)));
         return result;
     }
+
+    Db makeReadOnlyDb(std::string_view path)
+    {
+        Db result = openDb(path, SQLITE_OPEN_READONLY | SQLITE_OPEN_NOMUTEX);
+        // Readers may be briefly blocked by a concurrent checkpoint
+        sqlite3_busy_timeout(result.get(), 1000);
+        return result;
+    }
 }
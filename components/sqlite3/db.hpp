@@ -16,6 +16,10 @@ namespace Sqlite3
     using Db = std::unique_ptr<sqlite3, CloseSqlite3>;
 
     Db makeDb(std::string_view path, const char* schema);
+
+    // Opens an existing database for reading only. Multiple connections to the same file may be used concurrently
+    // from different threads, one connection per thread.
+    Db makeReadOnlyDb(std::string_view path);
 }
 
 #endif
@@ -0,0 +1,251 @@
+#include "diskcache.hpp"
+
+#include <components/debug/debuglog.hpp>
+#include <components/files/conversion.hpp>
+#include <components/serialization/binaryreader.hpp>
+#include <components/serialization/binarywriter.hpp>
+#include <components/serialization/format.hpp>
+#include <components/serialization/sizeaccumulator.hpp>
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace Terrain
+{
+    namespace
+    {
+        constexpr char diskCacheMagic[] = { 'O', 'M', 'W', 'T' };
+        // Should be incremented when the format or the generated data changes
+        constexpr std::uint32_t diskCacheVersion = 1;
+
+        template <Serialization::Mode mode>
+        struct Format : Serialization::Format<mode, Format<mode>>
+        {
+        };
+
+        template <class Visitor>
+        void writeHeader(Visitor& visitor, std::uint64_t hash)
+        {
+            constexpr Format<Serialization::Mode::Write> format;
+            visitor(format, diskCacheMagic, std::size(diskCacheMagic));
+            visitor(format, diskCacheVersion);
+            visitor(format, hash);
+        }
+
+        bool readHeader(Serialization::BinaryReader& reader, std::uint64_t expectedHash)
+        {
+            constexpr Format<Serialization::Mode::Read> format;
+            char magic[std::size(diskCacheMagic)];
+            reader(format, magic, std::size(magic));
+            if (std::memcmp(magic, diskCacheMagic, sizeof(magic)) != 0)
+                return false;
+            std::uint32_t version = 0;
+            reader(format, version);
+            if (version != diskCacheVersion)
+                return false;
+            std::uint64_t hash = 0;
+            reader(format, hash);
+            return hash == expectedHash;
+        }
+
+        template <class Visitor>
+        void writeVertexBuffers(Visitor& visitor, std::uint64_t hash, const osg::Vec3Array& positions,
+            const osg::Vec3Array& normals, const osg::Vec4ubArray& colours)
+        {
+            constexpr Format<Serialization::Mode::Write> format;
+            writeHeader(visitor, hash);
+            visitor(format, static_cast<std::uint32_t>(positions.size()));
+            visitor(format, positions.front().ptr(), positions.size() * 3);
+            visitor(format, normals.front().ptr(), normals.size() * 3);
+            visitor(format, colours.front().ptr(), colours.size() * 4);
+        }
+
+        template <class Visitor>
+        void writeBlendmaps(Visitor& visitor, std::uint64_t hash,
+            const std::vector<osg::ref_ptr<osg::Image>>& blendmaps, const std::vector<std::string>& layerTextures)
+        {
+            constexpr Format<Serialization::Mode::Write> format;
+            writeHeader(visitor, hash);
+            visitor(format, static_cast<std::uint32_t>(layerTextures.size()));
+            for (const std::string& texture : layerTextures)
+            {
+                visitor(format, static_cast<std::uint32_t>(texture.size()));
+                visitor(format, texture.data(), texture.size());
+            }
+            visitor(format, static_cast<std::uint32_t>(blendmaps.size()));
+            for (const osg::ref_ptr<osg::Image>& image : blendmaps)
+            {
+                visitor(format, static_cast<std::uint32_t>(image->s()));
+                visitor(format, image->data(), image->getTotalDataSize());
+            }
+        }
+
+        template <class Function>
+        std::string serialize(Function&& function)
+        {
+            Serialization::SizeAccumulator sizeAccumulator;
+            function(sizeAccumulator);
+            std::string result(sizeAccumulator.value(), '\0');
+            std::byte* const data = reinterpret_cast<std::byte*>(result.data());
+            Serialization::BinaryWriter writer(data, data + result.size());
+            function(writer);
+            return result;
+        }
+
+        // Calls the function with a reader over the memory-mapped file. Returns false if the file doesn't exist or
+        // doesn't contain valid data.
+        template <class Function>
+        bool readFile(const std::filesystem::path& path, Function&& function)
+        {
+            std::error_code ec;
+            if (!std::filesystem::exists(path, ec))
+                return false;
+            try
+            {
+                const boost::iostreams::mapped_file_source file(Files::pathToUnicodeString(path));
+                const std::byte* const data = reinterpret_cast<const std::byte*>(file.data());
+                Serialization::BinaryReader reader(data, data + file.size());
+                return function(reader, file.size());
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Warning) << "Failed to read terrain cache file " << path << ": " << e.what();
+                return false;
+            }
+        }
+    }
+
+    DiskCache::DiskCache(const std::filesystem::path& path)
+        : mPath(path)
+    {
+        std::filesystem::create_directories(mPath);
+    }
+
+    bool DiskCache::loadVertexBuffers(float size, const osg::Vec2f& center, int lodLevel, std::uint64_t hash,
+        osg::Vec3Array& positions, osg::Vec3Array& normals, osg::Vec4ubArray& colours) const
+    {
+        return readFile(getEntryPath("vertices", size, center, lodLevel),
+            [&](Serialization::BinaryReader& reader, std::size_t fileSize) {
+                constexpr Format<Serialization::Mode::Read> format;
+                if (!readHeader(reader, hash))
+                    return false;
+                std::uint32_t count = 0;
+                reader(format, count);
+                if (count == 0 || count > fileSize / (sizeof(osg::Vec3f) * 2 + sizeof(osg::Vec4ub)))
+                    return false;
+                positions.resize(count);
+                normals.resize(count);
+                colours.resize(count);
+                reader(format, positions.front().ptr(), positions.size() * 3);
+                reader(format, normals.front().ptr(), normals.size() * 3);
+                reader(format, colours.front().ptr(), colours.size() * 4);
+                return true;
+            });
+    }
+
+    void DiskCache::storeVertexBuffers(float size, const osg::Vec2f& center, int lodLevel, std::uint64_t hash,
+        const osg::Vec3Array& positions, const osg::Vec3Array& normals, const osg::Vec4ubArray& colours)
+    {
+        if (positions.empty() || normals.size() != positions.size() || colours.size() != positions.size())
+            return;
+        write(getEntryPath("vertices", size, center, lodLevel), serialize([&](auto& visitor) {
+            writeVertexBuffers(visitor, hash, positions, normals, colours);
+        }));
+    }
+
+    bool DiskCache::loadBlendmaps(float size, const osg::Vec2f& center, std::uint64_t hash,
+        std::vector<osg::ref_ptr<osg::Image>>& blendmaps, std::vector<std::string>& layerTextures) const
+    {
+        std::vector<osg::ref_ptr<osg::Image>> loadedBlendmaps;
+        std::vector<std::string> loadedLayerTextures;
+        const bool loaded = readFile(
+            getEntryPath("blendmaps", size, center, 0), [&](Serialization::BinaryReader& reader, std::size_t fileSize) {
+                constexpr Format<Serialization::Mode::Read> format;
+                if (!readHeader(reader, hash))
+                    return false;
+                std::uint32_t layersCount = 0;
+                reader(format, layersCount);
+                if (layersCount == 0 || layersCount > fileSize)
+                    return false;
+                loadedLayerTextures.resize(layersCount);
+                for (std::string& texture : loadedLayerTextures)
+                {
+                    std::uint32_t textureSize = 0;
+                    reader(format, textureSize);
+                    if (textureSize > fileSize)
+                        return false;
+                    texture.resize(textureSize);
+                    reader(format, texture.data(), texture.size());
+                }
+                std::uint32_t blendmapsCount = 0;
+                reader(format, blendmapsCount);
+                if (blendmapsCount != 0 && blendmapsCount != layersCount)
+                    return false;
+                for (std::uint32_t i = 0; i < blendmapsCount; ++i)
+                {
+                    std::uint32_t imageSize = 0;
+                    reader(format, imageSize);
+                    if (imageSize == 0 || static_cast<std::size_t>(imageSize) * imageSize > fileSize)
+                        return false;
+                    osg::ref_ptr<osg::Image> image(new osg::Image);
+                    image->allocateImage(imageSize, imageSize, 1, GL_ALPHA, GL_UNSIGNED_BYTE);
+                    reader(format, image->data(), image->getTotalDataSize());
+                    loadedBlendmaps.push_back(std::move(image));
+                }
+                return true;
+            });
+        if (!loaded)
+            return false;
+        blendmaps = std::move(loadedBlendmaps);
+        layerTextures = std::move(loadedLayerTextures);
+        return true;
+    }
+
+    void DiskCache::storeBlendmaps(float size, const osg::Vec2f& center, std::uint64_t hash,
+        const std::vector<osg::ref_ptr<osg::Image>>& blendmaps, const std::vector<std::string>& layerTextures)
+    {
+        if (layerTextures.empty() || (!blendmaps.empty() && blendmaps.size() != layerTextures.size()))
+            return;
+        write(getEntryPath("blendmaps", size, center, 0),
+            serialize([&](auto& visitor) { writeBlendmaps(visitor, hash, blendmaps, layerTextures); }));
+    }
+
+    std::filesystem::path DiskCache::getEntryPath(
+        std::string_view type, float size, const osg::Vec2f& center, int lodLevel) const
+    {
+        // Chunk sizes and centers are multiples of a power of two fraction of the cell
+        const auto toInt = [](float value) { return std::to_string(std::lround(value * 256)); };
+        return mPath
+            / (std::string(type) + "_" + toInt(size) + "_" + toInt(center.x()) + "_" + toInt(center.y()) + "_"
+                + std::to_string(lodLevel) + ".bin");
+    }
+
+    void DiskCache::write(const std::filesystem::path& path, const std::string& data)
+    {
+        const std::lock_guard lock(mWriteMutex);
+        std::filesystem::path tmpPath = path;
+        tmpPath += ".tmp";
+        try
+        {
+            {
+                std::ofstream stream(tmpPath, std::ios::binary | std::ios::trunc);
+                stream.exceptions(std::ios::failbit | std::ios::badbit);
+                stream.write(data.data(), static_cast<std::streamsize>(data.size()));
+            }
+            // Replace atomically so concurrent readers see either the old or the new entry
+            std::filesystem::rename(tmpPath, path);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to write terrain cache file " << path << ": " << e.what();
+            std::error_code ec;
+            std::filesystem::remove(tmpPath, ec);
+        }
+    }
+}
@@ -0,0 +1,52 @@
+#ifndef OPENMW_COMPONENTS_TERRAIN_DISKCACHE_H
+#define OPENMW_COMPONENTS_TERRAIN_DISKCACHE_H
+
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <osg/Array>
+#include <osg/Image>
+#include <osg/Vec2f>
+#include <osg/ref_ptr>
+
+namespace Terrain
+{
+    /// @brief Persistent cache of generated terrain chunk data: vertex buffers and blendmaps.
+    /// Each entry is stored in a separate file together with a hash of the data it was generated from. An entry with
+    /// a different hash is reported as missing and is replaced by the next store. Files are read memory-mapped.
+    /// @note Thread safe.
+    class DiskCache
+    {
+    public:
+        explicit DiskCache(const std::filesystem::path& path);
+
+        bool loadVertexBuffers(float size, const osg::Vec2f& center, int lodLevel, std::uint64_t hash,
+            osg::Vec3Array& positions, osg::Vec3Array& normals, osg::Vec4ubArray& colours) const;
+
+        void storeVertexBuffers(float size, const osg::Vec2f& center, int lodLevel, std::uint64_t hash,
+            const osg::Vec3Array& positions, const osg::Vec3Array& normals, const osg::Vec4ubArray& colours);
+
+        /// Blendmaps are single channel square images. Layers are identified by texture names since
+        /// the layer info depends on available resources and settings.
+        bool loadBlendmaps(float size, const osg::Vec2f& center, std::uint64_t hash,
+            std::vector<osg::ref_ptr<osg::Image>>& blendmaps, std::vector<std::string>& layerTextures) const;
+
+        void storeBlendmaps(float size, const osg::Vec2f& center, std::uint64_t hash,
+            const std::vector<osg::ref_ptr<osg::Image>>& blendmaps, const std::vector<std::string>& layerTextures);
+
+    private:
+        const std::filesystem::path mPath;
+        std::mutex mWriteMutex;
+
+        std::filesystem::path getEntryPath(
+            std::string_view type, float size, const osg::Vec2f& center, int lodLevel) const;
+
+        void write(const std::filesystem::path& path, const std::string& data);
+    };
+}
+
+#endif
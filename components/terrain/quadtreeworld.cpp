@@ -5,7 +5,9 @@
 #include <osg/ShapeDrawable>
 #include <osgUtil/CullVisitor>
 
+#include <chrono>
 #include <limits>
+#include <string>
 
 #include <components/loadinglistener/reporter.hpp>
 #include <components/misc/constants.hpp>
@@ -287,6 +289,37 @@ namespace Terrain
         unsigned int mNodeMask;
     };
 
+    /// Returns a view obtained from ViewDataMap::getViewData to the map when leaving the scope, even on exception,
+    /// so it is never left marked as in use.
+    class ViewDataGuard
+    {
+    public:
+        ViewDataGuard(ViewDataMap& map, ViewData* viewData, double referenceTime,
+            std::chrono::steady_clock::time_point start)
+            : mMap(map)
+            , mViewData(viewData)
+            , mReferenceTime(referenceTime)
+            , mStart(start)
+        {
+        }
+
+        ViewDataGuard(const ViewDataGuard&) = delete;
+        ViewDataGuard& operator=(const ViewDataGuard&) = delete;
+
+        ~ViewDataGuard()
+        {
+            const double traversalTime
+                = std::chrono::duration<double>(std::chrono::steady_clock::now() - mStart).count();
+            mMap.releaseViewData(mViewData, mReferenceTime, traversalTime);
+        }
+
+    private:
+        ViewDataMap& mMap;
+        ViewData* mViewData;
+        double mReferenceTime;
+        std::chrono::steady_clock::time_point mStart;
+    };
+
     QuadTreeWorld::QuadTreeWorld(osg::Group* parent, osg::Group* compileRoot, Resource::ResourceSystem* resourceSystem,
         Storage* storage, unsigned int nodeMask, unsigned int preCompileMask, unsigned int borderMask,
         int compMapResolution, float compMapLevel, float lodFactor, int vertexLodMod, float maxCompGeometrySize,
@@ -477,10 +510,13 @@ namespace Terrain
         if (!isCullVisitor && nv.getVisitorType() != osg::NodeVisitor::INTERSECTION_VISITOR)
             return;
 
+        const auto start = std::chrono::steady_clock::now();
         osg::Object* viewer = isCullVisitor ? static_cast<osgUtil::CullVisitor*>(&nv)->getCurrentCamera() : nullptr;
         bool needsUpdate = true;
         osg::Vec3f viewPoint = viewer ? nv.getViewPoint() : nv.getEyePoint();
         ViewData* vd = mViewDataMap->getViewData(viewer, viewPoint, mActiveGrid, needsUpdate);
+        const double referenceTime = nv.getFrameStamp() ? nv.getFrameStamp()->getReferenceTime() : 0.0;
+        const ViewDataGuard guard(*mViewDataMap, vd, referenceTime, start);
         if (needsUpdate)
         {
             vd->reset();
@@ -502,19 +538,16 @@ namespace Terrain
                 mStorage->getCellWorldSize(), !isGridEmpty());
 
         vd->resetChanged();
-
-        double referenceTime = nv.getFrameStamp() ? nv.getFrameStamp()->getReferenceTime() : 0.0;
-        if (referenceTime != 0.0)
-        {
-            vd->setLastUsageTimeStamp(referenceTime);
-            mViewDataMap->clearUnusedViews(referenceTime);
-        }
     }
 
     void QuadTreeWorld::ensureQuadTreeBuilt()
     {
+        // The quadtree is never modified after it is built, so once it is published readers don't need the lock
+        if (mQuadTreeBuilt.load(std::memory_order_acquire))
+            return;
+
         std::lock_guard<std::mutex> lock(mQuadTreeMutex);
-        if (mQuadTreeBuilt)
+        if (mQuadTreeBuilt.load(std::memory_order_relaxed))
             return;
 
         QuadTreeBuilder builder(mStorage, mMinSize);
@@ -522,7 +555,7 @@ namespace Terrain
 
         mRootNode = builder.getRootNode();
         mRootNode->setWorld(this);
-        mQuadTreeBuilt = true;
+        mQuadTreeBuilt.store(true, std::memory_order_release);
     }
 
     void QuadTreeWorld::enable(bool enabled)
@@ -591,6 +624,18 @@ namespace Terrain
     {
         if (mCompositeMapRenderer)
             stats->setAttribute(frameNumber, "Composite", mCompositeMapRenderer->getCompileSetSize());
+
+        // Traversal times are reported in microseconds
+        const std::vector<double> traversalTimes = mViewDataMap->getTraversalTimes();
+        double maxTraversalTime = 0;
+        for (std::size_t i = 0; i < traversalTimes.size(); ++i)
+        {
+            stats->setAttribute(
+                frameNumber, "Terrain View " + std::to_string(i) + " Traversal", traversalTimes[i] * 1e6);
+            maxTraversalTime = std::max(maxTraversalTime, traversalTimes[i]);
+        }
+        stats->setAttribute(frameNumber, "Terrain Views", traversalTimes.size());
+        stats->setAttribute(frameNumber, "Terrain Traversal", maxTraversalTime * 1e6);
     }
 
     void QuadTreeWorld::loadCell(int x, int y)
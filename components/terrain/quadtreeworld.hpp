@@ -88,7 +88,7 @@ namespace Terrain
         std::vector<ChunkManager*> mChunkManagers;
 
         std::mutex mQuadTreeMutex;
-        bool mQuadTreeBuilt;
+        std::atomic<bool> mQuadTreeBuilt;
         float mLodFactor;
         int mVertexLodMod;
         float mViewDistance;
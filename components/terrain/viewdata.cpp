@@ -3,6 +3,7 @@
 #include "quadtreenode.hpp"
 
 #include <algorithm>
+#include <limits>
 
 namespace Terrain
 {
@@ -13,6 +14,8 @@ namespace Terrain
         , mChanged(false)
         , mHasViewPoint(false)
         , mWorldUpdateRevision(0)
+        , mTraversalTime(0.0)
+        , mInUse(false)
     {
     }
 
@@ -129,6 +132,7 @@ namespace Terrain
     ViewData* ViewDataMap::getViewData(
         osg::Object* viewer, const osg::Vec3f& viewPoint, const osg::Vec4i& activeGrid, bool& needsUpdate)
     {
+        const std::lock_guard lock(mMutex);
         ViewerMap::const_iterator found = mViewers.find(viewer);
         ViewData* vd = nullptr;
         if (found == mViewers.end())
@@ -136,8 +140,15 @@ namespace Terrain
             vd = createOrReuseView();
             mViewers[viewer] = vd;
         }
+        else if (found->second->mInUse)
+        {
+            // Viewer-less visitors share the same key and may traverse concurrently,
+            // give them a separate view that will expire once it is released.
+            vd = createOrReuseView();
+        }
         else
             vd = found->second;
+        vd->mInUse = true;
         needsUpdate = false;
 
         if (!(vd->suitableToUse(activeGrid)
@@ -148,6 +159,9 @@ namespace Terrain
             const ViewData* mostSuitableView = nullptr;
             for (const ViewData* other : mUsedViews)
             {
+                // Views that are being traversed by other threads can't be copied
+                if (other != vd && other->mInUse)
+                    continue;
                 if (other->suitableToUse(activeGrid) && other->getWorldUpdateRevision() >= mWorldUpdateRevision)
                 {
                     float dist = (viewPoint - other->getViewPoint()).length2();
@@ -178,6 +192,18 @@ namespace Terrain
         return vd;
     }
 
+    void ViewDataMap::releaseViewData(ViewData* vd, double referenceTime, double traversalTime)
+    {
+        const std::lock_guard lock(mMutex);
+        vd->mInUse = false;
+        vd->mTraversalTime = traversalTime;
+        if (referenceTime == 0.0)
+            return;
+        vd->setLastUsageTimeStamp(referenceTime);
+        mLastReferenceTime = std::max(mLastReferenceTime, referenceTime);
+        clearUnusedViews(referenceTime);
+    }
+
     ViewData* ViewDataMap::createOrReuseView()
     {
         ViewData* vd = nullptr;
@@ -198,6 +224,7 @@ namespace Terrain
 
     ViewData* ViewDataMap::createIndependentView() const
     {
+        const std::lock_guard lock(mMutex);
         ViewData* vd = new ViewData;
         vd->setWorldUpdateRevision(mWorldUpdateRevision);
         return vd;
@@ -207,14 +234,14 @@ namespace Terrain
     {
         for (ViewerMap::iterator it = mViewers.begin(); it != mViewers.end();)
         {
-            if (it->second->getLastUsageTimeStamp() + mExpiryDelay < referenceTime)
+            if (!it->second->mInUse && it->second->getLastUsageTimeStamp() + mExpiryDelay < referenceTime)
                 mViewers.erase(it++);
             else
                 ++it;
         }
         for (std::deque<ViewData*>::iterator it = mUsedViews.begin(); it != mUsedViews.end();)
         {
-            if ((*it)->getLastUsageTimeStamp() + mExpiryDelay < referenceTime)
+            if (!(*it)->mInUse && (*it)->getLastUsageTimeStamp() + mExpiryDelay < referenceTime)
             {
                 (*it)->clear();
                 mUnusedViews.push_back(*it);
@@ -227,7 +254,18 @@ namespace Terrain
 
     void ViewDataMap::rebuildViews()
     {
+        const std::lock_guard lock(mMutex);
         ++mWorldUpdateRevision;
     }
 
+    std::vector<double> ViewDataMap::getTraversalTimes() const
+    {
+        const std::lock_guard lock(mMutex);
+        std::vector<double> result;
+        for (const ViewData* vd : mUsedViews)
+            if (vd->getLastUsageTimeStamp() == mLastReferenceTime)
+                result.push_back(vd->getTraversalTime());
+        return result;
+    }
+
 }
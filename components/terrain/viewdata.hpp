@@ -2,6 +2,9 @@
 #define OPENMW_COMPONENTS_TERRAIN_VIEWDATA_H
 
 #include <deque>
+#include <list>
+#include <map>
+#include <mutex>
 #include <vector>
 
 #include <osg/Node>
@@ -79,7 +82,12 @@ namespace Terrain
 
         void removeNodeFromIndex(const QuadTreeNode* node);
 
+        /// Time in seconds taken by the last traversal of this view.
+        double getTraversalTime() const { return mTraversalTime; }
+
     private:
+        friend class ViewDataMap;
+
         std::vector<ViewDataEntry> mEntries;
         std::vector<const QuadTreeNode*> mNodes;
         unsigned int mNumEntries;
@@ -89,8 +97,12 @@ namespace Terrain
         bool mHasViewPoint;
         osg::Vec4i mActiveGrid;
         unsigned int mWorldUpdateRevision;
+        double mTraversalTime;
+        bool mInUse;
     };
 
+    /// @note Thread safe. A view returned by getViewData is owned by the caller until it is passed to
+    /// releaseViewData, so it can be traversed without any locking while other cameras traverse their views.
     class ViewDataMap : public osg::Referenced
     {
     public:
@@ -108,15 +120,21 @@ namespace Terrain
         ViewData* getViewData(
             osg::Object* viewer, const osg::Vec3f& viewPoint, const osg::Vec4i& activeGrid, bool& needsUpdate);
 
-        ViewData* createOrReuseView();
+        /// Returns the view to the map and removes views that were not used for a while.
+        void releaseViewData(ViewData* vd, double referenceTime, double traversalTime);
+
         ViewData* createIndependentView() const;
 
-        void clearUnusedViews(double referenceTime);
         void rebuildViews();
 
         float getReuseDistance() const { return mReuseDistance; }
 
+        /// Returns traversal times of the views used in the last frame.
+        std::vector<double> getTraversalTimes() const;
+
     private:
+        mutable std::mutex mMutex;
+
         std::list<ViewData> mViewVector;
 
         typedef std::map<osg::ref_ptr<osg::Object>, ViewData*> ViewerMap;
@@ -127,8 +145,13 @@ namespace Terrain
 
         unsigned int mWorldUpdateRevision;
 
+        double mLastReferenceTime = 0;
+
         std::deque<ViewData*> mUsedViews;
         std::deque<ViewData*> mUnusedViews;
+
+        ViewData* createOrReuseView();
+        void clearUnusedViews(double referenceTime);
     };
 
 }
@@ -49,4 +49,12 @@
 ---
 -- To reload modified shaders
 -- @function [parent=#debug] triggerShaderReload
+
+---
+-- Records every Lua handler call (engine handlers, event handlers, timer callbacks) during the given number of frames.
+-- When finished, the recording is saved to the user data directory as `lua_profile.json` (Chrome trace format,
+-- can be opened in chrome://tracing or https://ui.perfetto.dev) and `lua_profile.folded` (collapsed stacks,
+-- can be used with flamegraph.pl or https://www.speedscope.app).
+-- @function [parent=#debug] recordLuaProfile
+-- @param #number frames
 return nil